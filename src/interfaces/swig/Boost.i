@@ -30,6 +30,8 @@
 
 /* Remove C Prefix */
 %shared_ptr(shogun::StochasticGBMachine)
+%shared_ptr(shogun::HistogramGBMachine)
 
 /* Include Class Headers to make them visible from within the target language */
 %include <shogun/machine/StochasticGBMachine.h>
+%include <shogun/machine/HistogramGBMachine.h>
@@ -1,3 +1,4 @@
 %{
  #include <shogun/machine/StochasticGBMachine.h>
+ #include <shogun/machine/HistogramGBMachine.h>
 %}
@@ -425,6 +425,25 @@ AnyParameter SGObject::get_function(const BaseTag& _tag) const
 	return parameter;
 }
 
+const AnyParameter* SGObject::get_direct_parameter(const BaseTag& _tag) const
+{
+	auto [has_tag, it] = self->has(_tag);
+	require(
+	    has_tag, "There is no parameter called \"{}\" in {}",
+	    _tag.name().c_str(), get_name());
+
+	const auto& parameter = it->second;
+	const auto& pprop = parameter.get_properties();
+	if (pprop.has_property(ParameterProperties::READONLY) ||
+	    pprop.has_property(ParameterProperties::CONSTRAIN) ||
+	    pprop.has_property(ParameterProperties::AUTO) ||
+	    pprop.has_property(ParameterProperties::RUNFUNCTION) ||
+	    !parameter.get_callbacks().empty())
+		return nullptr;
+
+	return &parameter;
+}
+
 bool SGObject::has_parameter(const BaseTag& _tag) const
 {
 	return std::get<0>(self->has(_tag));
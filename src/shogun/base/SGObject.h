@@ -44,6 +44,10 @@ class ParameterObserver;
 
 template <class T>
 class ObservedValueTemplated;
+
+template <typename T>
+class ParameterHandle;
+
 	namespace io
 	{
 		class Deserializer;
@@ -627,6 +631,21 @@ public:
 		Tag<T> tag(name);
 		return get(tag);
 	}
+
+	/** Resolves a class parameter, identified by a Tag, to a typed handle
+	 * that can be used for repeated put/get calls, e.g. in the inner loop
+	 * of a training algorithm. The name lookup and type check happen only
+	 * once, here. See ParameterHandle.
+	 * Throws an exception if the class does not have such a parameter.
+	 *
+	 * @param _tag name and type information of parameter
+	 * @return handle to the parameter identified by the input tag
+	 */
+	template <typename T>
+	ParameterHandle<T> get_parameter_handle(const Tag<T>& _tag) noexcept(false)
+	{
+		return ParameterHandle<T>(this, _tag);
+	}
 #endif
 	/** Returns string representation of the object that contains
 	 * its name and parameters.
@@ -1083,6 +1102,19 @@ private:
 	 */
 	AnyParameter get_function(const BaseTag& _tag) const;
 
+	/** Getter for a class parameter that can be written and read directly,
+	 * i.e. without the checks and callbacks done in update_parameter.
+	 * Throws an exception if the class does not have such a parameter.
+	 *
+	 * @param _tag name information of parameter
+	 * @return the parameter, or nullptr if it is read-only, constrained,
+	 * auto-initialised, a function or has callbacks attached
+	 */
+	const AnyParameter* get_direct_parameter(const BaseTag& _tag) const;
+
+	template <typename T>
+	friend class ParameterHandle;
+
 	class Self;
 	std::unique_ptr<Self> self;
 
@@ -1158,6 +1190,10 @@ protected:
 	template <class T>
 	void observe(const int64_t step, std::string_view name) const
 	{
+		// If there are no observers attached, do not look up/clone anything.
+		if (get_num_subscriptions() == 0)
+			return;
+
 		auto param = this->get_parameter(BaseTag(name));
 		auto cloned = any_cast<T>(param.get_value());
 		this->observe(
@@ -1235,6 +1271,87 @@ std::shared_ptr<const T> make_clone(std::shared_ptr<const T> orig, ParameterProp
 	return std::static_pointer_cast<const T>(clone);
 }
 
+#ifndef SWIG
+/** @brief Typed handle to a parameter of an SGObject, resolved once from a
+ * Tag.
+ *
+ * SGObject::put and SGObject::get look the parameter up by name, check its
+ * type and run the update checks on every call. A handle does all of that
+ * when it is created and afterwards reads and writes the registered member
+ * directly. Parameters that need the checks (read-only, constrained, auto,
+ * functions or parameters with callbacks) transparently use the regular
+ * put/get path.
+ *
+ * Handles are meant to be short lived, e.g. created at the start of a
+ * training method. They must not outlive their object.
+ */
+template <typename T>
+class ParameterHandle
+{
+	static_assert(
+	    !is_sg_base<T>::value && !is_string<T>::value,
+	    "ParameterHandle only supports value parameters");
+
+public:
+	/** Constructor
+	 *
+	 * @param owner object the parameter is registered in
+	 * @param tag name and type information of parameter
+	 */
+	ParameterHandle(SGObject* owner, const Tag<T>& tag)
+	    : m_owner(owner), m_tag(tag)
+	{
+		require(
+		    m_owner->has(m_tag), "Parameter {}::{} of type {} does not exist.",
+		    m_owner->get_name(), m_tag.name().c_str(),
+		    demangled_type<T>().c_str());
+		resolve();
+	}
+
+	/** @return value of the parameter */
+	T get() const
+	{
+		if (m_value)
+			return *m_value;
+		return m_owner->get(m_tag);
+	}
+
+	/** Sets the value of the parameter
+	 *
+	 * @param value new value of the parameter
+	 */
+	void put(const T& value)
+	{
+		if (m_value)
+		{
+			*m_value = value;
+			return;
+		}
+		m_owner->put(m_tag, value);
+		// an auto parameter becomes directly accessible once it was put
+		resolve();
+	}
+
+	/** @return true if the handle bypasses SGObject::put/get */
+	bool is_direct() const
+	{
+		return m_value != nullptr;
+	}
+
+private:
+	void resolve()
+	{
+		m_value = nullptr;
+		if (auto parameter = m_owner->get_direct_parameter(m_tag))
+			m_value = parameter->get_value().template referenced<T>();
+	}
+
+	SGObject* m_owner;
+	Tag<T> m_tag;
+	T* m_value = nullptr;
+};
+#endif // SWIG
+
 #ifndef SWIG
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 namespace sgo_details
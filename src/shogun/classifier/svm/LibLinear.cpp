@@ -15,6 +15,7 @@
 #include <shogun/lib/Signal.h>
 #include <shogun/lib/memory.h>
 #include <shogun/lib/Time.h>
+#include <shogun/lib/Tracer.h>
 #include <shogun/optimization/liblinear/tron.h>
 #include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/mathematics/UniformIntDistribution.h>
@@ -54,12 +55,17 @@ void LibLinear::init()
 	set_C(1, 1);
 	set_max_iterations();
 	set_epsilon(1e-5);
+	m_warm_start = false;
 
 	SG_ADD(&C1, "C1", "C Cost constant 1.", ParameterProperties::HYPER);
 	SG_ADD(&C2, "C2", "C Cost constant 2.", ParameterProperties::HYPER);
 	SG_ADD(&use_bias, "use_bias", "Indicates if bias is used.", ParameterProperties::SETTING);
 	SG_ADD(&epsilon, "epsilon", "Convergence precision.", ParameterProperties::HYPER);
 	SG_ADD(&max_iterations, "max_iterations", "Max number of iterations.", ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_warm_start, "warm_start",
+	    "Whether primal solvers start from the current model.",
+	    ParameterProperties::SETTING);
 	SG_ADD(&m_linear_term, "linear_term", "Linear Term", ParameterProperties::MODEL);
 	SG_ADD_OPTIONS(
 	    (machine_int_t*)&liblinear_solver_type, "liblinear_solver_type",
@@ -75,6 +81,7 @@ LibLinear::~LibLinear()
 
 bool LibLinear::train_machine(std::shared_ptr<Features> data)
 {
+	SG_TRACE_SCOPE("LibLinear::train_machine", "svm");
 
 	ASSERT(m_labels)
 	init_linear_term();
@@ -136,6 +143,18 @@ bool LibLinear::train_machine(std::shared_ptr<Features> data)
 		prob.n = w.vlen;
 		memset(w.vector, 0, sizeof(float64_t) * (w.vlen + 0));
 	}
+
+	bool warm_start = m_warm_start &&
+	                  (solver_type == L2R_LR || solver_type == L2R_L2LOSS_SVC) &&
+	                  m_w.vlen == w.vlen;
+	if (warm_start)
+	{
+		SG_DEBUG("warm starting from the current model")
+		sg_memcpy(w.vector, m_w.vector, sizeof(float64_t) * w.vlen);
+		if (get_bias_enabled())
+			w[w.vlen] = get_bias();
+	}
+
 	prob.l = num_vec;
 	prob.x = features;
 	prob.y = SG_MALLOC(double, prob.l);
@@ -177,7 +196,7 @@ bool LibLinear::train_machine(std::shared_ptr<Features> data)
 		    fun_obj, get_epsilon() * Math::min(pos, neg) / prob.l,
 		    get_max_iterations());
 		SG_DEBUG("starting L2R_LR training via tron")
-		tron_obj.tron(w.vector, m_max_train_time);
+		tron_obj.tron(w.vector, m_max_train_time, warm_start);
 		SG_DEBUG("done with tron")
 		delete fun_obj;
 		break;
@@ -188,7 +207,7 @@ bool LibLinear::train_machine(std::shared_ptr<Features> data)
 		Tron tron_obj(
 		    fun_obj, get_epsilon() * Math::min(pos, neg) / prob.l,
 		    get_max_iterations());
-		tron_obj.tron(w.vector, m_max_train_time);
+		tron_obj.tron(w.vector, m_max_train_time, warm_start);
 		delete fun_obj;
 		break;
 	}
@@ -403,6 +422,7 @@ void LibLinear::solve_l2r_l1l2_svc(
 		}
 
 		iter++;
+		SG_TRACE_COUNT("liblinear_iterations", 1);
 
 		float64_t gap=PGmax_new - PGmin_new;
 		pb.print_absolute(
@@ -756,6 +776,7 @@ void LibLinear::solve_l1r_l2_svc(
 		if (iter == 0)
 			Gmax_init = Gmax_new;
 		iter++;
+		SG_TRACE_COUNT("liblinear_iterations", 1);
 
 		pb.print_absolute(
 		    Gmax_new, -Math::log10(Gmax_new), -Math::log10(Gmax_init),
@@ -1130,6 +1151,7 @@ void LibLinear::solve_l1r_lr(
 		if (iter == 0)
 			Gmax_init = Gmax_new;
 		iter++;
+		SG_TRACE_COUNT("liblinear_iterations", 1);
 
 		pb.print_absolute(
 		    Gmax_new, -Math::log10(Gmax_new), -Math::log10(Gmax_init),
@@ -1333,6 +1355,7 @@ void LibLinear::solve_l2r_lr_dual(
 		if (iter == 0)
 			Gmax_init = Gmax;
 		iter++;
+		SG_TRACE_COUNT("liblinear_iterations", 1);
 
 		pb.print_absolute(
 		    Gmax, -Math::log10(Gmax), -Math::log10(Gmax_init),
@@ -192,6 +192,24 @@ namespace shogun
 			max_iterations = max_iter;
 		}
 
+		/** Enables warm starts. The primal solvers (L2R_LR and
+		 * L2R_L2LOSS_SVC) then start from the current model if it has the
+		 * dimension of the training features, e.g. when retraining along
+		 * a path of C values. Other solvers always start from zero.
+		 *
+		 * @param warm_start whether to start from the current model
+		 */
+		inline void set_warm_start(bool warm_start)
+		{
+			m_warm_start = warm_start;
+		}
+
+		/** @return whether warm starts are enabled */
+		inline bool get_warm_start() const
+		{
+			return m_warm_start;
+		}
+
 		/** set the linear term for qp */
 		void set_linear_term(const SGVector<float64_t> linear_term);
 
@@ -256,6 +274,9 @@ namespace shogun
 		/** maximum number of iterations */
 		int32_t max_iterations;
 
+		/** whether primal solvers start from the current model */
+		bool m_warm_start;
+
 		/** precomputed linear term */
 		SGVector<float64_t> m_linear_term;
 
@@ -0,0 +1,25 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/classifier/svm/LibLinear.h>
+#include <shogun/util/Learner_benchmark.h>
+
+namespace shogun
+{
+
+BENCHMARK_DEFINE_F(LearnerFixture, LibLinear_train_apply)(benchmark::State& st)
+{
+	for (auto _ : st)
+	{
+		auto svm = std::make_shared<LibLinear>(1.0, features, binary_labels);
+		svm->set_liblinear_solver_type(L2R_L2LOSS_SVC_DUAL);
+		svm->train();
+		benchmark::DoNotOptimize(svm->apply_binary(features));
+	}
+	report(st);
+}
+
+LEARNER_BENCHMARK(LibLinear_train_apply, 32768);
+
+}
@@ -8,6 +8,7 @@
 #include <shogun/classifier/svm/LibSVM.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/labels/BinaryLabels.h>
+#include <shogun/lib/Tracer.h>
 
 #include <utility>
 
@@ -46,6 +47,7 @@ void LibSVM::register_params()
 
 bool LibSVM::train_machine(std::shared_ptr<Features> data)
 {
+	SG_TRACE_SCOPE("LibSVM::train_machine", "svm");
 	svm_problem problem;
 	svm_parameter param;
 	struct svm_model* model = nullptr;
@@ -0,0 +1,26 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/classifier/svm/LibSVM.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/util/Learner_benchmark.h>
+
+namespace shogun
+{
+
+BENCHMARK_DEFINE_F(LearnerFixture, LibSVM_train_apply)(benchmark::State& st)
+{
+	for (auto _ : st)
+	{
+		auto kernel = std::make_shared<GaussianKernel>(features, features, 2.0);
+		auto svm = std::make_shared<LibSVM>(1.0, kernel, binary_labels);
+		svm->train();
+		benchmark::DoNotOptimize(svm->apply_binary(features));
+	}
+	report(st);
+}
+
+LEARNER_BENCHMARK(LibSVM_train_apply, 8192);
+
+}
@@ -12,6 +12,7 @@
 #include <shogun/clustering/KMeans.h>
 #include <shogun/distance/EuclideanDistance.h>
 #include <shogun/labels/MulticlassLabels.h>
+#include <shogun/lib/WorkspacePool.h>
 #include <shogun/lib/observers/ObservedValueTemplated.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/NormalDistribution.h>
@@ -24,6 +25,17 @@
 using namespace shogun;
 using namespace std;
 
+/** dense copy of a feature vector, drawn from the workspace pool */
+static SGVector<float64_t>
+computed_feature_vector(const DotFeatures& features, int32_t num)
+{
+	int32_t dim = features.get_dim_feature_space();
+	auto v = workspace::vector<float64_t>(dim);
+	v.zero();
+	features.add_to_dense_vec(1.0, num, v.vector, dim);
+	return v;
+}
+
 GMM::GMM() : RandomMixin<Distribution>(), m_components(), m_coefficients()
 {
 	register_params();
@@ -121,9 +133,12 @@ float64_t GMM::train_em(float64_t min_cov, int32_t max_iter, float64_t min_chang
 	if (!features)
 		error("No features to train on.");
 
-	auto dotdata=features->as<DenseFeatures<float64_t>>();
+	// float32 data is read through add_to_dense_vec into float64 vectors
+	auto dotdata=features->as<DotFeatures>();
 	int32_t num_vectors=dotdata->get_num_vectors();
 
+	// reuses the per-vector temporaries across iterations
+	WorkspaceScope scope;
 	SGMatrix<float64_t> alpha;
 
 	/* compute initialization via kmeans if none is present */
@@ -158,7 +173,7 @@ float64_t GMM::train_em(float64_t min_cov, int32_t max_iter, float64_t min_chang
 		for (int32_t i=0; i<num_vectors; i++)
 		{
 			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
+			SGVector<float64_t> v=computed_feature_vector(*dotdata, i);
 			for (int32_t j=0; j<int32_t(m_components.size()); j++)
 			{
 				logPxy[index_t(i * m_components.size() + j)] =
@@ -207,6 +222,8 @@ float64_t GMM::train_smem(int32_t max_iter, int32_t max_cand, float64_t min_cov,
 	auto dotdata = features->as<DotFeatures>();
 	auto num_vectors = dotdata->get_num_vectors();
 
+	// keeps the pools of the nested EM runs alive across candidates
+	WorkspaceScope scope;
 	float64_t cur_likelihood=train_em(min_cov, max_em_iter, min_change);
 
 	int32_t iter=0;
@@ -233,7 +250,7 @@ float64_t GMM::train_smem(int32_t max_iter, int32_t max_cand, float64_t min_cov,
 		for (int32_t i=0; i<num_vectors; i++)
 		{
 			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
+			SGVector<float64_t> v=computed_feature_vector(*dotdata, i);
 			for (int32_t j=0; j<int32_t(m_components.size()); j++)
 			{
 				logPxy[index_t(i * m_components.size() + j)] =
@@ -354,6 +371,8 @@ void GMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min_
 	auto dotdata=features->as<DotFeatures>();
 	int32_t num_vectors=dotdata->get_num_vectors();
 
+	WorkspaceScope scope;
+
 	SGVector<float64_t> init_logPxy(num_vectors * m_components.size());
 	SGVector<float64_t> init_logPx(num_vectors);
 	SGVector<float64_t> init_logPx_fix(num_vectors);
@@ -364,7 +383,7 @@ void GMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min_
 		init_logPx[i]=0;
 		init_logPx_fix[i]=0;
 
-		SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
+		SGVector<float64_t> v=computed_feature_vector(*dotdata, i);
 		for (int32_t j=0; j<int32_t(m_components.size()); j++)
 		{
 			init_logPxy[index_t(i * m_components.size() + j)] =
@@ -510,7 +529,7 @@ void GMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min_
 		for (int32_t i=0; i<num_vectors; i++)
 		{
 			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
+			SGVector<float64_t> v=computed_feature_vector(*dotdata, i);
 			for (int32_t j=0; j<3; j++)
 			{
 				logPxy[i * 3 + j] = components[j]->compute_log_PDF(v) +
@@ -563,7 +582,7 @@ void GMM::max_likelihood(SGMatrix<float64_t> alpha, float64_t min_cov)
 		for (int32_t j=0; j<alpha.num_rows; j++)
 		{
 			alpha_sum+=alpha.matrix[j*alpha.num_cols+i];
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(j);
+			SGVector<float64_t> v=computed_feature_vector(*dotdata, j);
 			linalg::add(
 			    v, mean_sum, mean_sum, alpha.matrix[j * alpha.num_cols + i],
 			    1.0);
@@ -594,7 +613,7 @@ void GMM::max_likelihood(SGMatrix<float64_t> alpha, float64_t min_cov)
 
 		for (int32_t j=0; j<alpha.num_rows; j++)
 		{
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(j);
+			SGVector<float64_t> v=computed_feature_vector(*dotdata, j);
 
 			linalg::add(v, mean_sum, v, 1.0, -1.0);
 			switch (cov_type)
@@ -605,7 +624,7 @@ void GMM::max_likelihood(SGMatrix<float64_t> alpha, float64_t min_cov)
 				    break;
 			    case DIAG:
 			    {
-				    auto temp_matrix = SGMatrix<float64_t>(v.vector, 1, v.vlen);
+				    auto temp_matrix = SGMatrix<float64_t>(v.vector, 1, v.vlen, false);
 				    auto temp_result = linalg::matrix_prod(
 				        temp_matrix, temp_matrix, true, false);
 				    cov_sum = temp_result.get_diagonal_vector().clone();
@@ -708,12 +727,14 @@ float64_t GMM::get_likelihood_example(int32_t num_example)
 
 	ASSERT(features);
 	ASSERT(features->get_feature_class() == C_DENSE);
-	ASSERT(features->get_feature_type() == F_DREAL);
+	ASSERT(
+	    features->get_feature_type() == F_DREAL ||
+	    features->get_feature_type() == F_SHORTREAL);
 
-	auto f = features->as<DenseFeatures<float64_t>>();
+	SGVector<float64_t> point =
+	    computed_feature_vector(*features->as<DotFeatures>(), num_example);
 	for (auto i: range(index_t(m_components.size())))
 	{
-		SGVector<float64_t> point= f->get_feature_vector(num_example);
 		result += std::exp(
 		    m_components[i]->compute_log_PDF(point) +
 		    std::log(m_coefficients[i]));
@@ -768,8 +789,7 @@ void GMM::set_comp(vector<shared_ptr<Gaussian>> components)
 
 SGMatrix<float64_t> GMM::alpha_init(SGMatrix<float64_t> init_means)
 {
-	auto dotdata=features->as<DenseFeatures<float64_t>>();
-	auto num_vectors=dotdata->get_num_vectors();
+	auto num_vectors=features->get_num_vectors();
 
 	SGVector<float64_t> label_num(init_means.num_cols);
 	linalg::range_fill(label_num);
@@ -25,7 +25,8 @@ namespace shogun
  * Split-Merge Expectation-Maximization algorithms. To estimate the GMM
  * parameters, the train(...) method has to be run to set the training data
  * and then either train_em(...) or train_smem(...) to do the actual
- * estimation.
+ * estimation. Dense float32 features are read into float64 vectors, so the
+ * components are estimated in float64.
  * The EM algorithm is described here:
  * http://en.wikipedia.org/wiki/Expectation-maximization_algorithm
  * The SMEM algorithm is described here:
@@ -11,6 +11,8 @@
 #include <shogun/distance/Distance.h>
 #include <shogun/distance/EuclideanDistance.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/DotFeatures.h>
+#include <shogun/lib/WorkspacePool.h>
 #include <shogun/lib/observers/ObservedValueTemplated.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
@@ -42,11 +44,11 @@ KMeans::~KMeans()
 
 void KMeans::Lloyd_KMeans(SGMatrix<float64_t> centers, int32_t num_centers)
 {
-	auto lhs =
-		std::dynamic_pointer_cast<DenseFeatures<float64_t>>(distance->get_lhs());
+	// float64 or float32 data, the centers are accumulated in float64
+	auto lhs = distance->get_lhs()->as<DotFeatures>();
 
 	int32_t lhs_size=lhs->get_num_vectors();
-	int32_t dim=lhs->get_num_features();
+	int32_t dim=lhs->get_dim_feature_space();
 
 	auto rhs_cache = distance->get_rhs();
 
@@ -61,6 +63,7 @@ void KMeans::Lloyd_KMeans(SGMatrix<float64_t> centers, int32_t num_centers)
 
 	distance->precompute_lhs();
 
+	WorkspaceScope scope;
 	int32_t changed=1;
 
 	for (auto iter : SG_PROGRESS(range(max_iter)))
@@ -70,7 +73,13 @@ void KMeans::Lloyd_KMeans(SGMatrix<float64_t> centers, int32_t num_centers)
 				   	Terminating. ", iter);
 
 		changed=0;
-		auto rhs_mus = std::make_shared<DenseFeatures<float64_t>>(centers.clone());
+		// the centers of the previous iteration are released by
+		// replace_rhs, so two pooled blocks alternate
+		auto mus = workspace::matrix<float64_t>(dim, num_centers);
+		sg_memcpy(
+		    mus.matrix, centers.matrix,
+		    sizeof(float64_t) * dim * num_centers);
+		auto rhs_mus = std::make_shared<DenseFeatures<float64_t>>(mus);
 		distance->replace_rhs(rhs_mus);
 
 #pragma omp parallel for firstprivate(lhs_size, dim, num_centers) \
@@ -105,31 +114,21 @@ void KMeans::Lloyd_KMeans(SGMatrix<float64_t> centers, int32_t num_centers)
 
 				if(fixed_centers)
 				{
-					SGVector<float64_t>vec=lhs->get_feature_vector(i);
 					float64_t temp_min = 1.0 / weights_set[min_cluster];
 
 					/* mu_new = mu_old + (x - mu_old)/(w) */
-					for (j=0; j<dim; j++)
-					{
-						centers(j, min_cluster)+=
-							(vec[j]-centers(j, min_cluster))*temp_min;
-					}
-
-					lhs->free_feature_vector(vec, i);
+					auto mu_min = centers.get_column(min_cluster);
+					linalg::scale(mu_min, mu_min, 1.0 - temp_min);
+					lhs->add_to_dense_vec(temp_min, i, mu_min.vector, dim);
 
 					/* mu_new = mu_old - (x - mu_old)/(w-1) */
 					/* if weights_set(j)~=0 */
 					if (weights_set[cluster_assignments_i]!=0)
 					{
 						float64_t temp_i = 1.0 / weights_set[cluster_assignments_i];
-						SGVector<float64_t>vec1=lhs->get_feature_vector(i);
-
-						for (j=0; j<dim; j++)
-						{
-							centers(j, cluster_assignments_i)-=
-								(vec1[j]-centers(j, cluster_assignments_i))*temp_i;
-						}
-						lhs->free_feature_vector(vec1, i);
+						auto mu_i = centers.get_column(cluster_assignments_i);
+						linalg::scale(mu_i, mu_i, 1.0 + temp_i);
+						lhs->add_to_dense_vec(-temp_i, i, mu_i.vector, dim);
 					}
 					else
 					{
@@ -152,10 +151,8 @@ void KMeans::Lloyd_KMeans(SGMatrix<float64_t> centers, int32_t num_centers)
 			for (int32_t i=0; i<lhs_size; i++)
 			{
 				int32_t cluster_i=cluster_assignments[i];
-
-				auto vec = lhs->get_feature_vector(i);
-				linalg::add_col_vec(centers, cluster_i, vec, centers);
-				lhs->free_feature_vector(vec, i);
+				lhs->add_to_dense_vec(
+				    1.0, i, centers.get_column_vector(cluster_i), dim);
 			}
 
 			for (int32_t i=0; i<num_centers; i++)
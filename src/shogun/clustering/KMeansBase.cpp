@@ -9,6 +9,7 @@
 #include <shogun/distance/Distance.h>
 #include <shogun/distance/EuclideanDistance.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/DotFeatures.h>
 #include <shogun/labels/Labels.h>
 #include <shogun/lib/observers/ObservedValueTemplated.h>
 #include <shogun/mathematics/Math.h>
@@ -50,8 +51,8 @@ KMeansBase::~KMeansBase()
 
 void KMeansBase::set_initial_centers(SGMatrix<float64_t> centers)
 {
-	auto lhs=distance->get_lhs()->as<DenseFeatures<float64_t>>();
-	dimensions=lhs->get_num_features();
+	auto lhs=distance->get_lhs()->as<DotFeatures>();
+	dimensions=lhs->get_dim_feature_space();
 	require(centers.num_cols == k,
 			"Expected {} initial cluster centers, got {}", k, centers.num_cols);
 	require(centers.num_rows == dimensions,
@@ -62,8 +63,7 @@ void KMeansBase::set_initial_centers(SGMatrix<float64_t> centers)
 void KMeansBase::set_random_centers()
 {
 	cluster_centers.zero();
-	auto lhs=
-		distance->get_lhs()->as<DenseFeatures<float64_t>>();
+	auto lhs=distance->get_lhs()->as<DotFeatures>();
 	int32_t lhs_size=lhs->get_num_vectors();
 
 	SGVector<int32_t> temp=SGVector<int32_t>(lhs_size);
@@ -73,10 +73,9 @@ void KMeansBase::set_random_centers()
 	for (int32_t i=0; i<k; i++)
 	{
 		const int32_t cluster_center_i=temp[i];
-		SGVector<float64_t> vec=lhs->get_feature_vector(cluster_center_i);
-
-		linalg::add_col_vec(cluster_centers, i, vec, cluster_centers, 0.0, 1.0);
-		lhs->free_feature_vector(vec, cluster_center_i);
+		lhs->add_to_dense_vec(
+		    1.0, cluster_center_i, cluster_centers.get_column_vector(i),
+		    dimensions);
 	}
 
 	observe<SGMatrix<float64_t>>(0, "cluster_centers");
@@ -147,12 +146,18 @@ void KMeansBase::initialize_training(const std::shared_ptr<Features>& data)
 	if (data)
 		distance->init(data, data);
 
-	auto lhs=
-		distance->get_lhs()->as<DenseFeatures<float64_t>>();
+	auto lhs=distance->get_lhs();
 
 	require(lhs, "Lhs features of distance not provided");
+	// float32 data is used as is, only the centers are kept in float64
+	require(
+	    lhs->get_feature_class() == C_DENSE &&
+	        (lhs->get_feature_type() == F_DREAL ||
+	         lhs->get_feature_type() == F_SHORTREAL),
+	    "Lhs features ({}) should be dense float64 or float32 features",
+	    lhs->get_name());
 	int32_t lhs_size=lhs->get_num_vectors();
-	dimensions=lhs->get_num_features();
+	dimensions=lhs->as<DotFeatures>()->get_dim_feature_space();
 	const int32_t centers_size=dimensions*k;
 
 	require(lhs_size>0, "Lhs features should not be empty");
@@ -199,7 +204,7 @@ SGMatrix<float64_t> KMeansBase::get_cluster_centers() const
 SGMatrix<float64_t> KMeansBase::kmeanspp()
 {
 	int32_t lhs_size;
-	auto lhs=distance->get_lhs()->as<DenseFeatures<float64_t>>();
+	auto lhs=distance->get_lhs()->as<DotFeatures>();
 	lhs_size=lhs->get_num_vectors();
 
 	SGMatrix<float64_t> centers=SGMatrix<float64_t>(dimensions, k);
@@ -210,9 +215,7 @@ SGMatrix<float64_t> KMeansBase::kmeanspp()
 	UniformIntDistribution<int32_t> uniform_int_dist(0, lhs_size-1);
 	/* First center is chosen at random */
 	int32_t mu=uniform_int_dist(m_prng);
-	SGVector<float64_t> mu_first=lhs->get_feature_vector(mu);
-	for(int32_t j=0; j<dimensions; j++)
-		centers(j, 0)=mu_first[j];
+	lhs->add_to_dense_vec(1.0, mu, centers.get_column_vector(0), dimensions);
 
 	distance->precompute_lhs();
 	distance->precompute_rhs();
@@ -280,9 +283,8 @@ SGMatrix<float64_t> KMeansBase::kmeanspp()
 			}
 		}
 
-		SGVector<float64_t> vec=lhs->get_feature_vector(best_center);
-		for(int32_t j=0; j<dimensions; j++)
-			centers(j, i)=vec[j];
+		lhs->add_to_dense_vec(
+		    1.0, best_center, centers.get_column_vector(i), dimensions);
 		sum=best_sum;
 		min_dist=best_min_dist;
 	}
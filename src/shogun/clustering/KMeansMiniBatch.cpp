@@ -8,6 +8,7 @@
 #include <shogun/clustering/KMeansMiniBatch.h>
 #include <shogun/distance/Distance.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/DotFeatures.h>
 #include <shogun/lib/observers/ObservedValueTemplated.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/RandomNamespace.h>
@@ -53,12 +54,11 @@ void KMeansMiniBatch::minibatch_KMeans()
 		              "iterations {} ",
 		max_iter);
 
-	auto lhs=
-		distance->get_lhs()->as<DenseFeatures<float64_t>>();
+	auto lhs=distance->get_lhs()->as<DotFeatures>();
 	auto rhs_mus = std::make_shared<DenseFeatures<float64_t>>(cluster_centers);
 	auto rhs_cache=distance->replace_rhs(rhs_mus);
 	int32_t XSize=lhs->get_num_vectors();
-	int32_t dims=lhs->get_num_features();
+	int32_t dims=lhs->get_dim_feature_space();
 
 	SGVector<float64_t> v=SGVector<float64_t>(k);
 	v.zero();
@@ -78,10 +78,10 @@ void KMeansMiniBatch::minibatch_KMeans()
 		{
 			int32_t near=ncent[j];
 			SGVector<float64_t> c_alive=rhs_mus->get_feature_vector(near);
-			SGVector<float64_t> x=lhs->get_feature_vector(M[j]);
 			v[near]+=1.0;
 			float64_t eta=1.0/v[near];
-			linalg::add(c_alive, x, c_alive, 1.0 - eta, eta);
+			linalg::scale(c_alive, c_alive, 1.0 - eta);
+			lhs->add_to_dense_vec(eta, M[j], c_alive.vector, c_alive.vlen);
 		}
 		cluster_centers = rhs_mus->get_feature_matrix();
 		observe<SGMatrix<float64_t>>(i, "cluster_centers");
@@ -0,0 +1,27 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/clustering/KMeans.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/util/Learner_benchmark.h>
+
+namespace shogun
+{
+
+BENCHMARK_DEFINE_F(LearnerFixture, KMeans_train_apply)(benchmark::State& st)
+{
+	for (auto _ : st)
+	{
+		auto distance = std::make_shared<EuclideanDistance>(features, features);
+		auto kmeans = std::make_shared<KMeans>(NUM_CLASSES, distance);
+		kmeans->put("seed", LEARNER_BENCHMARK_SEED);
+		kmeans->train();
+		benchmark::DoNotOptimize(kmeans->apply_multiclass(features));
+	}
+	report(st);
+}
+
+LEARNER_BENCHMARK(KMeans_train_apply, 32768);
+
+}
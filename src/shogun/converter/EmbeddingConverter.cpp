@@ -22,7 +22,8 @@ EmbeddingConverter::EmbeddingConverter()
 	m_distance = std::make_shared<EuclideanDistance>();
 	
 	m_kernel = std::make_shared<LinearKernel>();
-	
+	m_eigen_method = EMBEDDING_EIGEN_AUTO;
+	m_neighbors_method = EMBEDDING_NEIGHBORS_AUTO;
 
 	init();
 }
@@ -70,6 +71,26 @@ std::shared_ptr<Kernel> EmbeddingConverter::get_kernel() const
 	return m_kernel;
 }
 
+void EmbeddingConverter::set_eigen_method(EEmbeddingEigenMethod method)
+{
+	m_eigen_method = method;
+}
+
+EEmbeddingEigenMethod EmbeddingConverter::get_eigen_method() const
+{
+	return m_eigen_method;
+}
+
+void EmbeddingConverter::set_neighbors_method(EEmbeddingNeighborsMethod method)
+{
+	m_neighbors_method = method;
+}
+
+EEmbeddingNeighborsMethod EmbeddingConverter::get_neighbors_method() const
+{
+	return m_neighbors_method;
+}
+
 void EmbeddingConverter::init()
 {
 	SG_ADD(&m_target_dim, "target_dim",
@@ -79,5 +100,18 @@ void EmbeddingConverter::init()
 		ParameterProperties::HYPER);
 	SG_ADD(
 		&m_kernel, "kernel", "kernel to be used for embedding", ParameterProperties::HYPER);
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_eigen_method, "eigen_method",
+	    "eigensolver to be used for embedding", ParameterProperties::SETTING,
+	    SG_OPTIONS(
+	        EMBEDDING_EIGEN_AUTO, EMBEDDING_EIGEN_DENSE, EMBEDDING_EIGEN_ARPACK,
+	        EMBEDDING_EIGEN_RANDOMIZED));
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_neighbors_method, "neighbors_method",
+	    "nearest neighbors search to be used for embedding",
+	    ParameterProperties::SETTING,
+	    SG_OPTIONS(
+	        EMBEDDING_NEIGHBORS_AUTO, EMBEDDING_NEIGHBORS_BRUTE_FORCE,
+	        EMBEDDING_NEIGHBORS_VP_TREE, EMBEDDING_NEIGHBORS_COVER_TREE));
 }
 }
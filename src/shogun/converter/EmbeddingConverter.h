@@ -22,6 +22,32 @@ class Features;
 class Distance;
 class Kernel;
 
+/** eigensolver used by the spectral embedding converters */
+enum EEmbeddingEigenMethod
+{
+	/** ARPACK if available, dense otherwise */
+	EMBEDDING_EIGEN_AUTO,
+	/** dense eigendecomposition */
+	EMBEDDING_EIGEN_DENSE,
+	/** ARPACK (requires ARPACK) */
+	EMBEDDING_EIGEN_ARPACK,
+	/** randomized range finder, approximate but fast for many vectors */
+	EMBEDDING_EIGEN_RANDOMIZED
+};
+
+/** nearest neighbors search used by the neighborhood based converters */
+enum EEmbeddingNeighborsMethod
+{
+	/** cover tree if available, vantage point tree otherwise */
+	EMBEDDING_NEIGHBORS_AUTO,
+	/** brute force search */
+	EMBEDDING_NEIGHBORS_BRUTE_FORCE,
+	/** vantage point tree */
+	EMBEDDING_NEIGHBORS_VP_TREE,
+	/** cover tree (requires GPL code) */
+	EMBEDDING_NEIGHBORS_COVER_TREE
+};
+
 /** @brief class EmbeddingConverter (part of the Efficient Dimensionality
  * Reduction Toolkit) used to construct embeddings of
  * features, e.g. construct dense numeric embedding of string features
@@ -73,6 +99,28 @@ public:
 	 */
 	std::shared_ptr<Kernel> get_kernel() const;
 
+	/** setter for the eigensolver, used by converters that solve an
+	 * eigenproblem
+	 * @param method eigensolver
+	 */
+	void set_eigen_method(EEmbeddingEigenMethod method);
+
+	/** getter for the eigensolver
+	 * @return eigensolver
+	 */
+	EEmbeddingEigenMethod get_eigen_method() const;
+
+	/** setter for the nearest neighbors search, used by converters that
+	 * build a neighborhood graph. The searches are run in parallel.
+	 * @param method nearest neighbors search
+	 */
+	void set_neighbors_method(EEmbeddingNeighborsMethod method);
+
+	/** getter for the nearest neighbors search
+	 * @return nearest neighbors search
+	 */
+	EEmbeddingNeighborsMethod get_neighbors_method() const;
+
 	virtual const char* get_name() const { return "EmbeddingConverter"; };
 
 protected:
@@ -90,6 +138,12 @@ protected:
 
 	/** kernel to be used */
 	std::shared_ptr<Kernel> m_kernel;
+
+	/** eigensolver */
+	EEmbeddingEigenMethod m_eigen_method;
+
+	/** nearest neighbors search */
+	EEmbeddingNeighborsMethod m_neighbors_method;
 };
 }
 
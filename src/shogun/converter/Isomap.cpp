@@ -57,6 +57,8 @@ std::shared_ptr<DenseFeatures<float64_t>> Isomap::embed_distance(std::shared_ptr
 		parameters.method = SHOGUN_ISOMAP;
 	}
 	parameters.n_neighbors = m_k;
+	parameters.eigen_method = m_eigen_method;
+	parameters.neighbors_method = m_neighbors_method;
 	parameters.target_dimension = m_target_dim;
 	parameters.distance = distance.get();
 	return tapkee_embed(parameters);
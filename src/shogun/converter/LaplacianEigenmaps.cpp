@@ -81,6 +81,8 @@ std::shared_ptr<DenseFeatures<float64_t>> LaplacianEigenmaps::embed_distance(std
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
 	parameters.n_neighbors = m_k;
 	parameters.gaussian_kernel_width = m_tau;
+	parameters.eigen_method = m_eigen_method;
+	parameters.neighbors_method = m_neighbors_method;
 	parameters.method = SHOGUN_LAPLACIAN_EIGENMAPS;
 	parameters.target_dimension = m_target_dim;
 	parameters.distance = distance.get();
@@ -81,6 +81,8 @@ std::shared_ptr<Features> LocallyLinearEmbedding::transform(std::shared_ptr<Feat
 	auto kernel = std::make_shared<LinearKernel>(dot_feats, dot_feats);
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
 	parameters.n_neighbors = m_k;
+	parameters.eigen_method = m_eigen_method;
+	parameters.neighbors_method = m_neighbors_method;
 	parameters.eigenshift = m_nullspace_shift;
 	parameters.method = SHOGUN_LOCALLY_LINEAR_EMBEDDING;
 	parameters.target_dimension = m_target_dim;
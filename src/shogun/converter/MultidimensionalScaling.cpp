@@ -89,6 +89,7 @@ std::shared_ptr<DenseFeatures<float64_t>> MultidimensionalScaling::embed_distanc
 	{
 		parameters.method = SHOGUN_MULTIDIMENSIONAL_SCALING;
 	}
+	parameters.eigen_method = m_eigen_method;
 	parameters.target_dimension = m_target_dim;
 	parameters.distance = distance.get();
 	return tapkee_embed(parameters);
@@ -192,6 +192,7 @@ float64_t Distance::distance(int32_t idx_a, int32_t idx_b)
 
 	ASSERT(lhs)
 	ASSERT(rhs)
+	SG_TRACE_COUNT("distance_evaluations", 1);
 
 	if (lhs==rhs)
 	{
@@ -271,6 +272,7 @@ SGMatrix<T> Distance::get_distance_matrix()
 
 	require(has_features(), "no features assigned to distance");
 	init(lhs, rhs);
+	SG_TRACE_SCOPE("Distance::get_distance_matrix", "distance");
 
 	int32_t m=get_num_vec_lhs();
 	int32_t n=get_num_vec_rhs();
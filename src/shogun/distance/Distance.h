@@ -19,6 +19,7 @@
 #include <shogun/features/FeatureTypes.h>
 #include <shogun/features/Features.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/Tracer.h>
 
 namespace shogun
 {
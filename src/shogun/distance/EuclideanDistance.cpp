@@ -129,6 +129,23 @@ std::shared_ptr<Features> EuclideanDistance::replace_rhs(std::shared_ptr<Feature
 	return previous_rhs;
 }
 
+bool EuclideanDistance::check_compatibility(std::shared_ptr<Features> l, std::shared_ptr<Features> r)
+{
+	require(l, "Left hand side features must be set!");
+	require(r, "Right hand side features must be set!");
+
+	auto is_dense_real=[](const std::shared_ptr<Features>& f)
+	{
+		return f->get_feature_class()==C_DENSE &&
+			(f->get_feature_type()==F_DREAL || f->get_feature_type()==F_SHORTREAL);
+	};
+
+	if (l->get_feature_type()!=r->get_feature_type() && is_dense_real(l) && is_dense_real(r))
+		return true;
+
+	return Distance::check_compatibility(l, r);
+}
+
 void EuclideanDistance::register_params()
 {
 	disable_sqrt=false;
@@ -138,6 +155,33 @@ void EuclideanDistance::register_params()
 	SG_ADD(&m_lhs_squared_norms, "m_lhs_squared_norms", "Squared norms from features of left hand side");
 }
 
+template <typename ST>
+static float64_t sq_distance_upper_bounded(
+	const std::shared_ptr<Features>& lhs, const std::shared_ptr<Features>& rhs,
+	int32_t idx_a, int32_t idx_b, float64_t upper_bound)
+{
+	auto casted_lhs=std::static_pointer_cast<DenseFeatures<ST>>(lhs);
+	auto casted_rhs=std::static_pointer_cast<DenseFeatures<ST>>(rhs);
+
+	SGVector<ST> avec=casted_lhs->get_feature_vector(idx_a);
+	SGVector<ST> bvec=casted_rhs->get_feature_vector(idx_b);
+
+	require(avec.vlen==bvec.vlen, "The vector lengths are not equal ({} vs {})!", avec.vlen, bvec.vlen);
+
+	float64_t result=0;
+	for (int32_t i=0; i<avec.vlen; i++)
+	{
+		result+=Math::sq(float64_t(avec[i])-float64_t(bvec[i]));
+		if (result>upper_bound)
+			break;
+	}
+
+	casted_lhs->free_feature_vector(avec, idx_a);
+	casted_rhs->free_feature_vector(bvec, idx_b);
+
+	return result;
+}
+
 float64_t EuclideanDistance::distance_upper_bounded(int32_t idx_a, int32_t idx_b, float64_t upper_bound)
 {
 	require(lhs->get_feature_class()==C_DENSE,
@@ -145,27 +189,23 @@ float64_t EuclideanDistance::distance_upper_bounded(int32_t idx_a, int32_t idx_b
 	require(rhs->get_feature_class()==C_DENSE,
 		"Right hand side (was {}) has to be DenseFeatures instance!", rhs->get_name());
 
-	require(lhs->get_feature_type()==F_DREAL,
-		"Left hand side (was {}) has to be of double type!", lhs->get_name());
-	require(rhs->get_feature_type()==F_DREAL,
-		"Right hand side (was {}) has to be double type!", rhs->get_name());
-
-	auto casted_lhs=std::dynamic_pointer_cast<DenseFeatures<float64_t>>(lhs);
-	auto casted_rhs=std::dynamic_pointer_cast<DenseFeatures<float64_t>>(rhs);
+	require(lhs->get_feature_type()==rhs->get_feature_type(),
+		"Left hand side (was {}) and right hand side (was {}) have to be of the same type!",
+		lhs->get_name(), rhs->get_name());
 
 	upper_bound*=upper_bound;
 
-	SGVector<float64_t> avec=casted_lhs->get_feature_vector(idx_a);
-	SGVector<float64_t> bvec=casted_rhs->get_feature_vector(idx_b);
-
-	require(avec.vlen==bvec.vlen, "The vector lengths are not equal ({} vs {})!", avec.vlen, bvec.vlen);
-
 	float64_t result=0;
-	for (int32_t i=0; i<avec.vlen; i++)
+	switch (lhs->get_feature_type())
 	{
-		result+=Math::sq(avec[i]-bvec[i]);
-		if (result>upper_bound)
+		case F_DREAL:
+			result=sq_distance_upper_bounded<float64_t>(lhs, rhs, idx_a, idx_b, upper_bound);
+			break;
+		case F_SHORTREAL:
+			result=sq_distance_upper_bounded<float32_t>(lhs, rhs, idx_a, idx_b, upper_bound);
 			break;
+		default:
+			error("Left hand side (was {}) has to be of float32 or double type!", lhs->get_name());
 	}
 
 	if (!disable_sqrt)
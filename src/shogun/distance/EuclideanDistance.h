@@ -176,6 +176,17 @@ protected:
 	/// in the corresponding feature object
 	virtual float64_t compute(int32_t idx_a, int32_t idx_b);
 
+	/** Checks the compatibility between two supplied features. In addition
+	 * to features of the same type, dense float32 features may be paired
+	 * with dense float64 features, e.g. float32 data with float64 cluster
+	 * centers
+	 *
+	 * @param l left hand side features
+	 * @param r right hand side features
+	 * @return true if the features are compatible
+	 */
+	virtual bool check_compatibility(std::shared_ptr<Features> l, std::shared_ptr<Features> r);
+
 	/** if application of sqrt on matrix computation is disabled */
 	bool disable_sqrt;
 
@@ -7,6 +7,7 @@
 #include <shogun/lib/config.h>
 
 #include <shogun/distributions/Gaussian.h>
+#include <shogun/lib/WorkspacePool.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/NormalDistribution.h>
 #include <shogun/mathematics/RandomNamespace.h>
@@ -233,15 +234,14 @@ float64_t Gaussian::compute_log_PDF(SGVector<float64_t> point)
 {
 	ASSERT(m_mean.vector && m_d.vector)
 	ASSERT(point.vlen == m_mean.vlen)
-	SGVector<float64_t> difference = point.clone();
-
-	linalg::add(difference, m_mean, difference, -1.0, 1.0);
+	auto difference = workspace::vector<float64_t>(point.vlen);
+	linalg::add(point, m_mean, difference, 1.0, -1.0);
 
 	float64_t answer=m_constant;
 
 	if (m_cov_type==FULL)
 	{
-		SGVector<float64_t> temp_holder(m_d.vlen);
+		auto temp_holder = workspace::vector<float64_t>(m_d.vlen);
 		temp_holder.zero();
 #ifdef HAVE_LAPACK
 		cblas_dgemv(
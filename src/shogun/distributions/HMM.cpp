@@ -15,6 +15,7 @@
 #include <shogun/features/StringFeatures.h>
 #include <shogun/features/Alphabet.h>
 #include <shogun/mathematics/UniformRealDistribution.h>
+#include <shogun/mathematics/eigen3.h>
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -28,6 +29,7 @@
 #define ARRAY_SIZE 65336
 
 using namespace shogun;
+using namespace Eigen;
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -1280,6 +1282,147 @@ float64_t HMM::best_path(int32_t dimension)
 	}
 }
 
+namespace
+{
+	/* log(sum_i exp(x_i)) shifted by the largest element */
+	template <typename Derived>
+	float64_t log_sum_exp(const Eigen::MatrixBase<Derived>& x)
+	{
+		const float64_t m=x.maxCoeff();
+		if (!Math::is_finite(m))
+			return m;
+		return m+std::log((x.array()-m).exp().sum());
+	}
+}
+
+SGMatrix<float64_t> HMM::get_linear_transition_matrix() const
+{
+	SGMatrix<float64_t> lin_a(N, N);
+	Map<MatrixXd>(lin_a.matrix, N, N)=
+		Map<const MatrixXd>(transition_matrix_a, N, N).array().exp().matrix();
+	return lin_a;
+}
+
+float64_t HMM::forward_sequence(
+	int32_t dimension, const SGMatrix<float64_t>& lin_a,
+	SGMatrix<float64_t>& alpha) const
+{
+	int32_t len=0;
+	bool free_vec;
+	uint16_t* obs=p_observations->get_feature_vector(dimension, len, free_vec);
+	ASSERT(len>0 && len<=alpha.num_cols)
+
+	Map<const MatrixXd> a(lin_a.matrix, N, N);
+	Map<const MatrixXd> log_b(observation_matrix_b, M, N);
+	Map<const VectorXd> log_p(initial_state_distribution_p, N);
+	Map<const VectorXd> log_q(end_state_distribution_q, N);
+	Map<MatrixXd> log_alpha(alpha.matrix, N, len);
+
+	//initialization	alpha_1(i)=p_i*b_i(O_1)
+	log_alpha.col(0)=log_p+log_b.row(obs[0]).transpose();
+
+	//induction		alpha_t+1(j) = (sum_i=1^N alpha_t(i)a_ij) b_j(O_t+1)
+	//evaluated as a matrix-vector product on alpha_t scaled by its maximum
+	for (int32_t t=1; t<len; t++)
+	{
+		const float64_t m=log_alpha.col(t-1).maxCoeff();
+		if (!Math::is_finite(m))
+		{
+			log_alpha.col(t).setConstant(-Math::INFTY);
+			continue;
+		}
+
+		log_alpha.col(t)=(a.transpose()*
+			(log_alpha.col(t-1).array()-m).exp().matrix()).array().log().matrix();
+		log_alpha.col(t).array()+=m+log_b.row(obs[t]).transpose().array();
+	}
+
+	// termination
+	const float64_t sum=log_sum_exp(log_alpha.col(len-1)+log_q);
+	p_observations->free_feature_vector(obs, dimension, free_vec);
+
+	return sum;
+}
+
+void HMM::backward_sequence(
+	int32_t dimension, const SGMatrix<float64_t>& lin_a,
+	SGMatrix<float64_t>& beta) const
+{
+	int32_t len=0;
+	bool free_vec;
+	uint16_t* obs=p_observations->get_feature_vector(dimension, len, free_vec);
+	ASSERT(len>0 && len<=beta.num_cols)
+
+	Map<const MatrixXd> a(lin_a.matrix, N, N);
+	Map<const MatrixXd> log_b(observation_matrix_b, M, N);
+	Map<const VectorXd> log_q(end_state_distribution_q, N);
+	Map<MatrixXd> log_beta(beta.matrix, N, len);
+
+	//initialization	beta_T(i)=q(i)
+	log_beta.col(len-1)=log_q;
+
+	//induction		beta_t(i) = (sum_j=1^N a_ij*b_j(O_t+1)*beta_t+1(j)
+	for (int32_t t=len-2; t>=0; t--)
+	{
+		log_beta.col(t)=log_b.row(obs[t+1]).transpose()+log_beta.col(t+1);
+
+		const float64_t m=log_beta.col(t).maxCoeff();
+		if (!Math::is_finite(m))
+		{
+			log_beta.col(t).setConstant(-Math::INFTY);
+			continue;
+		}
+
+		log_beta.col(t)=(a*(log_beta.col(t).array()-m).exp().matrix())
+			.array().log().matrix();
+		log_beta.col(t).array()+=m;
+	}
+
+	p_observations->free_feature_vector(obs, dimension, free_vec);
+}
+
+float64_t HMM::best_path_sequence(
+	int32_t dimension, SGMatrix<T_STATES>& psi, SGVector<T_STATES>& out_path) const
+{
+	int32_t len=0;
+	bool free_vec;
+	uint16_t* obs=p_observations->get_feature_vector(dimension, len, free_vec);
+	ASSERT(len>0 && len<=psi.num_cols && len<=out_path.vlen)
+
+	Map<const MatrixXd> log_a(transition_matrix_a, N, N);
+	Map<const MatrixXd> log_b(observation_matrix_b, M, N);
+	Map<const VectorXd> log_p(initial_state_distribution_p, N);
+	Map<const VectorXd> log_q(end_state_distribution_q, N);
+
+	//initialization
+	VectorXd delta=log_p+log_b.row(obs[0]).transpose();
+	VectorXd delta_new(N);
+	Eigen::Index argmax;
+
+	//recursion
+	for (int32_t t=1; t<len; t++)
+	{
+		for (int32_t j=0; j<N; j++)
+		{
+			delta_new[j]=(delta+log_a.col(j)).maxCoeff(&argmax)+log_b(obs[t], j);
+			psi(j, t)=argmax;
+		}
+		delta.swap(delta_new);
+	}
+
+	//termination
+	const float64_t prob=(delta+log_q).maxCoeff(&argmax);
+	out_path[len-1]=argmax;
+
+	//state sequence backtracking
+	for (int32_t t=len-1; t>0; t--)
+		out_path[t-1]=psi(out_path[t], t);
+
+	p_observations->free_feature_vector(obs, dimension, free_vec);
+
+	return prob;
+}
+
 #ifndef USE_HMMPARALLEL
 float64_t HMM::model_probability_comp()
 {
@@ -2059,6 +2202,205 @@ void HMM::estimate_model_viterbi(const std::shared_ptr<HMM>& estimate)
 	invalidate_model();
 }
 
+void HMM::estimate_model_baum_welch_parallel(const std::shared_ptr<HMM>& estimate)
+{
+	const int32_t num_vectors=p_observations->get_num_vectors();
+	const int32_t max_len=p_observations->get_max_vector_length();
+	const SGMatrix<float64_t> lin_a=estimate->get_linear_transition_matrix();
+	Map<const MatrixXd> log_a(estimate->transition_matrix_a, N, N);
+	Map<const MatrixXd> log_b(estimate->observation_matrix_b, M, N);
+
+	//expected counts, summed over all sequences
+	MatrixXd a_count=MatrixXd::Zero(N, N);
+	MatrixXd b_count=MatrixXd::Zero(M, N);
+	VectorXd p_count=VectorXd::Zero(N);
+	VectorXd q_count=VectorXd::Zero(N);
+	float64_t fullmodprob=0;	//for all dims
+
+#pragma omp parallel
+	{
+		SGMatrix<float64_t> alpha(N, max_len);
+		SGMatrix<float64_t> beta(N, max_len);
+		MatrixXd a_local=MatrixXd::Zero(N, N);
+		MatrixXd b_local=MatrixXd::Zero(M, N);
+		VectorXd p_local=VectorXd::Zero(N);
+		VectorXd q_local=VectorXd::Zero(N);
+		VectorXd gamma(N);
+		float64_t modprob_local=0;
+
+#pragma omp for schedule(dynamic)
+		for (int32_t dim=0; dim<num_vectors; dim++)
+		{
+			if (p_observations->get_vector_length(dim)<1)
+				continue;
+
+			const float64_t dimmodprob=estimate->forward_sequence(dim, lin_a, alpha);
+			if (!Math::is_finite(dimmodprob))
+				continue;
+
+			estimate->backward_sequence(dim, lin_a, beta);
+			modprob_local+=dimmodprob;
+
+			int32_t len=0;
+			bool free_vec;
+			uint16_t* obs=p_observations->get_feature_vector(dim, len, free_vec);
+			Map<const MatrixXd> log_alpha(alpha.matrix, N, len);
+			Map<const MatrixXd> log_beta(beta.matrix, N, len);
+
+			//state posteriors give the numerators for p, q and b
+			for (int32_t t=0; t<len; t++)
+			{
+				gamma=(log_alpha.col(t)+log_beta.col(t)).array()-dimmodprob;
+				gamma=gamma.array().exp();
+				b_local.row(obs[t])+=gamma.transpose();
+			}
+			p_local+=((log_alpha.col(0)+log_beta.col(0)).array()-dimmodprob).exp().matrix();
+			q_local+=((log_alpha.col(len-1)+log_beta.col(len-1)).array()-dimmodprob).exp().matrix();
+
+			//transition posteriors alpha_t(i)+a_ij+b_j(O_t+1)+beta_t+1(j) give the numerator for a
+			for (int32_t t=0; t<len-1; t++)
+			{
+				a_local+=(((log_a.array().colwise()+log_alpha.col(t).array()).rowwise()+
+					(log_b.row(obs[t+1])+log_beta.col(t+1).transpose()).array())-dimmodprob).exp().matrix();
+			}
+
+			p_observations->free_feature_vector(obs, dim, free_vec);
+		}
+
+#pragma omp critical
+		{
+			a_count+=a_local;
+			b_count+=b_local;
+			p_count+=p_local;
+			q_count+=q_local;
+			fullmodprob+=modprob_local;
+		}
+	}
+
+	//pseudo counts plus expected counts as numerator, keeping dead states dead
+	for (int32_t i=0; i<N; i++)
+	{
+		if (estimate->get_p(i)>Math::ALMOST_NEG_INFTY)
+			set_p(i, log(PSEUDO+p_count[i]));
+		else
+			set_p(i, estimate->get_p(i));
+		if (estimate->get_q(i)>Math::ALMOST_NEG_INFTY)
+			set_q(i, log(PSEUDO+q_count[i]));
+		else
+			set_q(i, estimate->get_q(i));
+
+		for (int32_t j=0; j<N; j++)
+			if (estimate->get_a(i,j)>Math::ALMOST_NEG_INFTY)
+				set_a(i,j, log(PSEUDO+a_count(i,j)));
+			else
+				set_a(i,j, estimate->get_a(i,j));
+		for (int32_t j=0; j<M; j++)
+			if (estimate->get_b(i,j)>Math::ALMOST_NEG_INFTY)
+				set_b(i,j, log(PSEUDO+b_count(j,i)));
+			else
+				set_b(i,j, estimate->get_b(i,j));
+	}
+
+	//cache estimate model probability
+	estimate->mod_prob=fullmodprob;
+	estimate->mod_prob_updated=true ;
+
+	//new model probability is unknown
+	normalize();
+	invalidate_model();
+}
+
+void HMM::estimate_model_viterbi_parallel(const std::shared_ptr<HMM>& estimate)
+{
+	const int32_t num_vectors=p_observations->get_num_vectors();
+	const int32_t max_len=p_observations->get_max_vector_length();
+	const SGMatrix<float64_t> lin_a=estimate->get_linear_transition_matrix();
+
+	path_deriv_updated=false ;
+
+	//initialize with pseudocounts
+	MatrixXd a_count=MatrixXd::Constant(N, N, PSEUDO);
+	MatrixXd b_count=MatrixXd::Constant(M, N, PSEUDO);
+	VectorXd p_count=VectorXd::Constant(N, PSEUDO);
+	VectorXd q_count=VectorXd::Constant(N, PSEUDO);
+	float64_t allpatprob=0;
+	float64_t fullmodprob=0;
+
+#pragma omp parallel
+	{
+		SGMatrix<T_STATES> psi(N, max_len);
+		SGVector<T_STATES> best(max_len);
+		SGMatrix<float64_t> alpha(N, max_len);
+		MatrixXd a_local=MatrixXd::Zero(N, N);
+		MatrixXd b_local=MatrixXd::Zero(M, N);
+		VectorXd p_local=VectorXd::Zero(N);
+		VectorXd q_local=VectorXd::Zero(N);
+		float64_t patprob_local=0;
+		float64_t modprob_local=0;
+
+#pragma omp for schedule(dynamic)
+		for (int32_t dim=0; dim<num_vectors; dim++)
+		{
+			if (p_observations->get_vector_length(dim)<1)
+				continue;
+
+			//using viterbi to find best path
+			patprob_local+=estimate->best_path_sequence(dim, psi, best);
+			modprob_local+=estimate->forward_sequence(dim, lin_a, alpha);
+
+			int32_t len=0;
+			bool free_vec;
+			uint16_t* obs=p_observations->get_feature_vector(dim, len, free_vec);
+
+			//counting occurences for A and B
+			for (int32_t t=0; t<len-1; t++)
+			{
+				a_local(best[t], best[t+1])+=1;
+				b_local(obs[t], best[t])+=1;
+			}
+			b_local(obs[len-1], best[len-1])+=1;
+
+			p_local[best[0]]+=1;
+			q_local[best[len-1]]+=1;
+
+			p_observations->free_feature_vector(obs, dim, free_vec);
+		}
+
+#pragma omp critical
+		{
+			a_count+=a_local;
+			b_count+=b_local;
+			p_count+=p_local;
+			q_count+=q_local;
+			allpatprob+=patprob_local;
+			fullmodprob+=modprob_local;
+		}
+	}
+
+	estimate->all_pat_prob=allpatprob/num_vectors;
+	estimate->all_path_prob_updated=true ;
+	estimate->mod_prob=fullmodprob;
+	estimate->mod_prob_updated=true ;
+
+	//converting counts to probability measures a, b, p, q
+	const VectorXd a_sum=a_count.rowwise().sum();
+	const VectorXd b_sum=b_count.colwise().sum().transpose();
+	for (int32_t i=0; i<N; i++)
+	{
+		for (int32_t j=0; j<N; j++)
+			set_a(i,j, log(a_count(i,j)/a_sum[i]));
+
+		for (int32_t j=0; j<M; j++)
+			set_b(i,j, log(b_count(j,i)/b_sum[i]));
+
+		set_p(i, log(p_count[i]/p_count.sum()));
+		set_q(i, log(q_count[i]/q_count.sum()));
+	}
+
+	//new model probability is unknown
+	invalidate_model();
+}
+
 // estimate parameters listed in learn_x
 void HMM::estimate_model_viterbi_defined(const std::shared_ptr<HMM>& estimate)
 {
@@ -5589,6 +5931,10 @@ bool HMM::baum_welch_viterbi_train(BaumWelchViterbiType type)
 				working->estimate_model_viterbi(estimate); break;
 			case VIT_DEFINED:
 				working->estimate_model_viterbi_defined(estimate); break;
+			case BW_PARALLEL:
+				working->estimate_model_baum_welch_parallel(estimate); break;
+			case VIT_PARALLEL:
+				working->estimate_model_viterbi_parallel(estimate); break;
 		}
 		prob_train=estimate->model_probability();
 
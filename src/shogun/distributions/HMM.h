@@ -12,6 +12,8 @@
 #include <shogun/lib/common.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/config.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
 #include <shogun/features/Features.h>
 #include <shogun/features/StringFeatures.h>
 #include <shogun/distributions/Distribution.h>
@@ -74,7 +76,11 @@ enum BaumWelchViterbiType
 	/// standard viterbi
 	VIT_NORMAL,
 	/// viterbi only for defined transitions/observations
-	VIT_DEFINED
+	VIT_DEFINED,
+	/// baum welch with observation sequences processed in parallel
+	BW_PARALLEL,
+	/// viterbi with observation sequences processed in parallel
+	VIT_PARALLEL
 };
 
 
@@ -453,6 +459,40 @@ class HMM : public RandomMixin<Distribution>
 		 */
 		bool converged(float64_t x, float64_t y);
 
+		/** thread-safe log-space forward pass over one observation sequence.
+		 * Does not touch the alpha/beta caches, so it may be called
+		 * concurrently for different sequences.
+		 * @param dimension index of the observation sequence
+		 * @param lin_a transition matrix exp(a) in linear space
+		 * @param alpha N x T matrix receiving log alpha_t(i) in column t
+		 * @return log Pr[O|lambda] for this sequence
+		 */
+		float64_t forward_sequence(
+			int32_t dimension, const SGMatrix<float64_t>& lin_a,
+			SGMatrix<float64_t>& alpha) const;
+
+		/** thread-safe log-space backward pass over one observation sequence.
+		 * @param dimension index of the observation sequence
+		 * @param lin_a transition matrix exp(a) in linear space
+		 * @param beta N x T matrix receiving log beta_t(i) in column t
+		 */
+		void backward_sequence(
+			int32_t dimension, const SGMatrix<float64_t>& lin_a,
+			SGMatrix<float64_t>& beta) const;
+
+		/** thread-safe viterbi decoding of one observation sequence.
+		 * @param dimension index of the observation sequence
+		 * @param psi N x T backtracking table (workspace)
+		 * @param out_path vector of length T receiving the best state sequence
+		 * @return log probability of the best path
+		 */
+		float64_t best_path_sequence(
+			int32_t dimension, SGMatrix<T_STATES>& psi,
+			SGVector<T_STATES>& out_path) const;
+
+		/// returns exp(a) as dense N x N matrix
+		SGMatrix<float64_t> get_linear_transition_matrix() const;
+
 #ifdef USE_HMMPARALLEL_STRUCTURES
 		static void bw_dim_prefetch(S_BW_THREAD_PARAM* params);
 		static void bw_single_dim_prefetch(S_DIM_THREAD_PARAM* params);
@@ -667,6 +707,21 @@ class HMM : public RandomMixin<Distribution>
 		 */
 		void estimate_model_viterbi_defined(const std::shared_ptr<HMM>& train);
 
+		/** uses baum-welch-algorithm to train a fully connected HMM,
+		 * processing the observation sequences in parallel.
+		 * Every thread runs a vectorized log-space forward/backward pass
+		 * on its own workspace and accumulates expected counts locally,
+		 * the counts are reduced once all sequences are processed.
+		 * @param train model from which the new model is estimated
+		 */
+		void estimate_model_baum_welch_parallel(const std::shared_ptr<HMM>& train);
+
+		/** uses viterbi training to train a fully connected HMM,
+		 * decoding the observation sequences in parallel.
+		 * @param train model from which the new model is estimated
+		 */
+		void estimate_model_viterbi_parallel(const std::shared_ptr<HMM>& train);
+
 		//@}
 
 		/// estimates linear model from observations.
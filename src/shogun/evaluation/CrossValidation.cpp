@@ -11,7 +11,10 @@
 #include <shogun/evaluation/CrossValidationStorage.h>
 #include <shogun/evaluation/Evaluation.h>
 #include <shogun/evaluation/SplittingStrategy.h>
+#include <shogun/features/IndexFeatures.h>
+#include <shogun/kernel/CustomKernel.h>
 #include <shogun/lib/observers/ObservedValueTemplated.h>
+#include <shogun/machine/KernelMachine.h>
 #include <shogun/machine/Machine.h>
 #include <shogun/mathematics/Statistics.h>
 #include <shogun/lib/View.h>
@@ -50,8 +53,14 @@ CrossValidation::~CrossValidation()
 void CrossValidation::init()
 {
 	m_num_runs = 1;
+	m_cache_kernel_matrix = false;
+	m_kernel_matrix_hash = 0;
 
 	SG_ADD(&m_num_runs, "num_runs", "Number of repetitions");
+	SG_ADD(
+	    &m_cache_kernel_matrix, "cache_kernel_matrix",
+	    "Whether to share one kernel matrix between all folds",
+	    ParameterProperties::SETTING);
 }
 
 std::shared_ptr<EvaluationResult> CrossValidation::evaluate_impl() const
@@ -85,6 +94,55 @@ void CrossValidation::set_num_runs(int32_t num_runs)
 	m_num_runs = num_runs;
 }
 
+void CrossValidation::set_cache_kernel_matrix(bool cache_kernel_matrix)
+{
+	m_cache_kernel_matrix = cache_kernel_matrix;
+	if (!cache_kernel_matrix)
+	{
+		m_kernel_matrix = nullptr;
+		m_kernel_matrix_features = nullptr;
+	}
+}
+
+std::shared_ptr<CustomKernel> CrossValidation::get_cached_kernel_matrix() const
+{
+	if (!m_cache_kernel_matrix || !m_features)
+		return nullptr;
+
+	auto kernel_machine = std::dynamic_pointer_cast<KernelMachine>(m_machine);
+	if (!kernel_machine)
+		return nullptr;
+
+	auto kernel = kernel_machine->get_kernel();
+	if (!kernel || kernel->get_kernel_type() == K_CUSTOM)
+		return nullptr;
+
+	// the features are identified by the object, which is kept alive with
+	// the matrix, and by the hash of their parameters, which changes when
+	// the feature data is modified
+	size_t hash = kernel->hyperparameter_hash();
+	hash ^= m_features->hash() + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	hash ^= m_features->get_num_vectors() + 0x9e3779b9 + (hash << 6) +
+	        (hash >> 2);
+
+	if (m_kernel_matrix && m_kernel_matrix_features == m_features &&
+	    hash == m_kernel_matrix_hash)
+		return m_kernel_matrix;
+
+	SG_DEBUG(
+	    "computing {}x{} kernel matrix for cross-validation",
+	    m_features->get_num_vectors(), m_features->get_num_vectors());
+	auto full_kernel = make_clone(kernel);
+	full_kernel->init(m_features, m_features);
+	m_kernel_matrix = std::make_shared<CustomKernel>(
+	    full_kernel->get_kernel_matrix<float32_t>());
+	m_kernel_matrix_hash = hash;
+	m_kernel_matrix_features = m_features;
+	full_kernel->remove_lhs_and_rhs();
+
+	return m_kernel_matrix;
+}
+
 float64_t CrossValidation::evaluate_one_run(int64_t index) const
 {
 	SG_TRACE("entering {}::evaluate_one_run()", get_name());
@@ -94,6 +152,7 @@ float64_t CrossValidation::evaluate_one_run(int64_t index) const
 	m_splitting_strategy->build_subsets();
 
 	SGVector<float64_t> results(num_subsets);
+	auto kernel_matrix = get_cached_kernel_matrix();
 
 	#pragma omp parallel for shared(results)
 	for (auto i = 0; i<num_subsets; ++i)
@@ -109,9 +168,23 @@ float64_t CrossValidation::evaluate_one_run(int64_t index) const
 		SGVector<index_t> idx_test =
 			m_splitting_strategy->generate_subset_indices(i);
 
-		auto features_train = view(m_features, idx_train);
+		std::shared_ptr<Features> features_train;
+		std::shared_ptr<Features> features_test;
+		if (kernel_matrix)
+		{
+			// fold kernel shares the matrix, index features select the
+			// rows and columns of the fold
+			std::static_pointer_cast<KernelMachine>(machine)->set_kernel(
+			    std::make_shared<CustomKernel>(kernel_matrix));
+			features_train = std::make_shared<IndexFeatures>(idx_train);
+			features_test = std::make_shared<IndexFeatures>(idx_test);
+		}
+		else
+		{
+			features_train = view(m_features, idx_train);
+			features_test = view(m_features, idx_test);
+		}
 		auto labels_train = view(m_labels, idx_train);
-		auto features_test = view(m_features, idx_test);
 		auto labels_test = view(m_labels, idx_test);
 
 		auto evaluation_criterion = make_clone(m_evaluation_criterion);
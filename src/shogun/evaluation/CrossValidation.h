@@ -19,6 +19,7 @@ namespace shogun
 {
 
 	class MachineEvaluation;
+	class CustomKernel;
 	class CrossValidationOutput;
 	class CrossValidationStorage;
 	class List;
@@ -159,6 +160,21 @@ namespace shogun
 		/** setter for the number of runs to use for evaluation */
 		void set_num_runs(int32_t num_runs);
 
+		/** Enables the shared kernel matrix cache. If the machine is a
+		 * KernelMachine, the kernel matrix of all features is computed once
+		 * and every fold trains and applies on a CustomKernel subset of it.
+		 * The matrix is reused across runs and across evaluate() calls as
+		 * long as the kernel hyperparameters do not change, e.g. while
+		 * sweeping the C of an SVM.
+		 *
+		 * The matrix is stored in 32bit floats, and a data dependent
+		 * kernel normalizer is fitted on all features instead of the
+		 * training fold.
+		 *
+		 * @param cache_kernel_matrix whether to cache the kernel matrix
+		 */
+		void set_cache_kernel_matrix(bool cache_kernel_matrix);
+
 		/** @return name of the SGSerializable */
 		virtual const char* get_name() const
 		{
@@ -186,8 +202,29 @@ namespace shogun
 		 */
 		float64_t evaluate_one_run(int64_t index) const;
 
+		/** @return kernel matrix of all features as a CustomKernel, if the
+		 * kernel matrix cache is enabled and applicable, nullptr otherwise.
+		 * The matrix is only recomputed when the kernel hyperparameters,
+		 * the feature object or its data changed.
+		 */
+		std::shared_ptr<CustomKernel> get_cached_kernel_matrix() const;
+
 		/** number of evaluation runs for one fold */
 		int32_t m_num_runs;
+
+		/** whether to share one kernel matrix between all folds */
+		bool m_cache_kernel_matrix;
+
+		/** cached kernel matrix of all features */
+		mutable std::shared_ptr<CustomKernel> m_kernel_matrix;
+
+		/** features m_kernel_matrix was computed on */
+		mutable std::shared_ptr<Features> m_kernel_matrix_features;
+
+		/** hash of the kernel hyperparameters and the features
+		 * m_kernel_matrix belongs to
+		 */
+		mutable size_t m_kernel_matrix_hash;
 	};
 }
 
@@ -0,0 +1,533 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/evaluation/Evaluation.h>
+#include <shogun/evaluation/HyperparameterSearch.h>
+#include <shogun/evaluation/SplittingStrategy.h>
+#include <shogun/features/IndexFeatures.h>
+#include <shogun/kernel/CustomKernel.h>
+#include <shogun/lib/View.h>
+#include <shogun/machine/KernelMachine.h>
+#include <shogun/machine/Machine.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/UniformIntDistribution.h>
+#include <shogun/mathematics/UniformRealDistribution.h>
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+using namespace shogun;
+
+namespace
+{
+	/** Resolves "a::b::c" to the object that holds parameter c */
+	std::pair<std::shared_ptr<SGObject>, std::string>
+	resolve_parameter(std::shared_ptr<SGObject> obj, const std::string& name)
+	{
+		std::string rest = name;
+		for (auto pos = rest.find("::"); pos != std::string::npos;
+		     pos = rest.find("::"))
+		{
+			obj = obj->get(rest.substr(0, pos));
+			rest = rest.substr(pos + 2);
+		}
+		return {obj, rest};
+	}
+
+	void put_value(
+	    const std::shared_ptr<SGObject>& machine, const std::string& name,
+	    float64_t value)
+	{
+		auto [obj, param] = resolve_parameter(machine, name);
+		if (obj->has<float64_t>(param))
+			obj->put(param, value);
+		else if (obj->has<float32_t>(param))
+			obj->put(param, (float32_t)value);
+		else if (obj->has<int32_t>(param))
+			obj->put(param, (int32_t)std::round(value));
+		else if (obj->has<int64_t>(param))
+			obj->put(param, (int64_t)std::round(value));
+		else
+			error(
+			    "Hyperparameter {}::{} does not exist or is not numeric.",
+			    obj->get_name(), param);
+	}
+} // namespace
+
+HyperparameterSearch::HyperparameterSearch() : RandomMixin<SGObject>()
+{
+	init();
+}
+
+HyperparameterSearch::HyperparameterSearch(
+    std::shared_ptr<Machine> machine, std::shared_ptr<Features> features,
+    std::shared_ptr<Labels> labels,
+    std::shared_ptr<SplittingStrategy> splitting_strategy,
+    std::shared_ptr<Evaluation> evaluation_criterion)
+    : RandomMixin<SGObject>()
+{
+	init();
+
+	m_machine = std::move(machine);
+	m_features = std::move(features);
+	m_labels = std::move(labels);
+	m_splitting_strategy = std::move(splitting_strategy);
+	m_evaluation_criterion = std::move(evaluation_criterion);
+}
+
+HyperparameterSearch::~HyperparameterSearch()
+{
+}
+
+void HyperparameterSearch::init()
+{
+	m_strategy = HS_GRID;
+	m_num_random_configs = 0;
+	m_halving_rate = 3;
+	m_warm_start = false;
+	m_cache_kernel_matrix = false;
+	m_best_index = -1;
+
+	SG_ADD(&m_machine, "machine", "Machine whose hyperparameters are searched");
+	SG_ADD(&m_features, "features", "Used features");
+	SG_ADD(&m_labels, "labels", "Used labels");
+	SG_ADD(
+	    &m_splitting_strategy, "splitting_strategy", "Used splitting strategy");
+	SG_ADD(
+	    &m_evaluation_criterion, "evaluation_criterion",
+	    "Used evaluation criterion");
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_strategy, "strategy", "Search strategy",
+	    ParameterProperties::SETTING,
+	    SG_OPTIONS(HS_GRID, HS_RANDOM, HS_SUCCESSIVE_HALVING));
+	SG_ADD(
+	    &m_num_random_configs, "num_random_configs",
+	    "Number of random configurations", ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_halving_rate, "halving_rate",
+	    "Pruning factor of successive halving", ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_warm_start, "warm_start",
+	    "Whether to warm start along the last parameter",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_cache_kernel_matrix, "cache_kernel_matrix",
+	    "Whether to share kernel matrices", ParameterProperties::SETTING);
+	SG_ADD(&m_configs, "configs", "Evaluated configurations");
+	SG_ADD(&m_fold_results, "fold_results", "Results on every fold");
+	SG_ADD(&m_best_index, "best_index", "Index of the best configuration");
+}
+
+void HyperparameterSearch::add_grid(
+    const std::string& name, SGVector<float64_t> values)
+{
+	require(m_machine, "No machine to search hyperparameters of.");
+	require(values.vlen > 0, "Grid of {} has no values.", name);
+	require(
+	    std::find(m_names.begin(), m_names.end(), name) == m_names.end(),
+	    "Hyperparameter {} was already added.", name);
+	// fails early for unknown or non numeric parameters
+	put_value(
+	    make_clone(
+	        m_machine,
+	        ParameterProperties::HYPER | ParameterProperties::SETTING),
+	    name, values[0]);
+
+	m_names.push_back(name);
+	m_grids.push_back(values);
+	m_ranges.push_back({values[0], values[0], false});
+}
+
+void HyperparameterSearch::add_range(
+    const std::string& name, float64_t min, float64_t max, bool log_scale)
+{
+	require(m_machine, "No machine to search hyperparameters of.");
+	require(min <= max, "Range [{}, {}] of {} is empty.", min, max, name);
+	require(
+	    !log_scale || min > 0,
+	    "Range [{}, {}] of {} has to be positive for log scale.", min, max,
+	    name);
+	require(
+	    std::find(m_names.begin(), m_names.end(), name) == m_names.end(),
+	    "Hyperparameter {} was already added.", name);
+	put_value(
+	    make_clone(
+	        m_machine,
+	        ParameterProperties::HYPER | ParameterProperties::SETTING),
+	    name, min);
+
+	m_names.push_back(name);
+	m_grids.emplace_back();
+	m_ranges.push_back({min, max, log_scale});
+}
+
+void HyperparameterSearch::set_strategy(EHyperparameterSearchStrategy strategy)
+{
+	m_strategy = strategy;
+}
+
+void HyperparameterSearch::set_num_random_configs(int32_t num_configs)
+{
+	require(
+	    num_configs >= 0, "Number of random configurations ({}) must not be "
+	                      "negative.",
+	    num_configs);
+	m_num_random_configs = num_configs;
+}
+
+void HyperparameterSearch::set_halving_rate(int32_t halving_rate)
+{
+	require(
+	    halving_rate >= 2, "Halving rate ({}) has to be at least 2.",
+	    halving_rate);
+	m_halving_rate = halving_rate;
+}
+
+void HyperparameterSearch::set_warm_start(bool warm_start)
+{
+	m_warm_start = warm_start;
+}
+
+void HyperparameterSearch::set_cache_kernel_matrix(bool cache_kernel_matrix)
+{
+	m_cache_kernel_matrix = cache_kernel_matrix;
+}
+
+void HyperparameterSearch::build_configs()
+{
+	index_t num_params = m_names.size();
+	bool is_grid = std::all_of(
+	    m_grids.begin(), m_grids.end(),
+	    [](const auto& grid) { return grid.vlen > 0; });
+	bool random = m_strategy == HS_RANDOM ||
+	              (m_strategy == HS_SUCCESSIVE_HALVING && m_num_random_configs);
+
+	if (!random)
+	{
+		require(
+		    is_grid, "{} needs grid values for every hyperparameter, "
+		             "ranges are only sampled by random search.",
+		    get_name());
+
+		// last parameter varies fastest, so that neighbouring
+		// configurations only differ in the last parameter
+		index_t num_configs = 1;
+		for (const auto& grid : m_grids)
+			num_configs *= grid.vlen;
+
+		m_configs = SGMatrix<float64_t>(num_params, num_configs);
+		for (index_t c = 0; c < num_configs; ++c)
+		{
+			index_t rest = c;
+			for (index_t p = num_params - 1; p >= 0; --p)
+			{
+				m_configs(p, c) = m_grids[p][rest % m_grids[p].vlen];
+				rest /= m_grids[p].vlen;
+			}
+		}
+		return;
+	}
+
+	require(
+	    m_num_random_configs > 0,
+	    "Number of random configurations has to be set for random search.");
+	m_configs = SGMatrix<float64_t>(num_params, m_num_random_configs);
+	UniformRealDistribution<float64_t> uniform(0.0, 1.0);
+	for (index_t c = 0; c < m_num_random_configs; ++c)
+	{
+		for (index_t p = 0; p < num_params; ++p)
+		{
+			if (m_grids[p].vlen)
+			{
+				UniformIntDistribution<index_t> pick(0, m_grids[p].vlen - 1);
+				m_configs(p, c) = m_grids[p][pick(m_prng)];
+				continue;
+			}
+
+			const auto& range = m_ranges[p];
+			auto u = uniform(m_prng);
+			if (range.log_scale)
+				m_configs(p, c) = std::exp(
+				    std::log(range.min) +
+				    u * (std::log(range.max) - std::log(range.min)));
+			else
+				m_configs(p, c) = range.min + u * (range.max - range.min);
+		}
+	}
+}
+
+void HyperparameterSearch::apply_config(
+    const std::shared_ptr<Machine>& machine, index_t config) const
+{
+	for (index_t p = 0; p < (index_t)m_names.size(); ++p)
+		put_value(machine, m_names[p], m_configs(p, config));
+}
+
+void HyperparameterSearch::prepare_kernel_matrices(
+    const std::vector<index_t>& configs)
+{
+	if (!m_cache_kernel_matrix ||
+	    !std::dynamic_pointer_cast<KernelMachine>(m_machine))
+		return;
+
+	// configurations surviving a successive halving round already know
+	// their kernel, and configurations that only differ in machine
+	// parameters share one matrix
+	for (auto config : configs)
+	{
+		if (m_kernel_hashes[config])
+			continue;
+
+		auto machine = make_clone(
+		    m_machine,
+		    ParameterProperties::HYPER | ParameterProperties::SETTING);
+		apply_config(machine, config);
+		auto kernel =
+		    std::static_pointer_cast<KernelMachine>(machine)->get_kernel();
+		if (!kernel || kernel->get_kernel_type() == K_CUSTOM)
+			return;
+
+		auto hash = kernel->hyperparameter_hash();
+		m_kernel_hashes[config] = hash;
+		if (m_kernel_matrices.count(hash))
+			continue;
+
+		SG_DEBUG(
+		    "computing {}x{} kernel matrix of configuration {}",
+		    m_features->get_num_vectors(), m_features->get_num_vectors(),
+		    config);
+		kernel->init(m_features, m_features);
+		m_kernel_matrices[hash] =
+		    std::make_shared<CustomKernel>(kernel->get_kernel_matrix<float32_t>());
+		kernel->remove_lhs_and_rhs();
+	}
+}
+
+std::vector<std::vector<index_t>>
+HyperparameterSearch::build_chains(const std::vector<index_t>& configs) const
+{
+	std::vector<std::vector<index_t>> chains;
+	bool warm_start = m_warm_start && m_machine->has<bool>("warm_start");
+	index_t num_params = m_names.size();
+
+	for (auto config : configs)
+	{
+		bool extends = false;
+		if (warm_start && !chains.empty())
+		{
+			auto last = chains.back().back();
+			extends = true;
+			for (index_t p = 0; p < num_params - 1; ++p)
+				extends &= m_configs(p, last) == m_configs(p, config);
+		}
+
+		if (extends)
+			chains.back().push_back(config);
+		else
+			chains.push_back({config});
+	}
+	return chains;
+}
+
+void HyperparameterSearch::evaluate(
+    const std::vector<index_t>& configs, index_t fold_begin, index_t fold_end)
+{
+	prepare_kernel_matrices(configs);
+	auto chains = build_chains(configs);
+	bool warm_start = chains.size() < configs.size();
+	index_t num_folds = fold_end - fold_begin;
+	index_t num_jobs = chains.size() * num_folds;
+
+	SG_DEBUG(
+	    "evaluating {} configurations in {} chains on folds [{}, {})",
+	    configs.size(), chains.size(), fold_begin, fold_end);
+
+	// one job trains a chain of configurations on one fold, jobs of very
+	// different cost are balanced by dynamic scheduling
+#pragma omp parallel for schedule(dynamic, 1)
+	for (index_t job = 0; job < num_jobs; ++job)
+	{
+		const auto& chain = chains[job / num_folds];
+		auto fold = fold_begin + job % num_folds;
+		const auto& idx_train = m_train_indices[fold];
+		const auto& idx_test = m_test_indices[fold];
+
+		auto labels_train = view(m_labels, idx_train);
+		auto labels_test = view(m_labels, idx_test);
+		auto evaluation_criterion = make_clone(m_evaluation_criterion);
+
+		std::shared_ptr<Machine> machine;
+		for (auto config : chain)
+		{
+			// in a warm start chain the machine keeps its model and only
+			// the last parameter changes
+			if (!machine || !warm_start)
+			{
+				machine = make_clone(
+				    m_machine,
+				    ParameterProperties::HYPER | ParameterProperties::SETTING);
+				if (warm_start)
+					machine->put("warm_start", true);
+			}
+			apply_config(machine, config);
+
+			std::shared_ptr<Features> features_train;
+			std::shared_ptr<Features> features_test;
+			auto kernel_matrix = m_kernel_matrices.end();
+			if (m_kernel_hashes[config])
+				kernel_matrix = m_kernel_matrices.find(*m_kernel_hashes[config]);
+			if (kernel_matrix != m_kernel_matrices.end())
+			{
+				// the fold kernel only adds subsets to the shared matrix,
+				// and keeps the index features as lhs for apply
+				std::static_pointer_cast<KernelMachine>(machine)->set_kernel(
+				    std::make_shared<CustomKernel>(kernel_matrix->second));
+				features_train = std::make_shared<IndexFeatures>(idx_train);
+				features_test = std::make_shared<IndexFeatures>(idx_test);
+			}
+			else
+			{
+				features_train = view(m_features, idx_train);
+				features_test = view(m_features, idx_test);
+			}
+
+			machine->set_labels(labels_train);
+			machine->train(features_train);
+			auto result_labels = machine->apply(features_test);
+			m_fold_results(fold, config) =
+			    evaluation_criterion->evaluate(result_labels, labels_test);
+		}
+	}
+}
+
+bool HyperparameterSearch::is_better(float64_t a, float64_t b) const
+{
+	if (std::isnan(b))
+		return !std::isnan(a);
+	if (m_evaluation_criterion->get_evaluation_direction() == ED_MAXIMIZE)
+		return a > b;
+	return a < b;
+}
+
+SGVector<float64_t> HyperparameterSearch::get_results() const
+{
+	SGVector<float64_t> results(m_fold_results.num_cols);
+	for (index_t c = 0; c < m_fold_results.num_cols; ++c)
+	{
+		float64_t sum = 0;
+		index_t count = 0;
+		for (index_t f = 0; f < m_fold_results.num_rows; ++f)
+		{
+			if (std::isnan(m_fold_results(f, c)))
+				continue;
+			sum += m_fold_results(f, c);
+			++count;
+		}
+		results[c] = count ? sum / count : Math::NOT_A_NUMBER;
+	}
+	return results;
+}
+
+SGVector<float64_t> HyperparameterSearch::get_best_config() const
+{
+	require(m_best_index >= 0, "No search was run yet.");
+	return m_configs.get_column(m_best_index).clone();
+}
+
+std::shared_ptr<Machine> HyperparameterSearch::search()
+{
+	require(m_machine, "No machine to search hyperparameters of.");
+	require(m_features, "No features to search hyperparameters on.");
+	require(m_labels, "No labels to search hyperparameters on.");
+	require(m_splitting_strategy, "No splitting strategy.");
+	require(m_evaluation_criterion, "No evaluation criterion.");
+	require(!m_names.empty(), "No hyperparameters to search.");
+
+	build_configs();
+	index_t num_configs = m_configs.num_cols;
+
+	m_splitting_strategy->build_subsets();
+	index_t num_folds = m_splitting_strategy->get_num_subsets();
+	m_train_indices.clear();
+	m_test_indices.clear();
+	for (index_t f = 0; f < num_folds; ++f)
+	{
+		m_train_indices.push_back(
+		    m_splitting_strategy->generate_subset_inverse(f));
+		m_test_indices.push_back(
+		    m_splitting_strategy->generate_subset_indices(f));
+	}
+
+	m_fold_results = SGMatrix<float64_t>(num_folds, num_configs);
+	m_fold_results.set_const(Math::NOT_A_NUMBER);
+	m_kernel_hashes.assign(num_configs, std::nullopt);
+	m_kernel_matrices.clear();
+
+	std::vector<index_t> alive(num_configs);
+	std::iota(alive.begin(), alive.end(), 0);
+
+	if (m_strategy != HS_SUCCESSIVE_HALVING)
+	{
+		io::info(
+		    "evaluating {} configurations on {} folds", num_configs,
+		    num_folds);
+		evaluate(alive, 0, num_folds);
+	}
+	else
+	{
+		index_t folds_done = 0;
+		index_t folds_needed = 1;
+		while (folds_done < num_folds)
+		{
+			folds_needed = std::min(folds_needed, num_folds);
+			io::info(
+			    "successive halving: evaluating {} configurations on folds "
+			    "[{}, {})",
+			    alive.size(), folds_done, folds_needed);
+			evaluate(alive, folds_done, folds_needed);
+			folds_done = folds_needed;
+			folds_needed *= m_halving_rate;
+
+			if (folds_done == num_folds || alive.size() == 1)
+				continue;
+
+			// keep the best 1/halving_rate in their original order, which
+			// keeps warm start chains of the survivors intact
+			auto results = get_results();
+			auto ranked = alive;
+			std::stable_sort(
+			    ranked.begin(), ranked.end(), [&](index_t a, index_t b) {
+				    return is_better(results[a], results[b]);
+			    });
+			ranked.resize(
+			    (ranked.size() + m_halving_rate - 1) / m_halving_rate);
+			std::sort(ranked.begin(), ranked.end());
+			alive = std::move(ranked);
+		}
+	}
+
+	// best of the configurations that were evaluated on all folds
+	auto results = get_results();
+	m_best_index = alive[0];
+	for (auto config : alive)
+	{
+		if (is_better(results[config], results[m_best_index]))
+			m_best_index = config;
+	}
+	io::info(
+	    "best configuration {} with result {}", m_best_index,
+	    results[m_best_index]);
+
+	m_kernel_matrices.clear();
+	m_train_indices.clear();
+	m_test_indices.clear();
+
+	auto machine = make_clone(
+	    m_machine, ParameterProperties::HYPER | ParameterProperties::SETTING);
+	apply_config(machine, m_best_index);
+	machine->set_labels(m_labels);
+	machine->train(m_features);
+	return machine;
+}
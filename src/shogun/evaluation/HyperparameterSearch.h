@@ -0,0 +1,273 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef __HYPERPARAMETERSEARCH_H_
+#define __HYPERPARAMETERSEARCH_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/mathematics/RandomMixin.h>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace shogun
+{
+	class Machine;
+	class Features;
+	class Labels;
+	class SplittingStrategy;
+	class Evaluation;
+	class CustomKernel;
+
+	/** strategy of the HyperparameterSearch */
+	enum EHyperparameterSearchStrategy
+	{
+		/** every combination of the grid values */
+		HS_GRID = 0,
+		/** random samples of the grid values and ranges */
+		HS_RANDOM = 1,
+		/** successive halving of the grid or of random samples */
+		HS_SUCCESSIVE_HALVING = 2
+	};
+
+	/** @brief Searches hyperparameters of a machine by cross-validation.
+	 *
+	 * Hyperparameters are registered by name with add_grid() or
+	 * add_range(). Parameters of nested objects are addressed with "::",
+	 * e.g. "kernel::width". Integer parameters are rounded.
+	 *
+	 * All configurations are evaluated on the same folds of the splitting
+	 * strategy. Every (configuration, fold) pair is a job, and all jobs of a
+	 * round run in one dynamically scheduled parallel loop, so that slow
+	 * configurations do not stall the others. The strategies are
+	 *
+	 * - HS_GRID: every combination of the grid values on all folds.
+	 * - HS_RANDOM: set_num_random_configs() configurations, with values
+	 *   drawn uniformly from the grids and ranges, on all folds.
+	 * - HS_SUCCESSIVE_HALVING: the grid, or random configurations if
+	 *   set_num_random_configs() was set, are evaluated on one fold. Only
+	 *   the best 1/halving_rate of them are evaluated on halving_rate times
+	 *   as many folds, and so on until the survivors saw all folds. Losing
+	 *   configurations are thereby pruned after a fraction of the work.
+	 *
+	 * With warm starts enabled and a machine that supports them (it has a
+	 * "warm_start" setting, e.g. LibLinear), configurations that only
+	 * differ in the last registered parameter are trained in sequence on
+	 * one machine per fold, each starting from the model of the previous
+	 * value. Register e.g. C last and in increasing order for a C path.
+	 *
+	 * With the kernel matrix cache enabled and a KernelMachine, the kernel
+	 * matrix of all features is computed once per distinct kernel
+	 * configuration, and shared by all folds and all configurations that
+	 * only differ in non kernel parameters, see also
+	 * CrossValidation::set_cache_kernel_matrix().
+	 */
+	class HyperparameterSearch : public RandomMixin<SGObject>
+	{
+	public:
+		/** constructor */
+		HyperparameterSearch();
+
+		/** constructor
+		 *
+		 * @param machine learning machine whose hyperparameters are searched
+		 * @param features features to use for cross-validation
+		 * @param labels labels that correspond to the features
+		 * @param splitting_strategy splitting strategy to use
+		 * @param evaluation_criterion evaluation criterion to use
+		 */
+		HyperparameterSearch(
+		    std::shared_ptr<Machine> machine, std::shared_ptr<Features> features,
+		    std::shared_ptr<Labels> labels,
+		    std::shared_ptr<SplittingStrategy> splitting_strategy,
+		    std::shared_ptr<Evaluation> evaluation_criterion);
+
+		/** destructor */
+		virtual ~HyperparameterSearch();
+
+		/** adds a parameter that takes the given values
+		 *
+		 * @param name name of the parameter
+		 * @param values values of the parameter
+		 */
+		void add_grid(const std::string& name, SGVector<float64_t> values);
+
+		/** Adds a parameter that takes values in [min, max]. Only used by
+		 * random search.
+		 *
+		 * @param name name of the parameter
+		 * @param min smallest value
+		 * @param max largest value
+		 * @param log_scale whether to sample uniformly in log space
+		 */
+		void add_range(
+		    const std::string& name, float64_t min, float64_t max,
+		    bool log_scale = false);
+
+		/** @param strategy search strategy */
+		void set_strategy(EHyperparameterSearchStrategy strategy);
+
+		/** @param num_configs number of random configurations */
+		void set_num_random_configs(int32_t num_configs);
+
+		/** @param halving_rate factor of pruned configurations and added
+		 * folds per round of successive halving
+		 */
+		void set_halving_rate(int32_t halving_rate);
+
+		/** @param warm_start whether to warm start along the last parameter
+		 */
+		void set_warm_start(bool warm_start);
+
+		/** @param cache_kernel_matrix whether to share kernel matrices */
+		void set_cache_kernel_matrix(bool cache_kernel_matrix);
+
+		/** Runs the search and trains a clone of the machine with the best
+		 * configuration on all features.
+		 *
+		 * @return trained machine with the best configuration
+		 */
+		std::shared_ptr<Machine> search();
+
+		/** @return evaluated configurations, one per column, parameters in
+		 * the order they were added
+		 */
+		SGMatrix<float64_t> get_configs() const
+		{
+			return m_configs;
+		}
+
+		/** @return evaluation of every configuration (column) on every
+		 * fold (row), NaN for folds a configuration was pruned before
+		 */
+		SGMatrix<float64_t> get_fold_results() const
+		{
+			return m_fold_results;
+		}
+
+		/** @return mean evaluation of every configuration over the folds it
+		 * was evaluated on
+		 */
+		SGVector<float64_t> get_results() const;
+
+		/** @return index of the best configuration */
+		index_t get_best_index() const
+		{
+			return m_best_index;
+		}
+
+		/** @return best configuration */
+		SGVector<float64_t> get_best_config() const;
+
+		/** @return name of the SGSerializable */
+		virtual const char* get_name() const
+		{
+			return "HyperparameterSearch";
+		}
+
+	private:
+		/** sampling interval of a parameter added with add_range */
+		struct Range
+		{
+			float64_t min;
+			float64_t max;
+			bool log_scale;
+		};
+
+		void init();
+
+		/** builds m_configs for the current strategy */
+		void build_configs();
+
+		/** puts configuration config into a machine */
+		void apply_config(
+		    const std::shared_ptr<Machine>& machine, index_t config) const;
+
+		/** computes the kernel matrices the given configurations need */
+		void prepare_kernel_matrices(const std::vector<index_t>& configs);
+
+		/** groups configurations into warm start chains */
+		std::vector<std::vector<index_t>>
+		build_chains(const std::vector<index_t>& configs) const;
+
+		/** evaluates configurations on folds [fold_begin, fold_end) */
+		void evaluate(
+		    const std::vector<index_t>& configs, index_t fold_begin,
+		    index_t fold_end);
+
+		/** @return whether result a is better than result b */
+		bool is_better(float64_t a, float64_t b) const;
+
+	protected:
+		/** machine whose hyperparameters are searched */
+		std::shared_ptr<Machine> m_machine;
+
+		/** features */
+		std::shared_ptr<Features> m_features;
+
+		/** labels */
+		std::shared_ptr<Labels> m_labels;
+
+		/** splitting strategy */
+		std::shared_ptr<SplittingStrategy> m_splitting_strategy;
+
+		/** evaluation criterion */
+		std::shared_ptr<Evaluation> m_evaluation_criterion;
+
+		/** search strategy */
+		EHyperparameterSearchStrategy m_strategy;
+
+		/** number of random configurations */
+		int32_t m_num_random_configs;
+
+		/** pruning factor of successive halving */
+		int32_t m_halving_rate;
+
+		/** whether to warm start along the last parameter */
+		bool m_warm_start;
+
+		/** whether to share kernel matrices */
+		bool m_cache_kernel_matrix;
+
+		/** names of the parameters */
+		std::vector<std::string> m_names;
+
+		/** grid values of the parameters, empty for ranges */
+		std::vector<SGVector<float64_t>> m_grids;
+
+		/** intervals of the parameters, only used for ranges */
+		std::vector<Range> m_ranges;
+
+		/** configurations, one per column */
+		SGMatrix<float64_t> m_configs;
+
+		/** results of every configuration on every fold */
+		SGMatrix<float64_t> m_fold_results;
+
+		/** index of the best configuration */
+		index_t m_best_index;
+
+		/** kernel hyperparameter hash of every configuration, unset until
+		 * the kernel matrix of the configuration is prepared
+		 */
+		std::vector<std::optional<size_t>> m_kernel_hashes;
+
+		/** kernel matrices by kernel hyperparameter hash */
+		std::map<size_t, std::shared_ptr<CustomKernel>> m_kernel_matrices;
+
+		/** training indices of every fold */
+		std::vector<SGVector<index_t>> m_train_indices;
+
+		/** test indices of every fold */
+		std::vector<SGVector<index_t>> m_test_indices;
+	};
+} // namespace shogun
+
+#endif /* __HYPERPARAMETERSEARCH_H_ */
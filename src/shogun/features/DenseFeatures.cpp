@@ -405,8 +405,31 @@ template<class ST> float64_t DenseFeatures<ST>::dot(int32_t vec_idx1, std::share
 		int32_t vec_idx2) const
 {
 	ASSERT(df)
-	ASSERT(df->get_feature_type() == get_feature_type())
 	ASSERT(df->get_feature_class() == get_feature_class())
+
+	// mixed storage types, e.g. float32 data against float64 cluster
+	// centers: the product is evaluated against the float64 vector
+	if (df->get_feature_type() != get_feature_type())
+	{
+		if (df->get_feature_type() == F_DREAL)
+		{
+			auto sf = std::static_pointer_cast<DenseFeatures<float64_t>>(df);
+			SGVector<float64_t> vec2 = sf->get_feature_vector(vec_idx2);
+			float64_t result = dot(vec_idx1, vec2);
+			sf->free_feature_vector(vec2, vec_idx2);
+			return result;
+		}
+		require(
+		    get_feature_type() == F_DREAL,
+		    "Dot product of dense features of types {} and {} is not "
+		    "supported", (int32_t)get_feature_type(),
+		    (int32_t)df->get_feature_type());
+		SGVector<ST> vec1 = get_feature_vector(vec_idx1);
+		float64_t result = df->dot(vec_idx2, vec1.template as<float64_t>());
+		free_feature_vector(vec1, vec_idx1);
+		return result;
+	}
+
 	auto sf = std::static_pointer_cast<DenseFeatures<ST>>(df);
 
 	int32_t len1, len2;
@@ -417,7 +440,19 @@ template<class ST> float64_t DenseFeatures<ST>::dot(int32_t vec_idx1, std::share
 	SGVector<ST> sg_vec1(vec1, len1, false);
 	SGVector<ST> sg_vec2(vec2, len2, false);
 
-	float64_t result = linalg::dot(sg_vec1, sg_vec2);
+	float64_t result;
+	if constexpr (std::is_same<ST, float32_t>::value)
+	{
+		// accumulate in double precision, the operands are only widened in
+		// registers
+		ASSERT(len1 == len2)
+		result = Eigen::Map<const Eigen::VectorXf>(vec1, len1)
+		             .template cast<float64_t>()
+		             .dot(Eigen::Map<const Eigen::VectorXf>(vec2, len2)
+		                      .template cast<float64_t>());
+	}
+	else
+		result = linalg::dot(sg_vec1, sg_vec2);
 
 	free_feature_vector(vec1, vec_idx1, free1);
 	sf->free_feature_vector(vec2, vec_idx2, free2);
@@ -281,7 +281,9 @@ public:
 	/** compute dot product between vector1 and vector2,
 	 * appointed by their indices
 	 *
-	 * possible with subset
+	 * possible with subset. float32 vectors are accumulated in float64, and
+	 * df may also be dense features of a different storage type if either
+	 * side is float64
 	 *
 	 * @param vec_idx1 index of first vector
 	 * @param df DotFeatures (of same kind) to compute dot product with
@@ -6,9 +6,14 @@
 
 #include <shogun/mathematics/Math.h>
 #include <shogun/features/RandomFourierDotFeatures.h>
+#include <shogun/mathematics/FastHadamardTransform.h>
+#include <shogun/lib/WorkspacePool.h>
 #include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/RandomNamespace.h>
+#include <shogun/mathematics/UniformIntDistribution.h>
 #include <shogun/mathematics/UniformRealDistribution.h>
 
+#include <random>
 #include <utility>
 
 namespace shogun {
@@ -21,11 +26,16 @@ RandomFourierDotFeatures::RandomFourierDotFeatures()
 }
 
 RandomFourierDotFeatures::RandomFourierDotFeatures(std::shared_ptr<DotFeatures> features,
-	int32_t D, KernelName kernel_name, SGVector<float64_t> params)
+	int32_t D, KernelName kernel_name, SGVector<float64_t> params,
+	RandomFourierProjection projection_type)
 : RandomKitchenSinksDotFeatures(std::move(features), D)
 {
 	init(kernel_name, params);
-	random_coeff = generate_random_coefficients();
+	projection = projection_type;
+	if (projection == FASTFOOD_PROJECTION)
+		generate_fastfood_coefficients();
+	else
+		random_coeff = generate_random_coefficients();
 }
 
 RandomFourierDotFeatures::RandomFourierDotFeatures(std::shared_ptr<DotFeatures> features,
@@ -45,6 +55,11 @@ RandomFourierDotFeatures::RandomFourierDotFeatures(const RandomFourierDotFeature
 : RandomKitchenSinksDotFeatures(orig)
 {
 	init(orig.kernel, orig.kernel_params);
+	projection = orig.projection;
+	fastfood_signs = orig.fastfood_signs;
+	fastfood_permutations = orig.fastfood_permutations;
+	fastfood_gaussians = orig.fastfood_gaussians;
+	fastfood_scales = orig.fastfood_scales;
 }
 
 RandomFourierDotFeatures::~RandomFourierDotFeatures()
@@ -58,6 +73,7 @@ RandomFourierDotFeatures::~RandomFourierDotFeatures()
 		kernel_params = params;
 
 		constant = num_samples > 0 ? std::sqrt(2.0 / num_samples) : 1;
+		projection = DENSE_PROJECTION;
 		SG_ADD(
 		    &kernel_params, "kernel_params",
 		    "The parameters of the kernel to approximate");
@@ -65,6 +81,20 @@ RandomFourierDotFeatures::~RandomFourierDotFeatures()
 		SG_ADD_OPTIONS(
 		    (machine_int_t*)&kernel, "kernel", "The kernel to approximate",
 		    ParameterProperties::NONE, SG_OPTIONS(GAUSSIAN, NOT_SPECIFIED));
+		SG_ADD_OPTIONS(
+		    (machine_int_t*)&projection, "projection",
+		    "How the random projection is drawn", ParameterProperties::NONE,
+		    SG_OPTIONS(DENSE_PROJECTION, FASTFOOD_PROJECTION));
+		SG_ADD(&fastfood_signs, "fastfood_signs", "Signs of the Fastfood blocks");
+		SG_ADD(
+		    &fastfood_permutations, "fastfood_permutations",
+		    "Permutations of the Fastfood blocks");
+		SG_ADD(
+		    &fastfood_gaussians, "fastfood_gaussians",
+		    "Gaussian diagonals of the Fastfood blocks");
+		SG_ADD(
+		    &fastfood_scales, "fastfood_scales",
+		    "Scaling diagonals of the Fastfood blocks");
 	}
 
 std::shared_ptr<Features> RandomFourierDotFeatures::duplicate() const
@@ -77,12 +107,135 @@ const char* RandomFourierDotFeatures::get_name() const
 	return "RandomFourierDotFeatures";
 }
 
+RandomFourierProjection RandomFourierDotFeatures::get_projection() const
+{
+	return projection;
+}
+
+SGMatrix<float64_t> RandomFourierDotFeatures::compute_projections(
+	int32_t start, int32_t stop) const
+{
+	if (projection != FASTFOOD_PROJECTION)
+		return RandomKitchenSinksDotFeatures::compute_projections(start, stop);
+
+	int32_t dim = feats->get_dim_feature_space();
+	int32_t padded_dim = fastfood_signs.num_rows;
+	int32_t num_blocks = fastfood_signs.num_cols;
+	int32_t num = stop - start;
+	// blocks of up to 1024 entries (8KB) are transformed iteratively in the
+	// L1 cache, larger buffers are split recursively into such blocks
+	int32_t chunk = Math::max(Math::min(padded_dim, 1024), 8);
+
+	auto X = get_input_vectors(start, stop);
+	SGMatrix<float64_t> projections(num_samples, num);
+	bool transform_failed = false;
+
+	#pragma omp parallel if (num > 1)
+	{
+		// the transform expects buffers aligned for AVX, which the
+		// workspace provides
+		WorkspaceScope scope;
+		auto buffer = workspace::vector<float64_t>(padded_dim);
+		auto permuted = workspace::vector<float64_t>(padded_dim);
+
+		#pragma omp for
+		for (index_t i=0; i<num; i++)
+		{
+			for (index_t block=0; block<num_blocks; block++)
+			{
+				// H*B*x, with x padded with zeros
+				for (index_t j=0; j<dim; j++)
+					buffer[j] = X(j, i) * fastfood_signs(j, block);
+				std::fill(buffer.vector + dim, buffer.vector + padded_dim, 0.0);
+				int32_t status =
+				    fast_hadamard_transform(buffer.vector, padded_dim, chunk);
+
+				// H*G*Pi*H*B*x
+				for (index_t j=0; j<padded_dim; j++)
+				{
+					permuted[j] = buffer[fastfood_permutations(j, block)] *
+					              fastfood_gaussians(j, block);
+				}
+				status |=
+				    fast_hadamard_transform(permuted.vector, padded_dim, chunk);
+				if (status != 0)
+				{
+					#pragma omp atomic write
+					transform_failed = true;
+				}
+
+				// S*H*G*Pi*H*B*x, the last block is cut to the number of samples
+				int32_t offset = block * padded_dim;
+				int32_t size = Math::min(padded_dim, num_samples - offset);
+				for (index_t j=0; j<size; j++)
+					projections(offset + j, i) = permuted[j] * fastfood_scales(j, block);
+			}
+		}
+	}
+	require(
+	    !transform_failed,
+	    "Fast Hadamard transform of length {} failed", padded_dim);
+	return projections;
+}
+
 float64_t RandomFourierDotFeatures::post_dot(float64_t dot_result, index_t par_idx) const
 {
 	dot_result += random_coeff(random_coeff.num_rows-1, par_idx);
 	return std::cos(dot_result) * constant;
 }
 
+void RandomFourierDotFeatures::generate_fastfood_coefficients()
+{
+	require(kernel == GAUSSIAN, "Fastfood is only implemented for the Gaussian kernel.");
+
+	int32_t dim = feats->get_dim_feature_space();
+	int32_t padded_dim = 1;
+	while (padded_dim < dim)
+		padded_dim *= 2;
+	int32_t num_blocks = (num_samples + padded_dim - 1) / padded_dim;
+
+	fastfood_signs = SGMatrix<float64_t>(padded_dim, num_blocks);
+	fastfood_permutations = SGMatrix<index_t>(padded_dim, num_blocks);
+	fastfood_gaussians = SGMatrix<float64_t>(padded_dim, num_blocks);
+	fastfood_scales = SGMatrix<float64_t>(padded_dim, num_blocks);
+
+	NormalDistribution<float64_t> normal_dist;
+	UniformRealDistribution<float64_t> uniform_real_dist(0.0, 2 * Math::PI);
+	UniformIntDistribution<int32_t> sign_dist(0, 1);
+	// norms of Gaussian vectors of length padded_dim
+	std::chi_squared_distribution<float64_t> chi_squared_dist(padded_dim);
+
+	// the rows of H*G*Pi*H*B have norm |G|/sqrt(padded_dim) with the
+	// normalized transform, and the rows of the dense projection are
+	// Gaussian with variance 2/width
+	float64_t width_scale = std::sqrt(2.0 / kernel_params[0]);
+	for (index_t block=0; block<num_blocks; block++)
+	{
+		float64_t gaussian_sqnorm = 0;
+		for (index_t j=0; j<padded_dim; j++)
+		{
+			fastfood_signs(j, block) = sign_dist(m_prng) ? 1.0 : -1.0;
+			fastfood_gaussians(j, block) = normal_dist(m_prng);
+			gaussian_sqnorm += Math::sq(fastfood_gaussians(j, block));
+			fastfood_permutations(j, block) = j;
+		}
+		random::shuffle(fastfood_permutations.get_column_vector(block),
+			fastfood_permutations.get_column_vector(block) + padded_dim, m_prng);
+
+		for (index_t j=0; j<padded_dim; j++)
+		{
+			fastfood_scales(j, block) = std::sqrt(chi_squared_dist(m_prng)) *
+				width_scale * std::sqrt(padded_dim / gaussian_sqnorm);
+		}
+	}
+
+	// only the phases are kept in the random coefficients, post_dot reads
+	// them from the last row
+	random_coeff = SGMatrix<float64_t>(1, num_samples);
+	for (index_t i=0; i<num_samples; i++)
+		random_coeff(0, i) = uniform_real_dist(m_prng);
+}
+
 SGVector<float64_t> RandomFourierDotFeatures::generate_random_parameter_vector()
 {
 	NormalDistribution<float64_t> normal_dist;
@@ -31,6 +31,18 @@ enum KernelName
 	NOT_SPECIFIED
 };
 
+/** ways to draw the random projection of the input */
+enum RandomFourierProjection
+{
+	/** a dense matrix of Gaussian samples, O(dD) per vector */
+	DENSE_PROJECTION,
+
+	/** Fastfood, products of Hadamard and random diagonal matrices,
+	 *	O(D log d) per vector and O(D) memory
+	 */
+	FASTFOOD_PROJECTION
+};
+
 /** @brief This class implements the random fourier features for the DotFeatures
  *  framework.
  *  Basically upon the object creation it computes the random coefficients, namely w and b,
@@ -38,8 +50,17 @@ enum KernelName
  *  based on the following formula z(x) = sqrt(2/D) * cos(w'*x + b), where D is the number
  *  of samples that are used.
  *
+ *  With FASTFOOD_PROJECTION, the Gaussian matrix is replaced by blocks
+ *  \f$SHG\Pi HB\f$ of size d', the input dimension rounded up to a power of
+ *  two, where H is the Walsh-Hadamard transform, B random signs, \f$\Pi\f$ a
+ *  random permutation, G Gaussian and S scaling such that the rows have the
+ *  norms of Gaussian vectors. The transforms are computed with the bundled
+ *  FFHT library. The random coefficients then only hold the phases b.
+ *
  *  For more detailed information you can take a look at this source:
  *  i) Random Features for Large-Scale Kernel Machines - Ali Rahimi and Ben Recht
+ *  ii) Fastfood - Approximating Kernel Expansions in Loglinear Time - Quoc Le,
+ *  Tamas Sarlos and Alex Smola
  */
 class RandomFourierDotFeatures : public RandomKitchenSinksDotFeatures
 {
@@ -55,9 +76,10 @@ public:
 	 * @param D the number of random fourier samples to draw / dimensionality of new feature space
 	 * @param kernel_name the name of the kernel to approximate
 	 * @param params kernel parameters (see kernel's description in KernelName to see what each kernel expects)
+	 * @param projection_type how to draw the random projection
 	 */
 	RandomFourierDotFeatures(std::shared_ptr<DotFeatures> features, int32_t D, KernelName kernel_name,
-			SGVector<float64_t> params);
+			SGVector<float64_t> params, RandomFourierProjection projection_type = DENSE_PROJECTION);
 
 	/** constructor that uses the specified random coefficients.
 	 *
@@ -88,7 +110,18 @@ public:
 	/** @return object name */
 	virtual const char* get_name() const;
 
+	/** @return how the random projection is drawn */
+	RandomFourierProjection get_projection() const;
+
 protected:
+	/** computes the random projections of a range of vectors, with the
+	 * Hadamard transform for FASTFOOD_PROJECTION
+	 *
+	 * @param start first vector
+	 * @param stop one past the last vector
+	 * @return projections, one column per vector
+	 */
+	virtual SGMatrix<float64_t> compute_projections(int32_t start, int32_t stop) const;
 
 	/** subclass must override this to perform any operations
 	 * on the dot result between a feature vector and a parameter vector w
@@ -108,6 +141,11 @@ protected:
 private:
 	void init(KernelName kernel_name, const SGVector<float64_t>& params);
 
+	/** draws the diagonal matrices and permutations of the Fastfood blocks
+	 * and the phases
+	 */
+	void generate_fastfood_coefficients();
+
 private:
 	/** the kernel to approximate */
 	KernelName kernel;
@@ -117,6 +155,23 @@ private:
 
 	/** norm const */
 	float64_t constant;
+
+	/** how the random projection is drawn */
+	RandomFourierProjection projection;
+
+	/** random signs B of the Fastfood blocks, one block per column */
+	SGMatrix<float64_t> fastfood_signs;
+
+	/** permutations of the Fastfood blocks */
+	SGMatrix<index_t> fastfood_permutations;
+
+	/** Gaussian diagonals G of the Fastfood blocks */
+	SGMatrix<float64_t> fastfood_gaussians;
+
+	/** scaling diagonals S of the Fastfood blocks, including the kernel width
+	 * and the normalization of the transforms
+	 */
+	SGMatrix<float64_t> fastfood_scales;
 };
 }
 
@@ -4,14 +4,22 @@
  * Authors: Bjoern Esser, Evangelos Anagnostopoulos
  */
 
+#include <shogun/base/progress.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/features/RandomKitchenSinksDotFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/mathematics/eigen3.h>
 #include <typeinfo>
 #include <utility>
 
+using namespace Eigen;
+
 namespace shogun
 {
 
+/** number of vectors that are transformed together */
+static const int32_t block_size = 256;
+
 class CRKSFunctions;
 
 RandomKitchenSinksDotFeatures::RandomKitchenSinksDotFeatures()
@@ -59,6 +67,8 @@ RandomKitchenSinksDotFeatures::RandomKitchenSinksDotFeatures(
 {
 	init(orig.feats, orig.num_samples);
 	random_coeff = orig.random_coeff;
+	cache_features = orig.cache_features;
+	cached_features = orig.cached_features;
 }
 
 RandomKitchenSinksDotFeatures::~RandomKitchenSinksDotFeatures()
@@ -73,10 +83,13 @@ void RandomKitchenSinksDotFeatures::init(std::shared_ptr<DotFeatures> dataset,
 
 
 	num_samples = K;
+	cache_features = false;
 
 	SG_ADD((std::shared_ptr<SGObject>* ) &feats, "feats", "Features to work on");
 	SG_ADD(
 		&random_coeff, "random_coeff", "Random function parameters");
+	SG_ADD(&cache_features, "cache_features",
+		"Whether the transformed vectors are cached");
 }
 
 int32_t RandomKitchenSinksDotFeatures::get_dim_feature_space() const
@@ -91,17 +104,10 @@ float64_t RandomKitchenSinksDotFeatures::dot(int32_t vec_idx1, std::shared_ptr<D
 	auto other = std::static_pointer_cast<RandomKitchenSinksDotFeatures>(df);
 	ASSERT(get_dim_feature_space()==other->get_dim_feature_space());
 
-	float64_t dot_product = 0;
-	for (index_t i=0; i<num_samples; i++)
-	{
-		float64_t tmp_dot_1 = dot(vec_idx1, i);
-		float64_t tmp_dot_2 = other->dot(vec_idx2, i);
-
-		tmp_dot_1 = post_dot(tmp_dot_1, i);
-		tmp_dot_2 = other->post_dot(tmp_dot_2, i);
-		dot_product += tmp_dot_1 * tmp_dot_2;
-	}
-	return dot_product;
+	auto vec1 = get_random_feature_vector(vec_idx1);
+	auto vec2 = other->get_random_feature_vector(vec_idx2);
+	return Map<VectorXd>(vec1.vector, vec1.vlen).dot(
+		Map<VectorXd>(vec2.vector, vec2.vlen));
 }
 
 float64_t RandomKitchenSinksDotFeatures::dot(
@@ -110,13 +116,9 @@ float64_t RandomKitchenSinksDotFeatures::dot(
 	SG_TRACE("entering dense_dot()");
 	ASSERT(vec2.size() == get_dim_feature_space());
 
-	float64_t dot_product = 0;
-	for (index_t i=0; i<num_samples; i++)
-	{
-		float64_t tmp_dot = dot(vec_idx1, i);
-		tmp_dot = post_dot(tmp_dot, i);
-		dot_product += tmp_dot * vec2[i];
-	}
+	auto vec1 = get_random_feature_vector(vec_idx1);
+	float64_t dot_product = Map<VectorXd>(vec1.vector, vec1.vlen).dot(
+		Map<VectorXd>(vec2.vector, vec2.vlen));
 	SG_TRACE("Leaving dense_dot()");
 	return dot_product;
 }
@@ -127,16 +129,57 @@ void RandomKitchenSinksDotFeatures::add_to_dense_vec(float64_t alpha,
 	SG_TRACE("Entering add_to_dense()");
 	ASSERT(vec2_len == get_dim_feature_space());
 
-	for (index_t i=0; i<num_samples; i++)
+	auto vec1 = get_random_feature_vector(vec_idx1);
+	Map<VectorXd> map_vec1(vec1.vector, vec1.vlen);
+	Map<VectorXd> map_vec2(vec2, vec2_len);
+	if (abs_val)
+		map_vec2 += (alpha * map_vec1).cwiseAbs();
+	else
+		map_vec2 += alpha * map_vec1;
+	SG_TRACE("Leaving add_to_dense()");
+}
+
+void RandomKitchenSinksDotFeatures::dense_dot_range(float64_t* output,
+	int32_t start, int32_t stop, float64_t* alphas, float64_t* vec,
+	int32_t dim, float64_t b) const
+{
+	ASSERT(output)
+	ASSERT(start>=0)
+	ASSERT(start<stop)
+	ASSERT(stop<=get_num_vectors())
+	ASSERT(dim == get_dim_feature_space())
+
+	Map<VectorXd> w(vec, dim);
+	index_t num_blocks = (stop - start + block_size - 1) / block_size;
+	auto pb = SG_PROGRESS(range(num_blocks));
+
+	#pragma omp parallel for schedule(dynamic)
+	for (index_t block = 0; block < num_blocks; ++block)
 	{
-		float64_t tmp_dot = dot(vec_idx1, i);
-		tmp_dot = post_dot(tmp_dot, i);
-		if (abs_val)
-			vec2[i] += Math::abs(alpha * tmp_dot);
+		int32_t begin = start + block * block_size;
+		int32_t end = std::min(begin + block_size, stop);
+		Map<VectorXd> out(output + begin - start, end - begin);
+
+		if (cache_features && cached_features.num_cols == get_num_vectors())
+		{
+			Map<MatrixXd> features(
+				cached_features.get_column_vector(begin), num_samples,
+				end - begin);
+			out.noalias() = features.transpose() * w;
+		}
 		else
-			vec2[i] += alpha * tmp_dot;
+		{
+			auto features = compute_random_features(begin, end);
+			out.noalias() = Map<MatrixXd>(
+				features.matrix, num_samples, end - begin).transpose() * w;
+		}
+
+		if (alphas)
+			out.array() *= Map<ArrayXd>(alphas + begin - start, end - begin);
+		out.array() += b;
+		pb.print_progress();
 	}
-	SG_TRACE("Leaving add_to_dense()");
+	pb.complete();
 }
 
 int32_t RandomKitchenSinksDotFeatures::get_nnz_features_for_vector(int32_t num) const
@@ -193,10 +236,116 @@ SGMatrix<float64_t> RandomKitchenSinksDotFeatures::get_random_coefficients()
 	return random_coeff;
 }
 
-float64_t RandomKitchenSinksDotFeatures::dot(index_t vec_idx, index_t par_idx) const
+SGMatrix<float64_t> RandomKitchenSinksDotFeatures::compute_random_features(
+	int32_t start, int32_t stop) const
+{
+	ASSERT(start >= 0 && start <= stop && stop <= get_num_vectors())
+
+	auto features = compute_projections(start, stop);
+	for (index_t i=0; i<features.num_cols; i++)
+	{
+		for (index_t j=0; j<num_samples; j++)
+			features(j, i) = post_dot(features(j, i), j);
+	}
+	return features;
+}
+
+void RandomKitchenSinksDotFeatures::set_cache_features(bool cache)
+{
+	cache_features = cache;
+	cached_features = SGMatrix<float64_t>();
+	if (!cache)
+		return;
+
+	int32_t num_vectors = get_num_vectors();
+	cached_features = SGMatrix<float64_t>(num_samples, num_vectors);
+	index_t num_blocks = (num_vectors + block_size - 1) / block_size;
+
+	#pragma omp parallel for schedule(dynamic)
+	for (index_t block = 0; block < num_blocks; ++block)
+	{
+		int32_t begin = block * block_size;
+		int32_t end = std::min(begin + block_size, num_vectors);
+		auto features = compute_random_features(begin, end);
+		std::copy_n(features.matrix, features.num_rows * features.num_cols,
+			cached_features.get_column_vector(begin));
+	}
+}
+
+bool RandomKitchenSinksDotFeatures::get_cache_features() const
+{
+	return cache_features;
+}
+
+SGVector<float64_t> RandomKitchenSinksDotFeatures::get_random_feature_vector(
+	int32_t vec_idx) const
+{
+	if (cache_features && cached_features.num_cols == get_num_vectors())
+	{
+		return SGVector<float64_t>(
+			cached_features.get_column_vector(vec_idx), num_samples, false);
+	}
+
+	return compute_random_features(vec_idx, vec_idx + 1).get_column(0).clone();
+}
+
+SGMatrix<float64_t> RandomKitchenSinksDotFeatures::compute_projections(
+	int32_t start, int32_t stop) const
+{
+	int32_t dim = feats->get_dim_feature_space();
+	int32_t num = stop - start;
+	SGMatrix<float64_t> projections(num_samples, num);
+	Map<MatrixXd> map_projections(projections.matrix, num_samples, num);
+
+	// the parameter vectors may have additional entries after the first dim
+	Map<MatrixXd, 0, OuterStride<>> W(random_coeff.matrix, dim, num_samples,
+		OuterStride<>(random_coeff.num_rows));
+
+	auto sparse = std::dynamic_pointer_cast<SparseFeatures<float64_t>>(feats);
+	if (sparse)
+	{
+		map_projections.setZero();
+		for (index_t i=0; i<num; i++)
+		{
+			auto sv = sparse->get_sparse_feature_vector(start + i);
+			for (index_t k=0; k<sv.num_feat_entries; k++)
+			{
+				map_projections.col(i) += sv.features[k].entry *
+					W.row(sv.features[k].feat_index).transpose();
+			}
+			sparse->free_sparse_feature_vector(start + i);
+		}
+	}
+	else
+	{
+		auto X = get_input_vectors(start, stop);
+		map_projections.noalias() =
+			W.transpose() * Map<MatrixXd>(X.matrix, dim, num);
+	}
+	return projections;
+}
+
+SGMatrix<float64_t> RandomKitchenSinksDotFeatures::get_input_vectors(
+	int32_t start, int32_t stop) const
 {
-	auto vec2 = random_coeff.get_column(par_idx).slice(0, feats->get_dim_feature_space());
-	return feats->dot(vec_idx, vec2);
+	int32_t dim = feats->get_dim_feature_space();
+	SGMatrix<float64_t> X(dim, stop - start);
+
+	auto dense = std::dynamic_pointer_cast<DenseFeatures<float64_t>>(feats);
+	for (index_t i=0; i<X.num_cols; i++)
+	{
+		if (dense)
+		{
+			auto vec = dense->get_feature_vector(start + i);
+			std::copy_n(vec.vector, dim, X.get_column_vector(i));
+		}
+		else
+		{
+			std::fill_n(X.get_column_vector(i), dim, 0.0);
+			feats->add_to_dense_vec(1.0, start + i, X.get_column_vector(i), dim);
+		}
+	}
+	return X;
 }
 
 float64_t RandomKitchenSinksDotFeatures::post_dot(float64_t dot_result, index_t par_idx) const
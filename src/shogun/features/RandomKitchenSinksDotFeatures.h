@@ -40,6 +40,14 @@ namespace shogun
  * instantiated object of that class to the constructor. For example, in the derived class CRandomFourierDotFeatures,
  * random fourier features are implemented as \f$ z(x) = \sqrt{2/K}\cos(w^{\top}x + b)\f$, where \f$w\f$ drawn from a Gaussian distribution and \f$b\f$ from a uniform distribution.
  *
+ * The transformation of a vector computes the products with all \f$w_k\f$ at
+ * once, and compute_random_features() and dense_dot_range() transform blocks
+ * of vectors with matrix products. Dense inputs are used directly, sparse
+ * inputs only touch the rows of the coefficients of their non-zero entries,
+ * and any other DotFeatures, e.g. hashed ones, are expanded densely through
+ * add_to_dense_vec(). With set_cache_features(), the transformed vectors are
+ * computed once and kept in memory.
+ *
  * Further useful resources, include :
  *	http://www.shloosl.com/~ali/random-features/
  *	https://research.microsoft.com/apps/video/dl.aspx?id=103390&l=i
@@ -126,6 +134,20 @@ public:
 	virtual void add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
 			float64_t* vec2, int32_t vec2_len, bool abs_val = false) const;
 
+	/** Compute the dot product for a range of vectors, transforming the
+	 * vectors in blocks
+	 *
+	 * @param output result for the given vector range
+	 * @param start start vector range from this idx
+	 * @param stop stop vector range at this idx
+	 * @param alphas scalars to multiply with, may be NULL
+	 * @param vec dense vector to compute dot product with
+	 * @param dim length of the dense vector
+	 * @param b bias
+	 */
+	virtual void dense_dot_range(float64_t* output, int32_t start, int32_t stop,
+			float64_t* alphas, float64_t* vec, int32_t dim, float64_t b) const;
+
 	/** get number of non-zero features in vector
 	 *
 	 * @param num which vector
@@ -199,17 +221,51 @@ public:
 	 */
 	SGMatrix<float64_t> get_random_coefficients();
 
+	/** computes the transformed vectors of a range of vectors
+	 *
+	 * @param start first vector
+	 * @param stop one past the last vector
+	 * @return transformed vectors, one per column
+	 */
+	SGMatrix<float64_t> compute_random_features(int32_t start, int32_t stop) const;
+
+	/** set whether the transformed vectors of all vectors are computed now
+	 * and kept in memory. The cache is not updated if the underlying
+	 * features change.
+	 *
+	 * @param cache whether to cache
+	 */
+	void set_cache_features(bool cache);
+
+	/** @return whether the transformed vectors are cached */
+	bool get_cache_features() const;
+
 	/** @return object name */
 	const char* get_name() const;
 
 protected:
-	/** Method used before computing the dot product between
-	 * a feature vector and a parameter vector
+	/** computes the dot products of a range of vectors with all parameter
+	 * vectors, before post_dot() is applied
 	 *
-	 * @param vec_idx the feature vector index
-	 * @param par_idx the parameter vector index
+	 * @param start first vector
+	 * @param stop one past the last vector
+	 * @return dot products, one column per vector
 	 */
-	virtual float64_t dot(index_t vec_idx, index_t par_idx) const;
+	virtual SGMatrix<float64_t> compute_projections(int32_t start, int32_t stop) const;
+
+	/** expands a range of vectors of the underlying features densely
+	 *
+	 * @param start first vector
+	 * @param stop one past the last vector
+	 * @return vectors, one per column
+	 */
+	SGMatrix<float64_t> get_input_vectors(int32_t start, int32_t stop) const;
+
+	/** @return the transformed vector, read from the cache if there is one
+	 *
+	 * @param vec_idx index of the vector
+	 */
+	SGVector<float64_t> get_random_feature_vector(int32_t vec_idx) const;
 
 	/** subclass must override this to perform any operations
 	 * on the dot result between a feature vector and a parameter vector w
@@ -238,6 +294,12 @@ protected:
 
 	/** random coefficients of the function phi, drawn from p */
 	SGMatrix<float64_t> random_coeff;
+
+	/** whether the transformed vectors are cached */
+	bool cache_features;
+
+	/** transformed vectors of all vectors, one per column */
+	SGMatrix<float64_t> cached_features;
 };
 }
 
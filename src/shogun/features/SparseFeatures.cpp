@@ -166,6 +166,15 @@ template<class ST> SGSparseVector<ST> SparseFeatures<ST>::get_sparse_feature_vec
 
 template<class ST> ST SparseFeatures<ST>::dense_dot(ST alpha, int32_t num, ST* vec, int32_t dim, ST b) const
 {
+	// the packed indices are below num_features, so none are skipped
+	if (sparse_feature_matrix.is_packed() && dim>=get_num_features())
+	{
+		ASSERT(vec)
+		index_t real_num=m_subset_stack->subset_idx_conversion(num);
+		return b+alpha*sparse_feature_matrix.template packed_dot<ST>(
+			real_num, vec);
+	}
+
 	SGSparseVector<ST> sv=get_sparse_feature_vector(num);
 	ST result = sv.dense_dot(alpha,vec,dim,b);
 	free_sparse_feature_vector(num);
@@ -180,6 +189,14 @@ template<class ST> void SparseFeatures<ST>::add_to_dense_vec(float64_t alpha, in
 		"add_to_dense_vec(num={},dim={}): dim should contain number of features {}",
 		num, dim, get_num_features());
 
+	if (sparse_feature_matrix.is_packed())
+	{
+		index_t real_num=m_subset_stack->subset_idx_conversion(num);
+		sparse_feature_matrix.packed_add_to_dense(real_num, alpha, vec,
+			abs_val);
+		return;
+	}
+
 	SGSparseVector<ST> sv=get_sparse_feature_vector(num);
 
 	if (sv.features)
@@ -250,6 +267,8 @@ template<class ST> void SparseFeatures<ST>::set_sparse_feature_matrix(SGSparseMa
 			"sparse_matrix[{}] check failed (matrix features {} >= vector dimension {})",
 			j, get_num_features(), sv.get_num_dimensions());
 	}
+
+	sparse_feature_matrix.pack();
 }
 
 template<class ST> SGMatrix<ST> SparseFeatures<ST>::get_full_feature_matrix()
@@ -461,20 +480,28 @@ SparseFeatures<ST>::dot(int32_t vec_idx1, const SGVector<float64_t>& vec2) const
 		"features {} {}",
 		vec_idx1, vec2.size(), get_num_features());
 
+	if (sparse_feature_matrix.is_packed())
+	{
+		index_t real_num=m_subset_stack->subset_idx_conversion(vec_idx1);
+		return sparse_feature_matrix.template packed_dot<float64_t>(
+			real_num, vec2.vector);
+	}
+
 	float64_t result=0;
 	SGSparseVector<ST> sv=get_sparse_feature_vector(vec_idx1);
 
 	if (sv.features)
 	{
-		require(get_num_features() >= sv.get_num_dimensions(),
+		int32_t num_dims=sv.get_num_dimensions();
+		require(get_num_features() >= num_dims,
 			"sparse_matrix[{}] check failed (matrix features {} >= vector dimension {})",
-			vec_idx1, get_num_features(), sv.get_num_dimensions());
+			vec_idx1, get_num_features(), num_dims);
 
 		require(
-			vec2.size() >= sv.get_num_dimensions(),
+			vec2.size() >= num_dims,
 			"sparse_matrix[{}] check failed (dense vector dimension {} >= "
 			"vector dimension {})",
-			vec_idx1, vec2.size(), sv.get_num_dimensions());
+			vec_idx1, vec2.size(), num_dims);
 
 		for (int32_t i=0; i<sv.num_feat_entries; i++)
 			result+=vec2[sv.features[i].feat_index]*sv.features[i].entry;
@@ -619,6 +646,7 @@ template<class ST> void SparseFeatures<ST>::load(std::shared_ptr<File> loader)
 	ASSERT(loader)
 	free_sparse_feature_matrix();
 	sparse_feature_matrix.load(loader);
+	sparse_feature_matrix.pack();
 }
 
 template<class ST> SGVector<float64_t> SparseFeatures<ST>::load_with_labels(std::shared_ptr<LibSVMFile> loader)
@@ -626,7 +654,9 @@ template<class ST> SGVector<float64_t> SparseFeatures<ST>::load_with_labels(std:
 	remove_all_subsets();
 	ASSERT(loader)
 	free_sparse_feature_matrix();
-	return sparse_feature_matrix.load_with_labels(loader);
+	auto labels=sparse_feature_matrix.load_with_labels(loader);
+	sparse_feature_matrix.pack();
+	return labels;
 }
 
 template<class ST> void SparseFeatures<ST>::save(std::shared_ptr<File> writer)
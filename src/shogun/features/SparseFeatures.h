@@ -31,7 +31,10 @@ template <class T> class Cache;
 /** @brief Template class SparseFeatures implements sparse matrices.
  *
  * Features are an array of SGSparseVector. Within each vector feat_index are
- * sorted (increasing).
+ * sorted (increasing). The matrix is packed into the compressed sparse row
+ * format (see SGSparseMatrix::pack()) when it is set or loaded, and
+ * dense_dot(), dot() with a dense vector and add_to_dense_vec() then gather
+ * from the arrays of indices and values instead of the vectors.
  *
  * Sparse feature vectors can be accessed via get_sparse_feature_vector() and
  * should be freed (this operation is a NOP in most cases) via
@@ -187,7 +190,9 @@ template <class ST> class SparseFeatures : public DotFeatures
 
 		/** get the sparse feature matrix
 		 *
-		 * not possible with subset
+		 * not possible with subset. Entries written through the vectors of
+		 * the returned matrix are only used by the dot products after
+		 * set_sparse_feature_matrix() packs it again.
 		 *
 		 * @return sparse matrix
 		 *
@@ -10,6 +10,7 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/CircularBuffer.h>
 #include <shogun/lib/Tokenizer.h>
+#include <shogun/lib/Tracer.h>
 #include <utility>
 
 using namespace shogun;
@@ -97,6 +98,7 @@ SGVector<char> LineReader::read_line()
 	{
 		m_buffer->skip_characters(bytes_to_skip);
 		line=read_token(m_next_token_length-bytes_to_skip);
+		SG_TRACE_COUNT("io_bytes_read", m_next_token_length);
 	}
 
 	return line;
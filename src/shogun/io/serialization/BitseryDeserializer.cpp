@@ -5,7 +5,9 @@
 
 #include <shogun/io/serialization/BitseryDeserializer.h>
 #include <shogun/io/serialization/BitseryVisitor.h>
+#include <shogun/io/MemoryMappedFile.h>
 #include <shogun/io/ShogunErrc.h>
+#include <shogun/io/stream/ByteArrayInputStream.h>
 #include <shogun/util/converters.h>
 #include <shogun/base/class_list.h>
 #include <shogun/util/system.h>
@@ -25,6 +27,26 @@ public:
 	BitseryReaderVisitor(S& s):
 		detail::BitseryVisitor<S,BitseryReaderVisitor<S>>(s) {}
 
+	BitseryReaderVisitor(S& s, char* data_section, int64_t data_size, shared_ptr<void> storage):
+		detail::BitseryVisitor<S,BitseryReaderVisitor<S>>(s),
+		m_data_section(data_section), m_data_size(data_size),
+		m_storage(std::move(storage)) {}
+
+	bool on_array(S& s, void** data, int64_t bytes, shared_ptr<void>* storage)
+	{
+		if (!m_storage || bytes < detail::kMinAlignedArrayBytes)
+			return false;
+
+		uint64_t offset;
+		s.value8b(offset);
+		require(static_cast<int64_t>(offset) + bytes <= m_data_size,
+			"Array at offset {} with {} bytes exceeds the data section of {} bytes",
+			offset, bytes, m_data_size);
+		*data = m_data_section + offset;
+		*storage = m_storage;
+		return true;
+	}
+
 	void on_complex(S& s, complex128_t* v)
 	{
 		float64_t real, imag;
@@ -56,6 +78,10 @@ public:
 	}
 
 private:
+	char* m_data_section = nullptr;
+	int64_t m_data_size = 0;
+	shared_ptr<void> m_storage;
+
 	SG_DELETE_COPY_AND_ASSIGN(BitseryReaderVisitor);
 };
 
@@ -172,3 +198,34 @@ void BitseryDeserializer::read(std::shared_ptr<SGObject> _this)
 	BitseryReaderVisitor<BitseryDeser> reader_visitor(deser);
 	object_reader(deser, addressof(reader_visitor), _this);
 }
+
+std::shared_ptr<SGObject> BitseryDeserializer::read_mapped(const std::string& path)
+{
+	auto file = make_shared<MemoryMappedFile<char>>(path.c_str());
+	auto size = static_cast<int64_t>(file->get_size());
+	require(size >= detail::kPageAlignedHeaderBytes,
+		"{} is too small to contain page aligned arrays", path);
+
+	uint64_t magic, metadata_size, data_offset, data_size;
+	{
+		InputStreamAdapter adapter { make_shared<ByteArrayInputStream>(
+			file->get_map(), detail::kPageAlignedHeaderBytes) };
+		BitseryDeser deser {std::move(adapter)};
+		deser.value8b(magic);
+		deser.value8b(metadata_size);
+		deser.value8b(data_offset);
+		deser.value8b(data_size);
+	}
+	require(magic == detail::kPageAlignedMagic,
+		"{} was not written with page aligned arrays", path);
+	require(data_offset >= detail::kPageAlignedHeaderBytes + metadata_size &&
+		static_cast<int64_t>(data_offset + data_size) <= size,
+		"{} is truncated", path);
+
+	InputStreamAdapter adapter { make_shared<ByteArrayInputStream>(
+		file->get_map() + detail::kPageAlignedHeaderBytes, metadata_size) };
+	BitseryDeser deser {std::move(adapter)};
+	BitseryReaderVisitor<BitseryDeser> reader_visitor(
+		deser, file->get_map() + data_offset, data_size, file);
+	return object_reader(deser, addressof(reader_visitor));
+}
@@ -19,6 +19,18 @@ namespace shogun
 			std::shared_ptr<SGObject> read_object() override;
 			void read(std::shared_ptr<SGObject> _this) override;
 
+			/** Memory maps a file written by a BitserySerializer with page
+			 * aligned arrays and deserializes the object stored in it.
+			 * Only the object metadata is parsed, the large arrays become
+			 * read-only views into the mapping which is shared between all
+			 * processes loading the same file. The mapping stays alive as
+			 * long as any of these arrays is referenced.
+			 *
+			 * @param path file to load
+			 * @return the deserialized object
+			 */
+			std::shared_ptr<SGObject> read_mapped(const std::string& path);
+
 			const char* get_name() const override
 			{
 				return "BitseryDeserializer";
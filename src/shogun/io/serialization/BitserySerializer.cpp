@@ -6,6 +6,7 @@
 #include <shogun/io/serialization/BitserySerializer.h>
 #include <shogun/io/serialization/BitseryVisitor.h>
 #include <shogun/io/ShogunErrc.h>
+#include <shogun/io/stream/ByteArrayOutputStream.h>
 #include <shogun/util/converters.h>
 #include <shogun/util/system.h>
 
@@ -17,12 +18,40 @@ using namespace shogun;
 using namespace shogun::io;
 using namespace std;
 
+// arrays that are written to the data section of page aligned files
+struct DataSection
+{
+	struct Block
+	{
+		const void* data;
+		int64_t bytes;
+		int64_t offset;
+	};
+
+	vector<Block> blocks;
+	int64_t size = 0;
+};
+
 template<class Writer>
 class BitseryWriterVisitor : public detail::BitseryVisitor<Writer, BitseryWriterVisitor<Writer>>
 {
 public:
-	BitseryWriterVisitor(Writer& w):
-		detail::BitseryVisitor<Writer,BitseryWriterVisitor<Writer>>(w) {}
+	BitseryWriterVisitor(Writer& w, DataSection* data_section = nullptr):
+		detail::BitseryVisitor<Writer,BitseryWriterVisitor<Writer>>(w),
+		m_data_section(data_section) {}
+
+	bool on_array(Writer& writer, void** data, int64_t bytes, shared_ptr<void>* storage)
+	{
+		if (!m_data_section || bytes < detail::kMinAlignedArrayBytes)
+			return false;
+
+		// only the offset goes to the metadata, the shape is already there
+		auto offset = detail::align_array_offset(m_data_section->size);
+		m_data_section->blocks.push_back({*data, bytes, offset});
+		m_data_section->size = offset + bytes;
+		writer.value8b(static_cast<uint64_t>(offset));
+		return true;
+	}
 
 	void on_complex(Writer& writer, complex128_t* v)
 	{
@@ -68,6 +97,9 @@ public:
 			writer.value8b(detail::kNullObjectMagic);
 		}
 	}
+
+private:
+	DataSection* m_data_section;
 };
 
 struct OutputStreamAdapter
@@ -135,8 +167,54 @@ BitserySerializer::~BitserySerializer()
 
 void BitserySerializer::write(const shared_ptr<SGObject>& object) noexcept(false)
 {
-	OutputStreamAdapter adapter { stream() };
- 	BitserySer serializer {std::move(adapter)};
- 	BitseryWriterVisitor<BitserySer> writer_visitor(serializer);
- 	write_object(serializer, addressof(writer_visitor), object);
+	if (!m_page_aligned_arrays)
+	{
+		OutputStreamAdapter adapter { stream() };
+		BitserySer serializer {std::move(adapter)};
+		BitseryWriterVisitor<BitserySer> writer_visitor(serializer);
+		write_object(serializer, addressof(writer_visitor), object);
+		return;
+	}
+
+	// serialize the metadata first to learn the layout of the data section
+	auto metadata = make_shared<ByteArrayOutputStream>();
+	DataSection data_section;
+	{
+		OutputStreamAdapter adapter { metadata };
+		BitserySer serializer {std::move(adapter)};
+		BitseryWriterVisitor<BitserySer> writer_visitor(serializer, addressof(data_section));
+		write_object(serializer, addressof(writer_visitor), object);
+	}
+	auto content = metadata->content();
+	int64_t data_offset = detail::align_array_offset(
+		detail::kPageAlignedHeaderBytes + content.size());
+
+	// header | metadata | padding | page aligned arrays
+	{
+		OutputStreamAdapter adapter { stream() };
+		BitserySer serializer {std::move(adapter)};
+		serializer.value8b(detail::kPageAlignedMagic);
+		serializer.value8b(static_cast<uint64_t>(content.size()));
+		serializer.value8b(static_cast<uint64_t>(data_offset));
+		serializer.value8b(static_cast<uint64_t>(data_section.size));
+	}
+
+	auto write_checked = [this](const void* buffer, int64_t size) {
+		auto ec = stream()->write(buffer, size);
+		if (ec)
+			throw io::to_system_error(ec);
+	};
+	const vector<char> padding(detail::kArrayAlignment, 0);
+	write_checked(content.data(), content.size());
+	write_checked(padding.data(),
+		data_offset - detail::kPageAlignedHeaderBytes - content.size());
+
+	int64_t position = 0;
+	for (const auto& block: data_section.blocks)
+	{
+		write_checked(padding.data(), block.offset - position);
+		write_checked(block.data, block.bytes);
+		position = block.offset + block.bytes;
+	}
+	stream()->flush();
 }
@@ -18,10 +18,32 @@ namespace shogun
 			~BitserySerializer() override;
 			virtual void write(const std::shared_ptr<SGObject>& object) noexcept(false);
 
+			/** Enables writing large numeric arrays (SGVector, SGMatrix)
+			 * page aligned into a data section behind the object metadata
+			 * instead of inline. Such files can be loaded without copying
+			 * the arrays by BitseryDeserializer::read_mapped().
+			 * Arrays are stored in native byte order.
+			 *
+			 * @param page_aligned whether to use the page aligned layout
+			 */
+			void set_page_aligned_arrays(bool page_aligned)
+			{
+				m_page_aligned_arrays = page_aligned;
+			}
+
+			/** @return whether arrays are written page aligned */
+			bool get_page_aligned_arrays() const
+			{
+				return m_page_aligned_arrays;
+			}
+
 			virtual const char* get_name() const
 			{
 				return "BitserySerializer";
 			}
+
+		private:
+			bool m_page_aligned_arrays = false;
 		};
 	}
 }
@@ -15,6 +15,20 @@ namespace shogun
 		namespace detail
 		{
 			static const size_t kNullObjectMagic = std::numeric_limits<size_t>::max();
+			/** marks files written with page aligned arrays ("SGALIGND") */
+			static const uint64_t kPageAlignedMagic = 0x444e47494c414753;
+			/** size of the header of files written with page aligned arrays */
+			static const int64_t kPageAlignedHeaderBytes = 4 * sizeof(uint64_t);
+			/** alignment of arrays in the data section */
+			static const int64_t kArrayAlignment = 4096;
+			/** smaller arrays are stored inline with their object */
+			static const int64_t kMinAlignedArrayBytes = 4096;
+
+			inline int64_t align_array_offset(int64_t offset)
+			{
+				return (offset + kArrayAlignment - 1) / kArrayAlignment *
+				       kArrayAlignment;
+			}
 
 			template <class S, class T>
 			class BitseryVisitor : public AnyVisitor
@@ -109,6 +123,13 @@ namespace shogun
 				{
 					static_cast<T*>(this)->on_object(m_s, v);
 				}
+				bool on_contiguous(
+				    void** data, int64_t bytes,
+				    std::shared_ptr<void>* storage) override
+				{
+					return static_cast<T*>(this)->on_array(
+					    m_s, data, bytes, storage);
+				}
 
 				void enter_matrix_row(index_t *rows, index_t *cols) override {}
 				void exit_matrix_row(index_t *rows, index_t *cols) override {}
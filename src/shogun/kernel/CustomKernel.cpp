@@ -133,7 +133,13 @@ bool CustomKernel::init(std::shared_ptr<Features> l, std::shared_ptr<Features> r
 		add_row_subset(l_idx->get_feature_index());
 		add_col_subset(r_idx->get_feature_index());
 
-		lhs_equals_rhs=m_is_symmetric;
+		/* keep the index features as lhs and rhs, so that a machine
+		 * trained on them can re-init the kernel with its lhs and other
+		 * index features when applied */
+		lhs=l;
+		rhs=r;
+
+		lhs_equals_rhs=m_is_symmetric && l==r;
 
 		return true;
 	}
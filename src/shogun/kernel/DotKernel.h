@@ -63,21 +63,9 @@ class DotKernel : public Kernel
 			Kernel::init(l,r);
 			init_auto_params();
 
+			// the feature classes and types are checked by Kernel::init
 			ASSERT(l->has_property(FP_DOT))
 			ASSERT(r->has_property(FP_DOT))
-			ASSERT(l->get_feature_type() == r->get_feature_type());
-			if (l->support_compatible_class())
-			{
-				require(l->get_feature_class_compatibility(r->get_feature_class()),
-					"Right hand side of features ({}) must be compatible with left hand side features ({})",
-					l->get_name(), r->get_name());
-			}
-			else
-			{
-				require(l->get_feature_class()==r->get_feature_class(),
-					"Right hand side of features ({}) must be compatible with left hand side features ({})",
-					l->get_name(), r->get_name());
-			}
 
 			if ( (std::static_pointer_cast<DotFeatures>(l))->get_dim_feature_space() != (std::static_pointer_cast<DotFeatures>(r))->get_dim_feature_space() )
 			{
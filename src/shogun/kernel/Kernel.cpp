@@ -89,13 +89,25 @@ void Kernel::resize_kernel_cache(KERNELCACHE_IDX size, bool regression_hack)
 }
 #endif //USE_SVMLIGHT
 
-bool Kernel::init(std::shared_ptr<Features> l, std::shared_ptr<Features> r)
+size_t Kernel::hyperparameter_hash() const
 {
-	//make sure features were indeed supplied
-	require(l, "Kernel::init({}, {}): Left hand side features required!", fmt::ptr(l.get()), fmt::ptr(r.get()));
-	require(r, "Kernel::init({}, {}): Right hand side features required!", fmt::ptr(l.get()), fmt::ptr(r.get()));
+	// only hyperparameters define the kernel function, the other parameters
+	// are state (features, cache, ...)
+	size_t hash = std::hash<std::string>{}(get_name());
+	for (const auto& param : get_params())
+	{
+		if (!param.second->get_properties().has_property(
+		        ParameterProperties::HYPER))
+			continue;
+		const auto& value = param.second->get_value();
+		if (value.hashable())
+			hash ^= value.hash() + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	}
+	return hash;
+}
 
-	//make sure features are compatible
+bool Kernel::check_compatibility(std::shared_ptr<Features> l, std::shared_ptr<Features> r)
+{
 	if (l->support_compatible_class())
 	{
 		require(l->get_feature_class_compatibility(r->get_feature_class()),
@@ -110,6 +122,18 @@ bool Kernel::init(std::shared_ptr<Features> l, std::shared_ptr<Features> r)
 	}
 	ASSERT(l->get_feature_type()==r->get_feature_type())
 
+	return true;
+}
+
+bool Kernel::init(std::shared_ptr<Features> l, std::shared_ptr<Features> r)
+{
+	//make sure features were indeed supplied
+	require(l, "Kernel::init({}, {}): Left hand side features required!", fmt::ptr(l.get()), fmt::ptr(r.get()));
+	require(r, "Kernel::init({}, {}): Right hand side features required!", fmt::ptr(l.get()), fmt::ptr(r.get()));
+
+	//make sure features are compatible
+	require(check_compatibility(l, r), "Features are not compatible!");
+
 	//remove references to previous features
 	remove_lhs_and_rhs();
 
@@ -295,6 +319,7 @@ void Kernel::cache_kernel_row(int32_t m)
 
 	if(!kernel_cache_check(m))   // not cached yet
 	{
+		SG_TRACE_COUNT("kernel_cache_misses", 1);
 		cache = kernel_cache_clean_and_malloc(m);
 		if(cache) {
 			l=kernel_cache.totdoc2active[m];
@@ -1309,6 +1334,7 @@ SGMatrix<T> Kernel::get_kernel_matrix()
 	T* result = NULL;
 
 	require(has_features(), "no features assigned to kernel");
+	SG_TRACE_SCOPE("Kernel::get_kernel_matrix", "kernel");
 
 	int32_t m=get_num_vec_lhs();
 	int32_t n=get_num_vec_rhs();
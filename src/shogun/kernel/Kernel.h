@@ -20,6 +20,7 @@
 #include <shogun/features/FeatureTypes.h>
 #include <shogun/base/SGObject.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/Tracer.h>
 #include <shogun/features/Features.h>
 #include <shogun/kernel/normalizer/KernelNormalizer.h>
 
@@ -203,6 +204,7 @@ class Kernel : public SGObject
 				"{}::kernel(): index out of Range: idx_a={}/{} idx_b={}/{}",
 				get_name(), idx_a,num_lhs, idx_b,num_rhs);
 
+			SG_TRACE_COUNT("kernel_evaluations", 1);
 			return normalizer->normalize(compute(idx_a, idx_b), idx_a, idx_b);
 		}
 
@@ -442,6 +444,14 @@ class Kernel : public SGObject
 		 */
 		template <class T> SGMatrix<T> get_kernel_matrix();
 
+		/** Hash of the hyperparameters of the kernel. Two kernels of the
+		 * same class and hash compute the same kernel function, e.g. their
+		 * kernel matrices on the same features can be shared.
+		 *
+		 * @return hash of the kernel name and its HYPER parameters
+		 */
+		size_t hyperparameter_hash() const;
+
 		/** initialize kernel
 		 *  e.g. setup lhs/rhs of kernel, precompute normalization
 		 *  constants etc.
@@ -874,6 +884,15 @@ class Kernel : public SGObject
 		 */
 		static std::shared_ptr<Kernel> obtain_from_generic(const std::shared_ptr<SGObject>& kernel);
 	protected:
+		/** Checks the compatibility between two supplied features, which
+		 * have to be of compatible classes and of the same type
+		 *
+		 * @param l left hand side features
+		 * @param r right hand side features
+		 * @return true if the features are compatible
+		 */
+		virtual bool check_compatibility(std::shared_ptr<Features> l, std::shared_ptr<Features> r);
+
 		/** set property
 		 *
 		 * @param p kernel property to set
@@ -37,6 +37,20 @@ bool LinearKernel::init(std::shared_ptr<Features> l, std::shared_ptr<Features> r
 	return init_normalizer();
 }
 
+bool LinearKernel::check_compatibility(std::shared_ptr<Features> l, std::shared_ptr<Features> r)
+{
+	auto is_dense_real=[](const std::shared_ptr<Features>& f)
+	{
+		return f->get_feature_class()==C_DENSE &&
+			(f->get_feature_type()==F_DREAL || f->get_feature_type()==F_SHORTREAL);
+	};
+
+	if (l->get_feature_type()!=r->get_feature_type() && is_dense_real(l) && is_dense_real(r))
+		return true;
+
+	return DotKernel::check_compatibility(l, r);
+}
+
 void LinearKernel::cleanup()
 {
 	delete_optimization();
@@ -26,6 +26,9 @@ namespace shogun
  * \f[
  * k({\bf x},{\bf x'})= {\bf x}\cdot {\bf x'}
  * \f]
+ *
+ * Dense float32 features may be paired with dense float64 features, the
+ * products are accumulated in float64 by DotFeatures::dot().
  */
 class LinearKernel: public DotKernel
 {
@@ -130,6 +133,16 @@ class LinearKernel: public DotKernel
 		}
 
 	protected:
+		/** Checks the compatibility between two supplied features. In
+		 * addition to features of the same type, dense float32 features may
+		 * be paired with dense float64 features
+		 *
+		 * @param l left hand side features
+		 * @param r right hand side features
+		 * @return true if the features are compatible
+		 */
+		virtual bool check_compatibility(std::shared_ptr<Features> l, std::shared_ptr<Features> r);
+
 		/** normal vector (used in case of optimized kernel) */
 		SGVector<float64_t> normal;
 };
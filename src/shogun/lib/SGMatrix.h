@@ -62,6 +62,13 @@ template<class T> class SGMatrix : public SGReferencedData
 		/** Wraps a matrix around an existing memory segment with an offset */
 		SGMatrix(T* m, index_t nrows, index_t ncols, index_t offset);
 
+		/** Wraps a matrix around memory owned by storage, e.g. a memory
+		 * mapped file. Copies of the matrix share a reference count and keep
+		 * storage alive, the memory itself is never freed.
+		 */
+		SGMatrix(
+			T* m, index_t nrows, index_t ncols, std::shared_ptr<void> storage);
+
 		/** Constructor to create new matrix in memory */
 		SGMatrix(index_t nrows, index_t ncols, bool ref_counting=true);
 
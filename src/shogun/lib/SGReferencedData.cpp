@@ -18,13 +18,21 @@ SGReferencedData::SGReferencedData(bool ref_counting) : m_refcount(NULL)
 	ref();
 }
 
+SGReferencedData::SGReferencedData(std::shared_ptr<void> storage)
+	: m_refcount(new RefCount(0)), m_storage(std::move(storage))
+{
+	ref();
+}
+
 SGReferencedData::SGReferencedData(const SGReferencedData &orig)
 {
 	copy_refcount(orig);
 	ref();
 }
 
-SGReferencedData::SGReferencedData(SGReferencedData&& orig) noexcept: m_refcount{std::exchange(orig.m_refcount, nullptr)}
+SGReferencedData::SGReferencedData(SGReferencedData&& orig) noexcept
+	: m_refcount{std::exchange(orig.m_refcount, nullptr)},
+	  m_storage{std::move(orig.m_storage)}
 {
 }
 
@@ -60,6 +68,7 @@ int32_t SGReferencedData::ref_count()
 void SGReferencedData::copy_refcount(const SGReferencedData &orig)
 {
 	m_refcount =  orig.m_refcount;
+	m_storage = orig.m_storage;
 }
 
 /** increase reference counter
@@ -98,9 +107,14 @@ int32_t SGReferencedData::unref()
 	if (c<=0)
 	{
 		SG_TRACE("unref() refcount {} data {} destroying", c, fmt::ptr(this));
-		free_data();
+		// memory owned by m_storage is released together with it
+		if (m_storage)
+			init_data();
+		else
+			free_data();
 		delete m_refcount;
 		m_refcount=NULL;
+		m_storage.reset();
 		return 0;
 	}
 	else
@@ -108,6 +122,7 @@ int32_t SGReferencedData::unref()
 		SG_TRACE("unref() refcount {} data {} decreased", c, fmt::ptr(this));
 		init_data();
 		m_refcount=NULL;
+		m_storage.reset();
 		return c;
 	}
 }
@@ -11,6 +11,8 @@
 
 #include <shogun/lib/common.h>
 
+#include <memory>
+
 namespace shogun
 {
 class RefCount;
@@ -22,6 +24,15 @@ class SGReferencedData
 		/** default constructor */
 		SGReferencedData(bool ref_counting=true);
 
+		/** constructor for reference counted views into memory that is
+		 * owned by another object (e.g. a memory mapped file).
+		 * The data is not freed when the last reference is dropped,
+		 * instead the owner is released.
+		 *
+		 * @param storage owner of the referenced memory
+		 */
+		SGReferencedData(std::shared_ptr<void> storage);
+
 		/** copy constructor */
 		SGReferencedData(const SGReferencedData &orig);
 
@@ -61,6 +72,14 @@ class SGReferencedData
 		 */
 		int32_t unref();
 
+		/** @return whether the data is owned by a storage, i.e. must not
+		 * be freed nor resized
+		 */
+		bool has_storage() const
+		{
+			return m_storage != nullptr;
+		}
+
 		/** needs to be overridden to copy data */
 		virtual void copy_data(const SGReferencedData &orig)=0;
 
@@ -74,6 +93,9 @@ class SGReferencedData
 
 		/** reference counter */
 		RefCount* m_refcount;
+
+		/** owner of the data if it was not allocated by us */
+		std::shared_ptr<void> m_storage;
 };
 }
 #endif // __SGREFERENCED_DATA_H__
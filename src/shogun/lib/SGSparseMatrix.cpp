@@ -2,10 +2,15 @@
 #include <shogun/io/File.h>
 #include <shogun/io/LibSVMFile.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/mathematics/Math.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGSparseMatrix.h>
 #include <shogun/lib/SGSparseVector.h>
 
+#include <memory>
+#include <numeric>
+#include <vector>
+
 namespace shogun {
 
 template <class T>
@@ -37,6 +42,35 @@ SGSparseMatrix<T>::SGSparseMatrix(SGMatrix<T> dense) : SGReferencedData()
 	from_dense(dense);
 }
 
+template <class T>
+SGSparseMatrix<T>::SGSparseMatrix(SGVector<int64_t> indptr,
+		SGVector<index_t> indices, SGVector<T> values, index_t num_feat) :
+	SGReferencedData(), num_vectors(indptr.vlen-1), num_features(num_feat)
+{
+	require(indptr.vlen>0, "indptr should have num_vectors+1 entries!");
+	require(indptr[0]==0 && indptr[num_vectors]==indices.vlen &&
+		indices.vlen==values.vlen,
+		"indptr ({} entries) does not match indices ({}) and values ({})",
+		indptr[num_vectors], indices.vlen, values.vlen);
+
+	for (index_t i=0; i<num_vectors; i++)
+	{
+		for (int64_t k=indptr[i]; k<indptr[i+1]; k++)
+		{
+			require(indices[k]>=0 && indices[k]<num_features,
+				"Feature index {} of vector {} exceeds [0;{}]",
+				indices[k], i, num_features-1);
+		}
+	}
+
+	sparse_matrix=SG_MALLOC(SGSparseVector<T>, num_vectors);
+	allocate_packed(indptr.clone());
+	sg_memcpy(m_packed->indices.vector, indices.vector,
+		sizeof(index_t)*indices.vlen);
+	sg_memcpy(m_packed->values.vector, values.vector, sizeof(T)*values.vlen);
+	update_packed_vectors();
+}
+
 template <class T>
 SGSparseMatrix<T>::SGSparseMatrix(const SGSparseMatrix &orig) : SGReferencedData(orig)
 {
@@ -97,6 +131,7 @@ void SGSparseMatrix<T>::load(const std::shared_ptr<File>& loader)
 	SG_SET_LOCALE_C;
 	loader->get_sparse_matrix(sparse_matrix, num_features, num_vectors);
 	SG_RESET_LOCALE;
+	m_packed=nullptr;
 }
 
 template<>
@@ -112,6 +147,7 @@ template<class T> SGVector<float64_t> SGSparseMatrix<T>::load_with_labels(const
 	float64_t* raw_labels;
 	file->get_sparse_matrix(sparse_matrix, num_features, num_vectors,
 					raw_labels, true);
+	m_packed=nullptr;
 
 	SGVector<float64_t> labels(raw_labels, num_vectors);
 
@@ -162,6 +198,7 @@ void SGSparseMatrix<T>::copy_data(const SGReferencedData& orig)
 	sparse_matrix = ((SGSparseMatrix*)(&orig))->sparse_matrix;
 	num_vectors = ((SGSparseMatrix*)(&orig))->num_vectors;
 	num_features = ((SGSparseMatrix*)(&orig))->num_features;
+	m_packed = ((SGSparseMatrix*)(&orig))->m_packed;
 }
 
 template <class T>
@@ -170,6 +207,7 @@ void SGSparseMatrix<T>::init_data()
 	sparse_matrix = NULL;
 	num_vectors = 0;
 	num_features = 0;
+	m_packed = nullptr;
 }
 
 template <class T>
@@ -178,13 +216,142 @@ void SGSparseMatrix<T>::free_data()
 	SG_FREE(sparse_matrix);
 	num_vectors = 0;
 	num_features = 0;
+	m_packed = nullptr;
+}
+
+template <class T>
+SGSparseMatrix<T>::PackedStorage::~PackedStorage()
+{
+	SG_FREE(entries);
+}
+
+template <class T>
+void SGSparseMatrix<T>::allocate_packed(SGVector<int64_t> indptr)
+{
+	const int64_t num_entries=indptr[num_vectors];
+	auto storage=std::make_shared<PackedStorage>();
+	storage->vectors=sparse_matrix;
+	storage->indptr=indptr;
+	storage->indices=SGVector<index_t>(num_entries);
+	storage->values=SGVector<T>(num_entries);
+	storage->entries=SG_MALLOC(SGSparseVectorEntry<T>, num_entries);
+
+	for (index_t i=0; i<num_vectors; i++)
+	{
+		sparse_matrix[i]=SGSparseVector<T>(storage->entries+indptr[i],
+			indptr[i+1]-indptr[i], storage);
+	}
+
+	// copies that still refer to the old arrays use their vectors
+	unpack();
+	m_packed=storage;
+}
+
+template <class T>
+void SGSparseMatrix<T>::update_packed_vectors()
+{
+	const int64_t num_entries=m_packed->indptr[num_vectors];
+	const index_t* indices=m_packed->indices.vector;
+	const T* values=m_packed->values.vector;
+	SGSparseVectorEntry<T>* entries=m_packed->entries;
+
+	#pragma omp parallel for schedule(static, 4096)
+	for (int64_t k=0; k<num_entries; k++)
+	{
+		entries[k].feat_index=indices[k];
+		entries[k].entry=values[k];
+	}
+}
+
+template <class T>
+void SGSparseMatrix<T>::unpack()
+{
+	if (!m_packed)
+		return;
+
+	// the entries stay alive for the vectors that point to them
+	m_packed->vectors=nullptr;
+	m_packed->indptr=SGVector<int64_t>();
+	m_packed->indices=SGVector<index_t>();
+	m_packed->values=SGVector<T>();
+	m_packed=nullptr;
+}
+
+template <class T>
+void SGSparseMatrix<T>::pack()
+{
+	if (!sparse_matrix)
+		return;
+
+	SGVector<int64_t> indptr(num_vectors+1);
+	indptr[0]=0;
+	for (index_t i=0; i<num_vectors; i++)
+		indptr[i+1]=indptr[i]+sparse_matrix[i].num_feat_entries;
+
+	// the old vectors stay alive until their entries are copied
+	std::vector<SGSparseVector<T>> unpacked(sparse_matrix,
+		sparse_matrix+num_vectors);
+	allocate_packed(indptr);
+
+	index_t* indices=m_packed->indices.vector;
+	T* values=m_packed->values.vector;
+	index_t max_index=-1;
+	#pragma omp parallel for schedule(static, 256) reduction(max:max_index)
+	for (index_t i=0; i<num_vectors; i++)
+	{
+		const SGSparseVector<T>& vec=unpacked[i];
+		for (index_t j=0; j<vec.num_feat_entries; j++)
+		{
+			indices[indptr[i]+j]=vec.features[j].feat_index;
+			values[indptr[i]+j]=vec.features[j].entry;
+			max_index=Math::max(max_index, vec.features[j].feat_index);
+		}
+	}
+	update_packed_vectors();
+
+	require(max_index<num_features,
+		"Feature index {} exceeds the number of features {}",
+		max_index, num_features);
+}
+
+template <class T>
+void SGSparseMatrix<T>::get_csr(SGVector<int64_t>& indptr,
+		SGVector<index_t>& indices, SGVector<T>& values) const
+{
+	if (is_packed())
+	{
+		indptr=m_packed->indptr;
+		indices=m_packed->indices;
+		values=m_packed->values;
+		return;
+	}
+
+	indptr=SGVector<int64_t>(num_vectors+1);
+	indptr[0]=0;
+	for (index_t i=0; i<num_vectors; i++)
+		indptr[i+1]=indptr[i]+sparse_matrix[i].num_feat_entries;
+
+	indices=SGVector<index_t>(indptr[num_vectors]);
+	values=SGVector<T>(indptr[num_vectors]);
+
+	#pragma omp parallel for schedule(static, 256)
+	for (index_t i=0; i<num_vectors; i++)
+	{
+		const SGSparseVector<T>& vec=sparse_matrix[i];
+		for (index_t j=0; j<vec.num_feat_entries; j++)
+		{
+			indices[indptr[i]+j]=vec.features[j].feat_index;
+			values[indptr[i]+j]=vec.features[j].entry;
+		}
+	}
 }
 
 template<class T> SGSparseMatrix<T> SGSparseMatrix<T>::get_transposed()
 {
 	SGSparseMatrix<T> sfm(num_vectors, num_features);
 
-	int32_t* hist=SG_CALLOC(int32_t, num_features);
+	SGVector<int64_t> offsets(num_features+1);
+	offsets.zero();
 
 	// count the lengths of future feature vectors
 	for (int32_t v=0; v<num_vectors; v++)
@@ -192,14 +359,14 @@ template<class T> SGSparseMatrix<T> SGSparseMatrix<T>::get_transposed()
 		SGSparseVector<T> sv=sparse_matrix[v];
 
 		for (int32_t i=0; i<sv.num_feat_entries; i++)
-			hist[sv.features[i].feat_index]++;
+			offsets[sv.features[i].feat_index+1]++;
 	}
 
-	for (int32_t v=0; v<num_features; v++)
-		sfm[v]=SGSparseVector<T>(hist[v]);
-
-	SG_FREE(hist);
+	std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+	sfm.allocate_packed(offsets);
 
+	index_t* indices=sfm.m_packed->indices.vector;
+	T* values=sfm.m_packed->values.vector;
 	int32_t* index=SG_CALLOC(int32_t, num_features);
 
 	// fill future feature vectors with content
@@ -211,11 +378,13 @@ template<class T> SGSparseMatrix<T> SGSparseMatrix<T>::get_transposed()
 		{
 			int32_t vidx=sv.features[i].feat_index;
 			int32_t fidx=v;
-			sfm[vidx].features[index[vidx]].feat_index=fidx;
-			sfm[vidx].features[index[vidx]].entry=sv.features[i].entry;
+			int64_t k=offsets[vidx]+index[vidx];
+			indices[k]=fidx;
+			values[k]=sv.features[i].entry;
 			index[vidx]++;
 		}
 	}
+	sfm.update_packed_vectors();
 
 	SG_FREE(index);
 	return sfm;
@@ -224,10 +393,15 @@ template<class T> SGSparseMatrix<T> SGSparseMatrix<T>::get_transposed()
 
 template<class T> void SGSparseMatrix<T>::sort_features()
 {
+	const bool packed=is_packed();
 	for (int32_t i=0; i<num_vectors; i++)
 	{
 		sparse_matrix[i].sort_features();
 	}
+
+	// sorting may merge entries and moves them in the vectors only
+	if (packed)
+		pack();
 }
 
 template<class T> void SGSparseMatrix<T>::from_dense(SGMatrix<T> full)
@@ -259,10 +433,17 @@ template<class T> void SGSparseMatrix<T>::from_dense(SGMatrix<T> full)
 	num_vectors=num_vec;
 	sparse_matrix=SG_MALLOC(SGSparseVector<T>,num_vec);
 
+	SGVector<int64_t> indptr(num_vec+1);
+	indptr[0]=0;
+	for (int32_t i=0; i<num_vec; i++)
+		indptr[i+1]=indptr[i]+num_feat_entries[i];
+	allocate_packed(indptr);
+
+	index_t* indices=m_packed->indices.vector;
+	T* values=m_packed->values.vector;
 	for (int32_t i=0; i< num_vec; i++)
 	{
-		sparse_matrix[i]=SGSparseVector<T>(num_feat_entries[i]);
-		int32_t sparse_feat_idx=0;
+		int64_t k=indptr[i];
 
 		for (int32_t j=0; j< num_feat; j++)
 		{
@@ -270,13 +451,14 @@ template<class T> void SGSparseMatrix<T>::from_dense(SGMatrix<T> full)
 
 			if (src[pos] != static_cast<T>(0))
 			{
-				sparse_matrix[i].features[sparse_feat_idx].entry=src[pos];
-				sparse_matrix[i].features[sparse_feat_idx].feat_index=j;
-				sparse_feat_idx++;
+				values[k]=src[pos];
+				indices[k]=j;
+				k++;
 				num_total_entries++;
 			}
 		}
 	}
+	update_packed_vectors();
 
 	io::info("sparse feature matrix has {} entries (full matrix had {}, sparsity {:2.2f}%%)",
 			num_total_entries, int64_t(num_feat)*num_vec, (100.0*num_total_entries)/(int64_t(num_feat)*num_vec));
@@ -16,6 +16,9 @@
 #include <shogun/lib/SGVector.h>
 #include <shogun/io/SGIO.h>
 
+#include <memory>
+#include <type_traits>
+
 namespace shogun
 {
 
@@ -25,7 +28,13 @@ template<class T> class SGMatrix;
 class File;
 class LibSVMFile;
 
-/** @brief template class SGSparseMatrix */
+/** @brief template class SGSparseMatrix
+ *
+ * A packed matrix (see pack()) stores its entries in the compressed sparse
+ * row format, as separate arrays of vector offsets, feature indices and
+ * values. The sparse vectors are kept as a view of the same entries for
+ * code that works on SGSparseVector.
+ */
 template <class T> class SGSparseMatrix : public SGReferencedData
 {
 	public:
@@ -45,6 +54,19 @@ template <class T> class SGSparseMatrix : public SGReferencedData
 		 */
 		SGSparseMatrix(SGMatrix<T> dense);
 
+		/** constructor to create a packed sparse matrix from the compressed
+		 * sparse row format, where vector i has the entries
+		 * [indptr[i], indptr[i+1]) of indices and values. The arrays are
+		 * copied.
+		 *
+		 * @param indptr offsets of the vectors, of length num_vec+1
+		 * @param indices feature indices of the entries
+		 * @param values values of the entries
+		 * @param num_feat number of features
+		 */
+		SGSparseMatrix(SGVector<int64_t> indptr, SGVector<index_t> indices,
+				SGVector<T> values, index_t num_feat);
+
 		/** copy constructor */
 		SGSparseMatrix(const SGSparseMatrix &orig);
 
@@ -83,8 +105,18 @@ template <class T> class SGSparseMatrix : public SGReferencedData
 			require(v.vlen==num_features,
 				"Dimension mismatch! {} vs {}",
 				v.vlen, num_features);
-			for (index_t i=0; i<num_vectors; ++i)
-				result[i]=sparse_matrix[i].dense_dot(1.0, v.vector, v.vlen, 0.0);
+			if (is_packed())
+			{
+				#pragma omp parallel for schedule(static, 256)
+				for (index_t i=0; i<num_vectors; ++i)
+					result[i]=packed_dot<T>(i, v.vector);
+			}
+			else
+			{
+				#pragma omp parallel for schedule(static, 256)
+				for (index_t i=0; i<num_vectors; ++i)
+					result[i]=sparse_matrix[i].dense_dot(1.0, v.vector, v.vlen, 0.0);
+			}
 
 			return result;
 		}
@@ -116,12 +148,15 @@ template <class T> class SGSparseMatrix : public SGReferencedData
 			return 0;
 		}
 
-		/** operator overload for sparse-matrix r/w access
+		/** operator overload for sparse-matrix r/w access, unpacks the
+		 * matrix since the entry may be written through the reference
 		 * @param i_row
 		 * @param i_col
 		 */
 		inline T& operator()(index_t i_row, index_t i_col)
 		{
+			unpack();
+
 			require(i_row>=0, "Provided row index {} negative!", i_row);
 			require(i_col>=0, "Provided column index {} negative!", i_col);
 			require(i_row<num_features, "Provided row index ({}) is larger than number of rows ({})",
@@ -134,12 +169,16 @@ template <class T> class SGSparseMatrix : public SGReferencedData
 				if (i_row==sparse_matrix[i_col].features[i].feat_index)
 					return sparse_matrix[i_col].features[i].entry;
 			}
+			// the entries may be owned by the storage of a packed matrix, so
+			// the vector is replaced by a larger copy instead of being
+			// reallocated
 			index_t j=sparse_matrix[i_col].num_feat_entries;
-			sparse_matrix[i_col].num_feat_entries=j+1;
-			sparse_matrix[i_col].features=SG_REALLOC(SGSparseVectorEntry<T>,
-				sparse_matrix[i_col].features, j, j+1);
-			sparse_matrix[i_col].features[j].feat_index=i_row;
-			sparse_matrix[i_col].features[j].entry=static_cast<T>(0);
+			SGSparseVector<T> grown(j+1);
+			sg_memcpy(grown.features, sparse_matrix[i_col].features,
+				sizeof(SGSparseVectorEntry<T>)*j);
+			grown.features[j].feat_index=i_row;
+			grown.features[j].entry=static_cast<T>(0);
+			sparse_matrix[i_col]=grown;
 			return sparse_matrix[i_col].features[j].entry;
 		}
 
@@ -171,9 +210,99 @@ template <class T> class SGSparseMatrix : public SGReferencedData
 		 */
 		void save_with_labels(const std::shared_ptr<LibSVMFile>& saver, SGVector<float64_t> labels);
 
-		/** return the transposed of the sparse matrix */
+		/** return the transposed of the sparse matrix, which is packed and
+		 * hence a compressed sparse column copy of this matrix
+		 */
 		SGSparseMatrix<T> get_transposed();
 
+		/** Stores the entries of all vectors in the compressed sparse row
+		 * format: one array of vector offsets and separate arrays of
+		 * feature indices and values, in the order of the vectors. Dot
+		 * products of the packed matrix gather from these arrays, see
+		 * packed_dot().
+		 *
+		 * The vectors become views of the same entries as {index, value}
+		 * pairs in one contiguous array, which stays alive with the last
+		 * of them. Writing to the entries through a vector does not
+		 * update the packed arrays, call pack() again afterwards.
+		 */
+		void pack();
+
+		/** @return whether the entries are stored in the compressed sparse
+		 * row arrays, see pack()
+		 */
+		bool is_packed() const
+		{
+			return sparse_matrix && m_packed &&
+				m_packed->vectors==sparse_matrix;
+		}
+
+		/** Dot product of vector i of a packed matrix with a dense vector.
+		 * The dense entries at the feature indices of the vector are
+		 * gathered and multiplied with its values in SIMD lanes.
+		 *
+		 * @param i index of the vector
+		 * @param vec dense vector with num_features entries
+		 * @return sum of the products, accumulated in RT
+		 */
+		template <class RT, class VT>
+		RT packed_dot(index_t i, const VT* vec) const
+		{
+			const int64_t begin=m_packed->indptr[i];
+			const int64_t len=m_packed->indptr[i+1]-begin;
+			const index_t* indices=m_packed->indices.vector+begin;
+			const T* values=m_packed->values.vector+begin;
+
+			RT result=0;
+			if constexpr (std::is_arithmetic<RT>::value)
+			{
+				#pragma omp simd reduction(+:result)
+				for (int64_t k=0; k<len; ++k)
+					result+=static_cast<RT>(values[k])*static_cast<RT>(vec[indices[k]]);
+			}
+			else
+			{
+				for (int64_t k=0; k<len; ++k)
+					result+=static_cast<RT>(values[k])*static_cast<RT>(vec[indices[k]]);
+			}
+			return result;
+		}
+
+		/** Adds alpha times vector i of a packed matrix to a dense vector,
+		 * reading the feature indices and values from the packed arrays.
+		 *
+		 * @param i index of the vector
+		 * @param alpha scalar factor
+		 * @param vec dense vector with num_features entries
+		 * @param abs_val whether to add the absolute values of the entries
+		 */
+		template <class VT>
+		void packed_add_to_dense(index_t i, VT alpha, VT* vec, bool abs_val) const
+		{
+			const int64_t begin=m_packed->indptr[i];
+			const int64_t len=m_packed->indptr[i+1]-begin;
+			const index_t* indices=m_packed->indices.vector+begin;
+			const T* values=m_packed->values.vector+begin;
+
+			// feature indices may repeat within a vector, so the scatter
+			// is not vectorized
+			for (int64_t k=0; k<len; ++k)
+			{
+				VT value=static_cast<VT>(values[k]);
+				vec[indices[k]]+=alpha*(abs_val && value<0 ? -value : value);
+			}
+		}
+
+		/** export to the compressed sparse row format, a packed matrix
+		 * returns its arrays without copying
+		 *
+		 * @param indptr offsets of the vectors, of length num_vectors+1
+		 * @param indices feature indices of the entries
+		 * @param values values of the entries
+		 */
+		void get_csr(SGVector<int64_t>& indptr, SGVector<index_t>& indices,
+				SGVector<T>& values) const;
+
 		/** create a sparse matrix from a dense one
 		 *
 		 * @param full the dense matrix to create the sparse one from
@@ -206,6 +335,49 @@ template <class T> class SGSparseMatrix : public SGReferencedData
 		/** free data */
 		virtual void free_data();
 
+		/** allocates the packed arrays for the given vector offsets and
+		 * points every vector at its entries; the indices and values are
+		 * filled by the caller, followed by update_packed_vectors()
+		 *
+		 * @param indptr offsets of the vectors, of length num_vectors+1
+		 */
+		void allocate_packed(SGVector<int64_t> indptr);
+
+		/** copies the packed indices and values to the entries of the
+		 * vectors
+		 */
+		void update_packed_vectors();
+
+		/** drops the packed arrays, for all copies of the matrix, when the
+		 * vectors may be written to
+		 */
+		void unpack();
+
+	private:
+		/** packed arrays of a matrix and the entries its vectors point to,
+		 * shared by all copies of the matrix
+		 */
+		struct PackedStorage
+		{
+			~PackedStorage();
+
+			/** vectors of the matrix the arrays belong to, NULL once they
+			 * are dropped
+			 */
+			const SGSparseVector<T>* vectors=nullptr;
+			/** offsets of the vectors, of length num_vectors+1 */
+			SGVector<int64_t> indptr;
+			/** feature indices of the entries */
+			SGVector<index_t> indices;
+			/** values of the entries */
+			SGVector<T> values;
+			/** the entries as {index, value} pairs, for the vectors */
+			SGSparseVectorEntry<T>* entries=nullptr;
+		};
+
+		/** packed arrays, see pack() */
+		std::shared_ptr<PackedStorage> m_packed;
+
 public:
 
 	/// total number of vectors
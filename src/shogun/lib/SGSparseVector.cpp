@@ -27,6 +27,14 @@ SGSparseVector<T>::SGSparseVector(pointer feats, size_type num_entries,
 {
 }
 
+template <class T>
+SGSparseVector<T>::SGSparseVector(pointer feats, size_type num_entries,
+                                  std::shared_ptr<void> storage) :
+	SGReferencedData(std::move(storage)),
+	num_feat_entries(num_entries), features(feats)
+{
+}
+
 template <class T>
 SGSparseVector<T>::SGSparseVector(size_type num_entries, bool ref_counting) :
 	SGReferencedData(ref_counting),
@@ -244,8 +252,8 @@ void SGSparseVector<T>::sort_features(bool stable_pointer)
 	int32_t new_feat_count = last_index + 1;
 	ASSERT(new_feat_count <= num_feat_entries);
 
-	// shrinking vector
-	if (!stable_pointer)
+	// shrinking vector, entries owned by a storage are never reallocated
+	if (!stable_pointer && !has_storage())
 	{
 		io::info("shrinking vector from {} to {}", num_feat_entries, new_feat_count);
 		features = SG_REALLOC(value_type, features, num_feat_entries, new_feat_count);
@@ -58,6 +58,14 @@ public:
 	SGSparseVector(pointer feats, size_type num_entries,
 			bool ref_counting=true);
 
+	/** Wraps a sparse vector around entries owned by storage, e.g. the
+	 * contiguous entries of a packed SGSparseMatrix. Copies of the vector
+	 * keep storage alive, the entries themselves are never freed nor
+	 * resized.
+	 */
+	SGSparseVector(pointer feats, size_type num_entries,
+			std::shared_ptr<void> storage);
+
 	/** constructor to create new vector in memory */
 	SGSparseVector(size_type num_entries, bool ref_counting=true);
 
@@ -79,6 +79,15 @@ SGVector<T>::SGVector(T* v, index_t len, bool ref_counting)
 #endif
 }
 
+template<class T>
+SGVector<T>::SGVector(T* v, index_t len, std::shared_ptr<void> storage)
+: SGReferencedData(std::move(storage)), vector(v), vlen(len), gpu_ptr(NULL)
+{
+#ifdef HAVE_VIENNACL
+	m_on_gpu.store(false, std::memory_order_release);
+#endif
+}
+
 template<class T>
 SGVector<T>::SGVector(T* m, index_t len, index_t offset)
 : SGReferencedData(false), vector(m+offset), vlen(len)
@@ -65,6 +65,12 @@ template<class T> class SGVector : public SGReferencedData
 		/** Wraps a vector around an existing memory segment with an offset */
 		SGVector(T* m, index_t len, index_t offset);
 
+		/** Wraps a vector around memory owned by storage, e.g. a memory
+		 * mapped file. Copies of the vector share a reference count and keep
+		 * storage alive, the memory itself is never freed nor resized.
+		 */
+		SGVector(T* v, index_t len, std::shared_ptr<void> storage);
+
 		/** Constructor to create new vector in memory */
 		SGVector(index_t len, bool ref_counting=true);
 
@@ -0,0 +1,164 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/io/ShogunErrc.h>
+#include <shogun/io/fs/FileSystem.h>
+#include <shogun/lib/Tracer.h>
+#include <shogun/lib/observers/ObservedValueTemplated.h>
+
+#include <sstream>
+
+using namespace shogun;
+
+namespace
+{
+	void append_json_string(std::ostringstream& out, const char* str)
+	{
+		out << '"';
+		for (; *str; ++str)
+		{
+			if (*str == '"' || *str == '\\')
+				out << '\\';
+			out << *str;
+		}
+		out << '"';
+	}
+} // namespace
+
+Tracer::Tracer() : SGObject(), m_enabled(false), m_epoch(Clock::now())
+{
+}
+
+Tracer::~Tracer()
+{
+}
+
+Tracer* Tracer::instance()
+{
+	static Tracer tracer{};
+	return &tracer;
+}
+
+void Tracer::set_enabled(bool enabled)
+{
+	m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+TraceCounter& Tracer::counter(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto& counter = m_counters[name];
+	if (!counter)
+		counter = std::make_unique<TraceCounter>(m_enabled);
+	return *counter;
+}
+
+int32_t Tracer::thread_index(std::thread::id id)
+{
+	auto it = m_threads.find(id);
+	if (it == m_threads.end())
+		it = m_threads.emplace(id, static_cast<int32_t>(m_threads.size()))
+		         .first;
+	return it->second;
+}
+
+void Tracer::record(
+    const char* name, const char* category, Clock::time_point start,
+    Clock::time_point end)
+{
+	using std::chrono::duration_cast;
+	using std::chrono::microseconds;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_events.push_back(
+	    {name, category, duration_cast<microseconds>(start - m_epoch).count(),
+	     duration_cast<microseconds>(end - start).count(),
+	     thread_index(std::this_thread::get_id())});
+}
+
+void Tracer::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_events.clear();
+	for (auto& counter : m_counters)
+		counter.second->reset();
+	m_epoch = Clock::now();
+}
+
+std::string Tracer::to_chrome_trace() const
+{
+	using std::chrono::duration_cast;
+	using std::chrono::microseconds;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::ostringstream out;
+	out << "{\"traceEvents\":[";
+
+	bool first = true;
+	for (const auto& event : m_events)
+	{
+		if (!first)
+			out << ',';
+		first = false;
+		out << "{\"name\":";
+		append_json_string(out, event.name);
+		out << ",\"cat\":";
+		append_json_string(out, event.category);
+		out << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.thread
+		    << ",\"ts\":" << event.start_us << ",\"dur\":" << event.duration_us
+		    << '}';
+	}
+
+	// counters are reported once, with their value at the time of the dump
+	auto now = duration_cast<microseconds>(Clock::now() - m_epoch).count();
+	for (const auto& counter : m_counters)
+	{
+		if (!first)
+			out << ',';
+		first = false;
+		out << "{\"name\":";
+		append_json_string(out, counter.first.c_str());
+		out << ",\"ph\":\"C\",\"pid\":0,\"tid\":0,\"ts\":" << now
+		    << ",\"args\":{\"value\":" << counter.second->value() << "}}";
+	}
+
+	out << "],\"displayTimeUnit\":\"ms\"}";
+	return out.str();
+}
+
+void Tracer::save_chrome_trace(const std::string& filename) const
+{
+	std::error_condition ec;
+	std::unique_ptr<io::WritableFile> file;
+	if ((ec = env()->new_writable_file(filename, &file)))
+		throw io::to_system_error(ec);
+
+	if ((ec = file->append(to_chrome_trace())))
+		throw io::to_system_error(ec);
+	if ((ec = file->close()))
+		throw io::to_system_error(ec);
+}
+
+void Tracer::emit(int64_t step)
+{
+	if (get_num_subscriptions() == 0)
+		return;
+
+	std::vector<std::pair<std::string, int64_t>> counters;
+	std::map<std::string, float64_t> scopes_ms;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (const auto& counter : m_counters)
+			counters.emplace_back(counter.first, counter.second->value());
+		for (const auto& event : m_events)
+			scopes_ms[event.name] += event.duration_us / 1000.0;
+	}
+
+	for (const auto& counter : counters)
+		observe<int64_t>(step, counter.first, "Trace counter", counter.second);
+	for (const auto& scope : scopes_ms)
+		observe<float64_t>(
+		    step, scope.first, "Total time in trace scope [ms]", scope.second);
+}
@@ -0,0 +1,225 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef __TRACER_H__
+#define __TRACER_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/lib/common.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace shogun
+{
+	/** @brief Named event counter of the Tracer, e.g. the number of kernel
+	 * evaluations. Counting is a relaxed atomic add and does nothing while
+	 * tracing is disabled.
+	 */
+	class TraceCounter
+	{
+	public:
+		/** constructor
+		 *
+		 * @param enabled tracing switch of the owning tracer
+		 */
+		TraceCounter(const std::atomic<bool>& enabled) : m_enabled(enabled)
+		{
+		}
+
+		/** adds n to the counter if tracing is enabled
+		 *
+		 * @param n value to add
+		 */
+		void add(int64_t n)
+		{
+			if (m_enabled.load(std::memory_order_relaxed))
+				m_value.fetch_add(n, std::memory_order_relaxed);
+		}
+
+		/** @return current value of the counter */
+		int64_t value() const
+		{
+			return m_value.load(std::memory_order_relaxed);
+		}
+
+		/** resets the counter to zero */
+		void reset()
+		{
+			m_value.store(0, std::memory_order_relaxed);
+		}
+
+	private:
+		const std::atomic<bool>& m_enabled;
+		std::atomic<int64_t> m_value{0};
+	};
+
+	/** @brief Collects scoped timings and counters of hot code paths.
+	 *
+	 * Instrumentation is placed with the SG_TRACE_SCOPE and SG_TRACE_COUNT
+	 * macros, which compile to nothing unless shogun is configured with
+	 * ENABLE_TRACING. At runtime nothing is recorded until tracing is
+	 * switched on with set_enabled().
+	 *
+	 * The collected data can be written as a Chrome trace (load it in
+	 * chrome://tracing or Perfetto), or emitted through the observer system,
+	 * e.g. to a ParameterObserverTensorBoard subscribed to the tracer.
+	 */
+	class Tracer : public SGObject
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		/** constructor */
+		Tracer();
+		virtual ~Tracer();
+
+		/** @return the global tracer used by the instrumentation macros */
+		static Tracer* instance();
+
+		/** switches recording on or off
+		 *
+		 * @param enabled whether to record
+		 */
+		void set_enabled(bool enabled);
+
+		/** @return whether tracing is switched on */
+		bool is_enabled() const
+		{
+			return m_enabled.load(std::memory_order_relaxed);
+		}
+
+		/** Returns the counter with the given name, creating it if needed.
+		 * The reference stays valid for the lifetime of the tracer.
+		 *
+		 * @param name name of the counter
+		 * @return counter
+		 */
+		TraceCounter& counter(const std::string& name);
+
+		/** records a completed scope
+		 *
+		 * @param name name of the scope, must be a string literal
+		 * @param category category of the scope, must be a string literal
+		 * @param start time the scope was entered
+		 * @param end time the scope was left
+		 */
+		void record(
+		    const char* name, const char* category, Clock::time_point start,
+		    Clock::time_point end);
+
+		/** discards all recorded scopes and resets all counters */
+		void clear();
+
+		/** @return recorded scopes and counters in Chrome trace JSON */
+		std::string to_chrome_trace() const;
+
+		/** writes the Chrome trace JSON to a file
+		 *
+		 * @param filename name of the file
+		 */
+		void save_chrome_trace(const std::string& filename) const;
+
+		/** Emits the value of every counter and the total time in
+		 * milliseconds spent in every scope to the subscribed observers.
+		 *
+		 * @param step step the values are reported for
+		 */
+		void emit(int64_t step);
+
+		virtual const char* get_name() const
+		{
+			return "Tracer";
+		}
+
+	private:
+		struct TraceEvent
+		{
+			const char* name;
+			const char* category;
+			int64_t start_us;
+			int64_t duration_us;
+			int32_t thread;
+		};
+
+		int32_t thread_index(std::thread::id id);
+
+		std::atomic<bool> m_enabled;
+		Clock::time_point m_epoch;
+
+		mutable std::mutex m_mutex;
+		std::vector<TraceEvent> m_events;
+		std::map<std::thread::id, int32_t> m_threads;
+		std::map<std::string, std::unique_ptr<TraceCounter>> m_counters;
+	};
+
+	/** @brief Records the time between its construction and destruction
+	 * in the global Tracer. Use through SG_TRACE_SCOPE.
+	 */
+	class TraceScope
+	{
+	public:
+		/** constructor
+		 *
+		 * @param name name of the scope, must be a string literal
+		 * @param category category of the scope, must be a string literal
+		 */
+		TraceScope(const char* name, const char* category)
+		    : m_name(name), m_category(category),
+		      m_active(Tracer::instance()->is_enabled()),
+		      m_start(m_active ? Tracer::Clock::now() : Tracer::Clock::time_point())
+		{
+		}
+
+		~TraceScope()
+		{
+			if (m_active)
+				Tracer::instance()->record(
+				    m_name, m_category, m_start, Tracer::Clock::now());
+		}
+
+		TraceScope(const TraceScope&) = delete;
+		TraceScope& operator=(const TraceScope&) = delete;
+
+	private:
+		const char* m_name;
+		const char* m_category;
+		bool m_active;
+		Tracer::Clock::time_point m_start;
+	};
+} // namespace shogun
+
+#define SG_TRACE_CONCAT_IMPL(a, b) a##b
+#define SG_TRACE_CONCAT(a, b) SG_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef USE_TRACING
+/** Times the enclosing scope under the given name and category */
+#define SG_TRACE_SCOPE(name, category)                                         \
+	shogun::TraceScope SG_TRACE_CONCAT(sg_trace_scope_, __LINE__)(             \
+	    name, category)
+/** Adds n to the named trace counter */
+#define SG_TRACE_COUNT(name, n)                                                \
+	do                                                                         \
+	{                                                                          \
+		static auto& sg_trace_counter =                                        \
+		    shogun::Tracer::instance()->counter(name);                         \
+		sg_trace_counter.add(n);                                               \
+	} while (0)
+#else
+#define SG_TRACE_SCOPE(name, category)
+#define SG_TRACE_COUNT(name, n)                                                \
+	do                                                                         \
+	{                                                                          \
+	} while (0)
+#endif
+
+#endif /* __TRACER_H__ */
@@ -0,0 +1,84 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/lib/WorkspacePool.h>
+#include <shogun/lib/memory.h>
+
+#include <atomic>
+#include <cstdint>
+
+using namespace shogun;
+
+namespace
+{
+	thread_local int32_t scope_depth = 0;
+	thread_local std::vector<void (*)()> release_functions;
+
+	std::atomic<int64_t> num_allocations{0};
+	std::atomic<int64_t> num_reuses{0};
+	std::atomic<int64_t> num_bytes{0};
+} // namespace
+
+WorkspaceScope::WorkspaceScope()
+{
+	++scope_depth;
+}
+
+WorkspaceScope::~WorkspaceScope()
+{
+	if (--scope_depth == 0)
+	{
+		for (auto release : release_functions)
+			release();
+	}
+}
+
+bool workspace::in_scope()
+{
+	return scope_depth > 0;
+}
+
+WorkspaceStatistics workspace::statistics()
+{
+	return {num_allocations.load(std::memory_order_relaxed),
+	        num_reuses.load(std::memory_order_relaxed),
+	        num_bytes.load(std::memory_order_relaxed)};
+}
+
+void workspace::reset_statistics()
+{
+	num_allocations.store(0, std::memory_order_relaxed);
+	num_reuses.store(0, std::memory_order_relaxed);
+	num_bytes.store(0, std::memory_order_relaxed);
+}
+
+void workspace::detail::register_release(void (*release)())
+{
+	release_functions.push_back(release);
+}
+
+std::shared_ptr<void> workspace::detail::allocate(size_t bytes)
+{
+	auto raw = SG_MALLOC(char, bytes + alignment - 1);
+	auto aligned = reinterpret_cast<void*>(
+	    (reinterpret_cast<uintptr_t>(raw) + alignment - 1) &
+	    ~uintptr_t(alignment - 1));
+
+	num_allocations.fetch_add(1, std::memory_order_relaxed);
+	num_bytes.fetch_add(bytes, std::memory_order_relaxed);
+	return std::shared_ptr<void>(aligned, [raw](void*) { SG_FREE(raw); });
+}
+
+void workspace::detail::count_reuse()
+{
+	num_reuses.fetch_add(1, std::memory_order_relaxed);
+}
+
+index_t workspace::detail::size_class(size_t bytes)
+{
+	index_t c = 0;
+	while ((alignment << c) < bytes)
+		++c;
+	return c;
+}
@@ -0,0 +1,197 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef __WORKSPACEPOOL_H__
+#define __WORKSPACEPOOL_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/common.h>
+
+#include <memory>
+#include <vector>
+
+namespace shogun
+{
+	/** @brief Allocation counters of the workspace pools, summed over all
+	 * threads.
+	 */
+	struct WorkspaceStatistics
+	{
+		/** number of blocks that were newly allocated */
+		int64_t num_allocations;
+		/** number of requests that were served by an existing block */
+		int64_t num_reuses;
+		/** number of bytes that were newly allocated */
+		int64_t num_bytes;
+	};
+
+	/** @brief RAII scope in which workspace::vector() and workspace::matrix()
+	 * hand out pooled temporaries.
+	 *
+	 * Scopes nest. The pools are thread-local and live until the outermost
+	 * scope of the thread exits, which releases all of their blocks at once.
+	 * Learners open a scope around their training loop, so that the
+	 * temporaries of one iteration are reused by the next one:
+	 *
+	 * @code
+	 * WorkspaceScope scope;
+	 * for (auto iter : range(max_iter))
+	 * {
+	 * 	auto difference = workspace::vector<float64_t>(dim);
+	 * 	...
+	 * }
+	 * @endcode
+	 */
+	class WorkspaceScope
+	{
+	public:
+		/** constructor, enters the scope */
+		WorkspaceScope();
+
+		/** destructor, releases the pools of this thread if this is its
+		 * outermost scope
+		 */
+		~WorkspaceScope();
+
+		WorkspaceScope(const WorkspaceScope&) = delete;
+		WorkspaceScope& operator=(const WorkspaceScope&) = delete;
+	};
+
+	namespace workspace
+	{
+		/** alignment in bytes of pooled blocks, enough for any SIMD width */
+		static constexpr size_t alignment = 64;
+
+		/** @return whether the calling thread is inside a WorkspaceScope */
+		bool in_scope();
+
+		/** @return allocation counters of the pools since the last reset */
+		WorkspaceStatistics statistics();
+
+		/** resets the allocation counters to zero */
+		void reset_statistics();
+
+		namespace detail
+		{
+			/** registers the release function of a pool of the calling
+			 * thread, which is called when its outermost scope exits
+			 */
+			void register_release(void (*release)());
+
+			/** allocates an aligned block of the given size, which is freed
+			 * together with the returned storage
+			 */
+			std::shared_ptr<void> allocate(size_t bytes);
+
+			/** counts a request that was served by an existing block */
+			void count_reuse();
+
+			/** @return size class of a block of at least the given size,
+			 * class c holds blocks of (alignment << c) bytes
+			 */
+			index_t size_class(size_t bytes);
+
+			/** Thread-local pool of blocks of one element type. Every block
+			 * is held by a SGVector, and a block is free when the pool holds
+			 * the only reference to it. Requests share the reference count
+			 * of the block, so serving them allocates nothing.
+			 */
+			template <class T>
+			class Pool
+			{
+			public:
+				static Pool& instance()
+				{
+					thread_local Pool pool;
+					if (!pool.m_registered)
+					{
+						register_release(&Pool::release);
+						pool.m_registered = true;
+					}
+					return pool;
+				}
+
+				SGVector<T> acquire(index_t len)
+				{
+					auto c = size_class(sizeof(T) * len);
+					if (index_t(m_blocks.size()) <= c)
+						m_blocks.resize(c + 1);
+
+					for (auto& block : m_blocks[c])
+					{
+						if (block.ref_count() == 1)
+						{
+							count_reuse();
+							SGVector<T> result(block);
+							result.vlen = len;
+							return result;
+						}
+					}
+
+					size_t bytes = alignment << c;
+					auto storage = allocate(bytes);
+					m_blocks[c].emplace_back(
+					    static_cast<T*>(storage.get()), bytes / sizeof(T),
+					    storage);
+					SGVector<T> result(m_blocks[c].back());
+					result.vlen = len;
+					return result;
+				}
+
+			private:
+				/** drops all blocks, the ones still referenced outside of
+				 * the pool stay valid until they are released
+				 */
+				static void release()
+				{
+					instance().m_blocks.clear();
+				}
+
+				std::vector<std::vector<SGVector<T>>> m_blocks;
+				bool m_registered = false;
+			};
+		} // namespace detail
+
+		/** Returns a temporary vector of the given length. Inside a
+		 * WorkspaceScope it is drawn from the pool of the calling thread
+		 * and is 64-byte aligned, otherwise it is a plain SGVector.
+		 *
+		 * Unlike SGVector(len), a pooled vector is not initialized and must
+		 * not be resized. It stays valid as long as it is referenced, but it
+		 * only returns to the pool once all copies of it are gone.
+		 *
+		 * @param len length of the vector
+		 * @return temporary vector
+		 */
+		template <class T>
+		SGVector<T> vector(index_t len)
+		{
+			if (len <= 0 || !in_scope())
+				return SGVector<T>(len);
+
+			return detail::Pool<T>::instance().acquire(len);
+		}
+
+		/** Returns a temporary matrix, see vector()
+		 *
+		 * @param num_rows number of rows of the matrix
+		 * @param num_cols number of columns of the matrix
+		 * @return temporary matrix
+		 */
+		template <class T>
+		SGMatrix<T> matrix(index_t num_rows, index_t num_cols)
+		{
+			if (num_rows <= 0 || num_cols <= 0 || !in_scope())
+				return SGMatrix<T>(num_rows, num_cols);
+
+			return SGMatrix<T>(
+			    vector<T>(num_rows * num_cols), num_rows, num_cols);
+		}
+	} // namespace workspace
+} // namespace shogun
+
+#endif // __WORKSPACEPOOL_H__
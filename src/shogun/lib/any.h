@@ -208,11 +208,43 @@ namespace shogun
 			exit_matrix_row(rows, cols);
 		}
 
+		/** Called for contiguous arrays of arithmetic type before their
+		 * elements are visited one by one. A visitor that processes the
+		 * whole block at once returns true, which skips the element-wise
+		 * traversal. When reading, the visitor may point data to memory
+		 * owned by storage, the array then becomes a view into it.
+		 *
+		 * @param data pointer to the first element
+		 * @param bytes size of the array in bytes
+		 * @param storage set to the owner of data if data was replaced
+		 * @return whether the block was handled
+		 */
+		virtual bool
+		on_contiguous(void** data, int64_t bytes, std::shared_ptr<void>* storage)
+		{
+			return false;
+		}
+
 		template <typename T>
 		void on(SGVector<T>* _v)
 		{
 			auto size = _v->vlen;
 			enter_vector(std::addressof(size));
+			if constexpr (std::is_arithmetic<T>::value)
+			{
+				void* data = (size == _v->vlen) ? _v->vector : nullptr;
+				std::shared_ptr<void> storage;
+				if (on_contiguous(
+				        std::addressof(data), int64_t(size) * sizeof(T),
+				        std::addressof(storage)))
+				{
+					if (storage)
+						*_v = SGVector<T>(
+						    static_cast<T*>(data), size, std::move(storage));
+					exit_vector(std::addressof(size));
+					return;
+				}
+			}
 			if (size != _v->vlen)
 				_v->resize_vector(size);
 			for (auto&& _value : *_v)
@@ -292,6 +324,24 @@ namespace shogun
 			auto rows = _matrix->num_rows;
 			auto cols = _matrix->num_cols;
 			enter_matrix(std::addressof(rows), std::addressof(cols));
+			if constexpr (std::is_arithmetic<T>::value)
+			{
+				const bool same_shape =
+				    rows == _matrix->num_rows && cols == _matrix->num_cols;
+				void* data = same_shape ? _matrix->matrix : nullptr;
+				std::shared_ptr<void> storage;
+				if (on_contiguous(
+				        std::addressof(data), int64_t(rows) * cols * sizeof(T),
+				        std::addressof(storage)))
+				{
+					if (storage)
+						*_matrix = SGMatrix<T>(
+						    static_cast<T*>(data), rows, cols,
+						    std::move(storage));
+					exit_matrix(std::addressof(rows), std::addressof(cols));
+					return;
+				}
+			}
 			if ((rows != _matrix->num_rows) || (cols != _matrix->num_cols))
 				*_matrix = SGMatrix<T>(rows, cols);
 			for (auto index = 0; index < cols; index++)
@@ -1162,6 +1212,17 @@ namespace shogun
 			       policy->matches_type(typeid(std::function<T()>));
 		}
 
+		/** @return pointer to the referenced value if this Any is a
+		 * non-owning reference to a value of type T, nullptr otherwise.
+		 */
+		template <typename T>
+		T* referenced() const
+		{
+			if (policy == non_owning_policy<T>())
+				return static_cast<T*>(storage);
+			return nullptr;
+		}
+
 		/** @return true if Any object is empty. */
 		bool empty() const;
 
@@ -38,6 +38,7 @@
 #include <shogun/base/ShogunEnv.h>
 #include <shogun/base/progress.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/lib/Tracer.h>
 #include <shogun/kernel/Kernel.h>
 #include <shogun/lib/Signal.h>
 #include <shogun/lib/Time.h>
@@ -145,6 +146,7 @@ int32_t Cache::get_data(const int32_t index, Qfloat **data, int32_t len)
 
 	if(more > 0)
 	{
+		SG_TRACE_COUNT("libsvm_cache_misses", 1);
 		// free old space
 		while(size < more)
 		{
@@ -446,6 +448,7 @@ void Solver::Solve(
 	const schar *p_y, float64_t *p_alpha, float64_t p_Cp, float64_t p_Cn,
 	float64_t p_eps, SolutionInfo* p_si, int32_t shrinking, bool use_bias)
 {
+	SG_TRACE_SCOPE("libsvm::Solver::Solve", "svm");
 	auto sub = connect_to_signal_handler();
 
 	this->l = p_l;
@@ -544,6 +547,7 @@ void Solver::Solve(
 			gap, -Math::log10(gap), -Math::log10(1), -Math::log10(eps));
 
 		++iter;
+		SG_TRACE_COUNT("libsvm_iterations", 1);
 
 		// update alpha[i] and alpha[j], handle bounds carefully
 
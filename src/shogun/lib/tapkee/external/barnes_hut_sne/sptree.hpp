@@ -0,0 +1,268 @@
+/**
+ * Copyright (c) 2013, Laurens van der Maaten (Delft University of Technology)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. All advertising materials mentioning features or use of this software
+ *    must display the following acknowledgement:
+ *    This product includes software developed by the Delft University of Technology.
+ * 4. Neither the name of the Delft University of Technology nor the names of
+ *    its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY LAURENS VAN DER MAATEN ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL LAURENS VAN DER MAATEN BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SPTREE_H
+#define SPTREE_H
+
+#include <float.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+
+#include <shogun/lib/tapkee/defines.hpp>
+
+namespace tsne
+{
+
+using tapkee::ScalarType;
+
+// Space-partitioning tree (quadtree for two, octree for three dimensions)
+// stored as a flat array of nodes. Children of a node are contiguous and
+// every node knows the node to continue with once its subtree is skipped,
+// so that force computations walk the array without recursion or a stack.
+// The tree is immutable during force computations, which therefore can be
+// run concurrently for different points.
+template <int NDims>
+class SPTree
+{
+
+	// Fixed constants
+	static const int NO_CHILDREN = 1 << NDims;
+
+	struct Node
+	{
+		ScalarType center[NDims];
+		ScalarType center_of_mass[NDims];
+		ScalarType half_width[NDims];
+		ScalarType max_width;
+		int cum_size;
+		// index of the first child, -1 for leaves
+		int first_child;
+		// node to continue with after this subtree, -1 for the last one
+		int next;
+		// point stored in a leaf, -1 for empty leaves
+		int point;
+	};
+
+	const ScalarType* data;
+	std::vector<Node> nodes;
+
+public:
+
+	SPTree() : data(NULL), nodes()
+	{
+	}
+
+	// Builds the tree on N points, reusing the node storage of the last build
+	void build(const ScalarType* inp_data, int N)
+	{
+		data = inp_data;
+		nodes.clear();
+
+		// Compute mean and extent of the current map (boundaries of the tree)
+		ScalarType mean_Y[NDims], min_Y[NDims], max_Y[NDims];
+		for(int d = 0; d < NDims; d++) { mean_Y[d] = .0; min_Y[d] = DBL_MAX; max_Y[d] = -DBL_MAX; }
+		for(int n = 0; n < N; n++) {
+			for(int d = 0; d < NDims; d++) {
+				mean_Y[d] += data[n * NDims + d];
+				min_Y[d] = std::min(min_Y[d], data[n * NDims + d]);
+				max_Y[d] = std::max(max_Y[d], data[n * NDims + d]);
+			}
+		}
+		ScalarType width[NDims];
+		for(int d = 0; d < NDims; d++) {
+			mean_Y[d] /= (ScalarType) N;
+			width[d] = std::max(max_Y[d] - mean_Y[d], mean_Y[d] - min_Y[d]) + 1e-5;
+		}
+		addNode(mean_Y, width);
+		for(int n = 0; n < N; n++) insert(n);
+
+		// Thread the tree: children are created after their parent
+		nodes[0].next = -1;
+		for(size_t i = 0; i < nodes.size(); i++) {
+			int child = nodes[i].first_child;
+			if(child < 0) continue;
+			for(int k = 0; k < NO_CHILDREN - 1; k++) nodes[child + k].next = child + k + 1;
+			nodes[child + NO_CHILDREN - 1].next = nodes[i].next;
+		}
+	}
+
+	int getNumNodes() const
+	{
+		return nodes.size();
+	}
+
+	// Compute non-edge forces using Barnes-Hut algorithm
+	void computeNonEdgeForces(int point_index, ScalarType theta, ScalarType neg_f[], ScalarType* sum_Q) const
+	{
+		const ScalarType* point = data + point_index * NDims;
+		ScalarType buff[NDims];
+		int i = 0;
+		while(i >= 0) {
+			const Node& node = nodes[i];
+
+			// Make sure that we spend no time on empty nodes or self-interactions
+			if(node.cum_size == 0 || (node.first_child < 0 && node.point == point_index)) {
+				i = node.next;
+				continue;
+			}
+
+			// Compute distance between point and center-of-mass
+			ScalarType D = .0;
+			for(int d = 0; d < NDims; d++) buff[d] = point[d] - node.center_of_mass[d];
+			for(int d = 0; d < NDims; d++) D += buff[d] * buff[d];
+
+			// Check whether we can use this node as a "summary"
+			if(node.first_child < 0 || node.max_width < theta * sqrt(D)) {
+
+				// Compute and add t-SNE force between point and current node
+				ScalarType Q = 1.0 / (1.0 + D);
+				*sum_Q += node.cum_size * Q;
+				ScalarType mult = node.cum_size * Q * Q;
+				for(int d = 0; d < NDims; d++) neg_f[d] += mult * buff[d];
+				i = node.next;
+			}
+			else {
+				i = node.first_child;
+			}
+		}
+	}
+
+	// Computes edge forces of point n from row n of the sparse P
+	void computeEdgeForces(const int* row_P, const int* col_P, const ScalarType* val_P, int n, ScalarType* pos_f) const
+	{
+		const ScalarType* point = data + n * NDims;
+		for(int i = row_P[n]; i < row_P[n + 1]; i++) {
+
+			// Compute pairwise distance and Q-value
+			ScalarType buff[NDims];
+			ScalarType D = .0;
+			for(int d = 0; d < NDims; d++) buff[d] = point[d] - data[col_P[i] * NDims + d];
+			for(int d = 0; d < NDims; d++) D += buff[d] * buff[d];
+			D = val_P[i] / (1.0 + D);
+
+			// Sum positive force
+			for(int d = 0; d < NDims; d++) pos_f[d] += D * buff[d];
+		}
+	}
+
+private:
+
+	int addNode(const ScalarType* center, const ScalarType* half_width)
+	{
+		Node node;
+		node.max_width = .0;
+		for(int d = 0; d < NDims; d++) {
+			node.center[d] = center[d];
+			node.center_of_mass[d] = .0;
+			node.half_width[d] = half_width[d];
+			node.max_width = std::max(node.max_width, half_width[d]);
+		}
+		node.cum_size = 0;
+		node.first_child = -1;
+		node.next = -1;
+		node.point = -1;
+		nodes.push_back(node);
+		return nodes.size() - 1;
+	}
+
+	// Create children which fully divide a cell into cells of equal volume
+	void subdivide(int i)
+	{
+		int first_child = nodes.size();
+		for(int k = 0; k < NO_CHILDREN; k++) {
+			ScalarType center[NDims], half_width[NDims];
+			for(int d = 0; d < NDims; d++) {
+				half_width[d] = .5 * nodes[i].half_width[d];
+				center[d] = nodes[i].center[d] + ((k >> d) & 1 ? half_width[d] : -half_width[d]);
+			}
+			addNode(center, half_width);
+		}
+		nodes[i].first_child = first_child;
+
+		// Move the existing point to the correct child
+		int point = nodes[i].point;
+		nodes[i].point = -1;
+		insertAt(childFor(i, data + point * NDims), point);
+	}
+
+	int childFor(int i, const ScalarType* point) const
+	{
+		int k = 0;
+		for(int d = 0; d < NDims; d++)
+			if(point[d] > nodes[i].center[d]) k |= 1 << d;
+		return nodes[i].first_child + k;
+	}
+
+	void insert(int new_index)
+	{
+		insertAt(0, new_index);
+	}
+
+	// Insert a point into the subtree rooted at node i
+	void insertAt(int i, int new_index)
+	{
+		const ScalarType* point = data + new_index * NDims;
+		while(true) {
+
+			// Online update of cumulative size and center-of-mass
+			Node& node = nodes[i];
+			node.cum_size++;
+			ScalarType mult1 = (ScalarType) (node.cum_size - 1) / (ScalarType) node.cum_size;
+			ScalarType mult2 = 1.0 / (ScalarType) node.cum_size;
+			for(int d = 0; d < NDims; d++) node.center_of_mass[d] = mult1 * node.center_of_mass[d] + mult2 * point[d];
+
+			if(node.first_child < 0) {
+
+				// If there is space in this leaf, add the point here
+				if(node.point < 0) {
+					node.point = new_index;
+					return;
+				}
+
+				// Don't add duplicates for now (this is not very nice)
+				bool duplicate = true;
+				for(int d = 0; d < NDims; d++) {
+					if(point[d] != data[node.point * NDims + d]) { duplicate = false; break; }
+				}
+				if(duplicate) return;
+
+				// Otherwise, we need to subdivide the current cell
+				subdivide(i);
+			}
+			i = childFor(i, point);
+		}
+	}
+};
+
+}
+
+#endif
@@ -35,7 +35,7 @@
 /* Tapkee includes */
 #include <shogun/lib/tapkee/utils/logging.hpp>
 #include <shogun/lib/tapkee/utils/time.hpp>
-#include <shogun/lib/tapkee/external/barnes_hut_sne/quadtree.hpp>
+#include <shogun/lib/tapkee/external/barnes_hut_sne/sptree.hpp>
 #include <shogun/lib/tapkee/external/barnes_hut_sne/vptree.hpp>
 /* End of Tapkee includes */
 
@@ -60,8 +60,9 @@ class TSNE
 public:
 	void run(tapkee::DenseMatrix& X, int N, int D, ScalarType* Y, int no_dims, ScalarType perplexity, ScalarType theta)
 	{
-		// Determine whether we are using an exact algorithm
-		bool exact = (theta == .0) ? true : false;
+		// Determine whether we are using an exact algorithm, space-partitioning
+		// trees are only available for two and three dimensional embeddings
+		bool exact = (theta == .0 || (no_dims != 2 && no_dims != 3)) ? true : false;
 		if (exact)
 			tapkee::LoggingSingleton::instance().message_info("Using exact t-SNE algorithm");
 		else
@@ -130,11 +131,14 @@ public:
 
 		{
 			tapkee::tapkee_internal::timed_context context("Main t-SNE loop");
+			SPTree<2> tree_2d;
+			SPTree<3> tree_3d;
 			for(int iter = 0; iter < max_iter; iter++) {
 
 				// Compute (approximate) gradient
 				if(exact) computeExactGradient(P.data(), Y, N, no_dims, dY.data());
-				else computeGradient(P.data(), row_P, col_P, val_P, Y, N, no_dims, dY.data(), theta);
+				else if(no_dims == 2) computeGradient(tree_2d, row_P, col_P, val_P, Y, N, dY.data(), theta);
+				else computeGradient(tree_3d, row_P, col_P, val_P, Y, N, dY.data(), theta);
 
 				// Update gains
 				for(int i = 0; i < N * no_dims; i++) gains.data()[i] = (sign(dY.data()[i]) != sign(uY.data()[i])) ? (gains.data()[i] + .2) : (gains.data()[i] * .8);
@@ -162,7 +166,8 @@ public:
 				if((iter > 0) && ((iter % 50 == 0) || (iter == max_iter - 1))) {
 					ScalarType C = .0;
 					if(exact) C = evaluateError(P.data(), Y, N);
-					else      C = evaluateError(row_P, col_P, val_P, Y, N, theta);  // doing approximate computation here!
+					else if(no_dims == 2) C = evaluateError(tree_2d, row_P, col_P, val_P, Y, N, theta);  // doing approximate computation here!
+					else      C = evaluateError(tree_3d, row_P, col_P, val_P, Y, N, theta);
 					tapkee::LoggingSingleton::instance().message_info(
 							formatting::format("Iteration {}: error is {}\n", iter, C));
 				}
@@ -265,26 +270,36 @@ public:
 
 private:
 
-	void computeGradient(ScalarType* /*P*/, int* inp_row_P, int* inp_col_P, ScalarType* inp_val_P, ScalarType* Y, int N, int D, ScalarType* dC, ScalarType theta)
+	template <int NDims>
+	void computeGradient(SPTree<NDims>& tree, int* inp_row_P, int* inp_col_P, ScalarType* inp_val_P, ScalarType* Y, int N, ScalarType* dC, ScalarType theta)
 	{
-		// Construct quadtree on current map
-		QuadTree* tree = new QuadTree(Y, N);
+		// Construct space-partitioning tree on current map
+		tree.build(Y, N);
+
+		// Compute all terms required for t-SNE gradient, the tree is
+		// read-only and every point only writes its own forces
+		ScalarType* pos_f = (ScalarType*) calloc(N * NDims, sizeof(ScalarType));
+		ScalarType* neg_f = (ScalarType*) calloc(N * NDims, sizeof(ScalarType));
+		ScalarType* point_Q = (ScalarType*) calloc(N, sizeof(ScalarType));
+		if(pos_f == NULL || neg_f == NULL || point_Q == NULL) { printf("Memory allocation failed!\n"); exit(1); }
+#pragma omp parallel for schedule(dynamic, 64)
+		for(int n = 0; n < N; n++) {
+			tree.computeEdgeForces(inp_row_P, inp_col_P, inp_val_P, n, pos_f + n * NDims);
+			tree.computeNonEdgeForces(n, theta, neg_f + n * NDims, point_Q + n);
+		}
 
-		// Compute all terms required for t-SNE gradient
+		// Sum the normalization term in a fixed order, a reduction would make
+		// the embedding depend on the number of threads
 		ScalarType sum_Q = .0;
-		ScalarType* pos_f = (ScalarType*) calloc(N * D, sizeof(ScalarType));
-		ScalarType* neg_f = (ScalarType*) calloc(N * D, sizeof(ScalarType));
-		if(pos_f == NULL || neg_f == NULL) { printf("Memory allocation failed!\n"); exit(1); }
-		tree->computeEdgeForces(inp_row_P, inp_col_P, inp_val_P, N, pos_f);
-		for(int n = 0; n < N; n++) tree->computeNonEdgeForces(n, theta, neg_f + n * D, &sum_Q);
+		for(int n = 0; n < N; n++) sum_Q += point_Q[n];
+		free(point_Q);
 
 		// Compute final t-SNE gradient
-		for(int i = 0; i < N * D; i++) {
+		for(int i = 0; i < N * NDims; i++) {
 			dC[i] = pos_f[i] - (neg_f[i] / sum_Q);
 		}
 		free(pos_f);
 		free(neg_f);
-		delete tree;
 	}
 
 	void computeExactGradient(ScalarType* P, ScalarType* Y, int N, int D, ScalarType* dC)
@@ -362,26 +377,28 @@ private:
 		return C;
 	}
 
-	ScalarType evaluateError(int* row_P, int* col_P, ScalarType* val_P, ScalarType* Y, int N, ScalarType theta)
+	template <int NDims>
+	ScalarType evaluateError(SPTree<NDims>& tree, int* row_P, int* col_P, ScalarType* val_P, ScalarType* Y, int N, ScalarType theta)
 	{
 		// Get estimate of normalization term
-		const int QT_NO_DIMS = 2;
-		QuadTree* tree = new QuadTree(Y, N);
-		ScalarType buff[QT_NO_DIMS] = {.0, .0};
+		tree.build(Y, N);
 		ScalarType sum_Q = .0;
-		for(int n = 0; n < N; n++) tree->computeNonEdgeForces(n, theta, buff, &sum_Q);
+#pragma omp parallel for schedule(dynamic, 64) reduction(+:sum_Q)
+		for(int n = 0; n < N; n++) {
+			ScalarType buff[NDims] = {};
+			tree.computeNonEdgeForces(n, theta, buff, &sum_Q);
+		}
 
 		// Loop over all edges to compute t-SNE error
-		int ind1, ind2;
-		ScalarType C = .0, Q;
+		ScalarType C = .0;
+#pragma omp parallel for reduction(+:C)
 		for(int n = 0; n < N; n++) {
-			ind1 = n * QT_NO_DIMS;
 			for(int i = row_P[n]; i < row_P[n + 1]; i++) {
-				Q = .0;
-				ind2 = col_P[i] * QT_NO_DIMS;
-				for(int d = 0; d < QT_NO_DIMS; d++) buff[d]  = Y[ind1 + d];
-				for(int d = 0; d < QT_NO_DIMS; d++) buff[d] -= Y[ind2 + d];
-				for(int d = 0; d < QT_NO_DIMS; d++) Q += buff[d] * buff[d];
+				ScalarType Q = .0;
+				for(int d = 0; d < NDims; d++) {
+					ScalarType diff = Y[n * NDims + d] - Y[col_P[i] * NDims + d];
+					Q += diff * diff;
+				}
 				Q = (1.0 / (1.0 + Q)) / sum_Q;
 				C += val_P[i] * log((val_P[i] + FLT_MIN) / (Q + FLT_MIN));
 			}
@@ -491,8 +508,6 @@ private:
 		int* row_P = *_row_P;
 		int* col_P = *_col_P;
 		ScalarType* val_P = *_val_P;
-		ScalarType* cur_P = (ScalarType*) malloc((N - 1) * sizeof(ScalarType));
-		if(cur_P == NULL) { printf("Memory allocation failed!\n"); exit(1); }
 		row_P[0] = 0;
 		for(int n = 0; n < N; n++) row_P[n + 1] = row_P[n] + K;
 
@@ -502,77 +517,79 @@ private:
 		for(int n = 0; n < N; n++) obj_X[n] = DataPoint(D, n, X + n * D);
 		tree->create(obj_X);
 
-		// Loop over all points to find nearest neighbors
-		//printf("Building tree...\n");
-		std::vector<DataPoint> indices;
-		std::vector<ScalarType> distances;
-		for(int n = 0; n < N; n++) {
-
-			//if(n % 10000 == 0) printf(" - point %d of %d\n", n, N);
-
-			// Find nearest neighbors
-			indices.clear();
-			distances.clear();
-			tree->search(obj_X[n], K + 1, &indices, &distances);
-
-			// Initialize some variables for binary search
-			bool found = false;
-			ScalarType beta = 1.0;
-			ScalarType min_beta = -DBL_MAX;
-			ScalarType max_beta =  DBL_MAX;
-			ScalarType tol = 1e-5;
-
-			// Iterate until we found a good perplexity
-			int iter = 0; ScalarType sum_P;
-			while(!found && iter < 200) {
-
-				// Compute Gaussian kernel row
-				for(int m = 0; m < K; m++) cur_P[m] = exp(-beta * distances[m + 1]);
-
-				// Compute entropy of current row
-				sum_P = DBL_MIN;
-				for(int m = 0; m < K; m++) sum_P += cur_P[m];
-				ScalarType H = .0;
-				for(int m = 0; m < K; m++) H += beta * (distances[m + 1] * cur_P[m]);
-				H = (H / sum_P) + log(sum_P);
-
-				// Evaluate whether the entropy is within the tolerance level
-				ScalarType Hdiff = H - log(perplexity);
-				if(Hdiff < tol && -Hdiff < tol) {
-					found = true;
-				}
-				else {
-					if(Hdiff > 0) {
-						min_beta = beta;
-						if(max_beta == DBL_MAX || max_beta == -DBL_MAX)
-							beta *= 2.0;
-						else
-							beta = (beta + max_beta) / 2.0;
+		// Loop over all points to find nearest neighbors, rows of P are
+		// independent and the tree is only read
+#pragma omp parallel
+		{
+			std::vector<DataPoint> indices;
+			std::vector<ScalarType> distances;
+			std::vector<ScalarType> cur_P(K);
+#pragma omp for schedule(dynamic, 64)
+			for(int n = 0; n < N; n++) {
+
+				// Find nearest neighbors
+				indices.clear();
+				distances.clear();
+				tree->search(obj_X[n], K + 1, &indices, &distances);
+
+				// Initialize some variables for binary search
+				bool found = false;
+				ScalarType beta = 1.0;
+				ScalarType min_beta = -DBL_MAX;
+				ScalarType max_beta =  DBL_MAX;
+				ScalarType tol = 1e-5;
+
+				// Iterate until we found a good perplexity
+				int iter = 0; ScalarType sum_P;
+				while(!found && iter < 200) {
+
+					// Compute Gaussian kernel row
+					for(int m = 0; m < K; m++) cur_P[m] = exp(-beta * distances[m + 1]);
+
+					// Compute entropy of current row
+					sum_P = DBL_MIN;
+					for(int m = 0; m < K; m++) sum_P += cur_P[m];
+					ScalarType H = .0;
+					for(int m = 0; m < K; m++) H += beta * (distances[m + 1] * cur_P[m]);
+					H = (H / sum_P) + log(sum_P);
+
+					// Evaluate whether the entropy is within the tolerance level
+					ScalarType Hdiff = H - log(perplexity);
+					if(Hdiff < tol && -Hdiff < tol) {
+						found = true;
 					}
 					else {
-						max_beta = beta;
-						if(min_beta == -DBL_MAX || min_beta == DBL_MAX)
-							beta /= 2.0;
-						else
-							beta = (beta + min_beta) / 2.0;
+						if(Hdiff > 0) {
+							min_beta = beta;
+							if(max_beta == DBL_MAX || max_beta == -DBL_MAX)
+								beta *= 2.0;
+							else
+								beta = (beta + max_beta) / 2.0;
+						}
+						else {
+							max_beta = beta;
+							if(min_beta == -DBL_MAX || min_beta == DBL_MAX)
+								beta /= 2.0;
+							else
+								beta = (beta + min_beta) / 2.0;
+						}
 					}
-				}
 
-				// Update iteration counter
-				iter++;
-			}
+					// Update iteration counter
+					iter++;
+				}
 
-			// Row-normalize current row of P and store in matrix
-			for(int m = 0; m < K; m++) cur_P[m] /= sum_P;
-			for(int m = 0; m < K; m++) {
-				col_P[row_P[n] + m] = indices[m + 1].index();
-				val_P[row_P[n] + m] = cur_P[m];
+				// Row-normalize current row of P and store in matrix
+				for(int m = 0; m < K; m++) cur_P[m] /= sum_P;
+				for(int m = 0; m < K; m++) {
+					col_P[row_P[n] + m] = indices[m + 1].index();
+					val_P[row_P[n] + m] = cur_P[m];
+				}
 			}
 		}
 
 		// Clean up memory
 		obj_X.clear();
-		free(cur_P);
 		delete tree;
 	}
 
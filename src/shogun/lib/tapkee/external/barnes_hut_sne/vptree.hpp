@@ -89,7 +89,7 @@ class VpTree
 public:
 
 	// Default constructor
-	VpTree() :  _items(), _tau(0.0), _root(0) {}
+	VpTree() :  _items(), _root(0) {}
 
 	// Destructor
 	~VpTree() {
@@ -103,18 +103,19 @@ public:
 		_root = buildFromPoints(0, items.size());
 	}
 
-	// Function that uses the tree to find the k nearest neighbors of target
-	void search(const T& target, int k, std::vector<T>* results, std::vector<ScalarType>* distances)
+	// Function that uses the tree to find the k nearest neighbors of target,
+	// can be called concurrently as the search does not modify the tree
+	void search(const T& target, int k, std::vector<T>* results, std::vector<ScalarType>* distances) const
 	{
 
 		// Use a priority queue to store intermediate results on
 		std::priority_queue<HeapItem> heap;
 
 		// Variable that tracks the distance to the farthest point in our results
-		_tau = DBL_MAX;
+		ScalarType tau = DBL_MAX;
 
-		// Perform the searcg
-		search(_root, target, k, heap);
+		// Perform the search
+		search(_root, target, k, heap, tau);
 
 		// Gather final results
 		results->clear(); distances->clear();
@@ -135,7 +136,6 @@ private:
 	VpTree& operator=(const VpTree&);
 
 	std::vector<T> _items;
-	ScalarType _tau;
 
 	// Single node of a VP tree (has a point and radius; left children are closer to point than the radius)
 	struct Node
@@ -218,7 +218,7 @@ private:
 	}
 
 	// Helper function that searches the tree
-	void search(Node* node, const T& target, int k, std::priority_queue<HeapItem>& heap)
+	void search(Node* node, const T& target, int k, std::priority_queue<HeapItem>& heap, ScalarType& tau) const
 	{
 		if(node == NULL) return;     // indicates that we're done here
 
@@ -226,10 +226,10 @@ private:
 		ScalarType dist = distance(_items[node->index], target);
 
 		// If current node within radius tau
-		if(dist < _tau) {
+		if(dist < tau) {
 			if(heap.size() == static_cast<size_t>(k)) heap.pop(); // remove furthest node from result list (if we already have k results)
 			heap.push(HeapItem(node->index, dist));           // add current node to result list
-			if(heap.size() == static_cast<size_t>(k)) _tau = heap.top().dist;     // update value of tau (farthest point in result list)
+			if(heap.size() == static_cast<size_t>(k)) tau = heap.top().dist;     // update value of tau (farthest point in result list)
 		}
 
 		// Return if we arrived at a leaf
@@ -239,18 +239,18 @@ private:
 
 		// If the target lies within the radius of ball
 		if(dist < node->threshold) {
-			search(node->left, target, k, heap);
+			search(node->left, target, k, heap, tau);
 
-			if(dist + _tau >= node->threshold) {         // if there can still be neighbors outside the ball, recursively search right child
-				search(node->right, target, k, heap);
+			if(dist + tau >= node->threshold) {         // if there can still be neighbors outside the ball, recursively search right child
+				search(node->right, target, k, heap, tau);
 			}
 
 			// If the target lies outsize the radius of the ball
 		} else {
-			search(node->right, target, k, heap);
+			search(node->right, target, k, heap, tau);
 
-			if (dist - _tau <= node->threshold) {         // if there can still be neighbors inside the ball, recursively search left child
-				search(node->left, target, k, heap);
+			if (dist - tau <= node->threshold) {         // if there can still be neighbors inside the ball, recursively search left child
+				search(node->left, target, k, heap, tau);
 			}
 		}
 	}
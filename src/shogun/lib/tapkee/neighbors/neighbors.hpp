@@ -124,26 +124,36 @@ Neighbors find_neighbors_bruteforce_impl(const RandomAccessIterator& begin, cons
 	typedef std::pair<RandomAccessIterator, ScalarType> DistanceRecord;
 	typedef std::vector<DistanceRecord> Distances;
 
-	Neighbors neighbors;
-	neighbors.reserve(end-begin);
-	for (RandomAccessIterator iter=begin; iter!=end; ++iter)
+	const IndexType N = end-begin;
+	Neighbors neighbors(N);
+
+	// rows of the neighbors graph are independent
+#pragma omp parallel
 	{
 		Distances distances;
-		for (RandomAccessIterator around_iter=begin; around_iter!=end; ++around_iter)
-			distances.push_back(std::make_pair(around_iter, callback.distance(iter,around_iter)));
-
-		std::nth_element(distances.begin(),distances.begin()+k+1,distances.end(),
-		                 distances_comparator<DistanceRecord>());
+		distances.reserve(N);
 
-		LocalNeighbors local_neighbors;
-		local_neighbors.reserve(k);
-		for (typename Distances::const_iterator neighbors_iter=distances.begin();
-				neighbors_iter!=distances.begin()+k+1; ++neighbors_iter)
+#pragma omp for schedule(dynamic, 16)
+		for (IndexType i=0; i<N; ++i)
 		{
-			if (neighbors_iter->first != iter)
+			RandomAccessIterator iter = begin+i;
+			distances.clear();
+			for (RandomAccessIterator around_iter=begin; around_iter!=end; ++around_iter)
+			{
+				if (around_iter != iter)
+					distances.push_back(std::make_pair(around_iter, callback.distance(iter,around_iter)));
+			}
+
+			std::nth_element(distances.begin(),distances.begin()+k,distances.end(),
+			                 distances_comparator<DistanceRecord>());
+
+			LocalNeighbors local_neighbors;
+			local_neighbors.reserve(k);
+			for (typename Distances::const_iterator neighbors_iter=distances.begin();
+					neighbors_iter!=distances.begin()+k; ++neighbors_iter)
 				local_neighbors.push_back(neighbors_iter->first - begin);
+			neighbors[i] = local_neighbors;
 		}
-		neighbors.push_back(local_neighbors);
 	}
 	return neighbors;
 }
@@ -154,16 +164,23 @@ Neighbors find_neighbors_vptree_impl(const RandomAccessIterator& begin, const Ra
 {
 	timed_context context("VP-Tree based neighbors search");
 
-	Neighbors neighbors;
-	neighbors.reserve(end-begin);
+	const IndexType N = end-begin;
+	Neighbors neighbors(N);
 
 	VantagePointTree<RandomAccessIterator,Callback> tree(begin,end,callback);
 
-	for (RandomAccessIterator i=begin; i!=end; ++i)
+	// queries do not modify the tree
+#pragma omp parallel for schedule(dynamic, 16)
+	for (IndexType i=0; i<N; ++i)
 	{
-		LocalNeighbors local_neighbors = tree.search(i,k+1);
-		std::remove(local_neighbors.begin(),local_neighbors.end(),i-begin);
-		neighbors.push_back(local_neighbors);
+		LocalNeighbors local_neighbors = tree.search(begin+i,k+1);
+		local_neighbors.erase(std::remove(local_neighbors.begin(),local_neighbors.end(),i),
+		                      local_neighbors.end());
+		// the query point may be missing among duplicates, results are
+		// ordered from the farthest so drop the farthest one instead
+		if (static_cast<IndexType>(local_neighbors.size()) > k)
+			local_neighbors.erase(local_neighbors.begin());
+		neighbors[i] = local_neighbors;
 	}
 
 	return neighbors;
@@ -76,6 +76,56 @@ EigendecompositionResult generalized_eigendecomposition_impl_dense(const LMatrix
 	return EigendecompositionResult();
 }
 
+//! Randomized implementation of the generalized eigenproblem L x = lambda D x
+//! of a graph laplacian L = D - W. It is equivalent to the eigenproblem of the
+//! normalized laplacian N = D^{-1/2} L D^{-1/2} with x = D^{-1/2} z. A range of
+//! the smallest eigenvalues of N is found by randomized subspace iteration on
+//! the slightly shifted inverse (N + shift I)^{-1}, with one sparse
+//! factorization and a few solves, and is refined with a Rayleigh-Ritz step
+//! on N itself.
+inline EigendecompositionResult generalized_eigendecomposition_impl_randomized(const SparseWeightMatrix& lhs,
+		const DenseDiagonalMatrix& rhs, IndexType target_dimension, unsigned int skip)
+{
+	timed_context context("Randomized generalized eigendecomposition");
+
+	const IndexType n = lhs.rows();
+	const IndexType n_oversampling = 10;
+	const IndexType n_iterations = 4;
+	const ScalarType shift = 1e-6;
+	const IndexType k = std::min<IndexType>(target_dimension+skip+n_oversampling, n);
+
+	DenseVector inv_sqrt_degree = rhs.diagonal().cwiseSqrt().cwiseInverse();
+	SparseWeightMatrix normalized = inv_sqrt_degree.asDiagonal()*lhs*inv_sqrt_degree.asDiagonal();
+	SparseWeightMatrix identity(n,n);
+	identity.setIdentity();
+	SparseSolver solver;
+	solver.compute(normalized + shift*identity);
+	if (solver.info() != Eigen::Success)
+		throw eigendecomposition_error("factorization of the normalized laplacian failed");
+
+	DenseMatrix Y(n,k);
+	for (IndexType i=0; i<n; ++i)
+	{
+		for (IndexType j=0; j<k; ++j)
+			Y(i,j) = tapkee::gaussian_random();
+	}
+	for (IndexType i=0; i<=n_iterations; ++i)
+	{
+		DenseMatrix solved = solver.solve(Y);
+		Eigen::HouseholderQR<DenseMatrix> qr(solved);
+		Y = qr.householderQ()*DenseMatrix::Identity(n,k);
+	}
+
+	DenseMatrix B = Y.transpose()*(normalized*Y);
+	DenseSelfAdjointEigenSolver eigenOfB(B);
+	if (eigenOfB.info() != Eigen::Success)
+		throw eigendecomposition_error("eigendecomposition failed");
+
+	DenseMatrix selected_eigenvectors =
+		inv_sqrt_degree.asDiagonal()*(Y*eigenOfB.eigenvectors().middleCols(skip,target_dimension));
+	return EigendecompositionResult(selected_eigenvectors,eigenOfB.eigenvalues().segment(skip,target_dimension));
+}
+
 template <typename LMatrixType, typename RMatrixType>
 struct generalized_eigendecomposition_impl
 {
@@ -89,6 +139,10 @@ struct generalized_eigendecomposition_impl
                                    const ComputationStrategy& strategy,
                                    const EigendecompositionStrategy& eigen_strategy,
                                    IndexType target_dimension);
+	EigendecompositionResult randomized(const LMatrixType& lhs, const RMatrixType& rhs,
+                                        const ComputationStrategy& strategy,
+                                        const EigendecompositionStrategy& eigen_strategy,
+                                        IndexType target_dimension);
 };
 
 template <>
@@ -128,6 +182,21 @@ struct generalized_eigendecomposition_impl<SparseWeightMatrix, DenseDiagonalMatr
 		unsupported();
 		return EigendecompositionResult();
 	}
+	EigendecompositionResult randomized(const SparseWeightMatrix& lhs, const DenseDiagonalMatrix& rhs,
+                                        const ComputationStrategy& strategy,
+                                        const EigendecompositionStrategy& eigen_strategy,
+                                        IndexType target_dimension)
+	{
+		if (strategy.is(HomogeneousCPUStrategy))
+		{
+			if (eigen_strategy.is(SmallestEigenvalues))
+				return generalized_eigendecomposition_impl_randomized
+					(lhs,rhs,target_dimension,eigen_strategy.skip());
+			unsupported();
+		}
+		unsupported();
+		return EigendecompositionResult();
+	}
 	inline void unsupported() const
 	{
 		throw unsupported_method_error("Unsupported method");
@@ -171,6 +240,14 @@ struct generalized_eigendecomposition_impl<DenseMatrix, DenseMatrix>
 		unsupported();
 		return EigendecompositionResult();
 	}
+	EigendecompositionResult randomized(const DenseMatrix&, const DenseMatrix&,
+                                        const ComputationStrategy&,
+                                        const EigendecompositionStrategy&,
+                                        IndexType)
+	{
+		unsupported();
+		return EigendecompositionResult();
+	}
 	inline void unsupported() const
 	{
 		throw unsupported_method_error("Unsupported method");
@@ -193,7 +270,8 @@ EigendecompositionResult generalized_eigendecomposition(const EigenMethod& metho
 		return generalized_eigendecomposition_impl<LMatrixType, RMatrixType>()
 			.dense(lhs, rhs, strategy, eigen_strategy, target_dimension);
 	if (method.is(Randomized))
-		throw unsupported_method_error("Randomized method is not supported for generalized eigenproblems");
+		return generalized_eigendecomposition_impl<LMatrixType, RMatrixType>()
+			.randomized(lhs, rhs, strategy, eigen_strategy, target_dimension);
 	return EigendecompositionResult();
 }
 
@@ -87,6 +87,42 @@ std::shared_ptr<DenseFeatures<float64_t>> shogun::tapkee_embed(const shogun::TAP
 #else
 	tapkee::NeighborsMethod neighbors_method = tapkee::VpTree;
 #endif
+	switch (parameters.eigen_method)
+	{
+		case EMBEDDING_EIGEN_AUTO:
+			break;
+		case EMBEDDING_EIGEN_DENSE:
+			eigen_method = tapkee::Dense;
+			break;
+		case EMBEDDING_EIGEN_ARPACK:
+#ifdef HAVE_ARPACK
+			eigen_method = tapkee::Arpack;
+#else
+			error("ARPACK eigensolver requested, but shogun was built without ARPACK");
+#endif
+			break;
+		case EMBEDDING_EIGEN_RANDOMIZED:
+			eigen_method = tapkee::Randomized;
+			break;
+	}
+	switch (parameters.neighbors_method)
+	{
+		case EMBEDDING_NEIGHBORS_AUTO:
+			break;
+		case EMBEDDING_NEIGHBORS_BRUTE_FORCE:
+			neighbors_method = tapkee::Brute;
+			break;
+		case EMBEDDING_NEIGHBORS_VP_TREE:
+			neighbors_method = tapkee::VpTree;
+			break;
+		case EMBEDDING_NEIGHBORS_COVER_TREE:
+#ifdef TAPKEE_USE_LGPL_COVERTREE
+			neighbors_method = tapkee::CoverTree;
+#else
+			error("Cover tree requested, but shogun was built without GPL code");
+#endif
+			break;
+	}
 	size_t N = 0;
 
 	switch (parameters.method)
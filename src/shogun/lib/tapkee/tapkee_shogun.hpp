@@ -9,6 +9,7 @@
 #include <shogun/lib/config.h>
 
 
+#include <shogun/converter/EmbeddingConverter.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/kernel/Kernel.h>
 #include <shogun/distance/Distance.h>
@@ -51,6 +52,8 @@ struct TAPKEE_PARAMETERS_FOR_SHOGUN
 		spe_global_strategy(false), max_iteration(100),
 		fa_epsilon(1e-5), sne_theta(0.5),
 		sne_perplexity(30.0), squishing_rate(0.99),
+		eigen_method(EMBEDDING_EIGEN_AUTO),
+		neighbors_method(EMBEDDING_NEIGHBORS_AUTO),
 		kernel(NULL), distance(NULL), features(NULL)
 	{
 	}
@@ -69,6 +72,8 @@ struct TAPKEE_PARAMETERS_FOR_SHOGUN
 	float64_t sne_theta;
 	float64_t sne_perplexity;
 	float64_t squishing_rate;
+	EEmbeddingEigenMethod eigen_method;
+	EEmbeddingNeighborsMethod neighbors_method;
 	Kernel* kernel;
 	Distance* distance;
 	DotFeatures* features;
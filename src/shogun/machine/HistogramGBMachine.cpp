@@ -0,0 +1,620 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/base/progress.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/machine/HistogramGBMachine.h>
+#include <shogun/mathematics/RandomNamespace.h>
+
+#include <algorithm>
+#include <numeric>
+
+using namespace shogun;
+
+namespace
+{
+	/** gradient statistics of the vectors in one bin */
+	struct HistogramBin
+	{
+		float64_t sum_gradients = 0;
+		float64_t sum_hessians = 0;
+		index_t count = 0;
+	};
+
+	/** best split of a leaf, vectors with a bin at most bin go left */
+	struct Split
+	{
+		float64_t gain = 0;
+		int32_t feature = -1;
+		int32_t bin = -1;
+		float64_t left_gradients = 0;
+		float64_t left_hessians = 0;
+	};
+
+	/** leaf of the tree that is grown, its vectors are the range
+	 * [begin, end) of the row array
+	 */
+	struct Leaf
+	{
+		int32_t node;
+		index_t begin;
+		index_t end;
+		float64_t sum_gradients;
+		float64_t sum_hessians;
+		std::vector<HistogramBin> histogram;
+		Split split;
+	};
+} // namespace
+
+/** accumulates the histograms of all features over the given rows */
+static void build_histogram(
+    const std::vector<uint8_t>& bins, index_t num_vectors,
+    const SGVector<index_t>& bin_offsets, const index_t* rows,
+    index_t num_rows, const std::vector<float64_t>& gradients,
+    const std::vector<float64_t>& hessians,
+    std::vector<HistogramBin>& histogram)
+{
+	int32_t num_features = bin_offsets.vlen - 1;
+	histogram.assign(bin_offsets[num_features] + num_features, HistogramBin());
+
+#pragma omp parallel for schedule(dynamic)
+	for (int32_t f = 0; f < num_features; ++f)
+	{
+		const uint8_t* feature_bins = bins.data() + size_t(f) * num_vectors;
+		HistogramBin* feature_histogram =
+		    histogram.data() + bin_offsets[f] + f;
+		for (index_t i = 0; i < num_rows; ++i)
+		{
+			auto row = rows[i];
+			auto& bin = feature_histogram[feature_bins[row]];
+			bin.sum_gradients += gradients[row];
+			bin.sum_hessians += hessians[row];
+			++bin.count;
+		}
+	}
+}
+
+/** scans the histograms of a leaf for the split with the largest gain */
+static Split find_split(
+    const Leaf& leaf, const SGVector<index_t>& bin_offsets,
+    int32_t min_samples_leaf, float64_t l2_regularization)
+{
+	int32_t num_features = bin_offsets.vlen - 1;
+	index_t count = leaf.end - leaf.begin;
+	float64_t parent_score = leaf.sum_gradients * leaf.sum_gradients /
+	                         (leaf.sum_hessians + l2_regularization);
+
+	std::vector<Split> splits(num_features);
+#pragma omp parallel for schedule(dynamic)
+	for (int32_t f = 0; f < num_features; ++f)
+	{
+		const HistogramBin* feature_histogram =
+		    leaf.histogram.data() + bin_offsets[f] + f;
+		int32_t num_bins = bin_offsets[f + 1] - bin_offsets[f] + 1;
+
+		float64_t left_gradients = 0;
+		float64_t left_hessians = 0;
+		index_t left_count = 0;
+		for (int32_t b = 0; b < num_bins - 1; ++b)
+		{
+			left_gradients += feature_histogram[b].sum_gradients;
+			left_hessians += feature_histogram[b].sum_hessians;
+			left_count += feature_histogram[b].count;
+			if (left_count < min_samples_leaf)
+				continue;
+			if (count - left_count < min_samples_leaf)
+				break;
+
+			float64_t right_gradients = leaf.sum_gradients - left_gradients;
+			float64_t right_hessians = leaf.sum_hessians - left_hessians;
+			if (left_hessians + l2_regularization <= 0 ||
+			    right_hessians + l2_regularization <= 0)
+				continue;
+
+			float64_t gain = left_gradients * left_gradients /
+			                     (left_hessians + l2_regularization) +
+			                 right_gradients * right_gradients /
+			                     (right_hessians + l2_regularization) -
+			                 parent_score;
+			if (gain > splits[f].gain)
+			{
+				splits[f] = {gain, f, b, left_gradients, left_hessians};
+			}
+		}
+	}
+
+	Split best;
+	for (const auto& split : splits)
+	{
+		if (split.gain > best.gain)
+			best = split;
+	}
+	return best;
+}
+
+HistogramGBMachine::HistogramGBMachine(
+    const std::shared_ptr<LossFunction>& loss, int32_t num_iterations,
+    float64_t learning_rate, int32_t max_leaves)
+    : RandomMixin<Machine>()
+{
+	init();
+
+	m_loss = loss;
+	m_num_iterations = num_iterations;
+	m_learning_rate = learning_rate;
+	m_max_leaves = max_leaves;
+}
+
+HistogramGBMachine::~HistogramGBMachine()
+{
+}
+
+void HistogramGBMachine::init()
+{
+	m_loss = nullptr;
+	m_num_iterations = 100;
+	m_learning_rate = 0.1;
+	m_subset_fraction = 1.0;
+	m_max_bins = 255;
+	m_max_leaves = 31;
+	m_min_samples_leaf = 20;
+	m_l2_regularization = 0;
+	m_bias = 0;
+
+	SG_ADD(&m_loss, "loss", "loss function");
+	SG_ADD(
+	    &m_num_iterations, "num_iterations", "number of boosting rounds",
+	    ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_learning_rate, "learning_rate", "learning rate",
+	    ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_subset_fraction, "subset_fraction",
+	    "fraction of the vectors each tree is fitted to",
+	    ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_max_bins, "max_bins", "maximum number of bins per feature",
+	    ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_max_leaves, "max_leaves", "maximum number of leaves of a tree",
+	    ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_min_samples_leaf, "min_samples_leaf",
+	    "minimum number of vectors in a leaf", ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_l2_regularization, "l2_regularization",
+	    "L2 regularization of the leaf values", ParameterProperties::HYPER);
+	SG_ADD(&m_bin_thresholds, "bin_thresholds", "upper bin thresholds");
+	SG_ADD(&m_bin_offsets, "bin_offsets", "offsets of the bin thresholds");
+	SG_ADD(&m_bias, "bias", "constant prediction");
+	SG_ADD(&m_tree_roots, "tree_roots", "root node of each tree");
+	SG_ADD(&m_node_features, "node_features", "split feature of each node");
+	SG_ADD(
+	    &m_node_thresholds, "node_thresholds", "split threshold of each node");
+	SG_ADD(&m_node_left, "node_left", "left child of each node");
+	SG_ADD(&m_node_right, "node_right", "right child of each node");
+	SG_ADD(&m_node_values, "node_values", "value of each leaf");
+}
+
+void HistogramGBMachine::set_loss_function(
+    const std::shared_ptr<LossFunction>& loss)
+{
+	require(loss, "Supplied loss function is NULL");
+	m_loss = loss;
+}
+
+std::shared_ptr<LossFunction> HistogramGBMachine::get_loss_function() const
+{
+	return m_loss;
+}
+
+void HistogramGBMachine::set_num_iterations(int32_t num_iterations)
+{
+	require(
+	    num_iterations > 0, "Number of iterations ({}) must be positive",
+	    num_iterations);
+	m_num_iterations = num_iterations;
+}
+
+int32_t HistogramGBMachine::get_num_iterations() const
+{
+	return m_num_iterations;
+}
+
+void HistogramGBMachine::set_learning_rate(float64_t learning_rate)
+{
+	require(
+	    learning_rate > 0 && learning_rate <= 1,
+	    "Learning rate should lie between 0 and 1. Supplied value is {}",
+	    learning_rate);
+	m_learning_rate = learning_rate;
+}
+
+float64_t HistogramGBMachine::get_learning_rate() const
+{
+	return m_learning_rate;
+}
+
+void HistogramGBMachine::set_subset_fraction(float64_t fraction)
+{
+	require(
+	    fraction > 0 && fraction <= 1,
+	    "Subset fraction should lie between 0 and 1. Supplied value is {}",
+	    fraction);
+	m_subset_fraction = fraction;
+}
+
+float64_t HistogramGBMachine::get_subset_fraction() const
+{
+	return m_subset_fraction;
+}
+
+void HistogramGBMachine::set_max_bins(int32_t max_bins)
+{
+	require(
+	    max_bins >= 2 && max_bins <= 256,
+	    "Number of bins ({}) should lie between 2 and 256", max_bins);
+	m_max_bins = max_bins;
+}
+
+int32_t HistogramGBMachine::get_max_bins() const
+{
+	return m_max_bins;
+}
+
+void HistogramGBMachine::set_max_leaves(int32_t max_leaves)
+{
+	require(
+	    max_leaves >= 2, "Number of leaves ({}) must be at least 2",
+	    max_leaves);
+	m_max_leaves = max_leaves;
+}
+
+int32_t HistogramGBMachine::get_max_leaves() const
+{
+	return m_max_leaves;
+}
+
+void HistogramGBMachine::set_min_samples_leaf(int32_t min_samples_leaf)
+{
+	require(
+	    min_samples_leaf >= 1,
+	    "Minimum number of vectors in a leaf ({}) must be positive",
+	    min_samples_leaf);
+	m_min_samples_leaf = min_samples_leaf;
+}
+
+int32_t HistogramGBMachine::get_min_samples_leaf() const
+{
+	return m_min_samples_leaf;
+}
+
+void HistogramGBMachine::set_l2_regularization(float64_t l2_regularization)
+{
+	require(
+	    l2_regularization >= 0, "L2 regularization ({}) must not be negative",
+	    l2_regularization);
+	m_l2_regularization = l2_regularization;
+}
+
+float64_t HistogramGBMachine::get_l2_regularization() const
+{
+	return m_l2_regularization;
+}
+
+int32_t HistogramGBMachine::get_num_trees() const
+{
+	return m_tree_roots.vlen;
+}
+
+std::vector<uint8_t> HistogramGBMachine::compute_bins(
+    const std::shared_ptr<DenseFeatures<float64_t>>& features)
+{
+	auto matrix = features->get_feature_matrix();
+	int32_t num_features = matrix.num_rows;
+	index_t num_vectors = matrix.num_cols;
+
+	std::vector<std::vector<float64_t>> thresholds(num_features);
+	std::vector<uint8_t> bins(size_t(num_features) * num_vectors);
+
+#pragma omp parallel for schedule(dynamic)
+	for (int32_t f = 0; f < num_features; ++f)
+	{
+		std::vector<float64_t> sorted(num_vectors);
+		for (index_t i = 0; i < num_vectors; ++i)
+			sorted[i] = matrix(f, i);
+		std::sort(sorted.begin(), sorted.end());
+
+		std::vector<float64_t> distinct;
+		std::unique_copy(
+		    sorted.begin(), sorted.end(), std::back_inserter(distinct));
+
+		auto& feature_thresholds = thresholds[f];
+		if (distinct.size() <= size_t(m_max_bins))
+		{
+			// one bin per value, split halfway between them
+			for (size_t i = 1; i < distinct.size(); ++i)
+			{
+				feature_thresholds.push_back(
+				    (distinct[i - 1] + distinct[i]) / 2);
+			}
+		}
+		else
+		{
+			// bins bounded by quantiles of the data
+			for (int32_t b = 1; b < m_max_bins; ++b)
+			{
+				auto threshold = sorted[size_t(num_vectors) * b / m_max_bins];
+				if (feature_thresholds.empty() ||
+				    threshold > feature_thresholds.back())
+					feature_thresholds.push_back(threshold);
+			}
+		}
+
+		uint8_t* feature_bins = bins.data() + size_t(f) * num_vectors;
+		for (index_t i = 0; i < num_vectors; ++i)
+		{
+			feature_bins[i] = std::lower_bound(
+			                      feature_thresholds.begin(),
+			                      feature_thresholds.end(), matrix(f, i)) -
+			                  feature_thresholds.begin();
+		}
+	}
+
+	m_bin_offsets = SGVector<index_t>(num_features + 1);
+	m_bin_offsets[0] = 0;
+	for (int32_t f = 0; f < num_features; ++f)
+		m_bin_offsets[f + 1] = m_bin_offsets[f] + thresholds[f].size();
+
+	m_bin_thresholds = SGVector<float64_t>(m_bin_offsets[num_features]);
+	for (int32_t f = 0; f < num_features; ++f)
+	{
+		std::copy(
+		    thresholds[f].begin(), thresholds[f].end(),
+		    m_bin_thresholds.vector + m_bin_offsets[f]);
+	}
+
+	return bins;
+}
+
+bool HistogramGBMachine::train_machine(std::shared_ptr<Features> data)
+{
+	require(data, "training data not supplied!");
+	require(m_loss, "loss function not specified");
+	require(m_labels, "labels not specified");
+
+	auto features = data->as<DenseFeatures<float64_t>>();
+	index_t num_vectors = features->get_num_vectors();
+	auto labels = m_labels->as<DenseLabels>()->get_labels();
+	require(
+	    labels.vlen == num_vectors,
+	    "Number of labels ({}) must match number of vectors ({})",
+	    labels.vlen, num_vectors);
+
+	auto bins = compute_bins(features);
+
+	// the constant model is one Newton step from zero
+	float64_t sum_gradients = 0;
+	float64_t sum_hessians = 0;
+	for (index_t i = 0; i < num_vectors; ++i)
+	{
+		sum_gradients += m_loss->first_derivative(0, labels[i]);
+		sum_hessians += m_loss->second_derivative(0, labels[i]);
+	}
+	m_bias = sum_hessians > 0 ? -sum_gradients / sum_hessians : 0;
+
+	std::vector<float64_t> predictions(num_vectors, m_bias);
+	std::vector<float64_t> gradients(num_vectors);
+	std::vector<float64_t> hessians(num_vectors);
+	std::vector<index_t> rows(num_vectors);
+	index_t num_rows =
+	    std::max(index_t(1), index_t(m_subset_fraction * num_vectors));
+
+	std::vector<int32_t> roots;
+	std::vector<int32_t> node_features;
+	std::vector<int32_t> node_bins;
+	std::vector<float64_t> node_thresholds;
+	std::vector<int32_t> node_left;
+	std::vector<int32_t> node_right;
+	std::vector<float64_t> node_values;
+	auto add_node = [&]() {
+		node_features.push_back(-1);
+		node_bins.push_back(-1);
+		node_thresholds.push_back(0);
+		node_left.push_back(-1);
+		node_right.push_back(-1);
+		node_values.push_back(0);
+		return int32_t(node_features.size() - 1);
+	};
+
+	for (auto iter : SG_PROGRESS(range(m_num_iterations)))
+	{
+		// the rows of the subset come first, sorted for sequential access
+		std::iota(rows.begin(), rows.end(), 0);
+		if (num_rows < num_vectors)
+		{
+			random::shuffle(rows.begin(), rows.end(), m_prng);
+			std::sort(rows.begin(), rows.begin() + num_rows);
+		}
+
+#pragma omp parallel for
+		for (index_t i = 0; i < num_rows; ++i)
+		{
+			auto row = rows[i];
+			gradients[row] =
+			    m_loss->first_derivative(predictions[row], labels[row]);
+			hessians[row] =
+			    m_loss->second_derivative(predictions[row], labels[row]);
+		}
+
+		roots.push_back(add_node());
+		std::vector<Leaf> leaves(1);
+		auto& root = leaves[0];
+		root.node = roots.back();
+		root.begin = 0;
+		root.end = num_rows;
+		root.sum_gradients = 0;
+		root.sum_hessians = 0;
+		for (index_t i = 0; i < num_rows; ++i)
+		{
+			root.sum_gradients += gradients[rows[i]];
+			root.sum_hessians += hessians[rows[i]];
+		}
+		build_histogram(
+		    bins, num_vectors, m_bin_offsets, rows.data(), num_rows,
+		    gradients, hessians, root.histogram);
+		root.split = find_split(
+		    root, m_bin_offsets, m_min_samples_leaf, m_l2_regularization);
+
+		// leaf-wise growth, always splitting the leaf with the largest gain
+		while (int32_t(leaves.size()) < m_max_leaves)
+		{
+			auto best = std::max_element(
+			    leaves.begin(), leaves.end(),
+			    [](const Leaf& a, const Leaf& b) {
+				    return a.split.gain < b.split.gain;
+			    });
+			if (best->split.feature < 0)
+				break;
+
+			Leaf parent = std::move(*best);
+			const auto& split = parent.split;
+			const uint8_t* feature_bins =
+			    bins.data() + size_t(split.feature) * num_vectors;
+			auto middle = std::stable_partition(
+			    rows.begin() + parent.begin, rows.begin() + parent.end,
+			    [&](index_t row) { return feature_bins[row] <= split.bin; });
+
+			node_features[parent.node] = split.feature;
+			node_bins[parent.node] = split.bin;
+			node_thresholds[parent.node] =
+			    m_bin_thresholds[m_bin_offsets[split.feature] + split.bin];
+
+			Leaf left;
+			left.node = add_node();
+			left.begin = parent.begin;
+			left.end = middle - rows.begin();
+			left.sum_gradients = split.left_gradients;
+			left.sum_hessians = split.left_hessians;
+
+			Leaf right;
+			right.node = add_node();
+			right.begin = left.end;
+			right.end = parent.end;
+			right.sum_gradients = parent.sum_gradients - split.left_gradients;
+			right.sum_hessians = parent.sum_hessians - split.left_hessians;
+
+			node_left[parent.node] = left.node;
+			node_right[parent.node] = right.node;
+
+			// only the smaller child is scanned, the histogram of the other
+			// one is what remains of the parent
+			bool left_smaller =
+			    left.end - left.begin <= right.end - right.begin;
+			auto& smaller = left_smaller ? left : right;
+			auto& larger = left_smaller ? right : left;
+			build_histogram(
+			    bins, num_vectors, m_bin_offsets, rows.data() + smaller.begin,
+			    smaller.end - smaller.begin, gradients, hessians,
+			    smaller.histogram);
+			larger.histogram = std::move(parent.histogram);
+			for (size_t k = 0; k < larger.histogram.size(); ++k)
+			{
+				larger.histogram[k].sum_gradients -=
+				    smaller.histogram[k].sum_gradients;
+				larger.histogram[k].sum_hessians -=
+				    smaller.histogram[k].sum_hessians;
+				larger.histogram[k].count -= smaller.histogram[k].count;
+			}
+
+			left.split = find_split(
+			    left, m_bin_offsets, m_min_samples_leaf, m_l2_regularization);
+			right.split = find_split(
+			    right, m_bin_offsets, m_min_samples_leaf, m_l2_regularization);
+
+			*best = std::move(left);
+			leaves.push_back(std::move(right));
+		}
+
+		// the leaves hold the rows of the subset, so their predictions are
+		// updated without descending the tree
+		for (const auto& leaf : leaves)
+		{
+			float64_t denominator = leaf.sum_hessians + m_l2_regularization;
+			float64_t value = denominator > 0
+			                      ? -m_learning_rate * leaf.sum_gradients /
+			                            denominator
+			                      : 0;
+			node_values[leaf.node] = value;
+			for (index_t i = leaf.begin; i < leaf.end; ++i)
+				predictions[rows[i]] += value;
+		}
+
+		// the other rows descend the tree on their bins
+#pragma omp parallel for
+		for (index_t i = num_rows; i < num_vectors; ++i)
+		{
+			auto row = rows[i];
+			auto node = roots.back();
+			while (node_features[node] >= 0)
+			{
+				node = bins[size_t(node_features[node]) * num_vectors + row] <=
+				               node_bins[node]
+				           ? node_left[node]
+				           : node_right[node];
+			}
+			predictions[row] += node_values[node];
+		}
+	}
+
+	m_tree_roots = SGVector<int32_t>(roots.begin(), roots.end());
+	m_node_features =
+	    SGVector<int32_t>(node_features.begin(), node_features.end());
+	m_node_thresholds =
+	    SGVector<float64_t>(node_thresholds.begin(), node_thresholds.end());
+	m_node_left = SGVector<int32_t>(node_left.begin(), node_left.end());
+	m_node_right = SGVector<int32_t>(node_right.begin(), node_right.end());
+	m_node_values = SGVector<float64_t>(node_values.begin(), node_values.end());
+
+	SG_DEBUG(
+	    "trained {} trees with {} nodes", m_tree_roots.vlen,
+	    m_node_features.vlen);
+	return true;
+}
+
+std::shared_ptr<RegressionLabels>
+HistogramGBMachine::apply_regression(std::shared_ptr<Features> data)
+{
+	require(data, "test data supplied is NULL");
+	require(m_bin_offsets.vlen > 0, "Machine is not trained");
+
+	auto features = data->as<DenseFeatures<float64_t>>();
+	auto matrix = features->get_feature_matrix();
+	require(
+	    matrix.num_rows == m_bin_offsets.vlen - 1,
+	    "Number of features ({}) does not match the training data ({})",
+	    matrix.num_rows, m_bin_offsets.vlen - 1);
+
+	SGVector<float64_t> result(matrix.num_cols);
+#pragma omp parallel for
+	for (index_t i = 0; i < matrix.num_cols; ++i)
+	{
+		const float64_t* x = matrix.get_column_vector(i);
+		float64_t value = m_bias;
+		for (auto root : m_tree_roots)
+		{
+			auto node = root;
+			while (m_node_features[node] >= 0)
+			{
+				node = x[m_node_features[node]] <= m_node_thresholds[node]
+				           ? m_node_left[node]
+				           : m_node_right[node];
+			}
+			value += m_node_values[node];
+		}
+		result[i] = value;
+	}
+
+	return std::make_shared<RegressionLabels>(result);
+}
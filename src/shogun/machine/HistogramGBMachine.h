@@ -0,0 +1,226 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef _HISTOGRAMGBMACHINE_H__
+#define _HISTOGRAMGBMACHINE_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/loss/LossFunction.h>
+#include <shogun/machine/Machine.h>
+#include <shogun/mathematics/RandomMixin.h>
+
+#include <vector>
+
+namespace shogun
+{
+
+/** @brief Gradient boosting of regression trees on binned features.
+ *
+ * Unlike StochasticGBMachine, which boosts arbitrary machines, this class
+ * grows its own trees, which makes each round cheap:
+ *
+ * - every feature is quantized once into at most max_bins bins, bounded by
+ *   quantiles of the training data, and the bin indices are stored as bytes
+ * - the gradients and hessians of the loss are computed once per round into
+ *   contiguous arrays, optionally for a random subset of the vectors
+ * - trees are grown leaf-wise, always splitting the leaf with the largest
+ *   gain, until max_leaves leaves exist. The split search scans per-leaf
+ *   histograms of gradient sums, which are built in parallel over features,
+ *   and the histogram of the larger child is the difference of its parent
+ *   and its sibling
+ * - the predictions on the training data are updated from the leaf
+ *   assignments of the tree instead of applying it to the data again
+ *
+ * Leaf values are Newton steps \f$-\eta\sum g/(\sum h+\lambda)\f$, so the
+ * loss needs to implement first_derivative(prediction, label) and
+ * second_derivative(prediction, label), as SquaredLoss does.
+ */
+class HistogramGBMachine : public RandomMixin<Machine>
+{
+public:
+	/** problem type */
+	MACHINE_PROBLEM_TYPE(PT_REGRESSION);
+
+	/** constructor
+	 *
+	 * @param loss loss function
+	 * @param num_iterations number of boosting rounds
+	 * @param learning_rate shrinkage factor of the leaf values
+	 * @param max_leaves maximum number of leaves of a tree
+	 */
+	HistogramGBMachine(
+	    const std::shared_ptr<LossFunction>& loss = nullptr,
+	    int32_t num_iterations = 100, float64_t learning_rate = 0.1,
+	    int32_t max_leaves = 31);
+
+	/** destructor */
+	virtual ~HistogramGBMachine();
+
+	/** @return object name */
+	virtual const char* get_name() const { return "HistogramGBMachine"; }
+
+	/** set loss function
+	 *
+	 * @param loss loss function
+	 */
+	void set_loss_function(const std::shared_ptr<LossFunction>& loss);
+
+	/** @return loss function */
+	std::shared_ptr<LossFunction> get_loss_function() const;
+
+	/** set number of boosting rounds
+	 *
+	 * @param num_iterations number of rounds
+	 */
+	void set_num_iterations(int32_t num_iterations);
+
+	/** @return number of boosting rounds */
+	int32_t get_num_iterations() const;
+
+	/** set learning rate
+	 *
+	 * @param learning_rate learning rate (should lie in (0, 1])
+	 */
+	void set_learning_rate(float64_t learning_rate);
+
+	/** @return learning rate */
+	float64_t get_learning_rate() const;
+
+	/** set fraction of the training vectors that each tree is fitted to
+	 *
+	 * @param fraction subset fraction (should lie in (0, 1])
+	 */
+	void set_subset_fraction(float64_t fraction);
+
+	/** @return subset fraction */
+	float64_t get_subset_fraction() const;
+
+	/** set maximum number of bins per feature
+	 *
+	 * @param max_bins number of bins (between 2 and 256)
+	 */
+	void set_max_bins(int32_t max_bins);
+
+	/** @return maximum number of bins per feature */
+	int32_t get_max_bins() const;
+
+	/** set maximum number of leaves of a tree
+	 *
+	 * @param max_leaves number of leaves (at least 2)
+	 */
+	void set_max_leaves(int32_t max_leaves);
+
+	/** @return maximum number of leaves of a tree */
+	int32_t get_max_leaves() const;
+
+	/** set minimum number of training vectors in a leaf
+	 *
+	 * @param min_samples_leaf number of vectors
+	 */
+	void set_min_samples_leaf(int32_t min_samples_leaf);
+
+	/** @return minimum number of training vectors in a leaf */
+	int32_t get_min_samples_leaf() const;
+
+	/** set L2 regularization of the leaf values
+	 *
+	 * @param l2_regularization regularization constant
+	 */
+	void set_l2_regularization(float64_t l2_regularization);
+
+	/** @return L2 regularization of the leaf values */
+	float64_t get_l2_regularization() const;
+
+	/** @return number of trained trees */
+	int32_t get_num_trees() const;
+
+	/** apply machine to data
+	 *
+	 * @param data test data
+	 * @return regression labels
+	 */
+	virtual std::shared_ptr<RegressionLabels>
+	apply_regression(std::shared_ptr<Features> data = nullptr);
+
+protected:
+	/** train machine
+	 *
+	 * @param data training data
+	 * @return true
+	 */
+	virtual bool train_machine(std::shared_ptr<Features> data = nullptr);
+
+	/** quantizes the features into bins, computing the bin thresholds
+	 *
+	 * @param features training data
+	 * @return bin indices, stored feature by feature
+	 */
+	std::vector<uint8_t>
+	compute_bins(const std::shared_ptr<DenseFeatures<float64_t>>& features);
+
+private:
+	/** initialize */
+	void init();
+
+protected:
+	/** loss function */
+	std::shared_ptr<LossFunction> m_loss;
+
+	/** number of boosting rounds */
+	int32_t m_num_iterations;
+
+	/** learning rate */
+	float64_t m_learning_rate;
+
+	/** subset fraction */
+	float64_t m_subset_fraction;
+
+	/** maximum number of bins per feature */
+	int32_t m_max_bins;
+
+	/** maximum number of leaves of a tree */
+	int32_t m_max_leaves;
+
+	/** minimum number of vectors in a leaf */
+	int32_t m_min_samples_leaf;
+
+	/** L2 regularization of the leaf values */
+	float64_t m_l2_regularization;
+
+	/** upper bin thresholds of all features, concatenated */
+	SGVector<float64_t> m_bin_thresholds;
+
+	/** offsets of the bin thresholds of each feature, with one extra entry
+	 * for the end
+	 */
+	SGVector<index_t> m_bin_offsets;
+
+	/** constant prediction the trees are added to */
+	float64_t m_bias;
+
+	/** root node of each tree */
+	SGVector<int32_t> m_tree_roots;
+
+	/** split feature of each node, -1 for leaves */
+	SGVector<int32_t> m_node_features;
+
+	/** split threshold of each node, vectors with a feature value at most
+	 * the threshold go to the left child
+	 */
+	SGVector<float64_t> m_node_thresholds;
+
+	/** left child of each node */
+	SGVector<int32_t> m_node_left;
+
+	/** right child of each node */
+	SGVector<int32_t> m_node_right;
+
+	/** value of each leaf, scaled by the learning rate */
+	SGVector<float64_t> m_node_values;
+};
+} // namespace shogun
+
+#endif // _HISTOGRAMGBMACHINE_H__
@@ -7,9 +7,14 @@
 
 #include <shogun/machine/KernelMulticlassMachine.h>
 #include <shogun/features/Features.h>
+#include <shogun/features/IndexFeatures.h>
+#include <shogun/kernel/CustomKernel.h>
 #include <shogun/kernel/Kernel.h>
+#include <shogun/lib/SGSparseVector.h>
 #include <shogun/machine/KernelMachine.h>
 
+#include <algorithm>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
@@ -73,6 +78,91 @@ void KernelMulticlassMachine::store_model_features()
 	}
 }
 
+std::vector<std::shared_ptr<BinaryLabels>>
+KernelMulticlassMachine::get_all_submachine_outputs()
+{
+	std::vector<std::shared_ptr<KernelMachine>> machines;
+	for (const auto& m : m_machines)
+	{
+		auto machine = std::dynamic_pointer_cast<KernelMachine>(m);
+		if (!machine || machine->get_kernel() != m_kernel)
+			return MulticlassMachine::get_all_submachine_outputs();
+		machines.push_back(machine);
+	}
+	if (!m_kernel || machines.size() < 2 ||
+	    (m_kernel->has_property(KP_LINADD) && m_kernel->get_is_initialized()))
+		return MulticlassMachine::get_all_submachine_outputs();
+
+	index_t num_machines = machines.size();
+	auto rhs = m_kernel->get_rhs();
+	index_t num_vectors =
+	    rhs ? rhs->get_num_vectors() : m_kernel->get_num_vec_rhs();
+
+	// union of all support vectors, and the coefficients of every machine
+	// as a sparse vector over the union
+	std::vector<index_t> sv_union;
+	std::unordered_map<index_t, index_t> union_position;
+	std::vector<SGSparseVector<float64_t>> coefficients;
+	for (const auto& machine : machines)
+	{
+		auto num_svs = machine->get_num_support_vectors();
+		SGSparseVector<float64_t> coefs(num_svs);
+		for (index_t j = 0; j < num_svs; ++j)
+		{
+			auto sv = machine->get_support_vector(j);
+			auto it = union_position.emplace(sv, (index_t)sv_union.size());
+			if (it.second)
+				sv_union.push_back(sv);
+			coefs.features[j].feat_index = it.first->second;
+			coefs.features[j].entry = machine->get_alpha(j);
+		}
+		coefficients.push_back(coefs);
+	}
+	index_t num_union = sv_union.size();
+	SG_DEBUG(
+	    "computing outputs of {} machines on {} vectors with {} support "
+	    "vectors",
+	    num_machines, num_vectors, num_union);
+
+	std::vector<SGVector<float64_t>> outputs(num_machines);
+	for (auto& output : outputs)
+		output = SGVector<float64_t>(num_vectors);
+
+	// a tile of test vectors is evaluated against all support vectors, so
+	// every support vector is fetched once per tile
+	const index_t tile_size = 32;
+	index_t num_tiles = (num_vectors + tile_size - 1) / tile_size;
+#pragma omp parallel
+	{
+		SGMatrix<float64_t> block(num_union, tile_size);
+
+#pragma omp for schedule(dynamic)
+		for (index_t tile = 0; tile < num_tiles; ++tile)
+		{
+			index_t begin = tile * tile_size;
+			index_t end = std::min(begin + tile_size, num_vectors);
+
+			for (index_t u = 0; u < num_union; ++u)
+				for (index_t vec = begin; vec < end; ++vec)
+					block(u, vec - begin) = m_kernel->kernel(sv_union[u], vec);
+
+			for (index_t vec = begin; vec < end; ++vec)
+			{
+				auto column = block.get_column_vector(vec - begin);
+				for (index_t m = 0; m < num_machines; ++m)
+					outputs[m][vec] = coefficients[m].dense_dot(
+					    1.0, column, num_union, machines[m]->get_bias());
+			}
+		}
+	}
+
+	std::vector<std::shared_ptr<BinaryLabels>> result(num_machines);
+	for (index_t m = 0; m < num_machines; ++m)
+		result[m] = std::make_shared<BinaryLabels>(outputs[m]);
+
+	return result;
+}
+
 KernelMulticlassMachine::KernelMulticlassMachine() : MulticlassMachine(), m_kernel(NULL)
 {
 	SG_ADD(&m_kernel,"kernel", "The kernel to be used", ParameterProperties::HYPER);
@@ -173,4 +263,54 @@ void KernelMulticlassMachine::remove_machine_subset()
 	not_implemented(SOURCE_LOCATION);
 }
 
+void KernelMulticlassMachine::init_machines_for_parallel_train()
+{
+	m_train_kernel_matrix = std::make_shared<CustomKernel>(
+	    m_kernel->get_kernel_matrix<float32_t>());
+
+	// cloning the machine would clone the kernel and its features too
+	auto machine = m_machine->as<KernelMachine>();
+	machine->set_kernel(nullptr);
+	m_train_prototype = make_clone(
+	    m_machine, ParameterProperties::HYPER | ParameterProperties::SETTING);
+	machine->set_kernel(m_kernel);
+}
+
+void KernelMulticlassMachine::finish_machines_for_parallel_train()
+{
+	// the submachines would otherwise keep the shared matrix alive
+	for (auto& m : m_machines)
+		m->as<KernelMachine>()->set_kernel(m_kernel);
+
+	m_train_kernel_matrix = nullptr;
+	m_train_prototype = nullptr;
+}
 
+std::shared_ptr<Machine> KernelMulticlassMachine::train_submachine(
+    const SGVector<index_t>& subset,
+    const std::shared_ptr<BinaryLabels>& labels) const
+{
+	auto machine = make_clone(
+	    m_train_prototype,
+	    ParameterProperties::HYPER | ParameterProperties::SETTING)
+	                   ->as<KernelMachine>();
+	machine->set_kernel(std::make_shared<CustomKernel>(m_train_kernel_matrix));
+	machine->set_labels(labels);
+
+	SGVector<index_t> indices = subset;
+	if (!indices.vlen)
+	{
+		indices = SGVector<index_t>(m_kernel->get_num_vec_rhs());
+		indices.range_fill();
+	}
+	machine->train(std::make_shared<IndexFeatures>(indices));
+
+	// support vectors index into the subset, map them to training vectors
+	if (subset.vlen)
+	{
+		for (index_t j = 0; j < machine->get_num_support_vectors(); ++j)
+			machine->set_support_vector(j, subset[machine->get_support_vector(j)]);
+	}
+
+	return machine;
+}
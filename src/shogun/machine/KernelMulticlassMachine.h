@@ -18,6 +18,7 @@ namespace shogun
 
 class Features;
 class Kernel;
+class CustomKernel;
 
 /** @brief generic kernel multiclass */
 class KernelMulticlassMachine : public MulticlassMachine
@@ -55,6 +56,19 @@ class KernelMulticlassMachine : public MulticlassMachine
 		 */
 		std::shared_ptr<Kernel> get_kernel() const;
 
+		/** Computes the outputs of all submachines at once. The kernel
+		 * values between the test vectors and the union of the support
+		 * vectors of all submachines are computed once, in tiles of test
+		 * vectors and in parallel. Every submachine's outputs are then
+		 * the product of its sparse coefficients with these kernel values.
+		 * Falls back to one apply per submachine if the submachines do not
+		 * share the kernel, or if the kernel has linadd optimization.
+		 *
+		 * @return outputs of every submachine (in that order)
+		 */
+		virtual std::vector<std::shared_ptr<BinaryLabels>>
+		get_all_submachine_outputs();
+
 		/** Stores feature data of underlying model.
 		 *
 		 * Need to store the SVs for all sub-machines. We make a union of the
@@ -89,11 +103,43 @@ class KernelMulticlassMachine : public MulticlassMachine
 		/** deletes any subset set to the features of the machine */
 		virtual void remove_machine_subset();
 
+		virtual bool supports_parallel_training() const
+		{
+			return true;
+		}
+
+		/** Computes the kernel matrix of the training features once, in
+		 * 32bit floats. All submachines are trained on it, which also
+		 * makes subset strategies such as one-vs-one possible.
+		 */
+		virtual void init_machines_for_parallel_train();
+
+		/** points the submachines to the kernel of this machine and releases
+		 * the shared kernel matrix
+		 */
+		virtual void finish_machines_for_parallel_train();
+
+		/** trains a clone of the kernel machine on the rows and columns of
+		 * the shared kernel matrix given by subset
+		 */
+		virtual std::shared_ptr<Machine> train_submachine(
+		    const SGVector<index_t>& subset,
+		    const std::shared_ptr<BinaryLabels>& labels) const;
+
 	protected:
 
 		/** kernel */
 		std::shared_ptr<Kernel> m_kernel;
 
+	private:
+		/** kernel matrix shared by the submachines during parallel training */
+		std::shared_ptr<CustomKernel> m_train_kernel_matrix;
+
+		/** kernel machine without kernel that submachines are cloned from
+		 * during parallel training
+		 */
+		std::shared_ptr<Machine> m_train_prototype;
+
 };
 }
 #endif
@@ -0,0 +1,220 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/features/SubsetStack.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/labels/MultilabelLabels.h>
+#include <shogun/machine/LinearMulticlassMachine.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/multiclass/MulticlassOneVsRestStrategy.h>
+
+#include <algorithm>
+#include <numeric>
+
+using namespace shogun;
+using namespace Eigen;
+
+bool LinearMulticlassMachine::stack_weights(
+    SGMatrix<float64_t>& weights, SGVector<float64_t>& biases) const
+{
+	if (!m_features || m_machines.empty())
+		return false;
+
+	index_t num_machines = m_machines.size();
+	index_t dim = m_features->get_dim_feature_space();
+	weights = SGMatrix<float64_t>(num_machines, dim);
+	biases = SGVector<float64_t>(num_machines);
+	for (index_t m = 0; m < num_machines; ++m)
+	{
+		auto machine = std::dynamic_pointer_cast<LinearMachine>(m_machines[m]);
+		if (!machine)
+			return false;
+
+		auto w = machine->get_w();
+		if (w.vlen != dim)
+			return false;
+
+		for (index_t j = 0; j < dim; ++j)
+			weights(m, j) = w[j];
+		biases[m] = machine->get_bias();
+	}
+
+	return true;
+}
+
+void LinearMulticlassMachine::compute_scores(
+    const SGMatrix<float64_t>& weights, const SGVector<float64_t>& biases,
+    index_t begin, index_t end, SGMatrix<float64_t>& scores) const
+{
+	index_t num_machines = weights.num_rows;
+	index_t dim = weights.num_cols;
+	Map<MatrixXd> W(weights.matrix, num_machines, dim);
+	Map<VectorXd> b(biases.vector, num_machines);
+	Map<MatrixXd> S(scores.matrix, num_machines, end - begin);
+	S.colwise() = b;
+
+	switch (m_features->get_feature_class())
+	{
+	case C_DENSE:
+		if (m_features->get_feature_type() == F_DREAL)
+		{
+			// one matrix product with the columns of the tile, which are
+			// gathered first if the features have a subset
+			auto dense = m_features->as<DenseFeatures<float64_t>>();
+			SGMatrix<float64_t> X;
+			index_t offset = begin;
+			if (dense->get_subset_stack()->has_subsets())
+			{
+				X = SGMatrix<float64_t>(dim, end - begin);
+				for (index_t vec = begin; vec < end; ++vec)
+				{
+					auto x = dense->get_feature_vector(vec);
+					std::copy_n(x.vector, dim, X.get_column_vector(vec - begin));
+					dense->free_feature_vector(x, vec);
+				}
+				offset = 0;
+			}
+			else
+				X = dense->get_feature_matrix();
+
+			S.noalias() +=
+			    W * Map<MatrixXd>(X.get_column_vector(offset), dim, end - begin);
+			return;
+		}
+		break;
+	case C_SPARSE:
+		if (m_features->get_feature_type() == F_DREAL)
+		{
+			// every nonzero entry adds one contiguous column of weights
+			auto sparse = m_features->as<SparseFeatures<float64_t>>();
+			for (index_t vec = begin; vec < end; ++vec)
+			{
+				auto x = sparse->get_sparse_feature_vector(vec);
+				for (index_t k = 0; k < x.num_feat_entries; ++k)
+				{
+					S.col(vec - begin) +=
+					    x.features[k].entry * W.col(x.features[k].feat_index);
+				}
+				sparse->free_sparse_feature_vector(vec);
+			}
+			return;
+		}
+		break;
+	default:
+		break;
+	}
+
+	SGVector<float64_t> w(dim);
+	for (index_t m = 0; m < num_machines; ++m)
+	{
+		for (index_t j = 0; j < dim; ++j)
+			w[j] = weights(m, j);
+		for (index_t vec = begin; vec < end; ++vec)
+			scores(m, vec - begin) += m_features->dot(vec, w);
+	}
+}
+
+std::vector<std::shared_ptr<BinaryLabels>>
+LinearMulticlassMachine::get_all_submachine_outputs()
+{
+	SGMatrix<float64_t> weights;
+	SGVector<float64_t> biases;
+	if (m_machines.size() < 2 || !stack_weights(weights, biases))
+		return MulticlassMachine::get_all_submachine_outputs();
+
+	index_t num_machines = weights.num_rows;
+	index_t num_vectors = m_features->get_num_vectors();
+	SG_DEBUG(
+	    "computing outputs of {} machines on {} vectors", num_machines,
+	    num_vectors);
+
+	std::vector<SGVector<float64_t>> outputs(num_machines);
+	for (auto& output : outputs)
+		output = SGVector<float64_t>(num_vectors);
+
+	// every tile of vectors is scored against all weights at once, so the
+	// features are read only once
+	const index_t tile_size = 64;
+	index_t num_tiles = (num_vectors + tile_size - 1) / tile_size;
+#pragma omp parallel
+	{
+		SGMatrix<float64_t> block(num_machines, tile_size);
+
+#pragma omp for schedule(dynamic)
+		for (index_t tile = 0; tile < num_tiles; ++tile)
+		{
+			index_t begin = tile * tile_size;
+			index_t end = std::min(begin + tile_size, num_vectors);
+			compute_scores(weights, biases, begin, end, block);
+
+			for (index_t vec = begin; vec < end; ++vec)
+				for (index_t m = 0; m < num_machines; ++m)
+					outputs[m][vec] = block(m, vec - begin);
+		}
+	}
+
+	std::vector<std::shared_ptr<BinaryLabels>> result(num_machines);
+	for (index_t m = 0; m < num_machines; ++m)
+		result[m] = std::make_shared<BinaryLabels>(outputs[m]);
+
+	return result;
+}
+
+std::shared_ptr<MultilabelLabels>
+LinearMulticlassMachine::apply_multilabel_output(
+    std::shared_ptr<Features> data, int32_t n_outputs)
+{
+	init_machines_for_apply(data);
+
+	SGMatrix<float64_t> weights;
+	SGVector<float64_t> biases;
+	if (!std::dynamic_pointer_cast<MulticlassOneVsRestStrategy>(
+	        m_multiclass_strategy) ||
+	    !is_ready() || !stack_weights(weights, biases))
+		return MulticlassMachine::apply_multilabel_output(data, n_outputs);
+
+	index_t num_machines = weights.num_rows;
+	require(
+	    n_outputs <= num_machines,
+	    "You request more outputs than machines available");
+
+	index_t num_vectors = m_features->get_num_vectors();
+	auto result = std::make_shared<MultilabelLabels>(num_vectors, n_outputs);
+
+	const index_t tile_size = 64;
+	index_t num_tiles = (num_vectors + tile_size - 1) / tile_size;
+#pragma omp parallel
+	{
+		SGMatrix<float64_t> block(num_machines, tile_size);
+		std::vector<index_t> classes(num_machines);
+
+#pragma omp for schedule(dynamic)
+		for (index_t tile = 0; tile < num_tiles; ++tile)
+		{
+			index_t begin = tile * tile_size;
+			index_t end = std::min(begin + tile_size, num_vectors);
+			compute_scores(weights, biases, begin, end, block);
+
+			for (index_t vec = begin; vec < end; ++vec)
+			{
+				const float64_t* scores = block.get_column_vector(vec - begin);
+				std::iota(classes.begin(), classes.end(), 0);
+				std::partial_sort(
+				    classes.begin(), classes.begin() + n_outputs,
+				    classes.end(), [scores](index_t a, index_t b) {
+					    return scores[a] > scores[b] ||
+					           (scores[a] == scores[b] && a < b);
+				    });
+
+				SGVector<index_t> label(n_outputs);
+				std::copy_n(classes.begin(), n_outputs, label.vector);
+				result->set_label(vec, label);
+			}
+		}
+	}
+
+	return result;
+}
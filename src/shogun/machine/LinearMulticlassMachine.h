@@ -13,9 +13,12 @@
 
 #include <shogun/lib/common.h>
 #include <shogun/features/DotFeatures.h>
+#include <shogun/lib/View.h>
 #include <shogun/machine/LinearMachine.h>
 #include <shogun/machine/MulticlassMachine.h>
 
+#include <vector>
+
 namespace shogun
 {
 
@@ -81,6 +84,31 @@ class LinearMulticlassMachine : public MulticlassMachine
 			return m_features;
 		}
 
+		/** Computes the outputs of all submachines at once. The weight
+		 * vectors are stacked into a machines x dimensions matrix, and
+		 * tiles of test vectors are scored against all of them in parallel,
+		 * with one matrix product per tile for dense features, or by
+		 * accumulating the weight columns of the nonzero entries for sparse
+		 * features. Falls back to one apply per submachine if the
+		 * submachines are not linear machines of the same dimension.
+		 *
+		 * @return outputs of every submachine (in that order)
+		 */
+		virtual std::vector<std::shared_ptr<BinaryLabels>>
+		get_all_submachine_outputs();
+
+		/** Returns the n_outputs classes with the largest outputs of every
+		 * vector. For one-vs-rest, the classes are selected from each tile
+		 * of scores right after it is computed, so the outputs of all
+		 * classes on all vectors are never stored.
+		 *
+		 * @param data features to apply on
+		 * @param n_outputs number of classes per vector
+		 * @return the classes of every vector, by decreasing output
+		 */
+		virtual std::shared_ptr<MultilabelLabels> apply_multilabel_output(
+		    std::shared_ptr<Features> data = NULL, int32_t n_outputs = 5);
+
 	protected:
 
 		/** init machine for train with setting features */
@@ -154,6 +182,46 @@ class LinearMulticlassMachine : public MulticlassMachine
 			m_features->remove_subset();
 		}
 
+		virtual bool supports_parallel_training() const
+		{
+			return true;
+		}
+
+		/** stacks the weight vectors of the submachines
+		 *
+		 * @param weights machines x dimensions matrix of weights
+		 * @param biases bias of every submachine
+		 * @return whether the submachines are linear machines of the same
+		 * dimension as the features
+		 */
+		bool stack_weights(
+		    SGMatrix<float64_t>& weights, SGVector<float64_t>& biases) const;
+
+		/** computes the outputs of all submachines on the vectors
+		 * [begin, end) into the columns of scores
+		 */
+		void compute_scores(
+		    const SGMatrix<float64_t>& weights,
+		    const SGVector<float64_t>& biases, index_t begin, index_t end,
+		    SGMatrix<float64_t>& scores) const;
+
+		/** trains a clone of the linear machine on a view of the features */
+		virtual std::shared_ptr<Machine> train_submachine(
+		    const SGVector<index_t>& subset,
+		    const std::shared_ptr<BinaryLabels>& labels) const
+		{
+			auto machine = make_clone(
+			    m_machine,
+			    ParameterProperties::HYPER | ParameterProperties::SETTING);
+			machine->set_labels(labels);
+			if (subset.vlen)
+				machine->train(view(m_features, subset));
+			else
+				machine->train(m_features);
+
+			return machine;
+		}
+
 	protected:
 
 		/** features */
@@ -58,11 +58,11 @@ std::shared_ptr<StructuredLabels> LinearStructuredOutputMachine::apply_structure
 	std::shared_ptr<StructuredLabels> out;
 	out = m_model->structured_labels_factory(num_input_vectors);
 
+	SGVector<int32_t> examples(num_input_vectors);
+	examples.range_fill();
+	auto results = m_model->argmax_batch(m_w, examples, false);
 	for ( int32_t i = 0 ; i < num_input_vectors ; ++i )
-	{
-		auto result = m_model->argmax(m_w, i, false);
-		out->add_label(result->argmax);
-	}
+		out->add_label(results[i]->argmax);
 
 	io::info("{}", out->to_string());
 
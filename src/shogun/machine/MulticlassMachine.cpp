@@ -14,13 +14,14 @@
 #include <shogun/mathematics/Statistics.h>
 #include <shogun/labels/MultilabelLabels.h>
 
+#include <exception>
 #include <utility>
 
 using namespace shogun;
 
 MulticlassMachine::MulticlassMachine()
 : BaseMulticlassMachine(), m_multiclass_strategy(std::make_shared<MulticlassOneVsRestStrategy>()),
-	m_machine(NULL)
+	m_machine(NULL), m_parallel_training(false)
 {
 
 	register_parameters();
@@ -35,6 +36,7 @@ MulticlassMachine::MulticlassMachine(
 	set_labels(std::move(labs));
 
 	m_machine = std::move(machine);
+	m_parallel_training = false;
 	register_parameters();
 }
 
@@ -54,6 +56,10 @@ void MulticlassMachine::register_parameters()
 {
 	SG_ADD(&m_multiclass_strategy,"multiclass_strategy", "Multiclass strategy");
 	SG_ADD(&m_machine, "machine", "The base machine");
+	SG_ADD(
+	    &m_parallel_training, "parallel_training",
+	    "Whether to train submachines in parallel",
+	    ParameterProperties::SETTING);
 }
 
 void MulticlassMachine::init_strategy()
@@ -69,6 +75,16 @@ std::shared_ptr<BinaryLabels> MulticlassMachine::get_submachine_outputs(int32_t
 	return machine->apply_binary();
 }
 
+std::vector<std::shared_ptr<BinaryLabels>>
+MulticlassMachine::get_all_submachine_outputs()
+{
+	std::vector<std::shared_ptr<BinaryLabels>> outputs(m_machines.size());
+	for (int32_t i = 0; i < utils::safe_convert<int32_t>(m_machines.size()); ++i)
+		outputs[i] = get_submachine_outputs(i);
+
+	return outputs;
+}
+
 float64_t MulticlassMachine::get_submachine_output(int32_t i, int32_t num)
 {
 	auto machine = get_machine(i);
@@ -109,14 +125,12 @@ std::shared_ptr<MulticlassLabels> MulticlassMachine::apply_multiclass(std::share
 		else
 			result->allocate_confidences_for(num_machines);
 
-		std::vector<std::shared_ptr<BinaryLabels>> outputs(num_machines);
+		auto outputs = get_all_submachine_outputs();
 		SGVector<float64_t> As(num_machines);
 		SGVector<float64_t> Bs(num_machines);
 
 		for (int32_t i=0; i<num_machines; ++i)
 		{
-			outputs[i] = get_submachine_outputs(i);
-
 			if (heuris==OVA_SOFTMAX)
 			{
 				Statistics::SigmoidParamters params = Statistics::fit_sigmoid(outputs[i]->get_values());
@@ -195,10 +209,7 @@ std::shared_ptr<MultilabelLabels> MulticlassMachine::apply_multilabel_output(std
 		require(n_outputs<=num_machines,"You request more outputs than machines available");
 
 		auto result=std::make_shared<MultilabelLabels>(num_vectors, n_outputs);
-		std::vector<std::shared_ptr<BinaryLabels>> outputs(num_machines);
-
-		for (int32_t i=0; i < num_machines; ++i)
-			outputs[i] = get_submachine_outputs(i);
+		auto outputs = get_all_submachine_outputs();
 
 		SGVector<float64_t> output_for_i(num_machines);
 		for (int32_t i=0; i<num_vectors; i++)
@@ -229,6 +240,9 @@ bool MulticlassMachine::train_machine(std::shared_ptr<Features> data)
 	else
 		init_machine_for_train(data);
 
+	if (m_parallel_training && supports_parallel_training())
+		return train_machines_parallel();
+
 	m_machines.clear();
 	auto train_labels = std::make_shared<BinaryLabels>(get_num_rhs_vectors());
 
@@ -261,6 +275,56 @@ bool MulticlassMachine::train_machine(std::shared_ptr<Features> data)
 	return true;
 }
 
+bool MulticlassMachine::train_machines_parallel()
+{
+	auto tasks =
+	    m_multiclass_strategy->get_train_tasks(multiclass_labels(m_labels));
+	std::vector<std::shared_ptr<Machine>> machines(tasks.size());
+
+	SG_DEBUG("training {} submachines in parallel", tasks.size())
+	init_machines_for_parallel_train();
+
+	// releases the shared state also if a submachine throws
+	struct ParallelTrainGuard
+	{
+		MulticlassMachine* machine;
+		~ParallelTrainGuard() { machine->finish_machines_for_parallel_train(); }
+	} guard{this};
+
+	// exceptions must not leave the parallel region, the first one is
+	// rethrown after it
+	std::exception_ptr exception;
+
+	// OvO problems differ in size, dynamic scheduling balances them
+#pragma omp parallel for schedule(dynamic, 1)
+	for (index_t i = 0; i < (index_t)tasks.size(); ++i)
+	{
+		try
+		{
+			auto labels = std::make_shared<BinaryLabels>(tasks[i].labels);
+			machines[i] = get_machine_from_trained(
+			    train_submachine(tasks[i].subset, labels));
+		}
+		catch (...)
+		{
+#pragma omp critical (multiclass_machine_parallel_train)
+			if (!exception)
+				exception = std::current_exception();
+		}
+	}
+
+	// as in serial training, a failed training leaves no submachines
+	if (exception)
+	{
+		m_machines.clear();
+		std::rethrow_exception(exception);
+	}
+
+	m_machines = std::move(machines);
+
+	return true;
+}
+
 float64_t MulticlassMachine::apply_one(int32_t vec_idx)
 {
 	init_machines_for_apply(NULL);
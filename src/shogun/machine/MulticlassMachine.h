@@ -79,6 +79,14 @@ class MulticlassMachine : public BaseMulticlassMachine
 		 */
 		virtual std::shared_ptr<BinaryLabels> get_submachine_outputs(int32_t i);
 
+		/** get outputs of all submachines, by default one
+		 * get_submachine_outputs() call per submachine
+		 *
+		 * @return outputs of every submachine (in that order)
+		 */
+		virtual std::vector<std::shared_ptr<BinaryLabels>>
+		get_all_submachine_outputs();
+
 		/** get output of i-th submachine for num-th vector
 		 * @param i number of submachine
 		 * @param num number of feature vector
@@ -138,6 +146,25 @@ class MulticlassMachine : public BaseMulticlassMachine
 			return "MulticlassMachine";
 		}
 
+		/** Enables parallel training. The training problems of all
+		 * submachines are collected from the multiclass strategy first and
+		 * then trained concurrently on clones of the base machine, see
+		 * train_submachine(). Subclasses that do not implement
+		 * train_submachine() always train serially.
+		 *
+		 * @param parallel_training whether to train submachines in parallel
+		 */
+		inline void set_parallel_training(bool parallel_training)
+		{
+			m_parallel_training = parallel_training;
+		}
+
+		/** @return whether submachines are trained in parallel */
+		inline bool get_parallel_training() const
+		{
+			return m_parallel_training;
+		}
+
 		/** get prob output heuristic of multiclass strategy */
 		inline EProbHeuristicType get_prob_heuris()
 		{
@@ -186,6 +213,46 @@ class MulticlassMachine : public BaseMulticlassMachine
 		/** deletes any subset set to the features of the machine */
 		virtual void remove_machine_subset() = 0;
 
+		/** @return whether train_submachine() is implemented */
+		virtual bool supports_parallel_training() const
+		{
+			return false;
+		}
+
+		/** prepares state shared by all train_submachine() calls, e.g. a
+		 * precomputed kernel matrix
+		 */
+		virtual void init_machines_for_parallel_train()
+		{
+		}
+
+		/** releases the state of init_machines_for_parallel_train(), called
+		 * once the trained submachines are stored, or with no submachines
+		 * if training one of them threw
+		 */
+		virtual void finish_machines_for_parallel_train()
+		{
+		}
+
+		/** Trains a clone of the base machine on one training problem.
+		 * Called concurrently, so it must not modify the multiclass
+		 * machine, its base machine or the training features.
+		 *
+		 * @param subset indices of the training vectors, empty for all
+		 * @param labels binary labels of the vectors in subset
+		 * @return trained submachine
+		 */
+		virtual std::shared_ptr<Machine> train_submachine(
+		    const SGVector<index_t>& subset,
+		    const std::shared_ptr<BinaryLabels>& labels) const
+		{
+			not_implemented(SOURCE_LOCATION);
+			return nullptr;
+		}
+
+		/** trains all submachines in parallel */
+		bool train_machines_parallel();
+
 		/** whether the machine is acceptable in set_machine */
 		virtual bool is_acceptable_machine(std::shared_ptr<Machine >machine)
 		{
@@ -203,6 +270,9 @@ class MulticlassMachine : public BaseMulticlassMachine
 
 		/** machine */
 		std::shared_ptr<Machine> m_machine;
+
+		/** whether to train submachines in parallel */
+		bool m_parallel_training;
 };
 }
 #endif
@@ -0,0 +1,32 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/ensemble/MajorityVote.h>
+#include <shogun/machine/RandomForest.h>
+#include <shogun/util/Learner_benchmark.h>
+
+namespace shogun
+{
+
+BENCHMARK_DEFINE_F(LearnerFixture, RandomForest_train_apply)(benchmark::State& st)
+{
+	SGVector<bool> feature_types(features->get_num_features());
+	feature_types.set_const(false);
+
+	for (auto _ : st)
+	{
+		auto forest =
+		    std::make_shared<RandomForest>(features, multiclass_labels, 20);
+		forest->set_feature_types(feature_types);
+		forest->set_combination_rule(std::make_shared<MajorityVote>());
+		forest->put("seed", LEARNER_BENCHMARK_SEED);
+		forest->train();
+		benchmark::DoNotOptimize(forest->apply_multiclass(features));
+	}
+	report(st);
+}
+
+LEARNER_BENCHMARK(RandomForest_train_apply, 8192);
+
+}
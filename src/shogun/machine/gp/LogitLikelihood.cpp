@@ -36,6 +36,7 @@
 #include <shogun/mathematics/Integration.h>
 #endif //USE_GPL_SHOGUN
 #include <shogun/labels/BinaryLabels.h>
+#include <shogun/lib/WorkspacePool.h>
 #include <shogun/mathematics/eigen3.h>
 
 #include <utility>
@@ -287,7 +288,7 @@ SGVector<float64_t> LogitLikelihood::get_log_probability_f(std::shared_ptr<const
 
 	Map<VectorXd> eigen_f(func.vector, func.vlen);
 
-	SGVector<float64_t> r(func.vlen);
+	auto r = workspace::vector<float64_t>(func.vlen);
 	Map<VectorXd> eigen_r(r.vector, r.vlen);
 
 	// compute log probability: -log(1+exp(-f.*y))
@@ -312,7 +313,7 @@ SGVector<float64_t> LogitLikelihood::get_log_probability_derivative_f(
 
 	Map<VectorXd> eigen_f(func.vector, func.vlen);
 
-	SGVector<float64_t> r(func.vlen);
+	auto r = workspace::vector<float64_t>(func.vlen);
 	Map<VectorXd> eigen_r(r.vector, r.vlen);
 
 	// compute s(f)=1./(1+exp(-f))
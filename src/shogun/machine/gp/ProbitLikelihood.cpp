@@ -32,6 +32,7 @@
 
 
 #include <shogun/labels/BinaryLabels.h>
+#include <shogun/lib/WorkspacePool.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/Statistics.h>
 
@@ -91,7 +92,7 @@ SGVector<float64_t> ProbitLikelihood::get_log_probability_f(std::shared_ptr<cons
 
 	Map<VectorXd> eigen_f(func.vector, func.vlen);
 
-	SGVector<float64_t> r(func.vlen);
+	auto r = workspace::vector<float64_t>(func.vlen);
 	Map<VectorXd> eigen_r(r.vector, r.vlen);
 
 	// compute log pobability: log(normal_cdf(f.*y))
@@ -119,7 +120,7 @@ SGVector<float64_t> ProbitLikelihood::get_log_probability_derivative_f(
 
 	Map<VectorXd> eigen_f(func.vector, func.vlen);
 
-	SGVector<float64_t> dlp(func.vlen);
+	auto dlp = workspace::vector<float64_t>(func.vlen);
 	Map<VectorXd> eigen_dlp(dlp.vector, dlp.vlen);
 
 	VectorXd eigen_yf=eigen_y.cwiseProduct(eigen_f);
@@ -142,7 +143,7 @@ SGVector<float64_t> ProbitLikelihood::get_log_probability_derivative_f(
 		}
 	}
 
-	SGVector<float64_t> r(func.vlen);
+	auto r = workspace::vector<float64_t>(func.vlen);
 	Map<VectorXd> eigen_r(r.vector, r.vlen);
 
 	// compute derivatives of log probability wrt f
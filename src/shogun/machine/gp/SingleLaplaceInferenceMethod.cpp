@@ -8,6 +8,7 @@
 
 
 #include <shogun/machine/gp/StudentsTLikelihood.h>
+#include <shogun/lib/WorkspacePool.h>
 #include <shogun/machine/visitors/ShapeVisitor.h>
 #include <shogun/mathematics/Math.h>
 #ifdef USE_GPL_SHOGUN
@@ -161,6 +162,10 @@ float64_t SingleLaplaceNewtonOptimizer::minimize()
 	float64_t Psi_Old=Math::INFTY;
 	float64_t Psi_New=m_obj->m_Psi;
 
+	// the likelihood derivatives of every line search step are drawn from
+	// the workspace pool and recycled by the next step
+	WorkspaceScope scope;
+
 	// get mean vector and create eigen representation of it
 	Map<VectorXd> eigen_mean( (m_obj->m_mean_f).vector, (m_obj->m_mean_f).vlen);
 
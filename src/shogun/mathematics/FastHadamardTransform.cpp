@@ -0,0 +1,32 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/mathematics/FastHadamardTransform.h>
+
+// fht_impl.h includes these itself. They have to come first, so that their
+// include guards keep them out of the namespace fht_impl.h is included in.
+#include <shogun/mathematics/Math.h>
+
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+#include <cmath>
+
+namespace shogun
+{
+	// the FFHT implementation consists of non-inline global functions, which
+	// the FALCONN headers also define. A private namespace keeps this copy
+	// apart from theirs.
+	namespace ffht
+	{
+#include <shogun/lib/external/falconn/ffht/fht_impl.h>
+	}
+
+	int32_t fast_hadamard_transform(
+	    float64_t* buffer, int32_t len, int32_t chunk)
+	{
+		return ffht::FHTDouble(buffer, len, chunk);
+	}
+}
@@ -0,0 +1,29 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef _FASTHADAMARDTRANSFORM_H__
+#define _FASTHADAMARDTRANSFORM_H__
+
+#include <shogun/lib/config.h>
+#include <shogun/lib/common.h>
+
+namespace shogun
+{
+	/** Computes the normalized fast Walsh-Hadamard transform of a buffer in
+	 * place, i.e. multiplies it with \f$H/\sqrt{len}\f$, using the bundled
+	 * FFHT implementation.
+	 *
+	 * When shogun is built with AVX, the buffer has to be 32 byte aligned.
+	 *
+	 * @param buffer data to transform
+	 * @param len length of the buffer, a power of two
+	 * @param chunk block size of the recursion, at least 8
+	 * @return 0 on success, -1 if len is not a power of two or chunk is
+	 * smaller than 8
+	 */
+	int32_t fast_hadamard_transform(
+	    float64_t* buffer, int32_t len, int32_t chunk);
+}
+
+#endif // _FASTHADAMARDTRANSFORM_H__
@@ -171,6 +171,8 @@ void SparseMatrixOperator<T>::set_diagonal(SGVector<T> diag)
 
 		require(diag_size==diag.vlen, "Dimension mismatch!");
 
+		// the entries are written through the vectors
+		const bool packed=m_operator.is_packed();
 		bool need_sorting=false;
 		for (index_t i=0; i<diag_size; ++i)
 		{
@@ -190,18 +192,16 @@ void SparseMatrixOperator<T>::set_diagonal(SGVector<T> diag)
 			// we create a new entry if the diagonal element for this row doesn't exist
 			if (!inserted)
 			{
-				index_t j=m_operator[i].num_feat_entries;
-				m_operator[i].num_feat_entries=j+1;
-				m_operator[i].features=SG_REALLOC(SGSparseVectorEntry<T>,
-					m_operator[i].features, j, j+1);
-				m_operator[i].features[j].feat_index=i;
-				m_operator[i].features[j].entry=diag[i];
+				m_operator(i, i)=diag[i];
 				need_sorting=true;
 			}
 		}
 
 		if (need_sorting)
 			m_operator.sort_features();
+
+		if (packed)
+			m_operator.pack();
 	}
 
 template<class T>
@@ -12,12 +12,56 @@
 #include <utility>
 
 #include <shogun/lib/View.h>
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/multiclass/KNN.h>
 #include <shogun/preprocessor/PCA.h>
 #include <shogun/preprocessor/PruneVarSubMean.h>
 
 using namespace shogun;
+using namespace Eigen;
+
+/**
+ * add sum_i weights[i]*(x_a[i]-x_b[i])*(x_a[i]-x_b[i])' to G; the differences
+ * are gathered in blocks so that each block is accumulated with one matrix
+ * product
+ */
+static void add_weighted_outer_products(
+    const SGMatrix<float64_t>& X, const std::vector<index_t>& a,
+    const std::vector<index_t>& b, const std::vector<float64_t>& weights,
+    SGMatrix<float64_t>& G)
+{
+	const index_t block_size = 1024;
+	index_t d = X.num_rows;
+	index_t num_pairs = a.size();
+	index_t num_blocks = (num_pairs + block_size - 1) / block_size;
+
+	Map<MatrixXd> eigen_X(X.matrix, d, X.num_cols);
+	Map<MatrixXd> eigen_G(G.matrix, d, d);
+
+#pragma omp parallel if (num_blocks > 1)
+	{
+		MatrixXd local = MatrixXd::Zero(d, d);
+		MatrixXd D(d, block_size);
+		MatrixXd WD(d, block_size);
+
+#pragma omp for schedule(dynamic)
+		for (index_t block = 0; block < num_blocks; ++block)
+		{
+			index_t begin = block * block_size;
+			index_t size = std::min(block_size, num_pairs - begin);
+			for (index_t i = 0; i < size; ++i)
+			{
+				D.col(i) = eigen_X.col(a[begin + i]) - eigen_X.col(b[begin + i]);
+				WD.col(i) = weights[begin + i] * D.col(i);
+			}
+			local.noalias() += WD.leftCols(size) * D.leftCols(size).transpose();
+		}
+
+#pragma omp critical
+		eigen_G += local;
+	}
+}
 
 CImpostorNode::CImpostorNode(index_t ex, index_t tar, index_t imp)
 : example(ex), target(tar), impostor(imp)
@@ -168,19 +212,23 @@ SGMatrix<float64_t> LMNNImpl::sum_outer_products(
 	int32_t d = x->get_num_features();
 	// initialize the sum of outer products (sop)
 	SGMatrix<float64_t> sop(d, d);
+	sop.zero();
 
-	auto X = x->get_feature_matrix();
-
-	// sum the outer products stored in C using the indices specified in target_nn
+	// sum the outer products of the differences to the target neighbors
+	index_t num_pairs = target_nn.num_rows * target_nn.num_cols;
+	std::vector<index_t> a(num_pairs);
+	std::vector<index_t> b(num_pairs);
 	for (index_t i = 0; i < target_nn.num_cols; ++i)
 	{
 		for (index_t j = 0; j < target_nn.num_rows; ++j)
 		{
-			auto dx = linalg::add(
-			    X.get_column(i), X.get_column(target_nn(j, i)), 1.0, -1.0);
-			linalg::rank_update(sop, dx);
+			a[i * target_nn.num_rows + j] = i;
+			b[i * target_nn.num_rows + j] = target_nn(j, i);
 		}
 	}
+	add_weighted_outer_products(
+	    x->get_feature_matrix(), a, b, std::vector<float64_t>(num_pairs, 1.0),
+	    sop);
 
 	return sop;
 }
@@ -232,37 +280,36 @@ void LMNNImpl::update_gradient(
     const ImpostorsSetType& Nc, const ImpostorsSetType& Np,
     float64_t regularization)
 {
-	// compute the difference sets
+	// compute the difference sets, both sets are sorted
 	ImpostorsSetType Np_Nc, Nc_Np;
-	set_difference(Np.begin(), Np.end(), Nc.begin(), Nc.end(), inserter(Np_Nc, Np_Nc.begin()));
-	set_difference(Nc.begin(), Nc.end(), Np.begin(), Np.end(), inserter(Nc_Np, Nc_Np.begin()));
-
-	auto X = x->get_feature_matrix();
+	std::set_difference(
+	    Np.begin(), Np.end(), Nc.begin(), Nc.end(), std::back_inserter(Np_Nc));
+	std::set_difference(
+	    Nc.begin(), Nc.end(), Np.begin(), Np.end(), std::back_inserter(Nc_Np));
+
+	// every triplet contributes weight*(dx1*dx1' - dx2*dx2'), where dx1 is the
+	// difference to the target and dx2 the difference to the impostor
+	std::vector<index_t> a;
+	std::vector<index_t> b;
+	std::vector<float64_t> weights;
+	auto add_triplets = [&](const ImpostorsSetType& triplets, float64_t weight) {
+		for (const auto& triplet : triplets)
+		{
+			a.push_back(triplet.example);
+			b.push_back(triplet.target);
+			weights.push_back(weight);
+			a.push_back(triplet.example);
+			b.push_back(triplet.impostor);
+			weights.push_back(-weight);
+		}
+	};
 
 	// remove the gradient contributions of the impostors that were in the previous
-	// set but disappeared in the current
-	for (ImpostorsSetType::iterator it = Np_Nc.begin(); it != Np_Nc.end(); ++it)
-	{
-		// G -= regularization*(dx1*dx1' - dx2*dx2');
-		auto dx1 = linalg::add(
-		    X.get_column(it->example), X.get_column(it->target), 1.0, -1.0);
-		auto dx2 = linalg::add(
-		    X.get_column(it->example), X.get_column(it->impostor), 1.0, -1.0);
-		linalg::rank_update(G, dx1, -regularization);
-		linalg::rank_update(G, dx2, regularization);
-	}
+	// set but disappeared in the current, and add the ones of the new impostors
+	add_triplets(Np_Nc, -regularization);
+	add_triplets(Nc_Np, regularization);
 
-	// add the gradient contributions of the new impostors
-	for (ImpostorsSetType::iterator it = Nc_Np.begin(); it != Nc_Np.end(); ++it)
-	{
-		// G += regularization*(dx1*dx1' - dx2*dx2');
-		auto dx1 = linalg::add(
-		    X.get_column(it->example), X.get_column(it->target), 1.0, -1.0);
-		auto dx2 = linalg::add(
-		    X.get_column(it->example), X.get_column(it->impostor), 1.0, -1.0);
-		linalg::rank_update(G, dx1, regularization);
-		linalg::rank_update(G, dx2, -regularization);
-	}
+	add_weighted_outer_products(x->get_feature_matrix(), a, b, weights, G);
 }
 
 void LMNNImpl::gradient_step(
@@ -377,31 +424,20 @@ SGMatrix<float64_t> LMNNImpl::compute_sqdists(
 	int32_t k = target_nn.num_rows;
 
 	/// compute square distances to target neighbors plus margin
-
-	// create Shogun features from LX to later apply subset
-	auto lx = std::make_shared<DenseFeatures<float64_t>>(LX);
-
-	// initialize distances
+	Map<MatrixXd> eigen_LX(LX.matrix, LX.num_rows, n);
 	SGMatrix<float64_t> sqdists(k, n);
 
-	for (int32_t i = 0; i < k; ++i)
+#pragma omp parallel for
+	for (int32_t i = 0; i < n; ++i)
 	{
-		//FIXME avoid copying the rows of target_nn and access them directly. Maybe
-		//find_target_nn should be changed to return the output transposed wrt how it is
-		//done atm.
-		SGVector<index_t> subset_vec = target_nn.get_row_vector(i);
-		auto lx_subset = view(lx, subset_vec);
-		// after the subset, there are still n columns, i.e. the subset is used to
-		// modify the order of the columns in x according to the target neighbors
-		auto diff = linalg::add(LX, lx_subset->get_feature_matrix(), 1.0, -1.0);
-		auto sum = linalg::colwise_sum(linalg::element_prod(diff, diff));
-		for (int j = 0; j < sum.vlen; j++)
-			sqdists(i, j) = sum[j] + 1;
+		for (int32_t j = 0; j < k; ++j)
+		{
+			sqdists(j, i) =
+			    (eigen_LX.col(i) - eigen_LX.col(target_nn(j, i))).squaredNorm() +
+			    1;
+		}
 	}
 
-	// clean up features used to apply subset
-
-
 	return sqdists;
 }
 
@@ -411,11 +447,22 @@ ImpostorsSetType LMNNImpl::find_impostors_exact(
 {
 	SG_TRACE("Entering LMNNImpl::find_impostors_exact().");
 
-	// initialize empty impostors set
-	ImpostorsSetType N = ImpostorsSetType();
+	// the distances between two classes are computed in tiles of this size
+	const index_t tile_rows = 256;
+	const index_t tile_cols = 512;
+
+	int32_t d = LX.num_rows;
+	int32_t n = LX.num_cols;
+	Map<MatrixXd> eigen_LX(LX.matrix, d, n);
+	Map<MatrixXd> eigen_sqdists(sqdists.matrix, k, n);
+
+	// squared norms, and the largest distance plus margin of each example to
+	// its target neighbors, which bounds the distance to its impostors
+	VectorXd sqnorms = eigen_LX.colwise().squaredNorm().transpose();
+	VectorXd max_sqdists = eigen_sqdists.colwise().maxCoeff().transpose();
 
-	// create Shogun features from LX to later apply subset
-	auto lx = std::make_shared<DenseFeatures<float64_t>>(LX);
+	// initialize empty impostors set
+	ImpostorsSetType N;
 
 	// get a vector with unique label values
 	SGVector<float64_t> unique = y->get_unique_labels();
@@ -429,31 +476,80 @@ ImpostorsSetType LMNNImpl::find_impostors_exact(
 		// pairwise distances are computed once
 		std::vector<index_t> gtidxs = LMNNImpl::get_examples_gtlabel(y,unique[i]);
 
-		// get distance with features indexed by iidxs and gtidxs separated
-		auto euclidean = LMNNImpl::setup_distance(lx,iidxs,gtidxs);
-		euclidean->set_disable_sqrt(true);
+		index_t num_row_tiles = (iidxs.size() + tile_rows - 1) / tile_rows;
+		index_t num_col_tiles = (gtidxs.size() + tile_cols - 1) / tile_cols;
 
-		for (int32_t j = 0; j < k; ++j)
+#pragma omp parallel
 		{
-			for (std::size_t ii = 0; ii < iidxs.size(); ++ii)
+			ImpostorsSetType local;
+			MatrixXd A;
+			MatrixXd B;
+			MatrixXd dists;
+
+#pragma omp for schedule(dynamic)
+			for (index_t tile = 0; tile < num_row_tiles * num_col_tiles; ++tile)
 			{
-				for (std::size_t jj = 0; jj < gtidxs.size(); ++jj)
+				index_t row_begin = (tile / num_col_tiles) * tile_rows;
+				index_t col_begin = (tile % num_col_tiles) * tile_cols;
+				index_t num_rows =
+				    std::min(tile_rows, index_t(iidxs.size()) - row_begin);
+				index_t num_cols =
+				    std::min(tile_cols, index_t(gtidxs.size()) - col_begin);
+
+				A.resize(d, num_rows);
+				for (index_t ii = 0; ii < num_rows; ++ii)
+					A.col(ii) = eigen_LX.col(iidxs[row_begin + ii]);
+				B.resize(d, num_cols);
+				for (index_t jj = 0; jj < num_cols; ++jj)
+					B.col(jj) = eigen_LX.col(gtidxs[col_begin + jj]);
+
+				// squared distances of the tile with one matrix product
+				dists.noalias() = -2.0 * A.transpose() * B;
+
+				for (index_t jj = 0; jj < num_cols; ++jj)
 				{
-					// FIXME study if using upper bounded distances can be an improvement
-					float64_t distance = euclidean->distance(ii,jj);
-
-					if (distance <= sqdists(j,iidxs[ii]))
-						N.insert( CImpostorNode(iidxs[ii], target_nn(j,iidxs[ii]), gtidxs[jj]) );
-
-					if (distance <= sqdists(j,gtidxs[jj]))
-						N.insert( CImpostorNode(gtidxs[jj], target_nn(j,gtidxs[jj]), iidxs[ii]) );
+					index_t gt = gtidxs[col_begin + jj];
+					for (index_t ii = 0; ii < num_rows; ++ii)
+					{
+						index_t ex = iidxs[row_begin + ii];
+						float64_t distance =
+						    sqnorms[ex] + sqnorms[gt] + dists(ii, jj);
+
+						if (distance <= max_sqdists[ex])
+						{
+							for (int32_t j = 0; j < k; ++j)
+							{
+								if (distance <= sqdists(j, ex))
+									local.emplace_back(ex, target_nn(j, ex), gt);
+							}
+						}
+
+						if (distance <= max_sqdists[gt])
+						{
+							for (int32_t j = 0; j < k; ++j)
+							{
+								if (distance <= sqdists(j, gt))
+									local.emplace_back(gt, target_nn(j, gt), ex);
+							}
+						}
+					}
 				}
 			}
-		}
-
 
+#pragma omp critical
+			N.insert(N.end(), local.begin(), local.end());
+		}
 	}
 
+	// keep the set sorted and free of repeated triplets
+	std::sort(N.begin(), N.end());
+	N.erase(
+	    std::unique(
+	        N.begin(), N.end(),
+	        [](const CImpostorNode& lhs, const CImpostorNode& rhs) {
+		        return !(lhs < rhs) && !(rhs < lhs);
+	        }),
+	    N.end());
 
 	SG_TRACE("Leaving LMNNImpl::find_impostors_exact().");
 
@@ -467,26 +563,27 @@ ImpostorsSetType LMNNImpl::find_impostors_approx(
 	SG_TRACE("Entering LMNNImpl::find_impostors_approx().");
 
 	// initialize empty impostors set
-	ImpostorsSetType N = ImpostorsSetType();
+	ImpostorsSetType N;
 
 	// compute square distances from examples to impostors
 	SGVector<float64_t> impostors_sqdists = LMNNImpl::compute_impostors_sqdists(LX,Nexact);
 
-	// find in the exact set of impostors computed last, the triplets that remain impostors
-	index_t i = 0;
-	for (ImpostorsSetType::iterator it = Nexact.begin(); it != Nexact.end(); ++it)
+	// find in the exact set of impostors computed last, the triplets that remain
+	// impostors; the order, and thus sorting, of the exact set is preserved
+	for (index_t i = 0; i < index_t(Nexact.size()); ++i)
 	{
-		// find in target_nn(:,it->example) the position of the target neighbor it->target
+		const auto& node = Nexact[i];
+		// find in target_nn(:,node.example) the position of the target neighbor node.target
 		index_t target_idx = 0;
-		while (target_nn(target_idx, it->example)!=it->target && target_idx<target_nn.num_rows)
+		while (target_idx<target_nn.num_rows && target_nn(target_idx, node.example)!=node.target)
 			++target_idx;
 
 		require(target_idx<target_nn.num_rows, "The index of the target neighbour in the "
 				"impostors set was not found in the target neighbours matrix. "
 				"There must be a bug in find_impostors_exact.");
 
-		if ( impostors_sqdists[i++] <= sqdists(target_idx, it->example) )
-			N.insert(*it);
+		if (impostors_sqdists[i] <= sqdists(target_idx, node.example))
+			N.push_back(node);
 	}
 
 	SG_TRACE("Leaving LMNNImpl::find_impostors_approx().");
@@ -498,24 +595,19 @@ SGVector<float64_t> LMNNImpl::compute_impostors_sqdists(
     const SGMatrix<float64_t>& LX, const ImpostorsSetType& Nexact)
 {
 	// get the number of impostors
-	size_t num_impostors = Nexact.size();
+	index_t num_impostors = Nexact.size();
 
 	/// compute square distances to impostors
-
-	// create Shogun features from LX and distance
-	auto lx = std::make_shared<DenseFeatures<float64_t>>(LX);
-	auto euclidean = std::make_shared<EuclideanDistance>(lx,lx);
-	euclidean->set_disable_sqrt(true);
-
-	// initialize vector of square distances
+	Map<MatrixXd> eigen_LX(LX.matrix, LX.num_rows, LX.num_cols);
 	SGVector<float64_t> sqdists(num_impostors);
-	// compute square distances
-	index_t i = 0;
-	for (ImpostorsSetType::iterator it = Nexact.begin(); it != Nexact.end(); ++it)
-		sqdists[i++] = euclidean->distance(it->example,it->impostor);
-
-	// clean up distance
 
+#pragma omp parallel for
+	for (index_t i = 0; i < num_impostors; ++i)
+	{
+		sqdists[i] = (eigen_LX.col(Nexact[i].example) -
+		              eigen_LX.col(Nexact[i].impostor))
+		                 .squaredNorm();
+	}
 
 	return sqdists;
 }
@@ -549,17 +641,3 @@ std::vector<index_t> LMNNImpl::get_examples_gtlabel(const std::shared_ptr<Multic
 
 	return idxs;
 }
-
-std::shared_ptr<EuclideanDistance> LMNNImpl::setup_distance(const std::shared_ptr<DenseFeatures<float64_t>>& x,
-		std::vector<index_t>& a, std::vector<index_t>& b)
-{
-	// create new features only containing examples whose indices are in a
-	auto afeats = view(x, SGVector<index_t>(a.data(), a.size(), false));
-
-	// create new features only containing examples whose indices are in b
-	auto bfeats = view(x, SGVector<index_t>(b.data(), b.size(), false));
-
-	// create and return distance
-	return std::make_shared<EuclideanDistance>(afeats,bfeats);
-}
-
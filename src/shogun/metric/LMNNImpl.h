@@ -16,7 +16,6 @@
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/distance/EuclideanDistance.h>
 
-#include <set>
 #include <vector>
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -26,7 +25,8 @@ namespace shogun
 
 struct CImpostorNode;
 
-typedef std::set<CImpostorNode> ImpostorsSetType;
+/** impostor triplets, kept as a flat array sorted by CImpostorNode::operator< */
+typedef std::vector<CImpostorNode> ImpostorsSetType;
 
 /**
  * Struct ImpostorNode used to represent the sets of impostors. Each of the elements
@@ -160,13 +160,6 @@ class LMNNImpl
 		/** get the indices of the examples whose label is greater than yi */
 		static std::vector<index_t> get_examples_gtlabel(const std::shared_ptr<MulticlassLabels>& y, float64_t yi);
 
-		/**
-		 * create Euclidean distance where the lhs features are the features in x indexed
-		 * by the elements in a, and the rhs features are the ones indexed by b; caller
-		 * is responsible of releasing memory
-		 */
-		static std::shared_ptr<EuclideanDistance> setup_distance(const std::shared_ptr<DenseFeatures<float64_t>>& x, std::vector<index_t>& a, std::vector<index_t>& b);
-
 		/**
 		 * check that k is less than the minimum number of examples in any
 		 * class.
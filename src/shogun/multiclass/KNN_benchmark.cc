@@ -0,0 +1,26 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/multiclass/KNN.h>
+#include <shogun/util/Learner_benchmark.h>
+
+namespace shogun
+{
+
+BENCHMARK_DEFINE_F(LearnerFixture, KNN_train_apply)(benchmark::State& st)
+{
+	for (auto _ : st)
+	{
+		auto distance = std::make_shared<EuclideanDistance>();
+		auto knn = std::make_shared<KNN>(5, distance, multiclass_labels);
+		knn->train(features);
+		benchmark::DoNotOptimize(knn->apply_multiclass(features));
+	}
+	report(st);
+}
+
+LEARNER_BENCHMARK(KNN_train_apply, 8192);
+
+}
@@ -70,3 +70,34 @@ void MulticlassStrategy::train_stop()
     m_train_labels = NULL;
     m_orig_labels = NULL;
 }
+
+std::vector<MulticlassTrainTask> MulticlassStrategy::get_train_tasks(
+    std::shared_ptr<MulticlassLabels> orig_labels)
+{
+	auto train_labels =
+	    std::make_shared<BinaryLabels>(orig_labels->get_num_labels());
+	std::vector<MulticlassTrainTask> tasks;
+
+	train_start(std::move(orig_labels), train_labels);
+	while (train_has_more())
+	{
+		MulticlassTrainTask task;
+		task.subset = train_prepare_next();
+
+		// train_prepare_next overwrites the labels of the previous phase
+		auto labels = train_labels->get_labels();
+		if (task.subset.vlen)
+		{
+			task.labels = SGVector<float64_t>(task.subset.vlen);
+			for (index_t i = 0; i < task.subset.vlen; ++i)
+				task.labels[i] = labels[task.subset[i]];
+		}
+		else
+			task.labels = labels.clone();
+
+		tasks.push_back(task);
+	}
+	train_stop();
+
+	return tasks;
+}
@@ -16,6 +16,8 @@
 #include <shogun/multiclass/RejectionStrategy.h>
 #include <shogun/mathematics/Statistics.h>
 
+#include <vector>
+
 namespace shogun
 {
 
@@ -39,6 +41,17 @@ enum EProbHeuristicType
 	OVO_HAMAMURA = 5
 };
 
+/** @brief training problem of one binary submachine of a
+ * MulticlassStrategy
+ */
+struct MulticlassTrainTask
+{
+	/** indices of the training vectors, empty for all vectors */
+	SGVector<int32_t> subset;
+	/** binary labels of the vectors in subset */
+	SGVector<float64_t> labels;
+};
+
 /** @brief class MulticlassStrategy used to construct generic
  * multiclass classifiers with ensembles of binary classifiers
  */
@@ -103,6 +116,16 @@ public:
 	/** finish training, release resources */
 	virtual void train_stop();
 
+	/** Runs a complete training phase and collects the training problem
+	 * of every submachine. The problems are independent of each other,
+	 * so that the submachines can be trained concurrently.
+	 *
+	 * @param orig_labels multiclass labels to train on
+	 * @return training problem of every submachine (in that order)
+	 */
+	std::vector<MulticlassTrainTask> get_train_tasks(
+	    std::shared_ptr<MulticlassLabels> orig_labels);
+
 	/** decide the final label.
 	 * @param outputs a vector of output from each machine (in that order)
 	 */
@@ -45,6 +45,21 @@ const float64_t CARTree::MISSING=Math::MAX_REAL_NUMBER;
 const float64_t CARTree::EQ_DELTA=1e-7;
 const float64_t CARTree::MIN_SPLIT_GAIN=1e-7;
 
+/** the dense float64 features, float32 features are widened once so that
+ * the splits are computed in float64
+ */
+static std::shared_ptr<DenseFeatures<float64_t>>
+float64_features(const std::shared_ptr<Features>& data)
+{
+	if (data->get_feature_class()==C_DENSE &&
+		data->get_feature_type()==F_SHORTREAL)
+	{
+		return std::make_shared<DenseFeatures<float64_t>>(
+			data->as<DotFeatures>()->get_computed_dot_feature_matrix());
+	}
+	return data->as<DenseFeatures<float64_t>>();
+}
+
 CARTree::CARTree() : RandomMixin<FeatureImportanceTree<CARTreeNodeData>>()
 {
 	init();
@@ -130,7 +145,7 @@ std::shared_ptr<MulticlassLabels> CARTree::apply_multiclass(std::shared_ptr<Feat
 	}
 	else
 		return apply_from_current_node(
-		           data->as<DenseFeatures<float64_t>>(), current)
+		           float64_features(data), current)
 		    ->as<MulticlassLabels>();
 }
 
@@ -140,7 +155,7 @@ std::shared_ptr<RegressionLabels> CARTree::apply_regression(std::shared_ptr<Feat
 
 	// apply regression starting from root
 	auto current=get_root()->as<bnode_t>();
-	return apply_from_current_node(data->as<DenseFeatures<float64_t>>(), current)->as<RegressionLabels>();
+	return apply_from_current_node(float64_features(data), current)->as<RegressionLabels>();
 }
 
 void CARTree::prune_using_test_dataset(const std::shared_ptr<DenseFeatures<float64_t>>& feats, const std::shared_ptr<Labels>& gnd_truth, SGVector<float64_t> weights)
@@ -260,7 +275,7 @@ bool CARTree::train_machine(std::shared_ptr<Features> data)
 	require(data,"Data required for training");
 	require(data->get_feature_class()==C_DENSE,"Dense data required for training");
 
-	auto dense_features = data->as<DenseFeatures<float64_t>>();
+	auto dense_features = float64_features(data);
 	auto num_features = dense_features->get_num_features();
 	auto num_vectors = dense_features->get_num_vectors();
 	if (weights_set())
@@ -324,7 +339,7 @@ void CARTree::set_sorted_features(SGMatrix<float64_t>& sorted_feats, SGMatrix<in
 
 void CARTree::pre_sort_features(const std::shared_ptr<Features>& data, SGMatrix<float64_t>& sorted_feats, SGMatrix<index_t>& sorted_indices)
 {
-	SGMatrix<float64_t> mat=(data)->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+	SGMatrix<float64_t> mat=float64_features(data)->get_feature_matrix();
 	sorted_feats = SGMatrix<float64_t>(mat.num_cols, mat.num_rows);
 	sorted_indices = SGMatrix<index_t>(mat.num_cols, mat.num_rows);
 	for(int32_t i=0; i<sorted_indices.num_cols; i++)
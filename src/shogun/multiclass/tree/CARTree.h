@@ -81,6 +81,9 @@ namespace shogun
  * assigned left/right child, majority rule is used, ie. the data points are assigned the child where majority of data points
  * have gone from the node. \n
  * cf. http://pic.dhe.ibm.com/infocenter/spssstat/v20r0m0/index.jsp?topic=%2Fcom.ibm.spss.statistics.help%2Falg_tree-cart.htm
+ * \n \n
+ * Dense float32 features are copied into float64 features once for training and application, so the splits are computed
+ * in float64. Missing values have to be given as float64 features.
  */
 class CARTree : public RandomMixin<FeatureImportanceTree<CARTreeNodeData>>
 {
@@ -107,16 +107,7 @@ bool Autoencoder::train(std::shared_ptr<Features> data)
 		input_layer->gaussian_noise = m_noise_parameter;
 	}
 
-	for (int32_t i=0; i<m_num_layers-1; i++)
-	{
-		get_layer(i)->dropout_prop =
-			get_layer(i)->is_input() ? m_dropout_input : m_dropout_hidden;
-	}
-	get_layer(m_num_layers-1)->dropout_prop = 0.0;
-
-	m_is_training = true;
-	for (int32_t i=0; i<m_num_layers; i++)
-		get_layer(i)->is_training = true;
+	begin_training();
 
 	bool result = false;
 	if (m_optimization_method==NNOM_GRADIENT_DESCENT)
@@ -124,9 +115,7 @@ bool Autoencoder::train(std::shared_ptr<Features> data)
 	else if (m_optimization_method==NNOM_LBFGS)
 		result = train_lbfgs(inputs, inputs);
 
-	for (int32_t i=0; i<m_num_layers; i++)
-		get_layer(i)->is_training = false;
-	m_is_training = false;
+	end_training();
 
 	if (m_noise_type==AENT_GAUSSIAN)
 	{
@@ -151,15 +140,13 @@ std::shared_ptr<DenseFeatures< float64_t >> Autoencoder::reconstruct(
 	return std::make_shared<DenseFeatures<float64_t>>(reconstructed);
 }
 
-float64_t Autoencoder::compute_error(SGMatrix< float64_t > targets)
+float64_t Autoencoder::compute_contraction_error(
+	const std::vector<std::shared_ptr<NeuralLayer>>& layers)
 {
-	float64_t error = NeuralNetwork::compute_error(targets);
-
-	if (m_contraction_coefficient != 0.0)
-		error +=
-			get_layer(1)->compute_contraction_term(get_section(m_params,1));
+	if (m_contraction_coefficient == 0.0)
+		return 0.0;
 
-	return error;
+	return layers[1]->compute_contraction_term(get_section(m_params,1));
 }
 
 template <class T>
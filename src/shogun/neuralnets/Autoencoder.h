@@ -204,13 +204,13 @@ public:
 	}
 
 protected:
-	/** Computes the error between the output layer's activations and the given
-	 * target activations.
+	/** Computes the contraction term of the error from the activations of
+	 * the given layers
 	 *
-	 * @param targets desired values for the network's output, matrix of size
-	 * num_neurons_output_layer*batch_size
+	 * @param layers layers whose activations are used
 	 */
-	virtual float64_t compute_error(SGMatrix<float64_t> targets);
+	virtual float64_t compute_contraction_error(
+		const std::vector<std::shared_ptr<NeuralLayer>>& layers);
 
 private:
 	void init();
@@ -121,6 +121,7 @@ void NeuralLayer::init()
 	contraction_coefficient = 0.0;
 	is_training = false;
 	autoencoder_position = NLAP_NONE;
+	single_precision = false;
 
 	SG_ADD(&m_num_neurons, "num_neurons", "Number of Neurons");
 	SG_ADD(&m_width, "width", "Width");
@@ -132,6 +133,9 @@ void NeuralLayer::init()
 	    &contraction_coefficient, "contraction_coefficient",
 	    "Contraction Coefficient");
 	SG_ADD(&is_training, "is_training", "is_training");
+	SG_ADD(
+	    &single_precision, "single_precision",
+	    "Whether matrix products are computed in float32");
 	SG_ADD(&m_batch_size, "batch_size", "Batch Size");
 	SG_ADD(&m_activations, "activations", "Activations");
 	SG_ADD(
@@ -344,6 +344,12 @@ public:
 	 */
 	ENLAutoencoderPosition autoencoder_position;
 
+	/** If true, layers that support it compute their matrix products in
+	 * float32, parameters and activations are rounded to single precision
+	 * for the product. Default value is false
+	 */
+	bool single_precision;
+
 protected:
 	/** Number of neurons in this layer */
 	int32_t m_num_neurons;
@@ -34,12 +34,29 @@
 #include <shogun/neuralnets/NeuralLinearLayer.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/lib/SGVector.h>
+#include <shogun/lib/WorkspacePool.h>
 
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/NormalDistribution.h>
 
 using namespace shogun;
 
+typedef Eigen::Map<Eigen::MatrixXf> SingleMappedMatrix;
+
+/** maps a float32 workspace matrix */
+static SingleMappedMatrix single_map(SGMatrix<float32_t>& m)
+{
+	return SingleMappedMatrix(m.matrix, m.num_rows, m.num_cols);
+}
+
+/** float32 copy of a matrix, drawn from the workspace pool */
+static SGMatrix<float32_t> to_single(const Eigen::Map<Eigen::MatrixXd>& m)
+{
+	auto result = workspace::matrix<float32_t>(m.rows(), m.cols());
+	single_map(result) = m.cast<float32_t>();
+	return result;
+}
+
 NeuralLinearLayer::NeuralLinearLayer() : NeuralLayer()
 {
 }
@@ -101,7 +118,18 @@ void NeuralLinearLayer::compute_activations(
 		EMappedMatrix X(layer->get_activations().matrix,
 				layer->get_num_neurons(), m_batch_size);
 
-		A += W*X;
+		if (single_precision)
+		{
+			auto W_single = to_single(W);
+			auto X_single = to_single(X);
+			auto product =
+			    workspace::matrix<float32_t>(m_num_neurons, m_batch_size);
+			single_map(product).noalias() =
+			    single_map(W_single) * single_map(X_single);
+			A += single_map(product).cast<float64_t>();
+		}
+		else
+			A += W*X;
 
 	}
 }
@@ -151,6 +179,28 @@ void NeuralLinearLayer::compute_gradients(
 		EMappedMatrix  IG(layer->get_activation_gradients().matrix,
 				layer->get_num_neurons(), m_batch_size);
 
+		if (single_precision)
+		{
+			auto LG_single = to_single(LG);
+			auto X_single = to_single(X);
+			auto WG_single =
+			    workspace::matrix<float32_t>(WG.rows(), WG.cols());
+			single_map(WG_single).noalias() =
+			    single_map(LG_single) * single_map(X_single).transpose();
+			WG = single_map(WG_single).cast<float64_t>();
+
+			if (!layer->is_input())
+			{
+				auto W_single = to_single(W);
+				auto IG_single =
+				    workspace::matrix<float32_t>(IG.rows(), IG.cols());
+				single_map(IG_single).noalias() =
+				    single_map(W_single).transpose() * single_map(LG_single);
+				IG += single_map(IG_single).cast<float64_t>();
+			}
+			continue;
+		}
+
 		// compute weight gradients
 		WG = LG*X.transpose();
 
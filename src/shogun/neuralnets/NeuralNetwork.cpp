@@ -33,6 +33,7 @@
 
 #include <shogun/base/progress.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/lib/WorkspacePool.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/mathematics/UniformRealDistribution.h>
@@ -245,6 +246,21 @@ bool NeuralNetwork::train_machine(std::shared_ptr<Features> data)
 	SGMatrix<float64_t> inputs = features_to_matrix(data);
 	SGMatrix<float64_t> targets = labels_to_matrix(m_labels);
 
+	begin_training();
+
+	bool result = false;
+	if (m_optimization_method==NNOM_GRADIENT_DESCENT)
+		result = train_gradient_descent(inputs, targets);
+	else if (m_optimization_method==NNOM_LBFGS)
+		result = train_lbfgs(inputs, targets);
+
+	end_training();
+
+	return result;
+}
+
+void NeuralNetwork::begin_training()
+{
 	for (int32_t i=0; i<m_num_layers-1; i++)
 	{
 		get_layer(i)->dropout_prop =
@@ -254,19 +270,33 @@ bool NeuralNetwork::train_machine(std::shared_ptr<Features> data)
 
 	m_is_training = true;
 	for (int32_t i=0; i<m_num_layers; i++)
+	{
 		get_layer(i)->is_training = true;
+		get_layer(i)->single_precision = m_single_precision;
+	}
 
-	bool result = false;
-	if (m_optimization_method==NNOM_GRADIENT_DESCENT)
-		result = train_gradient_descent(inputs, targets);
-	else if (m_optimization_method==NNOM_LBFGS)
-		result = train_lbfgs(inputs, targets);
+	// replicas are copies of the layers, they are recreated with the
+	// current dropout, noise and precision settings
+	reset_replicas();
+}
 
+void NeuralNetwork::end_training()
+{
 	for (int32_t i=0; i<m_num_layers; i++)
+	{
 		get_layer(i)->is_training = false;
+		get_layer(i)->single_precision = false;
+	}
 	m_is_training = false;
 
-	return result;
+	reset_replicas();
+}
+
+void NeuralNetwork::reset_replicas()
+{
+	m_replicas.clear();
+	m_replica_gradients = SGMatrix<float64_t>();
+	m_replica_batch_size = 0;
 }
 
 bool NeuralNetwork::train_gradient_descent(SGMatrix<float64_t> inputs,
@@ -284,6 +314,9 @@ bool NeuralNetwork::train_gradient_descent(SGMatrix<float64_t> inputs,
 	int32_t n_param = get_num_parameters();
 	SGVector<float64_t> gradients(n_param);
 
+	// recycles the temporaries of the layers across batches
+	WorkspaceScope scope;
+
 	// needed for momentum
 	SGVector<float64_t> param_updates(n_param);
 	param_updates.zero();
@@ -379,6 +412,7 @@ bool NeuralNetwork::train_lbfgs(SGMatrix<float64_t> inputs,
 	m_lbfgs_temp_inputs = &inputs;
 	m_lbfgs_temp_targets = &targets;
 
+	WorkspaceScope scope;
 	int32_t result = lbfgs(m_total_num_parameters,
 			m_params,
 			NULL,
@@ -476,6 +510,17 @@ SGMatrix<float64_t> NeuralNetwork::forward_propagate(
 float64_t NeuralNetwork::compute_gradients(SGMatrix<float64_t> inputs,
 		SGMatrix<float64_t> targets, SGVector<float64_t> gradients)
 {
+	if (m_parallel_training && m_is_training)
+	{
+		// shards smaller than this do not pay off the extra reduction
+		const int32_t min_shard_size = 16;
+		int32_t num_shards = std::min(
+			env()->get_num_threads(), inputs.num_cols / min_shard_size);
+		if (num_shards > 1)
+			return compute_gradients_parallel(
+				inputs, targets, gradients, num_shards);
+	}
+
 	forward_propagate(inputs);
 
 	for (int32_t i=0; i<m_num_layers; i++)
@@ -494,6 +539,124 @@ float64_t NeuralNetwork::compute_gradients(SGMatrix<float64_t> inputs,
 				SGMatrix<float64_t>(), m_layers, get_section(gradients,i));
 	}
 
+	add_regularization_gradients(gradients);
+
+	return compute_error(targets);
+}
+
+float64_t NeuralNetwork::compute_gradients_parallel(SGMatrix<float64_t> inputs,
+		SGMatrix<float64_t> targets, SGVector<float64_t> gradients,
+		int32_t num_shards)
+{
+	int32_t batch_size = inputs.num_cols;
+	init_replicas(num_shards, batch_size);
+
+	SGVector<float64_t> errors(num_shards);
+
+	#pragma omp parallel for num_threads(num_shards)
+	for (int32_t t=0; t<num_shards; t++)
+	{
+		int32_t begin = (int64_t)batch_size*t/num_shards;
+		int32_t end = (int64_t)batch_size*(t+1)/num_shards;
+		const auto& layers = m_replicas[t];
+
+		SGMatrix<float64_t> shard_inputs(inputs.get_column_vector(begin),
+			inputs.num_rows, end-begin, false);
+		SGMatrix<float64_t> shard_targets(targets.get_column_vector(begin),
+			targets.num_rows, end-begin, false);
+		SGVector<float64_t> shard_gradients(
+			m_replica_gradients.get_column_vector(t), m_total_num_parameters,
+			false);
+
+		for (int32_t i=0; i<m_num_layers; i++)
+		{
+			if (layers[i]->is_input())
+				layers[i]->compute_activations(shard_inputs);
+			else
+				layers[i]->compute_activations(get_section(m_params, i), layers);
+
+			layers[i]->dropout_activations();
+		}
+
+		for (int32_t i=0; i<m_num_layers; i++)
+		{
+			if (!layers[i]->is_input())
+				layers[i]->get_activation_gradients().zero();
+		}
+
+		for (int32_t i=m_num_layers-1; i>=0; i--)
+		{
+			layers[i]->compute_gradients(get_section(m_params,i),
+				i==m_num_layers-1 ? shard_targets : SGMatrix<float64_t>(),
+				layers, get_section(shard_gradients,i));
+		}
+
+		// layers average over their shard, reweight to the whole batch. The
+		// contraction term is an average over the shard's activations too
+		float64_t weight = (float64_t)(end-begin)/batch_size;
+		errors[t] = weight*(
+			layers[m_num_layers-1]->compute_error(shard_targets) +
+			compute_contraction_error(layers));
+		for (int32_t k=0; k<m_total_num_parameters; k++)
+			shard_gradients[k] *= weight;
+	}
+
+	#pragma omp parallel for
+	for (int32_t k=0; k<m_total_num_parameters; k++)
+	{
+		float64_t sum = 0;
+		for (int32_t t=0; t<num_shards; t++)
+			sum += m_replica_gradients(k, t);
+		gradients[k] = sum;
+	}
+
+	add_regularization_gradients(gradients);
+
+	return SGVector<float64_t>::sum(errors) + compute_regularization_error();
+}
+
+void NeuralNetwork::init_replicas(int32_t num_shards, int32_t batch_size)
+{
+	if ((int32_t)m_replicas.size()==num_shards &&
+		m_replica_batch_size==batch_size)
+		return;
+
+	m_replicas.resize(num_shards);
+	for (int32_t t=0; t<num_shards; t++)
+	{
+		auto& layers = m_replicas[t];
+		if (layers.empty())
+		{
+			for (int32_t i=0; i<m_num_layers; i++)
+			{
+				auto layer = get_layer(i)->clone()->as<NeuralLayer>();
+				random::seed(layer, m_prng);
+				layers.push_back(layer);
+			}
+
+			for (int32_t i=0; i<m_num_layers; i++)
+			{
+				if (!layers[i]->is_input())
+					layers[i]->initialize_neural_layer(
+						layers, layers[i]->get_input_indices());
+			}
+		}
+
+		int32_t shard_size = (int64_t)batch_size*(t+1)/num_shards -
+			(int64_t)batch_size*t/num_shards;
+		for (auto& layer : layers)
+			layer->set_batch_size(shard_size);
+	}
+
+	m_replica_gradients =
+		SGMatrix<float64_t>(m_total_num_parameters, num_shards);
+	m_replica_batch_size = batch_size;
+	SG_DEBUG("Splitting batches of {} vectors into {} shards", batch_size,
+		num_shards);
+}
+
+void NeuralNetwork::add_regularization_gradients(SGVector<float64_t> gradients)
+{
 	// L2 regularization
 	if (m_l2_coefficient != 0.0)
 	{
@@ -524,13 +687,17 @@ float64_t NeuralNetwork::compute_gradients(SGMatrix<float64_t> inputs,
 			get_layer(i)->enforce_max_norm(layer_params, m_max_norm);
 		}
 	}
-
-	return compute_error(targets);
 }
 
 float64_t NeuralNetwork::compute_error(SGMatrix<float64_t> targets)
 {
-	float64_t error = get_layer(m_num_layers-1)->compute_error(targets);
+	return get_layer(m_num_layers-1)->compute_error(targets) +
+		compute_regularization_error() + compute_contraction_error(m_layers);
+}
+
+float64_t NeuralNetwork::compute_regularization_error()
+{
+	float64_t error = 0.0;
 
 	// L2 regularization
 	if (m_l2_coefficient != 0.0)
@@ -624,17 +791,22 @@ void NeuralNetwork::set_batch_size(int32_t batch_size)
 SGMatrix<float64_t> NeuralNetwork::features_to_matrix(const std::shared_ptr<Features>& features)
 {
 	require(features != NULL, "Invalid (NULL) feature pointer");
-	require(features->get_feature_type() == F_DREAL,
-		"Feature type must be F_DREAL");
+	require(features->get_feature_type() == F_DREAL ||
+		features->get_feature_type() == F_SHORTREAL,
+		"Feature type must be F_DREAL or F_SHORTREAL");
 	require(features->get_feature_class() == C_DENSE,
 		"Feature class must be C_DENSE");
 
-	auto inputs = features->as<DenseFeatures<float64_t>>();
-	require(inputs->get_num_features()==m_num_inputs,
+	auto inputs = features->as<DotFeatures>();
+	require(inputs->get_dim_feature_space()==m_num_inputs,
 		"Number of features ({}) must match the network's number of inputs "
-		"({})", inputs->get_num_features(), get_num_inputs());
+		"({})", inputs->get_dim_feature_space(), get_num_inputs());
+
+	if (features->get_feature_type() == F_DREAL)
+		return features->as<DenseFeatures<float64_t>>()->get_feature_matrix();
 
-	return inputs->get_feature_matrix();
+	// float32 inputs are widened once, the layers compute in float64
+	return inputs->get_computed_dot_feature_matrix();
 }
 
 SGMatrix<float64_t> NeuralNetwork::labels_to_matrix(const std::shared_ptr<Labels>& labs)
@@ -787,6 +959,9 @@ void NeuralNetwork::init()
 	m_auto_quick_initialize = true;
 	m_sigma = 0.01f;
 	m_layers.clear();
+	m_parallel_training = false;
+	m_single_precision = false;
+	m_replica_batch_size = 0;
 
 	SG_ADD_OPTIONS(
 	    (machine_int_t*)&m_optimization_method, "optimization_method",
@@ -832,6 +1007,12 @@ void NeuralNetwork::init()
 	    "auto_quick_initialize");
 	SG_ADD(&m_is_training, "is_training", "is_training");
 	SG_ADD(&m_sigma, "sigma", "sigma");
+	SG_ADD(
+	    &m_parallel_training, "parallel_training",
+	    "Whether batches are split across threads during training");
+	SG_ADD(
+	    &m_single_precision, "single_precision",
+	    "Whether layers compute in float32 during training");
 
 	watch_method("layer_parameters", &NeuralNetwork::get_layer_parameters);
 }
@@ -80,7 +80,8 @@ enum ENNOptimizationMethod
  * The network can also be initialized from a JSON file using
  * NeuralNetworkFileReader.
  *
- * Supported feature types: DenseFeatures<float64_t>
+ * Supported feature types: DenseFeatures<float64_t>, DenseFeatures<float32_t>
+ * (widened to float64 when passed to the input layers)
  * Supported label types:
  * 	- BinaryLabels
  * 	- MulticlassLabels
@@ -106,6 +107,14 @@ enum ENNOptimizationMethod
  *
  * When implemnting new layer types, the function check_gradients() can be used
  * to make sure the gradient computations are correct.
+ *
+ * With set_parallel_training(), every (mini-)batch is split into one shard per
+ * thread during training. Each thread propagates its shard through its own
+ * copy of the layers, whose activation and gradient buffers are kept across
+ * iterations, and writes into its own gradient buffer. The buffers are then
+ * summed, weighted by the shard sizes, so the result is the gradient of the
+ * whole batch. With set_single_precision(), the matrix products of the layers
+ * are computed in float32.
  */
 class NeuralNetwork : public RandomMixin<Machine>
 {
@@ -467,6 +476,41 @@ public:
 		return m_gd_error_damping_coeff;
 	}
 
+	/** Sets whether the batches are split across threads during training
+	 *
+	 * default value is false
+	 *
+	 * @param parallel_training whether to compute gradients in parallel
+	 */
+	void set_parallel_training(bool parallel_training)
+	{
+		m_parallel_training = parallel_training;
+	}
+
+	/** Returns whether the batches are split across threads during training */
+	bool get_parallel_training() const
+	{
+		return m_parallel_training;
+	}
+
+	/** Sets whether the layers compute their matrix products in float32
+	 * during training. Parameters are still updated in float64.
+	 *
+	 * default value is false
+	 *
+	 * @param single_precision whether to compute in float32
+	 */
+	void set_single_precision(bool single_precision)
+	{
+		m_single_precision = single_precision;
+	}
+
+	/** Returns whether the layers compute in float32 during training */
+	bool get_single_precision() const
+	{
+		return m_single_precision;
+	}
+
 protected:
 	/** trains the network */
 	virtual bool train_machine(std::shared_ptr<Features> data=NULL);
@@ -528,6 +572,58 @@ protected:
 	virtual float64_t compute_gradients(SGMatrix<float64_t> inputs,
 			SGMatrix<float64_t> targets, SGVector<float64_t> gradients);
 
+	/** Same as compute_gradients(), with the batch split into num_shards
+	 * shards that are propagated in parallel through copies of the layers
+	 *
+	 * @param inputs inputs to the network, a matrix of size
+	 * m_num_inputs*batch_size
+	 *
+	 * @param targets desired values for the output layer's activations
+	 *
+	 * @param gradients array to be filled with gradient values.
+	 *
+	 * @param num_shards number of shards
+	 *
+	 * @return error between the targets and the activations of the last layer
+	 */
+	float64_t compute_gradients_parallel(SGMatrix<float64_t> inputs,
+			SGMatrix<float64_t> targets, SGVector<float64_t> gradients,
+			int32_t num_shards);
+
+	/** Prepares the layers for training: sets their dropout probabilities,
+	 * training mode and precision, and drops the layer replicas of a
+	 * previous training run
+	 */
+	void begin_training();
+
+	/** Resets the layers after training and releases the layer replicas */
+	void end_training();
+
+	/** Adds the gradients of the L2 and L1 regularization terms, and applies
+	 * max-norm regularization to the parameters
+	 *
+	 * @param gradients gradients of the error
+	 */
+	void add_regularization_gradients(SGVector<float64_t> gradients);
+
+	/** Computes the part of the error that depends only on the parameters,
+	 * i.e the L2 and L1 regularization terms
+	 */
+	virtual float64_t compute_regularization_error();
+
+	/** Computes the contraction term of the error, which depends on the
+	 * activations of the given layers. Zero for networks without a
+	 * contraction term.
+	 *
+	 * @param layers layers whose activations are used, either the network's
+	 * layers or the replica of one shard of the batch
+	 */
+	virtual float64_t compute_contraction_error(
+		const std::vector<std::shared_ptr<NeuralLayer>>& layers)
+	{
+		return 0.0;
+	}
+
 	/** Forward propagates the inputs and computes the error between the output
 	 * layer's activations and the given target activations.
 	 *
@@ -554,7 +650,8 @@ protected:
 	std::shared_ptr<NeuralLayer> get_layer(int32_t i) const;
 
 	/** Ensures the given features are suitable for use with the network and
-	 * returns their feature matrix
+	 * returns their feature matrix, float32 features are copied into a
+	 * float64 matrix
 	 */
 	SGMatrix<float64_t> features_to_matrix(const std::shared_ptr<Features>& features);
 
@@ -591,6 +688,14 @@ private:
 	template<class T>
 	SGVector<T> get_section(SGVector<T> v, int32_t i) const;
 
+	/** Creates a copy of the layers and a gradient buffer for each shard,
+	 * unless they exist already for the given batch size
+	 */
+	void init_replicas(int32_t num_shards, int32_t batch_size);
+
+	/** Releases the layer replicas and their gradient buffer */
+	void reset_replicas();
+
 protected:
 	/** number of neurons in the input layer */
 	int32_t m_num_inputs;
@@ -731,7 +836,26 @@ protected:
 	 */
 	float64_t m_gd_error_damping_coeff;
 
+	/** whether batches are split across threads during training,
+	 * default value is false
+	 */
+	bool m_parallel_training;
+
+	/** whether layers compute in float32 during training,
+	 * default value is false
+	 */
+	bool m_single_precision;
+
 private:
+	/** copies of the layers, one per shard of the batch */
+	std::vector<std::vector<std::shared_ptr<NeuralLayer>>> m_replicas;
+
+	/** batch size the replicas are set up for */
+	int32_t m_replica_batch_size;
+
+	/** gradients of each shard, one column per shard */
+	SGMatrix<float64_t> m_replica_gradients;
+
 	/** temperary pointers to the training data, used to pass the data to L-BFGS
 	 * routines
 	 */
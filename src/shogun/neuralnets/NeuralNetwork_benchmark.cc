@@ -0,0 +1,39 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/neuralnets/NeuralInputLayer.h>
+#include <shogun/neuralnets/NeuralLogisticLayer.h>
+#include <shogun/neuralnets/NeuralNetwork.h>
+#include <shogun/neuralnets/NeuralSoftmaxLayer.h>
+#include <shogun/util/Learner_benchmark.h>
+
+namespace shogun
+{
+
+BENCHMARK_DEFINE_F(LearnerFixture, NeuralNetwork_train_apply)
+(benchmark::State& st)
+{
+	for (auto _ : st)
+	{
+		std::vector<std::shared_ptr<NeuralLayer>> layers;
+		layers.push_back(
+		    std::make_shared<NeuralInputLayer>(features->get_num_features()));
+		layers.push_back(std::make_shared<NeuralLogisticLayer>(32));
+		layers.push_back(std::make_shared<NeuralSoftmaxLayer>(NUM_CLASSES));
+
+		auto network = std::make_shared<NeuralNetwork>(layers);
+		network->put("seed", LEARNER_BENCHMARK_SEED);
+		network->quick_connect();
+		network->initialize_neural_network();
+		network->set_max_num_epochs(20);
+		network->set_labels(multiclass_labels);
+		network->train(features);
+		benchmark::DoNotOptimize(network->apply_multiclass(features));
+	}
+	report(st);
+}
+
+LEARNER_BENCHMARK(NeuralNetwork_train_apply, 8192);
+
+}
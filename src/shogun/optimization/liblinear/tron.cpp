@@ -69,7 +69,7 @@ Tron::~Tron()
 {
 }
 
-void Tron::tron(float64_t *w, float64_t max_train_time)
+void Tron::tron(float64_t *w, float64_t max_train_time, bool warm_start)
 {
 	// Parameters for updating the iterates.
 	float64_t eta0 = 1e-4, eta1 = 0.25, eta2 = 0.75;
@@ -89,14 +89,30 @@ void Tron::tron(float64_t *w, float64_t max_train_time)
 	double *w_new = SG_MALLOC(double, n);
 	double *g = SG_MALLOC(double, n);
 
-	for (i=0; i<n; i++)
-		w[i] = 0;
+	// the stopping criterion is relative to the gradient at zero, also
+	// when starting from a given w, so that warm starts converge to the
+	// same precision
+	float64_t gnorm1;
+	if (warm_start)
+	{
+		for (i=0; i<n; i++)
+			w_new[i] = 0;
+		fun_obj->fun(w_new);
+		fun_obj->grad(w_new, g);
+		gnorm1 = tron_dnrm2(n, g, inc);
+	}
+	else
+	{
+		for (i=0; i<n; i++)
+			w[i] = 0;
+	}
 
 	f = fun_obj->fun(w);
 	fun_obj->grad(w, g);
 	delta = tron_dnrm2(n, g, inc);
-	float64_t gnorm1 = delta;
-	float64_t gnorm = gnorm1;
+	if (!warm_start)
+		gnorm1 = delta;
+	float64_t gnorm = delta;
 
 	if (gnorm <= eps*gnorm1)
 		search = 0;
@@ -70,8 +70,9 @@ public:
 	 *
 	 * @param w w
 	 * @param max_train_time maximum training time
+	 * @param warm_start whether to start from the given w instead of zero
 	 */
-	void tron(float64_t *w, float64_t max_train_time);
+	void tron(float64_t *w, float64_t max_train_time, bool warm_start = false);
 
 	/** @return object name */
 	virtual const char* get_name() const { return "Tron"; }
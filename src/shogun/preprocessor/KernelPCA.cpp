@@ -14,20 +14,26 @@
 #include <string.h>
 #include <utility>
 
+#include <shogun/features/DenseFeatures.h>
 #include <shogun/features/Features.h>
+#include <shogun/features/RandomFourierDotFeatures.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/kernel/GaussianKernel.h>
 #include <shogun/kernel/Kernel.h>
 #include <shogun/lib/common.h>
+#include <shogun/mathematics/RandomNamespace.h>
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
 using namespace shogun;
+using namespace Eigen;
 
-KernelPCA::KernelPCA() : Preprocessor()
+KernelPCA::KernelPCA() : RandomMixin<Preprocessor>()
 {
 	init();
 }
 
-KernelPCA::KernelPCA(std::shared_ptr<Kernel> k) : Preprocessor()
+KernelPCA::KernelPCA(std::shared_ptr<Kernel> k) : RandomMixin<Preprocessor>()
 {
 	init();
 	set_kernel(std::move(k));
@@ -41,6 +47,9 @@ void KernelPCA::init()
 	m_bias_vector = SGVector<float64_t>();
 	m_target_dim = 1;
 	m_kernel = NULL;
+	m_method = KPCA_EXACT;
+	m_num_basis = 100;
+	m_random_coefficients = SGMatrix<float64_t>();
 
 	SG_ADD(&m_transformation_matrix, "transformation_matrix",
 		"matrix used to transform data");
@@ -50,12 +59,24 @@ void KernelPCA::init()
 	    &m_target_dim, "target_dim", "target dimensionality of preprocessor",
 	    ParameterProperties::HYPER);
 	SG_ADD(&m_kernel, "kernel", "kernel to be used", ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_num_basis, "num_basis",
+	    "number of landmarks or random features of approximate methods",
+	    ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_random_coefficients, "random_coefficients",
+	    "coefficients of the random Fourier features");
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_method, "method", "exact or approximate method",
+	    ParameterProperties::NONE,
+	    SG_OPTIONS(KPCA_EXACT, KPCA_NYSTROM, KPCA_RANDOM_FOURIER));
 }
 
 void KernelPCA::cleanup()
 {
 	m_transformation_matrix = SGMatrix<float64_t>();
 	m_bias_vector = SGVector<float64_t>();
+	m_random_coefficients = SGMatrix<float64_t>();
 
 	m_fitted = false;
 }
@@ -72,6 +93,13 @@ void KernelPCA::fit(std::shared_ptr<Features> features)
 	if (m_fitted)
 		cleanup();
 
+	if (m_method != KPCA_EXACT)
+	{
+		fit_approximation(features);
+		m_fitted = true;
+		io::info("Done");
+		return;
+	}
 
 	m_init_features = features;
 
@@ -123,10 +151,215 @@ void KernelPCA::fit(std::shared_ptr<Features> features)
 	io::info("Done");
 }
 
+void KernelPCA::fit_approximation(const std::shared_ptr<Features>& features)
+{
+	int32_t n = features->get_num_vectors();
+	int32_t m = m_num_basis;
+	require(
+	    m <= n || m_method == KPCA_RANDOM_FOURIER,
+	    "Number of landmarks ({}) must not exceed the number of vectors ({})",
+	    m, n);
+	if (m_target_dim > m)
+	{
+		io::warn(
+		    "Target dimension ({}) is not a valid value, it must be "
+		    "less or equal than the number of basis functions. "
+		    "Setting it to maximum allowed size ({}).",
+		    m_target_dim, m);
+		m_target_dim = m;
+	}
+
+	// maps responses to the feature map, K_mm^{-1/2} for Nystroem
+	MatrixXd basis_map = MatrixXd::Identity(m, m);
+	std::shared_ptr<RandomFourierDotFeatures> random_features;
+	if (m_method == KPCA_NYSTROM)
+	{
+		SGVector<index_t> indices(n);
+		indices.range_fill();
+		random::shuffle(indices, m_prng);
+		SGVector<index_t> landmarks(m);
+		std::copy_n(indices.vector, m, landmarks.vector);
+		std::sort(landmarks.begin(), landmarks.end());
+
+		m_init_features = features->copy_subset(landmarks);
+		m_kernel->init(features, m_init_features);
+
+		MatrixXd landmark_kernel(m, m);
+#pragma omp parallel for
+		for (index_t j = 0; j < m; ++j)
+		{
+			for (index_t i = 0; i < m; ++i)
+				landmark_kernel(i, j) = m_kernel->kernel(landmarks[i], j);
+		}
+
+		// pseudo inverse square root, as landmarks may coincide
+		SelfAdjointEigenSolver<MatrixXd> solver(landmark_kernel);
+		VectorXd eigenvalues = solver.eigenvalues();
+		const float64_t tolerance = m *
+		                            std::numeric_limits<float64_t>::epsilon() *
+		                            eigenvalues.cwiseAbs().maxCoeff();
+		for (index_t i = 0; i < m; ++i)
+		{
+			eigenvalues[i] = eigenvalues[i] > tolerance
+			                     ? 1.0 / std::sqrt(eigenvalues[i])
+			                     : 0.0;
+		}
+		basis_map = solver.eigenvectors() * eigenvalues.asDiagonal() *
+		            solver.eigenvectors().transpose();
+	}
+	else
+	{
+		auto gaussian = std::dynamic_pointer_cast<GaussianKernel>(m_kernel);
+		require(
+		    gaussian, "Random Fourier features only approximate GaussianKernel, "
+		              "got {}",
+		    m_kernel->get_name());
+
+		m_init_features = nullptr;
+		auto generator = std::make_shared<RandomFourierDotFeatures>(
+		    features->as<DotFeatures>(), m, GAUSSIAN,
+		    SGVector<float64_t>({gaussian->get_width()}),
+		    SGMatrix<float64_t>());
+		random::seed(generator, m_prng);
+		m_random_coefficients = generator->generate_random_coefficients();
+		random_features = random_fourier_features(features);
+	}
+
+	// mean and second moment of the responses, accumulated per block so
+	// that only m x m matrices are held in memory
+	MatrixXd second_moment = MatrixXd::Zero(m, m);
+	VectorXd mean = VectorXd::Zero(m);
+	const index_t block_size = 256;
+	index_t num_blocks = (n + block_size - 1) / block_size;
+#pragma omp parallel
+	{
+		MatrixXd local_moment = MatrixXd::Zero(m, m);
+		VectorXd local_sum = VectorXd::Zero(m);
+		MatrixXd responses(m, block_size);
+
+#pragma omp for schedule(dynamic)
+		for (index_t block = 0; block < num_blocks; ++block)
+		{
+			index_t begin = block * block_size;
+			index_t end = std::min(begin + block_size, (index_t)n);
+			compute_responses(
+			    random_features, m, begin, end, responses.data());
+
+			auto columns = responses.leftCols(end - begin);
+			local_moment.noalias() += columns * columns.transpose();
+			local_sum += columns.rowwise().sum();
+		}
+
+#pragma omp critical
+		{
+			second_moment += local_moment;
+			mean += local_sum;
+		}
+	}
+	mean /= n;
+
+	if (m_method == KPCA_NYSTROM)
+		m_kernel->cleanup();
+
+	// covariance of the feature map, its eigenvalues are in increasing order
+	MatrixXd covariance = basis_map *
+	                      (second_moment / n - mean * mean.transpose()) *
+	                      basis_map;
+	SelfAdjointEigenSolver<MatrixXd> solver(covariance);
+
+	m_transformation_matrix = SGMatrix<float64_t>(m, m_target_dim);
+	Map<MatrixXd> transformation(
+	    m_transformation_matrix.matrix, m, m_target_dim);
+	transformation =
+	    basis_map * solver.eigenvectors().rightCols(m_target_dim).rowwise().reverse();
+
+	m_bias_vector = SGVector<float64_t>(m_target_dim);
+	Map<VectorXd>(m_bias_vector.vector, m_target_dim) =
+	    -transformation.transpose() * mean;
+}
+
+std::shared_ptr<RandomFourierDotFeatures> KernelPCA::random_fourier_features(
+    const std::shared_ptr<Features>& features) const
+{
+	auto gaussian = m_kernel->as<GaussianKernel>();
+	return std::make_shared<RandomFourierDotFeatures>(
+	    features->as<DotFeatures>(), m_random_coefficients.num_cols, GAUSSIAN,
+	    SGVector<float64_t>({gaussian->get_width()}), m_random_coefficients);
+}
+
+void KernelPCA::compute_responses(
+    const std::shared_ptr<RandomFourierDotFeatures>& random_features, int32_t m,
+    index_t begin, index_t end, float64_t* responses) const
+{
+	if (random_features)
+	{
+		auto block = random_features->compute_random_features(begin, end);
+		std::copy_n(block.matrix, m * (end - begin), responses);
+		return;
+	}
+
+	for (index_t i = begin; i < end; ++i)
+	{
+		float64_t* response = responses + (i - begin) * m;
+		for (index_t j = 0; j < m; ++j)
+			response[j] = m_kernel->kernel(i, j);
+	}
+}
+
+SGMatrix<float64_t>
+KernelPCA::apply_approximation(const std::shared_ptr<Features>& features)
+{
+	std::shared_ptr<RandomFourierDotFeatures> random_features;
+	if (m_method == KPCA_NYSTROM)
+		m_kernel->init(features, m_init_features);
+	else
+		random_features = random_fourier_features(features);
+
+	int32_t n = features->get_num_vectors();
+	int32_t m = m_transformation_matrix.num_rows;
+	SGMatrix<float64_t> result(m_target_dim, n);
+	Map<MatrixXd> transformation(
+	    m_transformation_matrix.matrix, m, m_target_dim);
+	Map<VectorXd> bias(m_bias_vector.vector, m_target_dim);
+
+	const index_t block_size = 256;
+	index_t num_blocks = (n + block_size - 1) / block_size;
+#pragma omp parallel
+	{
+		MatrixXd responses(m, block_size);
+
+#pragma omp for schedule(dynamic)
+		for (index_t block = 0; block < num_blocks; ++block)
+		{
+			index_t begin = block * block_size;
+			index_t end = std::min(begin + block_size, (index_t)n);
+			compute_responses(
+			    random_features, m, begin, end, responses.data());
+
+			Map<MatrixXd> embedding(
+			    result.get_column_vector(begin), m_target_dim, end - begin);
+			embedding.noalias() =
+			    transformation.transpose() * responses.leftCols(end - begin);
+			embedding.colwise() += bias;
+		}
+	}
+
+	if (m_method == KPCA_NYSTROM)
+		m_kernel->cleanup();
+
+	return result;
+}
+
 std::shared_ptr<Features> KernelPCA::transform(std::shared_ptr<Features> features, bool inplace)
 {
 	assert_fitted();
 
+	if (m_method != KPCA_EXACT)
+	{
+		return std::make_shared<DenseFeatures<float64_t>>(
+		    apply_approximation(features));
+	}
+
 	if (std::dynamic_pointer_cast<DenseFeatures<float64_t>>(features))
 	{
 		auto feature_matrix = apply_to_feature_matrix(features);
@@ -145,6 +378,9 @@ std::shared_ptr<Features> KernelPCA::transform(std::shared_ptr<Features> feature
 SGMatrix<float64_t> KernelPCA::apply_to_feature_matrix(std::shared_ptr<Features> features)
 {
 	assert_fitted();
+	if (m_method != KPCA_EXACT)
+		return apply_approximation(features);
+
 	int32_t n = m_init_features->get_num_vectors();
 
 	m_kernel->init(std::move(features), m_init_features);
@@ -179,6 +415,11 @@ SGVector<float64_t> KernelPCA::apply_to_feature_vector(SGVector<float64_t> vecto
 std::shared_ptr<DenseFeatures<float64_t>> KernelPCA::apply_to_string_features(std::shared_ptr<Features> features)
 {
 	assert_fitted();
+	if (m_method != KPCA_EXACT)
+	{
+		return std::make_shared<DenseFeatures<float64_t>>(
+		    apply_approximation(features));
+	}
 
 	int32_t num_vectors = features->get_num_vectors();
 	int32_t i,j,k;
@@ -240,3 +481,26 @@ std::shared_ptr<Kernel> KernelPCA::get_kernel() const
 
 	return m_kernel;
 }
+
+void KernelPCA::set_method(EKernelPCAMethod method)
+{
+	m_method = method;
+}
+
+EKernelPCAMethod KernelPCA::get_method() const
+{
+	return m_method;
+}
+
+void KernelPCA::set_num_basis(int32_t num_basis)
+{
+	require(
+	    num_basis > 0, "Number of basis functions ({}) must be positive",
+	    num_basis);
+	m_num_basis = num_basis;
+}
+
+int32_t KernelPCA::get_num_basis() const
+{
+	return m_num_basis;
+}
@@ -12,6 +12,7 @@
 #include <shogun/features/Features.h>
 #include <shogun/kernel/Kernel.h>
 #include <shogun/lib/common.h>
+#include <shogun/mathematics/RandomMixin.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 
 namespace shogun
@@ -19,6 +20,20 @@ namespace shogun
 
 class Features;
 class Kernel;
+class RandomFourierDotFeatures;
+
+/** method used by KernelPCA to compute the principal components */
+enum EKernelPCAMethod
+{
+	/** eigendecomposition of the full centered kernel matrix */
+	KPCA_EXACT = 10,
+	/** PCA of the Nystroem feature map of uniformly sampled landmarks */
+	KPCA_NYSTROM = 20,
+	/** PCA of random Fourier features, only for GaussianKernel and
+	 * DotFeatures
+	 */
+	KPCA_RANDOM_FOURIER = 30
+};
 
 /** @brief Preprocessor KernelPCA performs kernel principal component analysis
  *
@@ -27,8 +42,21 @@ class Kernel;
  * Advances in kernel methods support vector learning, 1327(3), 327-352. MIT Press.
  * Retrieved from http://citeseerx.ist.psu.edu/viewdoc/summary?doi=10.1.1.32.8744
  *
+ * The exact method needs the full \f$n \times n\f$ kernel matrix and
+ * evaluates the kernel against all training vectors for every new vector.
+ * For large data, the kernel can be approximated by an explicit feature map
+ * of dimension \f$m\f$ (set_num_basis), on which linear PCA is done in
+ * \f$O(nm^2)\f$ time and \f$O(m^2)\f$ memory. Projecting a vector then
+ * costs \f$m\f$ kernel evaluations or random features:
+ *
+ * <em>KPCA_NYSTROM</em> : \f$\psi(x) = K_{mm}^{-1/2} k_m(x)\f$ for
+ * \f$m\f$ landmarks sampled uniformly from the training vectors, as in
+ * KRRNystrom. With all vectors as landmarks this equals the exact method.
+ *
+ * <em>KPCA_RANDOM_FOURIER</em> : \f$\psi(x)\f$ are the random Fourier
+ * features of RandomFourierDotFeatures for the width of the GaussianKernel.
  */
-class KernelPCA : public Preprocessor
+class KernelPCA : public RandomMixin<Preprocessor>
 {
 public:
 		/** default constructor
@@ -111,11 +139,53 @@ public:
 		 */
 		std::shared_ptr<Kernel> get_kernel() const;
 
+		/** setter for method
+		 * @param method exact or approximate method
+		 */
+		void set_method(EKernelPCAMethod method);
+
+		/** getter for method
+		 * @return method
+		 */
+		EKernelPCAMethod get_method() const;
+
+		/** setter for the number of landmarks or random features of the
+		 * approximate methods
+		 * @param num_basis dimension of the approximate feature map
+		 */
+		void set_num_basis(int32_t num_basis);
+
+		/** getter for the number of landmarks or random features
+		 * @return dimension of the approximate feature map
+		 */
+		int32_t get_num_basis() const;
+
 	protected:
 
 		/** default init */
 		void init();
 
+		/** fit on the approximate feature map */
+		void fit_approximation(const std::shared_ptr<Features>& features);
+
+		/** apply preproc using the approximate feature map */
+		SGMatrix<float64_t> apply_approximation(const std::shared_ptr<Features>& features);
+
+		/** random Fourier features of given features with the fitted
+		 * coefficients
+		 */
+		std::shared_ptr<RandomFourierDotFeatures> random_fourier_features(const std::shared_ptr<Features>& features) const;
+
+		/** writes the approximate feature map, before the linear transform,
+		 * of vectors begin to end-1 into consecutive columns of length
+		 * num_basis of responses. Expects the kernel to be initialized with
+		 * the landmarks in KPCA_NYSTROM mode.
+		 */
+		void compute_responses(
+		    const std::shared_ptr<RandomFourierDotFeatures>& random_features,
+		    int32_t num_basis, index_t begin, index_t end,
+		    float64_t* responses) const;
+
 	protected:
 
 		/** features used by init. needed for apply */
@@ -132,6 +202,15 @@ public:
 
 		/** kernel to be used */
 		std::shared_ptr<Kernel> m_kernel;
+
+		/** method */
+		EKernelPCAMethod m_method;
+
+		/** number of landmarks or random features */
+		int32_t m_num_basis;
+
+		/** coefficients of the random Fourier features */
+		SGMatrix<float64_t> m_random_coefficients;
 };
 }
 #endif
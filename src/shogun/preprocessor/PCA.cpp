@@ -6,9 +6,13 @@
  */
 #include <shogun/lib/config.h>
 
+#include <shogun/features/DenseFeatures.h>
 #include <shogun/features/Features.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 #include <shogun/preprocessor/PCA.h>
@@ -16,10 +20,43 @@
 using namespace shogun;
 using namespace Eigen;
 
+/** Divides the eigenvectors by the corresponding singular values of the
+ * centered data, sqrt(eigenvalue*(N-1)). Eigenvectors with an eigenvalue
+ * within the zero tolerance are set to zero.
+ */
+static void whiten(
+    Map<MatrixXd>& transform, const float64_t* eigenvalues, int32_t first_dim,
+    int32_t num_vectors, float64_t zero_tolerance)
+{
+	for (int32_t i = 0; i < transform.cols(); i++)
+	{
+		if (Math::fequals_abs<float64_t>(0.0, eigenvalues[i], zero_tolerance))
+		{
+			io::warn(
+			    "Covariance matrix has almost zero Eigenvalue (ie "
+			    "Eigenvalue within a tolerance of {:E} around 0) at "
+			    "dimension {}. Consider reducing its dimension.",
+			    zero_tolerance, i + first_dim + 1);
+
+			transform.col(i).setZero();
+			continue;
+		}
+
+		transform.col(i) /= std::sqrt(eigenvalues[i] * (num_vectors - 1));
+	}
+}
+
+/** @return orthonormal basis of the columns of a matrix with full column rank */
+static MatrixXd orthonormal_basis(const MatrixXd& matrix)
+{
+	HouseholderQR<MatrixXd> qr(matrix);
+	return qr.householderQ() * MatrixXd::Identity(matrix.rows(), matrix.cols());
+}
+
 PCA::PCA(
     bool do_whitening, EPCAMode mode, float64_t thresh, EPCAMethod method,
     EPCAMemoryMode mem_mode)
-    : DensePreprocessor<float64_t>()
+    : RandomMixin<DensePreprocessor<float64_t>>()
 {
 	init();
 	m_whitening = do_whitening;
@@ -30,7 +67,7 @@ PCA::PCA(
 }
 
 PCA::PCA(EPCAMethod method, bool do_whitening, EPCAMemoryMode mem_mode)
-    : DensePreprocessor<float64_t>()
+    : RandomMixin<DensePreprocessor<float64_t>>()
 {
 	init();
 	m_whitening = do_whitening;
@@ -51,6 +88,9 @@ void PCA::init()
 	m_method = AUTO;
 	m_eigenvalue_zero_tolerance = 1e-15;
 	m_target_dim = 1;
+	m_oversampling = 10;
+	m_power_iterations = 2;
+	m_chunk_size = 1000;
 
 	SG_ADD(
 	    &m_transformation_matrix, "transformation_matrix",
@@ -72,6 +112,15 @@ void PCA::init()
 	SG_ADD(
 	    &m_target_dim, "target_dim", "target dimensionality of preprocessor",
 	    ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_oversampling, "oversampling",
+	    "Extra random vectors sampled by randomized PCA.",
+	    ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_power_iterations, "power_iterations",
+	    "Power iterations of randomized PCA.", ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_chunk_size, "chunk_size", "Vectors per chunk of incremental PCA.");
 	SG_ADD_OPTIONS(
 	    (machine_int_t*)&m_mode, "mode", "PCA Mode.",
 	    ParameterProperties::HYPER,
@@ -83,7 +132,7 @@ void PCA::init()
 	SG_ADD_OPTIONS(
 	    (machine_int_t*)&m_method, "method",
 	    "Method used for PCA calculation", ParameterProperties::NONE,
-	    SG_OPTIONS(AUTO, SVD, EVD));
+	    SG_OPTIONS(AUTO, SVD, EVD, RANDOMIZED, INCREMENTAL));
 }
 
 PCA::~PCA()
@@ -95,6 +144,18 @@ void PCA::fit(std::shared_ptr<Features> features)
 	if (m_fitted)
 		cleanup();
 
+	require(
+	    (m_method != RANDOMIZED && m_method != INCREMENTAL) ||
+	        m_mode == FIXED_NUMBER,
+	    "Randomized and incremental PCA only support FIXED_NUMBER mode");
+
+	if (m_method == INCREMENTAL)
+	{
+		init_with_incremental(features);
+		m_fitted = true;
+		return;
+	}
+
 	auto feature_matrix =
 	    features->as<DenseFeatures<float64_t>>()->get_feature_matrix();
 	auto num_vectors = feature_matrix.num_cols;
@@ -124,6 +185,8 @@ void PCA::fit(std::shared_ptr<Features> features)
 
 	if (m_method == EVD)
 		init_with_evd(feature_matrix, max_dim_allowed);
+	else if (m_method == RANDOMIZED)
+		init_with_randomized(feature_matrix, max_dim_allowed);
 	else
 		init_with_svd(feature_matrix, max_dim_allowed);
 
@@ -194,25 +257,10 @@ void PCA::init_with_evd(const SGMatrix<float64_t>& feature_matrix, int32_t max_d
 				num_features-num_dim, num_features,num_dim);
 	if (m_whitening)
 	{
-		for (int32_t i=0; i<num_dim; i++)
-		{
-			if (Math::fequals_abs<float64_t>(0.0, eigenValues[i+max_dim_allowed-num_dim],
-									m_eigenvalue_zero_tolerance))
-			{
-				io::warn(
-				    "Covariance matrix has almost zero Eigenvalue (ie "
-				    "Eigenvalue within a tolerance of {:E} around 0) at "
-				    "dimension {}. Consider reducing its dimension.",
-				    m_eigenvalue_zero_tolerance,
-				    i + max_dim_allowed - num_dim + 1);
-
-				transformMatrix.col(i) = MatrixXd::Zero(num_features,1);
-				continue;
-			}
-
-			transformMatrix.col(i) /= std::sqrt(
-			    eigenValues[i + max_dim_allowed - num_dim] * (num_vectors - 1));
-		}
+		whiten(
+		    transformMatrix, eigenValues.data() + max_dim_allowed - num_dim,
+		    max_dim_allowed - num_dim, num_vectors,
+		    m_eigenvalue_zero_tolerance);
 	}
 }
 
@@ -269,23 +317,168 @@ void PCA::init_with_svd(const SGMatrix<float64_t> &feature_matrix, int32_t max_d
 
 	if (m_whitening)
 	{
-		for (int32_t i = 0; i < num_dim; i++)
-		{
-			if (Math::fequals_abs<float64_t>(0.0, eigenValues[i], m_eigenvalue_zero_tolerance))
-			{
+		whiten(
+		    transformMatrix, eigenValues.data(), 0, num_vectors,
+		    m_eigenvalue_zero_tolerance);
+	}
+}
 
-				io::warn("Covariance matrix has almost zero Eigenvalue (ie "
-					"Eigenvalue within a tolerance of {:E} around 0) at "
-					"dimension {}. Consider reducing its dimension.",
-					m_eigenvalue_zero_tolerance, i + 1);
+void PCA::init_with_randomized(
+    const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed)
+{
+	int32_t num_vectors = feature_matrix.num_cols;
+	int32_t num_features = feature_matrix.num_rows;
 
-				transformMatrix.col(i) = MatrixXd::Zero(num_features, 1);
-				continue;
-			}
+	Map<MatrixXd> fmatrix(feature_matrix.matrix, num_features, num_vectors);
+
+	num_dim = m_target_dim;
+	auto num_samples = std::min(m_target_dim + m_oversampling, max_dim_allowed);
+	io::info("Sampling the range of the data with {} vectors", num_samples);
+
+	SGMatrix<float64_t> test_matrix(num_vectors, num_samples);
+	random::fill_array(test_matrix, NormalDistribution<float64_t>(), m_prng);
+	Map<MatrixXd> omega(test_matrix.matrix, num_vectors, num_samples);
+
+	// the basis is orthonormalized after every product, otherwise the
+	// power iterations would wash out all but the leading direction
+	MatrixXd basis = orthonormal_basis(fmatrix * omega);
+	for (int32_t i = 0; i < m_power_iterations; i++)
+	{
+		MatrixXd row_basis = orthonormal_basis(fmatrix.transpose() * basis);
+		basis = orthonormal_basis(fmatrix * row_basis);
+	}
+
+	// SVD of the data projected onto the sampled range
+	MatrixXd projected = basis.transpose() * fmatrix;
+	JacobiSVD<MatrixXd> svd(projected, ComputeThinU);
+
+	m_eigenvalues_vector = SGVector<float64_t>(num_dim);
+	Map<VectorXd> eigenValues(m_eigenvalues_vector.vector, num_dim);
+	eigenValues = svd.singularValues().head(num_dim);
+	eigenValues = eigenValues.cwiseProduct(eigenValues) / (num_vectors - 1);
+	io::info("Reducing from {} to {} features", num_features, num_dim);
+
+	m_transformation_matrix = SGMatrix<float64_t>(num_features, num_dim);
+	Map<MatrixXd> transformMatrix(
+	    m_transformation_matrix.matrix, num_features, num_dim);
+	num_old_dim = num_features;
+	transformMatrix = basis * svd.matrixU().leftCols(num_dim);
+
+	if (m_whitening)
+	{
+		whiten(
+		    transformMatrix, eigenValues.data(), 0, num_vectors,
+		    m_eigenvalue_zero_tolerance);
+	}
+}
 
-			transformMatrix.col(i) /=
-			    std::sqrt(eigenValues[i] * (num_vectors - 1));
+void PCA::init_with_incremental(const std::shared_ptr<Features>& features)
+{
+	require(m_chunk_size > 0, "Chunk size ({}) must be positive", m_chunk_size);
+
+	std::shared_ptr<StreamingDenseFeatures<float64_t>> stream;
+	SGMatrix<float64_t> feature_matrix;
+	if (features->get_feature_class() == C_STREAMING_DENSE)
+	{
+		stream = features->as<StreamingDenseFeatures<float64_t>>();
+		stream->start_parser();
+	}
+	else
+	{
+		feature_matrix =
+		    features->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+	}
+
+	int64_t num_seen = 0;
+	VectorXd mean;
+	MatrixXd basis;
+	VectorXd singular_values;
+	for (index_t begin = 0;; begin += m_chunk_size)
+	{
+		SGMatrix<float64_t> chunk;
+		if (stream)
+		{
+			chunk = stream->get_streamed_features(m_chunk_size)
+			            ->as<DenseFeatures<float64_t>>()
+			            ->get_feature_matrix();
+		}
+		else if (begin < feature_matrix.num_cols)
+		{
+			chunk = SGMatrix<float64_t>(
+			    feature_matrix.get_column_vector(begin),
+			    feature_matrix.num_rows,
+			    std::min(m_chunk_size, feature_matrix.num_cols - begin), false);
+		}
+		if (chunk.num_cols == 0)
+			break;
+
+		Map<MatrixXd> chunk_matrix(chunk.matrix, chunk.num_rows, chunk.num_cols);
+		int64_t num_chunk = chunk.num_cols;
+		int64_t num_total = num_seen + num_chunk;
+		VectorXd chunk_mean = chunk_matrix.rowwise().mean();
+		require(
+		    num_seen == 0 || chunk_mean.size() == mean.size(),
+		    "Chunk dimension ({}) differs from data dimension ({})",
+		    chunk_mean.size(), mean.size());
+
+		// the current components, the centered chunk and a correction
+		// for the shift of the mean span the updated data
+		index_t num_components = basis.cols();
+		MatrixXd stacked(
+		    chunk.num_rows, num_components + num_chunk + (num_seen > 0));
+		stacked.leftCols(num_components) =
+		    basis * singular_values.asDiagonal();
+		stacked.middleCols(num_components, num_chunk) =
+		    chunk_matrix.colwise() - chunk_mean;
+		if (num_seen > 0)
+		{
+			stacked.rightCols(1) =
+			    std::sqrt(float64_t(num_seen) * num_chunk / num_total) *
+			    (mean - chunk_mean);
+			mean = (num_seen * mean + num_chunk * chunk_mean) / num_total;
 		}
+		else
+			mean = chunk_mean;
+
+		JacobiSVD<MatrixXd> svd(stacked, ComputeThinU);
+		auto rank = std::min<index_t>(m_target_dim, svd.singularValues().size());
+		basis = svd.matrixU().leftCols(rank);
+		singular_values = svd.singularValues().head(rank);
+		num_seen = num_total;
+		SG_DEBUG("Updated components with {} vectors", num_seen);
+	}
+
+	if (stream)
+		stream->end_parser();
+
+	require(
+	    num_seen > 1 && basis.cols() == m_target_dim,
+	    "target dimension should be less or equal to than minimum of N and D");
+
+	int32_t num_features = mean.size();
+	num_dim = m_target_dim;
+	num_old_dim = num_features;
+	io::info(
+	    "num_examples: {} num_features: {}", num_seen, num_features);
+	io::info("Reducing from {} to {} features", num_features, num_dim);
+
+	m_mean_vector = SGVector<float64_t>(num_features);
+	Map<VectorXd>(m_mean_vector.vector, num_features) = mean;
+
+	m_eigenvalues_vector = SGVector<float64_t>(num_dim);
+	Map<VectorXd> eigenValues(m_eigenvalues_vector.vector, num_dim);
+	eigenValues = singular_values.cwiseProduct(singular_values) / (num_seen - 1);
+
+	m_transformation_matrix = SGMatrix<float64_t>(num_features, num_dim);
+	Map<MatrixXd> transformMatrix(
+	    m_transformation_matrix.matrix, num_features, num_dim);
+	transformMatrix = basis;
+
+	if (m_whitening)
+	{
+		whiten(
+		    transformMatrix, eigenValues.data(), 0, num_seen,
+		    m_eigenvalue_zero_tolerance);
 	}
 }
 
@@ -409,3 +602,39 @@ int32_t PCA::get_target_dim() const
 {
 	return m_target_dim;
 }
+
+void PCA::set_oversampling(int32_t oversampling)
+{
+	require(oversampling >= 0, "Oversampling ({}) must be non-negative", oversampling);
+	m_oversampling = oversampling;
+}
+
+int32_t PCA::get_oversampling() const
+{
+	return m_oversampling;
+}
+
+void PCA::set_power_iterations(int32_t power_iterations)
+{
+	require(
+	    power_iterations >= 0,
+	    "Number of power iterations ({}) must be non-negative",
+	    power_iterations);
+	m_power_iterations = power_iterations;
+}
+
+int32_t PCA::get_power_iterations() const
+{
+	return m_power_iterations;
+}
+
+void PCA::set_chunk_size(int32_t chunk_size)
+{
+	require(chunk_size > 0, "Chunk size ({}) must be positive", chunk_size);
+	m_chunk_size = chunk_size;
+}
+
+int32_t PCA::get_chunk_size() const
+{
+	return m_chunk_size;
+}
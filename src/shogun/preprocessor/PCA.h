@@ -13,6 +13,7 @@
 
 #include <shogun/features/Features.h>
 #include <shogun/lib/common.h>
+#include <shogun/mathematics/RandomMixin.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 
 namespace shogun
@@ -29,7 +30,17 @@ enum EPCAMethod
 	/** Eigenvalue decomposition of covariance matrix.
 	 * Time complexity ~10d^3 (d-dimensions n-number of vectors)
 	 */
-	EVD = 30
+	EVD = 30,
+	/** Randomized range finder on the data matrix, refined with power
+	 * iterations. Time complexity ~dnk per pass (k-target dimension plus
+	 * oversampling). Only in FIXED_NUMBER mode.
+	 */
+	RANDOMIZED = 40,
+	/** Incremental SVD over chunks of vectors, which also accepts
+	 * StreamingDenseFeatures. Memory ~d(k+c) (c-chunk size).
+	 * Only in FIXED_NUMBER mode.
+	 */
+	INCREMENTAL = 50
 };
 
 /** mode of pca */
@@ -86,6 +97,21 @@ enum EPCAMemoryMode
  * <em>AUTO</em> : This mode automagically chooses one of the above modes for the user
  * based on whether N > D (chooses EVD) or N < D (chooses SVD).
  *
+ * For large data, two more methods compute only the T leading components :
+ *
+ * <em>RANDOMIZED</em> : The range of X is sampled with a Gaussian test matrix
+ * of T+oversampling columns, sharpened by a few power iterations with
+ * re-orthonormalization, and the small projected matrix is decomposed with SVD
+ * (Halko, Martinsson, Tropp, 2011).
+ *
+ * <em>INCREMENTAL</em> : The vectors are consumed in chunks and the rank T
+ * SVD is updated with every chunk together with the mean (Ross et al., 2008).
+ * The feature matrix is never centered in place and StreamingDenseFeatures
+ * are read once, so the whole data never has to be in memory.
+ *
+ * Both only support the FIXED_NUMBER mode and store the T leading eigenvalues
+ * in descending order.
+ *
  * This class provides 3 modes to determine the value of T :
  *
  * <em>FIXED_NUMBER</em> : T is supplied by user directly using set_target_dims method
@@ -104,7 +130,7 @@ enum EPCAMemoryMode
  *
  * Note that vectors/matrices don't have to have zero mean as it is substracted within the class.
  */
-class PCA : public DensePreprocessor<float64_t>
+class PCA : public RandomMixin<DensePreprocessor<float64_t>>
 {
 	public:
 
@@ -188,6 +214,37 @@ class PCA : public DensePreprocessor<float64_t>
 		 */
 		int32_t get_target_dim() const;
 
+		/** setter for the number of extra columns sampled by the
+		 * RANDOMIZED method
+		 * @param oversampling oversampling
+		 */
+		void set_oversampling(int32_t oversampling);
+
+		/** getter for the oversampling of the RANDOMIZED method
+		 * @return oversampling
+		 */
+		int32_t get_oversampling() const;
+
+		/** setter for the number of power iterations of the RANDOMIZED method
+		 * @param power_iterations number of power iterations
+		 */
+		void set_power_iterations(int32_t power_iterations);
+
+		/** getter for the number of power iterations of the RANDOMIZED method
+		 * @return number of power iterations
+		 */
+		int32_t get_power_iterations() const;
+
+		/** setter for the number of vectors per chunk of the INCREMENTAL method
+		 * @param chunk_size chunk size
+		 */
+		void set_chunk_size(int32_t chunk_size);
+
+		/** getter for the number of vectors per chunk of the INCREMENTAL method
+		 * @return chunk size
+		 */
+		int32_t get_chunk_size() const;
+
 	protected:
 
 		void init();
@@ -225,11 +282,26 @@ class PCA : public DensePreprocessor<float64_t>
 		/** target dimension */
 		int32_t m_target_dim;
 
+		/** extra columns of the random test matrix */
+		int32_t m_oversampling;
+
+		/** number of power iterations */
+		int32_t m_power_iterations;
+
+		/** vectors per chunk of incremental PCA */
+		int32_t m_chunk_size;
+
 	private:
 		/** Computes the transformation matrix using an eigenvalue decomposition. */
 		void init_with_evd(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
 		/** Computes the transformation matrix using svd */
 		void init_with_svd(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
+
+		/** Computes the transformation matrix using a randomized range finder */
+		void init_with_randomized(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
+
+		/** Computes the mean and the transformation matrix chunk by chunk */
+		void init_with_incremental(const std::shared_ptr<Features>& features);
 };
 }
 #endif // PCA_H_
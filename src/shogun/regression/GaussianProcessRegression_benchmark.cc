@@ -0,0 +1,35 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/machine/gp/ExactInferenceMethod.h>
+#include <shogun/machine/gp/GaussianLikelihood.h>
+#include <shogun/machine/gp/ZeroMean.h>
+#include <shogun/regression/GaussianProcessRegression.h>
+#include <shogun/util/Learner_benchmark.h>
+
+namespace shogun
+{
+
+BENCHMARK_DEFINE_F(LearnerFixture, GaussianProcessRegression_train_apply)
+(benchmark::State& st)
+{
+	for (auto _ : st)
+	{
+		auto kernel = std::make_shared<GaussianKernel>(10, 2.0);
+		auto mean = std::make_shared<ZeroMean>();
+		auto lik = std::make_shared<GaussianLikelihood>();
+		auto inf = std::make_shared<ExactInferenceMethod>(
+		    kernel, features, mean, regression_labels, lik);
+		auto gpr = std::make_shared<GaussianProcessRegression>(inf);
+		gpr->train();
+		benchmark::DoNotOptimize(gpr->apply_regression(features));
+	}
+	report(st);
+}
+
+// exact inference is cubic in the number of vectors
+LEARNER_BENCHMARK(GaussianProcessRegression_train_apply, 2048);
+
+}
@@ -11,6 +11,7 @@
 #include <vector>
 #include <limits>
 #include <algorithm>
+#include <numeric>
 
 #include <shogun/base/progress.h>
 #include <shogun/features/DenseFeatures.h>
@@ -44,10 +45,33 @@ void LeastAngleRegression::init()
 	m_max_nonz = 0;
 	m_max_l1_norm = 0;
 	m_epsilon = Math::MACHINE_EPSILON;
+	m_solver = LARS_SOLVER_HOMOTOPY;
+	m_precompute_gram = false;
+	m_num_lambdas = 100;
+	m_lambda_min_ratio = 1e-3;
+	m_cd_tolerance = 1e-10;
+	m_cd_max_iterations = 1000;
 	SG_ADD(&m_epsilon, "epsilon", "Epsilon for early stopping", ParameterProperties::HYPER);
 	SG_ADD(&m_max_nonz, "max_nonz", "Max number of non-zero variables", ParameterProperties::HYPER);
 	SG_ADD(&m_max_l1_norm, "max_l1_norm", "Max l1-norm of estimator", ParameterProperties::HYPER);
 	SG_ADD(&m_lasso, "lasso", "Max l1-norm of estimator", ParameterProperties::HYPER);
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_solver, "solver", "Solver of the path",
+	    ParameterProperties::SETTING,
+	    SG_OPTIONS(LARS_SOLVER_HOMOTOPY, LARS_SOLVER_COORDINATE_DESCENT));
+	SG_ADD(&m_precompute_gram, "precompute_gram",
+	    "Whether to work on the precomputed Gram matrix", ParameterProperties::SETTING);
+	SG_ADD(&m_num_lambdas, "num_lambdas",
+	    "Number of regularization constants of the coordinate descent path",
+	    ParameterProperties::HYPER);
+	SG_ADD(&m_lambda_min_ratio, "lambda_min_ratio",
+	    "Smallest over largest regularization constant of the path",
+	    ParameterProperties::HYPER);
+	SG_ADD(&m_cd_tolerance, "cd_tolerance",
+	    "Tolerance of coordinate descent", ParameterProperties::HYPER);
+	SG_ADD(&m_cd_max_iterations, "cd_max_iterations",
+	    "Max number of coordinate descent sweeps per regularization constant",
+	    ParameterProperties::HYPER);
 	watch_method("path_size", &LeastAngleRegression::get_path_size);
 }
 
@@ -75,6 +99,55 @@ void LeastAngleRegression::find_max_abs(const std::vector<ST> &vec, const std::v
 	}
 }
 
+/** computes G = X*X' and Xy = X*y for X with one vector per column, splitting
+ * the vectors over threads
+ */
+template <typename ST>
+static void compute_gram(
+    const SGMatrix<ST>& X, const SGVector<ST>& y, SGMatrix<ST>& G,
+    SGVector<ST>& Xy)
+{
+	const index_t block_size = 4096;
+	index_t n_fea = X.num_rows;
+	index_t n_vec = X.num_cols;
+	index_t num_blocks = (n_vec + block_size - 1) / block_size;
+
+	typename SGMatrix<ST>::EigenMatrixXtMap map_X(X.matrix, n_fea, n_vec);
+	typename SGVector<ST>::EigenVectorXtMap map_y(y.vector, n_vec);
+	typename SGMatrix<ST>::EigenMatrixXtMap map_G(G.matrix, n_fea, n_fea);
+	typename SGVector<ST>::EigenVectorXtMap map_Xy(Xy.vector, n_fea);
+	map_G.setZero();
+	map_Xy.setZero();
+
+	#pragma omp parallel if (num_blocks > 1)
+	{
+		typename SGMatrix<ST>::EigenMatrixXt local_G =
+		    SGMatrix<ST>::EigenMatrixXt::Zero(n_fea, n_fea);
+		typename SGVector<ST>::EigenVectorXt local_Xy =
+		    SGVector<ST>::EigenVectorXt::Zero(n_fea);
+
+		#pragma omp for schedule(static)
+		for (index_t block = 0; block < num_blocks; ++block)
+		{
+			index_t begin = block * block_size;
+			index_t size = std::min(block_size, n_vec - begin);
+			local_G.template selfadjointView<Lower>().rankUpdate(
+			    map_X.middleCols(begin, size));
+			local_Xy.noalias() +=
+			    map_X.middleCols(begin, size) * map_y.segment(begin, size);
+		}
+
+		#pragma omp critical
+		{
+			map_G += local_G;
+			map_Xy += local_Xy;
+		}
+	}
+
+	// only the lower triangle was accumulated
+	map_G.template triangularView<StrictlyUpper>() = map_G.transpose();
+}
+
 template <typename ST>
 void LeastAngleRegression::plane_rot(ST x0, ST x1,
 	ST &y0, ST &y1, SGMatrix<ST> &G)
@@ -109,13 +182,13 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 	std::vector<SGVector<ST>> m_beta_path_t;
 
 	int32_t n_fea = data->get_num_features();
-	int32_t n_vec = data->get_num_vectors();
 
-	bool lasso_cond = false;
-	bool stop_cond = false;
+	require(m_lasso || m_solver != LARS_SOLVER_COORDINATE_DESCENT,
+		"Coordinate descent only computes the lasso path.");
 
 	// init facilities
 	m_beta_idx.clear();
+	m_beta_path.clear();
 	m_beta_path_t.clear();
 	m_num_active = 0;
 	m_active_set.clear();
@@ -123,48 +196,111 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 	fill(m_is_active.begin(), m_is_active.end(), false);
 
 	SGVector<ST> y = regression_labels(m_labels)->template get_labels_t<ST>();
-	typename SGVector<ST>::EigenVectorXtMap map_y(y.vector, y.size());
+	SGMatrix<ST> X = data->get_feature_matrix();
+
+	SGVector<ST> Xy(n_fea);
+	SGMatrix<ST> G;
+	if (m_precompute_gram || m_solver == LARS_SOLVER_COORDINATE_DESCENT)
+	{
+		G = SGMatrix<ST>(n_fea, n_fea);
+		compute_gram(X, y, G, Xy);
+	}
+	else
+	{
+		// Xy = X' * y
+		typename SGMatrix<ST>::EigenMatrixXtMap map_X(X.matrix, X.num_rows, X.num_cols);
+		typename SGVector<ST>::EigenVectorXtMap map_y(y.vector, y.size());
+		typename SGVector<ST>::EigenVectorXtMap map_Xy(Xy.vector, n_fea);
+		map_Xy = map_X*map_y;
+	}
+
+	if (m_solver == LARS_SOLVER_COORDINATE_DESCENT)
+		coordinate_descent_path(G, Xy, m_beta_path_t);
+	else
+		homotopy_path(X, G, Xy, m_beta_path_t);
+
+	//copy m_beta_path_t (of type ST) into m_beta_path
+	// do also a cast to float64_t
+	for (index_t i = 0; i < m_beta_path_t.size(); ++i)
+	{
+		SGVector<float64_t> va(m_beta_path_t[i].vlen);
+		for (index_t p = 0; p < m_beta_path_t[i].vlen; ++p)
+		{
+			va.set_element(static_cast<float64_t>(m_beta_path_t[i][p]), p);
+		}
+		m_beta_path.push_back(va);
+		observe(i, "beta_path", "Beta path", va.clone());
+	}
+
+	// assign default estimator
+	set_w(SGVector<float64_t>(n_fea));
+	switch_w(get_path_size()-1);
+
+	return true;
+}
+
+template <typename ST>
+void LeastAngleRegression::homotopy_path(const SGMatrix<ST>& Xr,
+		const SGMatrix<ST>& G, const SGVector<ST>& Xy,
+		std::vector<SGVector<ST>>& beta_path)
+{
+	int32_t n_fea = Xr.num_rows;
+	int32_t n_vec = Xr.num_cols;
+
+	bool lasso_cond = false;
+	bool stop_cond = false;
+	// with the Gram matrix, all inner products are read off G and the data
+	// is not touched
+	bool use_gram = G.num_rows > 0;
+
+	typename SGMatrix<ST>::EigenMatrixXtMap map_Xr(Xr.matrix, n_fea, n_vec);
+	typename SGMatrix<ST>::EigenMatrixXtMap map_G(G.matrix, G.num_rows, G.num_cols);
+	typename SGVector<ST>::EigenVectorXtMap map_Xy(Xy.vector, n_fea);
 
 	// transpose(X) is more convenient to work with since we care
 	// about features here. After transpose, each row will be a data
 	// point while each column corresponds to a feature
-	SGMatrix<ST> X (n_vec, n_fea);
-	typename SGMatrix<ST>::EigenMatrixXtMap map_Xr = data->get_feature_matrix();
-	typename SGMatrix<ST>::EigenMatrixXtMap map_X(X.matrix, n_vec, n_fea);
-	map_X = map_Xr.transpose();
-
-	SGMatrix<ST> X_active(n_vec, n_fea);
+	SGMatrix<ST> X;
+	SGMatrix<ST> X_active;
+	if (!use_gram)
+	{
+		X = SGMatrix<ST>(n_vec, n_fea);
+		X_active = SGMatrix<ST>(n_vec, n_fea);
+	}
+	typename SGMatrix<ST>::EigenMatrixXtMap map_X(X.matrix, X.num_rows, X.num_cols);
+	if (!use_gram)
+		map_X = map_Xr.transpose();
 
 	// beta is the estimator
 	SGVector<ST> beta(n_fea);
 	beta.set_const(0);
-
-	vector<ST> Xy(n_fea);
-	typename SGVector<ST>::EigenVectorXtMap map_Xy(&Xy[0], n_fea);
-	// Xy = X' * y
-	map_Xy=map_Xr*map_y;
+	typename SGVector<ST>::EigenVectorXtMap map_beta(beta.vector, n_fea);
 
 	// mu is the prediction
-	vector<ST> mu(n_vec);
+	vector<ST> mu(use_gram ? 0 : n_vec);
 
 	// correlation
 	vector<ST> corr(n_fea);
 	// sign of correlation
 	vector<ST> corr_sign(n_fea);
+	// correlation of each feature with the equiangular direction
+	typename SGVector<ST>::EigenVectorXt dir_corr(n_fea);
+
+	//maximum allowed active variables at a time
+	int32_t max_active_allowed = Math::min(n_vec-1, n_fea);
 
-	// Cholesky factorization R'R = X'X, R is upper triangular
-	SGMatrix<ST> R;
+	// Cholesky factorization R'R = X'X, R is upper triangular. Only its
+	// leading m_num_active x m_num_active block is used
+	SGMatrix<ST> R(max_active_allowed, max_active_allowed);
+	typename SGMatrix<ST>::EigenMatrixXtMap map_R_all(R.matrix, R.num_rows, R.num_cols);
 
 	ST max_corr = 1;
 	int32_t i_max_corr = 1;
 
 	// first entry: all coefficients are zero
-	m_beta_path_t.push_back(beta.clone());
+	beta_path.push_back(beta.clone());
 	m_beta_idx.push_back(0);
 
-	//maximum allowed active variables at a time
-	int32_t max_active_allowed = Math::min(n_vec-1, n_fea);
-
 	//========================================
 	// main loop
 	//========================================
@@ -177,9 +313,12 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 
 		// corr = X' * (y-mu) = - X'*mu + Xy
 		typename SGVector<ST>::EigenVectorXtMap map_corr(&corr[0], n_fea);
-		typename SGVector<ST>::EigenVectorXtMap map_mu(&mu[0], n_vec);
+		typename SGVector<ST>::EigenVectorXtMap map_mu(mu.data(), mu.size());
 
-		map_corr = map_Xy - (map_Xr*map_mu);
+		if (use_gram)
+			map_corr = map_Xy - map_G*map_beta;
+		else
+			map_corr = map_Xy - (map_Xr*map_mu);
 
 		// corr_sign = sign(corr)
 		for (size_t i=0; i < corr.size(); ++i)
@@ -188,32 +327,40 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 		// find max absolute correlation in inactive set
 		find_max_abs(corr, m_is_active, i_max_corr, max_corr);
 
+		// Active variables
+		typename SGMatrix<ST>::EigenMatrixXtMap map_Xa(
+		    X_active.matrix, X_active.num_rows,
+		    use_gram ? 0 : m_num_active + !lasso_cond);
+
 		if (!lasso_cond)
 		{
-			// update Cholesky factorization matrix
-			if (m_num_active == 0)
+			// update Cholesky factorization matrix, col_k is the k-th column
+			// of (X'X) restricted to the active variables
+			SGVector<ST> col_k(m_num_active);
+			ST diag_k;
+			if (use_gram)
 			{
-				// R isn't allocated yet
-				R=SGMatrix<ST>(1,1);
-				ST diag_k = map_X.col(i_max_corr).dot(map_X.col(i_max_corr));
-				R(0, 0) = std::sqrt(diag_k);
+				for (index_t i=0; i < m_num_active; ++i)
+					col_k[i] = G(m_active_set[i], i_max_corr);
+				diag_k = G(i_max_corr, i_max_corr);
 			}
 			else
-				R=cholesky_insert(X, X_active, R, i_max_corr, m_num_active);
+			{
+				typename SGVector<ST>::EigenVectorXtMap map_col_k(col_k.vector, m_num_active);
+				map_col_k = map_Xa.leftCols(m_num_active).transpose()*map_X.col(i_max_corr);
+				diag_k = map_X.col(i_max_corr).dot(map_X.col(i_max_corr));
+				map_Xa.col(m_num_active)=map_X.col(i_max_corr);
+			}
+			cholesky_insert(R, col_k, diag_k, m_num_active);
 			activate_variable(i_max_corr);
 		}
 
-		// Active variables
-		typename SGMatrix<ST>::EigenMatrixXtMap map_Xa(X_active.matrix, n_vec, m_num_active);
-		if (!lasso_cond)
-			map_Xa.col(m_num_active-1)=map_X.col(i_max_corr);
-
 		SGVector<ST> corr_sign_a(m_num_active);
 		for (index_t i=0; i < m_num_active; ++i)
 			corr_sign_a[i] = corr_sign[m_active_set[i]];
 
 		typename SGVector<ST>::EigenVectorXtMap map_corr_sign_a(corr_sign_a.vector, corr_sign_a.size());
-		typename SGMatrix<ST>::EigenMatrixXtMap map_R(R.matrix, R.num_rows, R.num_cols);
+		auto map_R = map_R_all.topLeftCorner(m_num_active, m_num_active);
 		typename SGVector<ST>::EigenVectorXt solve = map_R.transpose().template triangularView<Lower>().template solve<OnTheLeft>(map_corr_sign_a);
 
 		typename SGVector<ST>::EigenVectorXt GA1 = map_R.template triangularView<Upper>().template solve<OnTheLeft>(solve);
@@ -225,32 +372,36 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 		typename SGVector<ST>::EigenVectorXt wA = AA*GA1;
 
 		// equiangular direction (unit vector)
-		vector<ST> u(n_vec);
-		typename SGVector<ST>::EigenVectorXtMap map_u(&u[0], n_vec);
+		vector<ST> u(use_gram ? 0 : n_vec);
+		typename SGVector<ST>::EigenVectorXtMap map_u(u.data(), u.size());
 
-		map_u = map_Xa*wA;
+		// correlation between X[:,i] and u, which is G[:,active]*wA
+		if (use_gram)
+		{
+			dir_corr.setZero();
+			for (index_t i=0; i < m_num_active; ++i)
+				dir_corr += wA(i)*map_G.col(m_active_set[i]);
+		}
+		else
+		{
+			map_u = map_Xa*wA;
+			dir_corr.noalias() = map_X.transpose()*map_u;
+		}
 
 		ST gamma = max_corr / AA;
 		if (m_num_active < n_fea)
 		{
-			#pragma omp parallel for shared(gamma)
 			for (index_t i=0; i < n_fea; ++i)
 			{
 				if (m_is_active[i])
 					continue;
 
-				// correlation between X[:,i] and u
-				ST dir_corr = map_u.dot(map_X.col(i));
-
-				ST tmp1 = (max_corr-corr[i])/(AA-dir_corr);
-				ST tmp2 = (max_corr+corr[i])/(AA+dir_corr);
-				#pragma omp critical
-				{
+				ST tmp1 = (max_corr-corr[i])/(AA-dir_corr(i));
+				ST tmp2 = (max_corr+corr[i])/(AA+dir_corr(i));
 				if (tmp1 > Math::MACHINE_EPSILON && tmp1 < gamma)
 					gamma = tmp1;
 				if (tmp2 > Math::MACHINE_EPSILON && tmp2 < gamma)
 					gamma = tmp2;
-				}
 			}
 		}
 
@@ -281,7 +432,8 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 		}
 
 		// update prediction: mu = mu + gamma * u
-		map_mu += gamma*map_u;
+		if (!use_gram)
+			map_mu += gamma*map_u;
 
 		// update estimator
 		for (index_t i=0; i < m_num_active; ++i)
@@ -297,13 +449,11 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 				stop_cond = true;
 				lasso_cond = false;
 				ST l1_prev = (ST)SGVector<ST>::onenorm(
-				    m_beta_path_t[nloop].vector, n_fea);
+				    beta_path[nloop].vector, n_fea);
 				ST s = (m_max_l1_norm - l1_prev) / (l1 - l1_prev);
 
-				typename SGVector<ST>::EigenVectorXtMap map_beta(
-				    beta.vector, n_fea);
 				typename SGVector<ST>::EigenVectorXtMap map_beta_prev(
-				    m_beta_path_t[nloop].vector, n_fea);
+				    beta_path[nloop].vector, n_fea);
 				map_beta = (1-s)*map_beta_prev + s*map_beta;
 			}
 		}
@@ -312,7 +462,7 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 		if (lasso_cond)
 		{
 			beta[i_change] = 0;
-			R=cholesky_delete(R, i_kick);
+			cholesky_delete(R, i_kick);
 			deactivate_variable(i_kick);
 
 			// Remove column from active set
@@ -324,7 +474,7 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 		}
 
 		nloop++;
-		m_beta_path_t.push_back(beta.clone());
+		beta_path.push_back(beta.clone());
 		if (int32_t(m_num_active) >= get_path_size())
 			m_beta_idx.push_back(nloop);
 		else
@@ -339,23 +489,6 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 	}
 	pb.complete();
 
-	//copy m_beta_path_t (of type ST) into m_beta_path
-	// do also a cast to float64_t
-	for (index_t i = 0; i < m_beta_path_t.size(); ++i)
-	{
-		SGVector<float64_t> va(m_beta_path_t[i].vlen);
-		for (index_t p = 0; p < m_beta_path_t[i].vlen; ++p)
-		{
-			va.set_element(static_cast<float64_t>(m_beta_path_t[i][p]), p);
-		}
-		m_beta_path.push_back(va);
-		observe(i, "beta_path", "Beta path", va.clone());
-	}
-
-	// assign default estimator
-	set_w(SGVector<float64_t>(n_fea));
-	switch_w(get_path_size()-1);
-
 	if (max_corr / n_vec > m_epsilon)
 	{
 		io::warn(
@@ -363,8 +496,119 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 		    "iterations.",
 		    max_corr / n_vec, m_epsilon, nloop);
 	}
+}
 
-	return true;
+template <typename ST>
+void LeastAngleRegression::coordinate_descent_path(const SGMatrix<ST>& G,
+		const SGVector<ST>& Xy, std::vector<SGVector<ST>>& beta_path)
+{
+	require(m_num_lambdas > 0, "Number of regularization constants ({}) must be positive.",
+		m_num_lambdas);
+	require(m_lambda_min_ratio > 0 && m_lambda_min_ratio < 1,
+		"Ratio of the smallest regularization constant ({}) must lie in (0, 1).",
+		m_lambda_min_ratio);
+
+	int32_t n_fea = Xy.vlen;
+	typename SGMatrix<ST>::EigenMatrixXtMap map_G(G.matrix, n_fea, n_fea);
+
+	// all coefficients are zero for lambda >= max |Xy|
+	ST lambda_max = 0;
+	for (index_t i=0; i < n_fea; ++i)
+		lambda_max = Math::max(lambda_max, Math::abs(Xy[i]));
+
+	SGVector<ST> beta(n_fea);
+	beta.set_const(0);
+
+	// c = Xy - G*beta, the correlations of the features with the residuals
+	typename SGVector<ST>::EigenVectorXt c =
+	    typename SGVector<ST>::EigenVectorXtMap(Xy.vector, n_fea);
+
+	// one sweep over the given coordinates, returns the largest change of a
+	// coefficient scaled by the norm of its feature
+	auto sweep = [&](const std::vector<index_t>& coordinates, ST lambda) {
+		ST max_change = 0;
+		for (auto j : coordinates)
+		{
+			ST g_jj = G(j, j);
+			if (g_jj <= 0)
+				continue;
+
+			ST z = c(j) + g_jj*beta[j];
+			ST beta_j = Math::sign(z)*Math::max(Math::abs(z)-lambda, ST(0))/g_jj;
+			ST delta = beta_j - beta[j];
+			if (delta != 0)
+			{
+				c -= delta*map_G.col(j);
+				beta[j] = beta_j;
+				max_change = Math::max(max_change, ST(Math::abs(delta)*std::sqrt(g_jj)));
+			}
+		}
+		return max_change;
+	};
+
+	std::vector<index_t> all(n_fea);
+	std::iota(all.begin(), all.end(), 0);
+	std::vector<index_t> active;
+
+	auto pb = SG_PROGRESS(range(0, m_num_lambdas));
+	for (int32_t l=0; l < m_num_lambdas; ++l)
+	{
+		COMPUTATION_CONTROLLERS
+
+		// geometric grid from lambda_max down to lambda_min_ratio*lambda_max
+		ST lambda = lambda_max;
+		if (m_num_lambdas > 1)
+			lambda *= std::pow(ST(m_lambda_min_ratio), ST(l)/(m_num_lambdas-1));
+
+		// alternate full sweeps, which may change the active set, with
+		// sweeps over the non-zero coefficients only until those converge
+		int32_t iter = 0;
+		while (iter++ < m_cd_max_iterations && sweep(all, lambda) > m_cd_tolerance)
+		{
+			active.clear();
+			for (index_t j=0; j < n_fea; ++j)
+			{
+				if (beta[j] != 0)
+					active.push_back(j);
+			}
+			while (iter++ < m_cd_max_iterations && sweep(active, lambda) > m_cd_tolerance)
+				;
+		}
+		if (iter > m_cd_max_iterations)
+		{
+			io::warn(
+			    "Coordinate descent did not converge within {} sweeps for "
+			    "lambda {}.", m_cd_max_iterations, lambda);
+		}
+
+		int32_t num_nonz = 0;
+		for (index_t j=0; j < n_fea; ++j)
+			num_nonz += beta[j] != 0;
+
+		// early stopping, the path ends with the last estimator within the
+		// constraints
+		if (m_max_nonz > 0 && num_nonz > m_max_nonz)
+			break;
+		if (m_max_l1_norm > 0 &&
+		    SGVector<ST>::onenorm(beta.vector, n_fea) > m_max_l1_norm)
+			break;
+
+		// m_beta_idx[i] is the last estimator with at most i non-zeros. The
+		// sparsity levels this estimator skips keep the previous one, which
+		// exists since the estimator at lambda_max is zero
+		int32_t idx = beta_path.size();
+		beta_path.push_back(beta.clone());
+		for (int32_t i=num_nonz; i < get_path_size(); ++i)
+			m_beta_idx[i] = idx;
+		while (get_path_size() < num_nonz)
+			m_beta_idx.push_back(idx-1);
+		if (get_path_size() == num_nonz)
+			m_beta_idx.push_back(idx);
+
+		SG_DEBUG("lambda {}, non-zero coefficients {}", lambda, num_nonz);
+		pb.print_progress();
+	}
+	pb.complete();
 }
 
 template <typename ST>
@@ -376,26 +620,38 @@ SGMatrix<ST> LeastAngleRegression::cholesky_insert(const SGMatrix<ST>& X,
 	ST diag_k = map_X.col(i_max_corr).dot(map_X.col(i_max_corr));
 
 	// col_k is the k-th column of (X'X)
-	typename SGVector<ST>::EigenVectorXtMap map_i_max(X.get_column_vector(i_max_corr), X.num_rows);
-	typename SGVector<ST>::EigenVectorXt R_k = map_X_active.transpose()*map_i_max;
-	typename SGMatrix<ST>::EigenMatrixXtMap map_R(R.matrix, R.num_rows, R.num_cols);
-
-	// R' * R_k = (X' * X)_k = col_k, solving to get R_k
-	map_R.transpose().template triangularView<Lower>().template solveInPlace<OnTheLeft>(R_k);
-	ST R_kk = std::sqrt(diag_k - R_k.dot(R_k));
+	SGVector<ST> col_k(num_active);
+	typename SGVector<ST>::EigenVectorXtMap map_col_k(col_k.vector, num_active);
+	map_col_k = map_X_active.transpose()*map_X.col(i_max_corr);
 
 	SGMatrix<ST> R_new(num_active+1, num_active+1);
+	typename SGMatrix<ST>::EigenMatrixXtMap map_R(R.matrix, R.num_rows, R.num_cols);
 	typename SGMatrix<ST>::EigenMatrixXtMap map_R_new(R_new.matrix, R_new.num_rows, R_new.num_cols);
+	map_R_new.topLeftCorner(num_active, num_active) = map_R.topLeftCorner(num_active, num_active);
 
-	map_R_new.block(0, 0, num_active, num_active) = map_R;
-	sg_memcpy(R_new.matrix+num_active*(num_active+1), R_k.data(), sizeof(ST)*(num_active));
-	map_R_new.row(num_active).setZero();
-	map_R_new(num_active, num_active) = R_kk;
+	cholesky_insert(R_new, col_k, diag_k, num_active);
 	return R_new;
 }
 
 template <typename ST>
-SGMatrix<ST> LeastAngleRegression::cholesky_delete(SGMatrix<ST>& R, int32_t i_kick)
+void LeastAngleRegression::cholesky_insert(SGMatrix<ST>& R,
+		const SGVector<ST>& col_k, ST diag_k, int32_t num_active)
+{
+	typename SGMatrix<ST>::EigenMatrixXtMap map_R(R.matrix, R.num_rows, R.num_cols);
+	typename SGVector<ST>::EigenVectorXtMap map_col_k(col_k.vector, num_active);
+
+	// R' * R_k = (X' * X)_k = col_k, solving to get R_k
+	typename SGVector<ST>::EigenVectorXt R_k = map_R.topLeftCorner(num_active, num_active)
+		.transpose().template triangularView<Lower>().solve(map_col_k);
+	ST R_kk = std::sqrt(diag_k - R_k.dot(R_k));
+
+	map_R.col(num_active).head(num_active) = R_k;
+	map_R.row(num_active).head(num_active).setZero();
+	map_R(num_active, num_active) = R_kk;
+}
+
+template <typename ST>
+void LeastAngleRegression::cholesky_delete(SGMatrix<ST>& R, int32_t i_kick)
 {
 	if (i_kick != m_num_active-1)
 	{
@@ -420,13 +676,6 @@ SGMatrix<ST> LeastAngleRegression::cholesky_delete(SGMatrix<ST>& R, int32_t i_ki
 			}
 		}
 	}
-
-	SGMatrix<ST> nR(m_num_active-1, m_num_active-1);
-	for (index_t i=0; i < m_num_active-1; ++i)
-		for (index_t j=0; j < m_num_active-1; ++j)
-			nR(i,j) = R(i,j);
-
-	return nR;
 }
 
 template bool LeastAngleRegression::train_machine_templated<floatmax_t>(const std::shared_ptr<DenseFeatures<floatmax_t>>& data);
@@ -20,6 +20,15 @@ namespace shogun
 
 class Features;
 
+/** solvers of LeastAngleRegression */
+enum ELARSSolver
+{
+	/** least angle steps, one per change of the active set */
+	LARS_SOLVER_HOMOTOPY = 0,
+	/** coordinate descent on a grid of regularization constants, lasso only */
+	LARS_SOLVER_COORDINATE_DESCENT = 1
+};
+
 /** @brief Class for Least Angle Regression, can be used to solve LASSO.
  *
  * LASSO is basically L1 regulairzed least square regression
@@ -53,6 +62,25 @@ class Features;
  *
  * When no constraints is provided, the full path is generated.
  *
+ * For data with many more vectors than features, the Gram matrix \f$XX^T\f$
+ * and \f$Xy\f$ can be computed once, in parallel, by setting
+ * "precompute_gram". The path is then computed from these d x d quantities
+ * only, so the data is read a single time.
+ *
+ * Alternatively, the lasso path can be computed with the solver
+ * LARS_SOLVER_COORDINATE_DESCENT, which always works on the Gram matrix. It
+ * solves
+ *
+ * \f[
+ * \min \frac{1}{2}\|X^T\beta - y\|^2 + \lambda\|\beta\|_{1}
+ * \f]
+ *
+ * for "num_lambdas" values of lambda, spaced geometrically from the smallest
+ * value at which all coefficients are zero down to "lambda_min_ratio" times
+ * that value, each starting from the solution of the previous one. Here,
+ * get_w_for_var(i) returns the last estimator on the path with at most i
+ * non-zero coefficients.
+ *
  * Please see the following paper for more details.
  *
  * @code
@@ -153,8 +181,23 @@ protected:
 	SGMatrix<ST> cholesky_insert(const SGMatrix<ST>& X,
 			const SGMatrix<ST>& X_active, SGMatrix<ST>& R, int32_t i_max_corr, int32_t num_active);
 
+	/** extends the Cholesky factor of the active variables in place
+	 *
+	 * @param R factor, of which the leading num_active x num_active block is
+	 * used, with room for one more row and column
+	 * @param col_k inner products of the new variable with the active ones
+	 * @param diag_k squared norm of the new variable
+	 * @param num_active number of active variables
+	 */
 	template <typename ST>
-	SGMatrix<ST> cholesky_delete(SGMatrix<ST>& R, int32_t i_kick);
+	static void cholesky_insert(SGMatrix<ST>& R, const SGVector<ST>& col_k,
+			ST diag_k, int32_t num_active);
+
+	/** removes a variable from the Cholesky factor of the active variables
+	 * in place, the leading block of R shrinks by one row and column
+	 */
+	template <typename ST>
+	void cholesky_delete(SGMatrix<ST>& R, int32_t i_kick);
 
 	template <typename ST>
 	static void plane_rot(ST x0, ST x1,
@@ -175,6 +218,28 @@ protected:
 		                       std::is_floating_point<ST>::value>>
 	bool train_machine_templated(const std::shared_ptr<DenseFeatures<ST>>& data);
 
+	/** computes the path with least angle steps
+	 *
+	 * @param X features, one vector per column
+	 * @param G Gram matrix of the features, or an empty matrix to compute
+	 * the inner products from X
+	 * @param Xy inner products of the features with the labels
+	 * @param beta_path estimators along the path
+	 */
+	template <typename ST>
+	void homotopy_path(const SGMatrix<ST>& X, const SGMatrix<ST>& G,
+			const SGVector<ST>& Xy, std::vector<SGVector<ST>>& beta_path);
+
+	/** computes the lasso path with coordinate descent
+	 *
+	 * @param G Gram matrix of the features
+	 * @param Xy inner products of the features with the labels
+	 * @param beta_path estimators along the path
+	 */
+	template <typename ST>
+	void coordinate_descent_path(const SGMatrix<ST>& G, const SGVector<ST>& Xy,
+			std::vector<SGVector<ST>>& beta_path);
+
 private:
 	/** Initialize and register parameters */
 	void init();
@@ -204,6 +269,21 @@ private:
 	std::vector<bool> m_is_active;
 	int32_t m_num_active;
 	float64_t m_epsilon;
+
+	/** solver */
+	ELARSSolver m_solver;
+	/** whether the least angle steps work on the Gram matrix */
+	bool m_precompute_gram;
+	/** number of regularization constants of the coordinate descent path */
+	int32_t m_num_lambdas;
+	/** smallest over largest regularization constant of the path */
+	float64_t m_lambda_min_ratio;
+	/** coordinate descent stops when no coefficient, scaled by the norm of
+	 * its feature, changes by more than this
+	 */
+	float64_t m_cd_tolerance;
+	/** maximum number of coordinate descent sweeps per regularization constant */
+	int32_t m_cd_max_iterations;
 }; // class LARS
 
 } // namespace shogun
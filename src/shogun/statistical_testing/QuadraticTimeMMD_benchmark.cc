@@ -0,0 +1,44 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/statistical_testing/QuadraticTimeMMD.h>
+#include <shogun/util/Learner_benchmark.h>
+
+namespace shogun
+{
+
+BENCHMARK_DEFINE_F(LearnerFixture, QuadraticTimeMMD_perform_test)
+(benchmark::State& st)
+{
+	// first half of the blobs is p, the second half is q
+	auto data = features->get_feature_matrix();
+	auto m = data.num_cols / 2;
+	SGMatrix<float64_t> data_p(data.num_rows, m);
+	SGMatrix<float64_t> data_q(data.num_rows, data.num_cols - m);
+	sg_memcpy(data_p.matrix, data.matrix, data_p.size() * sizeof(float64_t));
+	sg_memcpy(
+	    data_q.matrix, data.get_column_vector(m),
+	    data_q.size() * sizeof(float64_t));
+	auto features_p = std::make_shared<DenseFeatures<float64_t>>(data_p);
+	auto features_q = std::make_shared<DenseFeatures<float64_t>>(data_q);
+
+	for (auto _ : st)
+	{
+		auto mmd = std::make_shared<QuadraticTimeMMD>();
+		mmd->put("seed", LEARNER_BENCHMARK_SEED);
+		mmd->set_p(features_p);
+		mmd->set_q(features_q);
+		mmd->set_kernel(std::make_shared<GaussianKernel>(10, 2.0));
+		mmd->set_statistic_type(ST_UNBIASED_FULL);
+		mmd->set_null_approximation_method(NAM_PERMUTATION);
+		mmd->set_num_null_samples(50);
+		benchmark::DoNotOptimize(mmd->perform_test(0.05));
+	}
+	report(st);
+}
+
+LEARNER_BENCHMARK(QuadraticTimeMMD_perform_test, 8192);
+
+}
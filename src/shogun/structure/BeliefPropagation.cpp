@@ -5,7 +5,9 @@
  */
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
+#include <limits>
 #include <numeric>
 #include <shogun/io/SGIO.h>
 #include <shogun/structure/BeliefPropagation.h>
@@ -550,3 +552,329 @@ void TreeMaxProduct::top_down_pass()
 	SG_DEBUG("***leave top_down_pass().");
 }
 
+
+// -----------------------------------------------------------------
+
+LoopyMaxProduct::LoopyMaxProduct()
+	: BeliefPropagation()
+{
+	unstable(SOURCE_LOCATION);
+
+	init();
+}
+
+LoopyMaxProduct::LoopyMaxProduct(std::shared_ptr<FactorGraph> fg)
+	: BeliefPropagation(std::move(fg))
+{
+	ASSERT(m_fg != NULL);
+
+	init();
+	build_layout();
+}
+
+LoopyMaxProduct::~LoopyMaxProduct()
+{
+}
+
+void LoopyMaxProduct::init()
+{
+	m_max_iter = 100;
+	m_tolerance = 1E-8;
+	m_damping = 0;
+	m_schedule_ratio = 0.5;
+	m_converged = false;
+	m_map_energy = 0;
+}
+
+void LoopyMaxProduct::set_max_iter(int32_t max_iter)
+{
+	require(max_iter > 0, "{}::set_max_iter(): max_iter should be positive!",
+		get_name());
+	m_max_iter = max_iter;
+}
+
+void LoopyMaxProduct::set_tolerance(float64_t tolerance)
+{
+	require(tolerance >= 0, "{}::set_tolerance(): tolerance should be "
+		"non-negative!", get_name());
+	m_tolerance = tolerance;
+}
+
+void LoopyMaxProduct::set_damping(float64_t damping)
+{
+	require(damping >= 0 && damping < 1, "{}::set_damping(): damping should "
+		"be in [0, 1)!", get_name());
+	m_damping = damping;
+}
+
+void LoopyMaxProduct::set_schedule_ratio(float64_t ratio)
+{
+	require(ratio > 0 && ratio <= 1, "{}::set_schedule_ratio(): ratio should "
+		"be in (0, 1]!", get_name());
+	m_schedule_ratio = ratio;
+}
+
+void LoopyMaxProduct::build_layout()
+{
+	auto facs = m_fg->get_factors();
+	SGVector<int32_t> cards = m_fg->get_cardinalities();
+	int32_t num_vars = cards.size();
+
+	m_fac_edges.assign(1, 0);
+	m_msg_offsets.assign(1, 0);
+	m_edge_var.clear();
+	m_edge_fac.clear();
+	for (int32_t fi = 0; fi < (int32_t)facs.size(); fi++)
+	{
+		SGVector<int32_t> vars = facs[fi]->get_variables();
+		for (int32_t vi = 0; vi < vars.size(); vi++)
+		{
+			m_edge_var.push_back(vars[vi]);
+			m_edge_fac.push_back(fi);
+			m_msg_offsets.push_back(m_msg_offsets.back() + cards[vars[vi]]);
+		}
+		m_fac_edges.push_back(m_edge_var.size());
+	}
+
+	// edges of every variable, compressed by variable
+	m_var_edges.assign(num_vars + 1, 0);
+	for (auto var_id : m_edge_var)
+		m_var_edges[var_id + 1]++;
+	std::partial_sum(m_var_edges.begin(), m_var_edges.end(), m_var_edges.begin());
+
+	m_var_edge_ids.resize(m_edge_var.size());
+	std::vector<int32_t> fill_pos(m_var_edges.begin(), m_var_edges.end() - 1);
+	for (int32_t ei = 0; ei < (int32_t)m_edge_var.size(); ei++)
+		m_var_edge_ids[fill_pos[m_edge_var[ei]]++] = ei;
+
+	m_f2v.assign(m_msg_offsets.back(), 0);
+	m_f2v_new.assign(m_msg_offsets.back(), 0);
+	m_v2f.assign(m_msg_offsets.back(), 0);
+	m_residuals.assign(facs.size(), 0);
+}
+
+float64_t LoopyMaxProduct::compute_factor_messages(int32_t fac_id)
+{
+	const int32_t first = m_fac_edges[fac_id];
+	const int32_t num_vars = m_fac_edges[fac_id + 1] - first;
+	const int32_t* offsets = &m_msg_offsets[first];
+	const SGVector<float64_t>& fenrgs = m_energies[fac_id];
+
+	std::fill(m_f2v_new.begin() + offsets[0],
+		m_f2v_new.begin() + offsets[num_vars],
+		std::numeric_limits<float64_t>::infinity());
+
+	// r_f2v(x_v) = min_{x_f, x_f[v] = x_v} (E(x_f) + sum_{u!=v} q_u2f(x_u)),
+	// states of the energy table are enumerated with the first variable
+	// changing fastest, see TableFactorType::state_from_index()
+	std::vector<int32_t> states(num_vars, 0);
+	for (int32_t ei = 0; ei < fenrgs.size(); ei++)
+	{
+		float64_t marg = fenrgs[ei];
+		for (int32_t vi = 0; vi < num_vars; vi++)
+			marg += m_v2f[offsets[vi] + states[vi]];
+
+		for (int32_t vi = 0; vi < num_vars; vi++)
+		{
+			int32_t mi = offsets[vi] + states[vi];
+			m_f2v_new[mi] = std::min(m_f2v_new[mi], marg - m_v2f[mi]);
+		}
+
+		for (int32_t vi = 0; vi < num_vars; vi++)
+		{
+			if (++states[vi] < offsets[vi + 1] - offsets[vi])
+				break;
+			states[vi] = 0;
+		}
+	}
+
+	// normalize, damp and measure the change of every message
+	float64_t residual = 0;
+	for (int32_t vi = 0; vi < num_vars; vi++)
+	{
+		auto begin = m_f2v_new.begin() + offsets[vi];
+		auto end = m_f2v_new.begin() + offsets[vi + 1];
+		float64_t min_msg = *std::min_element(begin, end);
+		if (!std::isfinite(min_msg))
+			continue;
+
+		for (int32_t mi = offsets[vi]; mi < offsets[vi + 1]; mi++)
+		{
+			float64_t msg = m_f2v_new[mi] - min_msg;
+			msg = (1 - m_damping) * msg + m_damping * m_f2v[mi];
+			m_f2v_new[mi] = msg;
+			residual = std::max(residual, std::abs(msg - m_f2v[mi]));
+		}
+	}
+
+	return residual;
+}
+
+void LoopyMaxProduct::update_variable_messages(int32_t var_id)
+{
+	const int32_t* edges = &m_var_edge_ids[m_var_edges[var_id]];
+	const int32_t num_edges = m_var_edges[var_id + 1] - m_var_edges[var_id];
+	if (num_edges == 0)
+		return;
+
+	const int32_t card = m_msg_offsets[edges[0] + 1] - m_msg_offsets[edges[0]];
+
+	// q_v2f = sum_{g!=f} r_g2v, normalized
+	std::vector<float64_t> belief(card, 0);
+	for (int32_t i = 0; i < num_edges; i++)
+	{
+		const float64_t* r_f2v = &m_f2v[m_msg_offsets[edges[i]]];
+		for (int32_t si = 0; si < card; si++)
+			belief[si] += r_f2v[si];
+	}
+
+	for (int32_t i = 0; i < num_edges; i++)
+	{
+		const float64_t* r_f2v = &m_f2v[m_msg_offsets[edges[i]]];
+		float64_t* q_v2f = &m_v2f[m_msg_offsets[edges[i]]];
+		for (int32_t si = 0; si < card; si++)
+			q_v2f[si] = belief[si] - r_f2v[si];
+
+		float64_t min_msg = *std::min_element(q_v2f, q_v2f + card);
+		if (std::isfinite(min_msg))
+		{
+			for (int32_t si = 0; si < card; si++)
+				q_v2f[si] -= min_msg;
+		}
+	}
+}
+
+float64_t LoopyMaxProduct::inference(SGVector<int32_t> assignment)
+{
+	SGVector<int32_t> cards = m_fg->get_cardinalities();
+	require(assignment.size() == cards.size(),
+		"{}::inference(): the output assignment should be prepared as"
+		"the same size as variables!", get_name());
+
+	auto facs = m_fg->get_factors();
+	const int32_t num_facs = facs.size();
+	const int32_t num_vars = cards.size();
+	ASSERT((int32_t)m_fac_edges.size() == num_facs + 1);
+
+	m_energies.resize(num_facs);
+	for (int32_t fi = 0; fi < num_facs; fi++)
+		m_energies[fi] = facs[fi]->get_energies();
+
+	std::fill(m_f2v.begin(), m_f2v.end(), 0);
+	std::fill(m_v2f.begin(), m_v2f.end(), 0);
+
+	#pragma omp parallel for schedule(dynamic, 16)
+	for (int32_t fi = 0; fi < num_facs; fi++)
+		m_residuals[fi] = compute_factor_messages(fi);
+
+	// residual scheduling: every round commits the pending factors with
+	// the largest residuals, then propagates to the touched variables and
+	// recomputes the residuals of their factors
+	std::vector<int32_t> pending;
+	std::vector<int32_t> touched_vars;
+	std::vector<int32_t> touched_facs;
+	std::vector<int32_t> var_round(num_vars, -1);
+	std::vector<int32_t> fac_round(num_facs, -1);
+	const int64_t max_updates = (int64_t)m_max_iter * num_facs;
+	int64_t num_updates = 0;
+	int32_t round = 0;
+
+	m_converged = false;
+	for (; num_updates < max_updates; round++)
+	{
+		pending.clear();
+		for (int32_t fi = 0; fi < num_facs; fi++)
+		{
+			if (m_residuals[fi] > m_tolerance)
+				pending.push_back(fi);
+		}
+
+		if (pending.empty())
+		{
+			m_converged = true;
+			break;
+		}
+
+		int64_t num_commit = std::max<int64_t>(1,
+			std::ceil(m_schedule_ratio * pending.size()));
+		num_commit = std::min(num_commit, max_updates - num_updates);
+		std::nth_element(pending.begin(), pending.begin() + num_commit - 1,
+			pending.end(), [this](int32_t a, int32_t b)
+			{
+				return m_residuals[a] > m_residuals[b] ||
+					(m_residuals[a] == m_residuals[b] && a < b);
+			});
+		pending.resize(num_commit);
+		num_updates += num_commit;
+
+		#pragma omp parallel for schedule(dynamic, 16)
+		for (int32_t i = 0; i < (int32_t)pending.size(); i++)
+		{
+			int32_t fi = pending[i];
+			std::copy(m_f2v_new.begin() + m_msg_offsets[m_fac_edges[fi]],
+				m_f2v_new.begin() + m_msg_offsets[m_fac_edges[fi + 1]],
+				m_f2v.begin() + m_msg_offsets[m_fac_edges[fi]]);
+			m_residuals[fi] = 0;
+		}
+
+		touched_vars.clear();
+		for (auto fi : pending)
+		{
+			for (int32_t ei = m_fac_edges[fi]; ei < m_fac_edges[fi + 1]; ei++)
+			{
+				int32_t var_id = m_edge_var[ei];
+				if (var_round[var_id] != round)
+				{
+					var_round[var_id] = round;
+					touched_vars.push_back(var_id);
+				}
+			}
+		}
+
+		#pragma omp parallel for schedule(dynamic, 16)
+		for (int32_t i = 0; i < (int32_t)touched_vars.size(); i++)
+			update_variable_messages(touched_vars[i]);
+
+		touched_facs.clear();
+		for (auto var_id : touched_vars)
+		{
+			for (int32_t i = m_var_edges[var_id]; i < m_var_edges[var_id + 1]; i++)
+			{
+				int32_t fac_id = m_edge_fac[m_var_edge_ids[i]];
+				if (fac_round[fac_id] != round)
+				{
+					fac_round[fac_id] = round;
+					touched_facs.push_back(fac_id);
+				}
+			}
+		}
+
+		#pragma omp parallel for schedule(dynamic, 16)
+		for (int32_t i = 0; i < (int32_t)touched_facs.size(); i++)
+			m_residuals[touched_facs[i]] = compute_factor_messages(touched_facs[i]);
+	}
+
+	SG_DEBUG("{}::inference(): {} rounds, {} factor updates, converged: {}",
+		get_name(), round, num_updates, m_converged);
+
+	// decode from beliefs b_v = sum_f r_f2v
+	std::vector<float64_t> belief;
+	for (int32_t vi = 0; vi < num_vars; vi++)
+	{
+		belief.assign(cards[vi], 0);
+		for (int32_t i = m_var_edges[vi]; i < m_var_edges[vi + 1]; i++)
+		{
+			const float64_t* r_f2v = &m_f2v[m_msg_offsets[m_var_edge_ids[i]]];
+			for (int32_t si = 0; si < cards[vi]; si++)
+				belief[si] += r_f2v[si];
+		}
+
+		assignment[vi] = static_cast<int32_t>(
+			std::min_element(belief.begin(), belief.end()) - belief.begin());
+	}
+
+	m_map_energy = m_fg->evaluate_energy(assignment);
+	SG_DEBUG("minimized energy = {}", m_map_energy);
+
+	return m_map_energy;
+}
@@ -132,6 +132,100 @@ private:
 	msgset_map_type m_msgset_map_var;
 };
 
+/** max-product algorithm for graphs with cycles, run as min-sum on the
+ * energies. Messages are flattened into contiguous arrays with one slice
+ * per factor-variable edge, so that a factor update is a single pass over
+ * its energy table.
+ *
+ * Updates are scheduled by residual [1]: all factors whose outgoing
+ * messages would change by more than the tolerance are candidates, and
+ * every round commits the fraction of them with the largest residuals.
+ * A factor only writes its own outgoing messages, so the committed
+ * factors, the variables they touch and the recomputed residuals of
+ * their neighbours are each updated in parallel. Inference stops when no
+ * residual exceeds the tolerance or after max_iter sweeps worth of factor
+ * updates, and the assignment is decoded from the variable beliefs.
+ *
+ * [1] Gal Elidan, Ian McGraw and Daphne Koller,
+ * Residual Belief Propagation: Informed Scheduling for Asynchronous
+ * Message Passing, UAI 2006.
+ */
+IGNORE_IN_CLASSLIST class LoopyMaxProduct : public BeliefPropagation
+{
+public:
+	LoopyMaxProduct();
+	LoopyMaxProduct(std::shared_ptr<FactorGraph> fg);
+
+	virtual ~LoopyMaxProduct();
+
+	/** @return class name */
+	virtual const char* get_name() const { return "LoopyMaxProduct"; }
+
+	virtual float64_t inference(SGVector<int32_t> assignment);
+
+	/** @param max_iter maximum number of sweeps over all factors */
+	void set_max_iter(int32_t max_iter);
+
+	/** @param tolerance largest message change regarded as converged */
+	void set_tolerance(float64_t tolerance);
+
+	/** @param damping weight of the old message in [0, 1) */
+	void set_damping(float64_t damping);
+
+	/** @param ratio fraction of the pending factors updated per round */
+	void set_schedule_ratio(float64_t ratio);
+
+	/** @return whether the last inference converged */
+	bool get_converged() const { return m_converged; }
+
+protected:
+	/** builds the edge layout of the factor graph */
+	void build_layout();
+
+	/** computes the outgoing messages of a factor into m_f2v_new
+	 *
+	 * @return largest change to the current outgoing messages
+	 */
+	float64_t compute_factor_messages(int32_t fac_id);
+
+	/** recomputes the messages of a variable to its factors */
+	void update_variable_messages(int32_t var_id);
+
+private:
+	void init();
+
+private:
+	int32_t m_max_iter;
+	float64_t m_tolerance;
+	float64_t m_damping;
+	float64_t m_schedule_ratio;
+	bool m_converged;
+
+	/** energy tables of the factors during inference */
+	std::vector<SGVector<float64_t> > m_energies;
+
+	/** first edge of every factor, edges of a factor in variable order */
+	std::vector<int32_t> m_fac_edges;
+	/** first edge index into m_var_edge_ids of every variable */
+	std::vector<int32_t> m_var_edges;
+	/** edges adjacent to the variables */
+	std::vector<int32_t> m_var_edge_ids;
+	/** variable and factor of every edge */
+	std::vector<int32_t> m_edge_var;
+	std::vector<int32_t> m_edge_fac;
+	/** offset of the message slice of every edge */
+	std::vector<int32_t> m_msg_offsets;
+
+	/** factor to variable messages */
+	std::vector<float64_t> m_f2v;
+	/** pending factor to variable messages */
+	std::vector<float64_t> m_f2v_new;
+	/** variable to factor messages */
+	std::vector<float64_t> m_v2f;
+	/** residuals of the pending messages of every factor */
+	std::vector<float64_t> m_residuals;
+};
+
 }
 
 #endif /* DOXYGEN_SHOULD_SKIP_THIS */
@@ -530,9 +530,12 @@ SGSparseVector<float64_t> CCSOSVM::find_cutting_plane(float64_t* margin)
 	/* find cutting plane */
 	*margin = 0;
 	new_constraint.zero();
+	SGVector<int32_t> samples(num_samples);
+	samples.range_fill();
+	auto results = m_model->argmax_batch(m_w, samples);
 	for (index_t i = 0; i < num_samples; i++)
 	{
-		auto result = m_model->argmax(m_w, i);
+		auto& result = results[i];
 		if (result->psi_computed)
 		{
 			linalg::add(new_constraint, result->psi_truth, new_constraint);
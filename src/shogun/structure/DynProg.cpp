@@ -95,7 +95,9 @@ DynProg::DynProg(int32_t num_svms /*= 8 */)
 	  m_num_raw_data(0),
 
 	  m_long_transitions(true),
-	  m_long_transition_threshold(1000)
+	  m_long_transition_threshold(1000),
+	  m_beam_width(Math::INFTY),
+	  m_num_pruned_segments(0)
 {
 	trans_list_forward = NULL ;
 	trans_list_forward_cnt = NULL ;
@@ -1113,11 +1115,7 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 		long_transition_content_end_position.set_const(0) ;
 #endif
 
-		svm_value = SG_MALLOC(float64_t , m_num_lin_feat_plifs_cum[m_num_raw_data]+m_num_intron_plifs);
-		{ // initialize svm_svalue
-			for (int32_t s=0; s<m_num_lin_feat_plifs_cum[m_num_raw_data]+m_num_intron_plifs; s++)
-				svm_value[s]=0 ;
-		}
+		const int32_t num_svm_values = m_num_lin_feat_plifs_cum[m_num_raw_data]+m_num_intron_plifs ;
 
 		DynamicArray<int32_t> look_back(m_N,m_N) ; // 2d
 		//DynamicArray<int32_t> look_back_orig(m_N,m_N) ;
@@ -1269,11 +1267,6 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 	    DynamicArray<int16_t> ktable_end(nbest);
 	    // ktable_end.set_const(0) ;
 
-	    float64_t* fixedtempvv = SG_MALLOC(float64_t, look_back_buflen);
-	    memset(fixedtempvv, 0, look_back_buflen * sizeof(float64_t));
-	    int32_t* fixedtempii = SG_MALLOC(int32_t, look_back_buflen);
-	    memset(fixedtempii, 0, look_back_buflen * sizeof(int32_t));
-
 	    DynamicArray<float64_t> oldtempvv(look_back_buflen);
 
 	    DynamicArray<float64_t> oldtempvv2(look_back_buflen);
@@ -1320,11 +1313,6 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 		path_ends.display_size() ;
 		ktable_end.display_size() ;
 
-#ifdef USE_TMP_ARRAYCLASS
-		fixedtempvv.display_size() ;
-		fixedtempii.display_size() ;
-#endif
-
 		//oldtempvv.display_size() ;
 		//oldtempii.display_size() ;
 
@@ -1391,12 +1379,44 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 			}
 		}
 
+		// segments are never longer than the sequence, so PLiFs up to that
+		// length are tabulated; concurrent decoders may share the PLiFs
+#pragma omp critical (dynprog_plif_caches)
+		m_plif_matrices->init_plif_caches(m_genestr.get_dim1());
+
+		// whether the penalty of a transition needs the content SVM values
+		DynamicArray<bool> pen_uses_svm(m_N,m_N) ; // 2d
+		for (int32_t i=0; i<m_N; i++)
+			for (int32_t j=0; j<m_N; j++)
+			{
+				const auto& penalty = PEN[index_N(j,i)] ;
+				pen_uses_svm.set_element(penalty && penalty->uses_svm_values(), j, i) ;
+			}
+
+		// score of the best partial path per position, for the beam
+		std::vector<float64_t> best_delta(m_seq_len, -Math::INFTY) ;
+		for (T_STATES i=0; i<m_N; i++)
+			best_delta[0] = Math::max(best_delta[0], delta.element(delta_array, 0, i, 0, m_seq_len, m_N)) ;
+
 		SG_DEBUG("START_RECURSION ")
 
+		m_num_pruned_segments = 0 ;
+
+		// the states of a position only depend on earlier positions
+#pragma omp parallel
+		{
+		int64_t num_pruned = 0 ;
+		float64_t* thread_svm_value = SG_MALLOC(float64_t, num_svm_values) ;
+		for (int32_t s=0; s<num_svm_values; s++)
+			thread_svm_value[s]=0 ;
+		float64_t* fixedtempvv = SG_CALLOC(float64_t, look_back_buflen) ;
+		int32_t* fixedtempii = SG_CALLOC(int32_t, look_back_buflen) ;
+
 		// recursion
 		for (int32_t t=1; t<m_seq_len; t++)
 		{
-			for (T_STATES j=0; j<m_N; j++)
+#pragma omp for schedule(dynamic)
+			for (int32_t j=0; j<m_N; j++)
 			{
 				if (seq.element(j,t)<=-1e20)
 				{ // if we cannot observe the symbol here, then we can omit the rest
@@ -1480,6 +1500,13 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 							else
 								ok=false ;
 
+							// pruned search: skip segments that start far below the best path
+							if (ok && delta.element(delta_array, ts, ii, 0, m_seq_len, m_N) < best_delta[ts]-m_beam_width)
+							{
+								ok=false ;
+								num_pruned++ ;
+							}
+
 							if (ok)
 							{
 
@@ -1495,7 +1522,8 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 								////////////////////////////////////////////////////////
 
 								int32_t frame = orf_from;//m_orf_info.element(ii,0);
-								lookup_content_svm_values(ts, t, m_pos[ts], m_pos[t], svm_value, frame);
+								if (pen_uses_svm.element(j, ii))
+									lookup_content_svm_values(ts, t, m_pos[ts], m_pos[t], thread_svm_value, frame);
 
 								float64_t pen_val = 0.0 ;
 								if (penalty)
@@ -1503,7 +1531,7 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 #ifdef DYNPROG_TIMING_DETAIL
 									MyTime.start() ;
 #endif
-									pen_val = penalty->lookup_penalty(m_pos[t]-m_pos[ts], svm_value) ;
+									pen_val = penalty->lookup_penalty(m_pos[t]-m_pos[ts], thread_svm_value) ;
 
 #ifdef DYNPROG_TIMING_DETAIL
 									MyTime.stop() ;
@@ -1662,8 +1690,9 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 								if (penalty)
 								{
 									int32_t frame = m_orf_info.element(ii,0);
-									lookup_content_svm_values(start_5p_part, end_5p_part, m_pos[start_5p_part], m_pos[end_5p_part], svm_value, frame); // * t -> end_5p_part
-									pen_val = penalty->lookup_penalty(m_pos[end_5p_part]-m_pos[start_5p_part], svm_value) ;
+									if (pen_uses_svm.element(j, ii))
+										lookup_content_svm_values(start_5p_part, end_5p_part, m_pos[start_5p_part], m_pos[end_5p_part], thread_svm_value, frame); // * t -> end_5p_part
+									pen_val = penalty->lookup_penalty(m_pos[end_5p_part]-m_pos[start_5p_part], thread_svm_value) ;
 								}
 
 								/*if (m_pos[start_5p_part]==1003)
@@ -1758,8 +1787,9 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 								if (penalty)
 								{
 									int32_t frame = orf_from ; //m_orf_info.element(ii, 0);
-									lookup_content_svm_values(ts, t, m_pos[ts], m_pos[t], svm_value, frame);
-									pen_val_3p = penalty->lookup_penalty(m_pos[t]-m_pos[ts], svm_value) ;
+									if (pen_uses_svm.element(j, ii))
+										lookup_content_svm_values(ts, t, m_pos[ts], m_pos[t], thread_svm_value, frame);
+									pen_val_3p = penalty->lookup_penalty(m_pos[t]-m_pos[ts], thread_svm_value) ;
 								}
 
 								float64_t mval = -(long_transition_content_scores.get_element(ii, j) + pen_val_3p*0.5) ;
@@ -1880,7 +1910,20 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 					}
 				}
 			}
+
+#pragma omp single
+			for (T_STATES j=0; j<m_N; j++)
+				best_delta[t] = Math::max(best_delta[t], delta.element(delta_array, t, j, 0, m_seq_len, m_N)) ;
+		}
+
+#pragma omp atomic
+		m_num_pruned_segments += num_pruned ;
+
+		SG_FREE(thread_svm_value);
+		SG_FREE(fixedtempvv);
+		SG_FREE(fixedtempii);
 		}
+
 		{ //termination
 			int32_t list_len = 0 ;
 			for (int16_t diff=0; diff<nbest; diff++)
@@ -1954,10 +1997,45 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 		io::print("Timing:  orf={:1.2f} s \n Segment_init={:1.2f} s Segment_pos={:1.2f} s  Segment_extend={:1.2f} s Segment_clean={:1.2f} s\nsvm_init={:1.2f} s  svm_pos={:1.2f}  svm_clean={:1.2f}\n  content_svm_values_time={:1.2f}  content_plifs_time={:1.2f}\ninner_loop_max_time={:1.2f} inner_loop={:1.2f} long_transition_time={:1.2f}\n total={:1.2f}\n", orf_time, segment_init_time, segment_pos_time, segment_extend_time, segment_clean_time, svm_init_time, svm_pos_time, svm_clean_time, content_svm_values_time, content_plifs_time, inner_loop_max_time, inner_loop_time, long_transition_time, MyTime2.time_diff_sec());
 #endif
 
-		SG_FREE(fixedtempvv);
-		SG_FREE(fixedtempii);
 	}
 
+void DynProg::compute_nbest_paths_batch(
+	const std::vector<std::shared_ptr<DynProg>>& decoders,
+	int32_t max_num_signals, bool use_orf, int16_t nbest, bool with_loss)
+{
+	// fill the PLiF tables up front, so that decoders sharing a PlifMatrix
+	// only read them
+	for (const auto& decoder : decoders)
+	{
+		require(decoder, "Decoder must not be null");
+		require(decoder->m_plif_matrices, "Decoder has no PLiF matrices");
+		decoder->m_plif_matrices->init_plif_caches(decoder->m_genestr.get_dim1());
+	}
+
+	// exceptions must not leave the parallel region, the first one is
+	// rethrown after it
+	std::exception_ptr exception;
+
+	// sequences differ in length, dynamic scheduling balances them
+#pragma omp parallel for schedule(dynamic, 1)
+	for (index_t i=0; i<(index_t)decoders.size(); i++)
+	{
+		try
+		{
+			decoders[i]->compute_nbest_paths(
+				max_num_signals, use_orf, nbest, with_loss, false);
+		}
+		catch (...)
+		{
+#pragma omp critical (dynprog_batch)
+			if (!exception)
+				exception = std::current_exception();
+		}
+	}
+
+	if (exception)
+		std::rethrow_exception(exception);
+}
 
 void DynProg::best_path_trans_deriv(
 	int32_t *my_state_seq, int32_t *my_pos_seq,
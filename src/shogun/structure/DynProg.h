@@ -24,6 +24,8 @@
 #include <shogun/lib/DynamicArray.h>
 #include <shogun/lib/Time.h>
 
+#include <vector>
+
 
 namespace shogun
 {
@@ -256,6 +258,13 @@ public:
 
 
 	/** run the viterbi algorithm to compute the n best viterbi paths
+	 *
+	 * The states of a position are computed in parallel. Segment length
+	 * PLiFs without SVM values are tabulated beforehand, and the content
+	 * SVM values of a segment are only looked up for transitions whose
+	 * PLiF uses them. See set_beam_width() for a pruned search on long
+	 * sequences and compute_nbest_paths_batch() to decode many sequences
+	 * in parallel.
 	 *
 	 * @param max_num_signals maximal number of signals for a single state
 	 * @param use_orf whether orf shall be used
@@ -266,6 +275,25 @@ public:
 	void compute_nbest_paths(int32_t max_num_signals,
 						 bool use_orf, int16_t nbest, bool with_loss, bool with_multiple_sequences);
 
+	/** run compute_nbest_paths() on many sequences in parallel
+	 *
+	 * Every sequence is decoded by its own DynProg object, set up as for
+	 * compute_nbest_paths(), in one OpenMP task each; the states of a
+	 * sequence are then computed by a single thread. The objects may share
+	 * a PlifMatrix, its tables are filled for all sequences before decoding
+	 * starts. The first error of a decoder is rethrown once all sequences
+	 * are decoded.
+	 *
+	 * @param decoders one DynProg object per sequence
+	 * @param max_num_signals maximal number of signals for a single state
+	 * @param use_orf whether orf shall be used
+	 * @param nbest number of best paths (n)
+	 * @param with_loss use loss
+	 */
+	static void compute_nbest_paths_batch(
+		const std::vector<std::shared_ptr<DynProg>>& decoders,
+		int32_t max_num_signals, bool use_orf, int16_t nbest, bool with_loss);
+
 ////////////////////////////////////////////////////////////////////////////////
 
 	/** given a path though the state model and the corresponding
@@ -477,6 +505,33 @@ public:
 		//m_long_transition_max = max_len;
 	}
 
+	/** set the beam width of the pruned search. A segment is only
+	 * considered if the best partial path ending at its start
+	 * position and state is at most beam_width below the best partial
+	 * path ending at that position. The default, infinity, decodes
+	 * exactly.
+	 *
+	 * @param beam_width maximal score difference to the best partial path
+	 */
+	void set_beam_width(float64_t beam_width)
+	{
+		m_beam_width = beam_width;
+	}
+
+	/** @return beam width of the pruned search */
+	float64_t get_beam_width() const
+	{
+		return m_beam_width;
+	}
+
+	/** @return number of segments the last compute_nbest_paths() call
+	 * skipped because of the beam, see set_beam_width()
+	 */
+	int64_t get_num_pruned_segments() const
+	{
+		return m_num_pruned_segments;
+	}
+
 protected:
 
 	/* helper functions */
@@ -753,6 +808,10 @@ protected:
 	/** threshold for transitions that are computed
 	 *  the traditional way*/
 	int32_t m_long_transition_threshold  ;
+	/** beam width of the pruned search */
+	float64_t m_beam_width;
+	/** number of segments skipped by the pruned search */
+	int64_t m_num_pruned_segments;
 	/** maximal length of a long transition
 	 *  Note: is ignored in the current implementation
 	 *        => arbitrarily long transitions can be decoded
@@ -5,14 +5,43 @@
  */
 
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/structure/FWSOSVM.h>
+#include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGVector.h>
 
 using namespace shogun;
 
+// psi_i(y) := phi(x_i,y_i) - phi(x_i, y_pred)
+static SGVector<float64_t> joint_feature_difference(
+		const std::shared_ptr<ResultSet>& result, int32_t M,
+		const std::shared_ptr<StructuredModel>& model)
+{
+	SGVector<float64_t> psi_i(M);
+	if (result->psi_computed)
+	{
+		SGVector<float64_t>::add(psi_i.vector,
+			1.0, result->psi_truth.vector, -1.0, result->psi_pred.vector,
+			psi_i.vlen);
+	}
+	else if(result->psi_computed_sparse)
+	{
+		psi_i.zero();
+		result->psi_pred_sparse.add_to_dense(1.0, psi_i.vector, psi_i.vlen);
+		result->psi_truth_sparse.add_to_dense(-1.0, psi_i.vector, psi_i.vlen);
+	}
+	else
+	{
+		error("model({}) should have either of psi_computed or psi_computed_sparse"
+				"to be set true", model->get_name());
+	}
+
+	return psi_i;
+}
+
 FWSOSVM::FWSOSVM()
-: LinearStructuredOutputMachine()
+: RandomMixin<LinearStructuredOutputMachine>()
 {
 	init();
 }
@@ -22,7 +51,7 @@ FWSOSVM::FWSOSVM(
 		const std::shared_ptr<StructuredLabels>& labs,
 		bool do_line_search,
 		bool verbose)
-: LinearStructuredOutputMachine(model, labs)
+: RandomMixin<LinearStructuredOutputMachine>(model, labs)
 {
 	require(model != NULL && labs != NULL,
 		"{}::CFWSOSVM(): model and labels cannot be NULL!", get_name());
@@ -44,12 +73,15 @@ void FWSOSVM::init()
 	SG_ADD(&m_do_line_search, "do_line_search", "Do line search");
 	SG_ADD(&m_gap_threshold, "gap_threshold", "Gap threshold");
 	SG_ADD(&m_ell, "ell", "Average loss");
+	SG_ADD(&m_batch_size, "batch_size",
+		"Examples per block-coordinate step, 0 for batch Frank-Wolfe");
 
 	m_lambda = 1.0;
 	m_num_iter = 50;
 	m_do_line_search = true;
 	m_gap_threshold = 0.1;
 	m_ell = 0;
+	m_batch_size = 0;
 }
 
 FWSOSVM::~FWSOSVM()
@@ -93,6 +125,19 @@ bool FWSOSVM::train_machine(std::shared_ptr<Features> data)
 		m_helper = std::make_shared<SOSVMHelper>();
 	}
 
+	if (m_batch_size > 0)
+	{
+		train_block_coordinate(M, N);
+		if (m_verbose)
+			m_helper->terminate();
+
+		SG_TRACE("Leaving CFWSOSVM::train_machine.");
+		return true;
+	}
+
+	SGVector<int32_t> examples(N);
+	examples.range_fill();
+
 	// Main loop
 	int32_t k = 0;
 	SGVector<float64_t> w_s(M);
@@ -104,42 +149,22 @@ bool FWSOSVM::train_machine(std::shared_ptr<Features> data)
 		w_s.zero();
 		ell_s = 0;
 
+		// 1) solve the loss-augmented inference for all points
+		auto results = m_model->argmax_batch(m_w, examples);
+
 		for (int32_t si = 0; si < N; ++si)
 		{
-			// 1) solve the loss-augmented inference for point si
-			auto result = m_model->argmax(m_w, si);
-
 			// 2) get the subgradient
-			// psi_i(y) := phi(x_i,y_i) - phi(x_i, y_pred)
-			SGVector<float64_t> psi_i(M);
-			if (result->psi_computed)
-			{
-				SGVector<float64_t>::add(psi_i.vector,
-					1.0, result->psi_truth.vector, -1.0, result->psi_pred.vector,
-					psi_i.vlen);
-			}
-			else if(result->psi_computed_sparse)
-			{
-				psi_i.zero();
-				result->psi_pred_sparse.add_to_dense(1.0, psi_i.vector, psi_i.vlen);
-				result->psi_truth_sparse.add_to_dense(-1.0, psi_i.vector, psi_i.vlen);
-			}
-			else
-			{
-				error("model({}) should have either of psi_computed or psi_computed_sparse"
-						"to be set true", m_model->get_name());
-			}
+			SGVector<float64_t> psi_i =
+				joint_feature_difference(results[si], M, m_model);
 
 			// 3) loss_i = L(y_i, y_pred)
-			float64_t loss_i = result->delta;
+			float64_t loss_i = results[si]->delta;
 			ASSERT(loss_i - linalg::dot(m_w, psi_i) >= -1e-12);
 
 			// 4) update w_s and ell_s
 			linalg::add(w_s, psi_i, w_s);
 			ell_s += loss_i;
-
-
-
 		} // end si
 
 		w_s.scale(1.0 / (N*m_lambda));
@@ -200,6 +225,92 @@ bool FWSOSVM::train_machine(std::shared_ptr<Features> data)
 	return true;
 }
 
+void FWSOSVM::train_block_coordinate(int32_t M, int32_t N)
+{
+	// w and ell are the sums of the per-example blocks w_i and ell_i
+	SGMatrix<float64_t> w_blocks(M, N);
+	w_blocks.zero();
+	SGVector<float64_t> ell_blocks(N);
+	ell_blocks.zero();
+
+	SGVector<int32_t> order(N);
+	order.range_fill();
+
+	int32_t batch_size = Math::min(m_batch_size, N);
+	SGVector<float64_t> w_diff(M);
+	int64_t k = 0;
+	for (int32_t pi = 0; pi < m_num_iter; ++pi)
+	{
+		random::shuffle(order, m_prng);
+		float64_t dual_gap = 0;
+
+		for (int32_t start = 0; start < N; start += batch_size)
+		{
+			// 1) solve the loss-augmented inference for the mini-batch
+			int32_t end = Math::min(start + batch_size, N);
+			SGVector<int32_t> batch(end - start);
+			for (int32_t bi = 0; bi < batch.vlen; ++bi)
+				batch[bi] = order[start + bi];
+
+			auto results = m_model->argmax_batch(m_w, batch);
+
+			for (int32_t bi = 0; bi < batch.vlen; ++bi, ++k)
+			{
+				int32_t i = batch[bi];
+				SGVector<float64_t> w_i(w_blocks.get_column_vector(i), M, false);
+
+				// 2) corner of block i: w_s = psi_i/(lambda*N), ell_s = loss_i/N
+				SGVector<float64_t> w_s =
+					joint_feature_difference(results[bi], M, m_model);
+				w_s.scale(1.0 / (N*m_lambda));
+				float64_t ell_s = results[bi]->delta / N;
+
+				// 3) duality gap of block i
+				SGVector<float64_t>::add(w_diff.vector, 1.0, w_i.vector, -1.0, w_s.vector, M);
+				float64_t gap_i = m_lambda * linalg::dot(w_diff, m_w) - ell_blocks[i] + ell_s;
+				dual_gap += gap_i;
+
+				// 4) step-size gamma
+				float64_t gamma = 2.0*N / (k + 2.0*N);
+				if (m_do_line_search)
+				{
+					gamma = gap_i / (m_lambda * (linalg::dot(w_diff, w_diff) + 1e-12));
+					gamma = ((gamma > 1 ? 1 : gamma) < 0) ? 0 : gamma; // clip to [0,1]
+				}
+
+				// 5) update block i, and w and ell with it
+				SGVector<float64_t>::add(m_w.vector, 1.0, m_w.vector, -gamma, w_diff.vector, M);
+				SGVector<float64_t>::add(w_i.vector, 1.0, w_i.vector, -gamma, w_diff.vector, M);
+				float64_t ell_i = (1.0-gamma) * ell_blocks[i] + gamma * ell_s;
+				m_ell += ell_i - ell_blocks[i];
+				ell_blocks[i] = ell_i;
+			}
+		}
+
+		// Debug: compute primal and dual objectives and training error
+		if (m_verbose)
+		{
+			float64_t primal = SOSVMHelper::primal_objective(m_w, m_model, m_lambda);
+			float64_t dual = SOSVMHelper::dual_objective(m_w, m_ell, m_lambda);
+			float64_t train_error = SOSVMHelper::average_loss(m_w, m_model);
+
+			io::print("pass {}, primal = {}, dual = {}, duality gap = {}, train_error = {} \n",
+				pi, primal, dual, dual_gap, train_error);
+
+			m_helper->add_debug_info(primal, pi + 1.0, train_error, dual, dual_gap);
+		}
+
+		// 6) check the sum of the block gaps of the pass, each taken at the
+		// w of its block update
+		SG_DEBUG("pass {}, summed block gaps: {}.", pi, dual_gap);
+		if (dual_gap <= m_gap_threshold)
+		{
+			SG_DEBUG("Duality gap below threshold -- stopping!");
+			break;
+		}
+	}
+}
+
 float64_t FWSOSVM::get_lambda() const
 {
 	return m_lambda;
@@ -240,3 +351,14 @@ void FWSOSVM::set_ell(float64_t ell)
 	m_ell = ell;
 }
 
+int32_t FWSOSVM::get_batch_size() const
+{
+	return m_batch_size;
+}
+
+void FWSOSVM::set_batch_size(int32_t batch_size)
+{
+	require(batch_size >= 0, "Batch size ({}) must be non-negative", batch_size);
+	m_batch_size = batch_size;
+}
+
@@ -10,16 +10,26 @@
 #include <shogun/lib/config.h>
 
 #include <shogun/machine/LinearStructuredOutputMachine.h>
+#include <shogun/mathematics/RandomMixin.h>
 
 namespace shogun
 {
 
 /** @brief Class CFWSOSVM solves SOSVM using Frank-Wolfe algorithm [1].
+ *
+ * By default, every iteration is a batch Frank-Wolfe step over all
+ * examples. With set_batch_size(), the solver runs the block-coordinate
+ * variant of [1] on mini-batches instead: every pass visits the examples in
+ * random order, the loss-augmented inference of a mini-batch is solved
+ * concurrently at the current w (see StructuredModel::argmax_batch()), and
+ * the blocks of the mini-batch are then updated one after another with
+ * their own line search. The block updates only use slightly stale oracles,
+ * so larger batches trade a few more passes for more parallelism.
  *
  * [1] S. Lacoste-Julien, M. Jaggi, M. Schmidt and P. Pletscher. Block-Coordinate
  * Frank-Wolfe Optimization for Structural SVMs. ICML 2013.
  */
-class FWSOSVM : public LinearStructuredOutputMachine
+class FWSOSVM : public RandomMixin<LinearStructuredOutputMachine>
 {
 public:
 	/** default constructor */
@@ -83,6 +93,18 @@ public:
 	 */
 	void set_ell(float64_t ell);
 
+	/** @return number of examples per block-coordinate step, 0 for batch
+	 * Frank-Wolfe
+	 */
+	int32_t get_batch_size() const;
+
+	/** set the number of examples per block-coordinate step
+	 *
+	 * @param batch_size number of examples whose inference is solved
+	 * concurrently, 0 (default) for batch Frank-Wolfe
+	 */
+	void set_batch_size(int32_t batch_size);
+
 protected:
 	/** train primal SO-SVM
 	 *
@@ -95,6 +117,13 @@ private:
 	/** register and initialize parameters */
 	void init();
 
+	/** runs mini-batch block-coordinate Frank-Wolfe from w = 0
+	 *
+	 * @param M dimensionality of the joint feature space
+	 * @param N number of training examples
+	 */
+	void train_block_coordinate(int32_t M, int32_t N);
+
 private:
 	/** The regularization constant (default: 1/n) */
 	float64_t m_lambda;
@@ -111,6 +140,9 @@ private:
 	/** Average loss */
 	float64_t m_ell;
 
+	/** Examples per block-coordinate step, 0 for batch Frank-Wolfe */
+	int32_t m_batch_size;
+
 }; /* CFWSOSVM */
 
 } /* namespace shogun */
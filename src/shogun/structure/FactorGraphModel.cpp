@@ -372,6 +372,12 @@ std::shared_ptr<ResultSet> FactorGraphModel::argmax(SGVector<float64_t> w, int32
 	return ret;
 }
 
+void FactorGraphModel::init_parallel_argmax(SGVector<float64_t> w)
+{
+	// argmax() then finds m_w_cache up to date and does not write it
+	w_to_fparams(w);
+}
+
 float64_t FactorGraphModel::delta_loss(std::shared_ptr<StructuredData> y1, std::shared_ptr<StructuredData> y2)
 {
 	auto y_truth = y1->as<FactorGraphObservation>();
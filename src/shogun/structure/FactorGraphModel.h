@@ -165,6 +165,17 @@ private:
 	void add_map(const std::shared_ptr<FactorType>& ftype);
 
 protected:
+	/** argmax() only modifies the factor graph of its example once the
+	 * factor parameters are set
+	 */
+	virtual bool supports_parallel_argmax() const
+	{
+		return true;
+	}
+
+	/** sets the factor parameters from w once for all examples */
+	virtual void init_parallel_argmax(SGVector<float64_t> w);
+
 	/** array of factor types */
 	std::vector<std::shared_ptr<FactorType>> m_factor_types;
 
@@ -77,16 +77,21 @@ SGVector< float64_t > HMSVMModel::get_joint_feature_vector(
 
 	// Translate from labels sequence to state sequence
 	SGVector< int32_t > state_seq = m_state_model->labels_to_states(label_seq);
-	m_transmission_weights.zero();
+	// Local counts rather than the weight members, so that argmax may
+	// compute joint feature vectors of several examples concurrently
+	int32_t S = m_state_model->get_num_states();
+	SGMatrix< float64_t > transmission_weights(S,S);
+	transmission_weights.zero();
 
 	for ( int32_t i = 0 ; i < state_seq.vlen-1 ; ++i )
-		m_transmission_weights(state_seq[i],state_seq[i+1]) += 1;
+		transmission_weights(state_seq[i],state_seq[i+1]) += 1;
 
 	SGMatrix< float64_t > obs = mf->get_feature_vector(feat_idx);
 	require(obs.num_rows == D && obs.num_cols == state_seq.vlen,
 		"obs.num_rows ({}) != D ({}) OR obs.num_cols ({}) != state_seq.vlen ({})",
 		obs.num_rows, D, obs.num_cols, state_seq.vlen);
-	m_emission_weights.zero();
+	SGVector< float64_t > emission_weights(m_emission_weights.vlen);
+	emission_weights.zero();
 	index_t aux_idx, weight_idx;
 
 	if ( !m_use_plifs )	// Do not use PLiFs
@@ -98,17 +103,15 @@ SGVector< float64_t > HMSVMModel::get_joint_feature_vector(
 			for ( int32_t j = 0 ; j < state_seq.vlen ; ++j )
 			{
 				weight_idx = aux_idx + state_seq[j]*D*m_num_obs + obs(f,j);
-				m_emission_weights[weight_idx] += 1;
+				emission_weights[weight_idx] += 1;
 			}
 		}
 
-		m_state_model->weights_to_vector(psi, m_transmission_weights, m_emission_weights,
+		m_state_model->weights_to_vector(psi, transmission_weights, emission_weights,
 				D, m_num_obs);
 	}
 	else	// Use PLiFs
 	{
-		int32_t S = m_state_model->get_num_states();
-
 		for ( int32_t f = 0 ; f < D ; ++f )
 		{
 			aux_idx = f*m_num_plif_nodes;
@@ -133,15 +136,15 @@ SGVector< float64_t > HMSVMModel::get_joint_feature_vector(
 				weight_idx = aux_idx + state_seq[j]*D*m_num_plif_nodes;
 
 				if ( count == 0 )
-					m_emission_weights[weight_idx] += 1;
+					emission_weights[weight_idx] += 1;
 				else if ( count == m_num_plif_nodes )
-					m_emission_weights[weight_idx + m_num_plif_nodes-1] += 1;
+					emission_weights[weight_idx + m_num_plif_nodes-1] += 1;
 				else
 				{
-					m_emission_weights[weight_idx + count] +=
+					emission_weights[weight_idx + count] +=
 						(value-limits[count-1]) / (limits[count]-limits[count-1]);
 
-					m_emission_weights[weight_idx + count-1] +=
+					emission_weights[weight_idx + count-1] +=
 						(limits[count]-value) / (limits[count]-limits[count-1]);
 				}
 
@@ -149,7 +152,7 @@ SGVector< float64_t > HMSVMModel::get_joint_feature_vector(
 			}
 		}
 
-		m_state_model->weights_to_vector(psi, m_transmission_weights, m_emission_weights,
+		m_state_model->weights_to_vector(psi, transmission_weights, emission_weights,
 				D, m_num_plif_nodes);
 	}
 
@@ -192,7 +195,8 @@ std::shared_ptr<ResultSet> HMSVMModel::argmax(
 	if ( !m_use_plifs )	// Do not use PLiFs
 	{
 		index_t em_idx;
-		m_state_model->reshape_emission_params(m_emission_weights, w, D, m_num_obs);
+		if ( !m_parallel_argmax )
+			m_state_model->reshape_emission_params(m_emission_weights, w, D, m_num_obs);
 
 		for ( int32_t i = 0 ; i < T ; ++i )
 		{
@@ -208,7 +212,8 @@ std::shared_ptr<ResultSet> HMSVMModel::argmax(
 	}
 	else	// Use PLiFs
 	{
-		m_state_model->reshape_emission_params(m_plif_matrix, w, D, m_num_plif_nodes);
+		if ( !m_parallel_argmax )
+			m_state_model->reshape_emission_params(m_plif_matrix, w, D, m_num_plif_nodes);
 
 		for ( int32_t i = 0 ; i < T ; ++i )
 		{
@@ -248,7 +253,8 @@ std::shared_ptr<ResultSet> HMSVMModel::argmax(
 	// Initialize the dynamic programming table and the traceback matrix
 	SGMatrix< float64_t >  dp(T, S);
 	SGMatrix< float64_t > trb(T, S);
-	m_state_model->reshape_transmission_params(m_transmission_weights, w);
+	if ( !m_parallel_argmax )
+		m_state_model->reshape_transmission_params(m_transmission_weights, w);
 
 	for ( int32_t s = 0 ; s < S ; ++s )
 	{
@@ -481,6 +487,27 @@ bool HMSVMModel::check_training_setup() const
 	return true;
 }
 
+void HMSVMModel::init_parallel_argmax(SGVector< float64_t > w)
+{
+	ASSERT(w.vlen == get_dim())
+
+	auto mf = m_features->as<MatrixFeatures<float64_t>>();
+	int32_t D = mf->get_num_features();
+
+	if ( m_use_plifs )
+		m_state_model->reshape_emission_params(m_plif_matrix, w, D, m_num_plif_nodes);
+	else
+		m_state_model->reshape_emission_params(m_emission_weights, w, D, m_num_obs);
+
+	m_state_model->reshape_transmission_params(m_transmission_weights, w);
+	m_parallel_argmax = true;
+}
+
+void HMSVMModel::finish_parallel_argmax()
+{
+	m_parallel_argmax = false;
+}
+
 void HMSVMModel::init()
 {
 	SG_ADD((std::shared_ptr<SGObject>*) &m_state_model, "m_state_model", "The state model");
@@ -510,6 +537,7 @@ void HMSVMModel::init()
 	m_num_obs = 0;
 	m_num_aux = 0;
 	m_use_plifs = false;
+	m_parallel_argmax = false;
 	m_state_model = NULL;
 	m_plif_matrix.clear();
 	m_num_plif_nodes = 0;
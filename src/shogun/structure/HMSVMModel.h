@@ -168,6 +168,21 @@ class HMSVMModel : public StructuredModel
 		 */
 		virtual const char* get_name() const { return "HMSVMModel"; }
 
+	protected:
+		/** argmax() only reads the model once the weights are reshaped */
+		virtual bool supports_parallel_argmax() const
+		{
+			return true;
+		}
+
+		/** reshapes the transmission and emission weights from w once for
+		 * all examples
+		 */
+		virtual void init_parallel_argmax(SGVector< float64_t > w);
+
+		/** lets argmax() reshape the weights again */
+		virtual void finish_parallel_argmax();
+
 	private:
 		/* internal initialization */
 		void init();
@@ -199,6 +214,9 @@ class HMSVMModel : public StructuredModel
 
 		/** whether to use PLiFs. Otherwise, the observations must be discrete and finite */
 		bool m_use_plifs;
+
+		/** whether the weights are reshaped by init_parallel_argmax() */
+		bool m_parallel_argmax;
 }; /* class CHMSVMModel */
 
 } /* namespace shogun */
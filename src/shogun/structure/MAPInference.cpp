@@ -41,8 +41,7 @@ MAPInference::MAPInference(std::shared_ptr<FactorGraph> fg, EMAPInferType infere
 			m_infer_impl = std::make_shared<GEMPLP>(fg);
 			break;
 		case LOOPY_MAX_PROD:
-			error("{}::MAPInference(): LoopyMaxProduct has not been implemented!",
-				get_name());
+			m_infer_impl = std::make_shared<LoopyMaxProduct>(fg);
 			break;
 		case LP_RELAXATION:
 			error("{}::MAPInference(): LPRelaxation has not been implemented!",
@@ -73,7 +73,10 @@ std::shared_ptr<ResultSet> MulticlassModel::argmax(
 	if ( training )
 	{
 		auto ml = m_labels->as<MulticlassSOLabels>();
-		m_num_classes = ml->get_num_classes();
+		// only written when it changes, so that concurrent calls just read
+		int32_t num_classes = ml->get_num_classes();
+		if ( m_num_classes != num_classes )
+			m_num_classes = num_classes;
 	}
 	else
 	{
@@ -163,6 +166,12 @@ void MulticlassModel::init_primal_opt(
 	C = SGMatrix< float64_t >::create_identity_matrix(get_dim(), regularization);
 }
 
+void MulticlassModel::init_parallel_argmax(SGVector< float64_t > w)
+{
+	if ( m_labels )
+		m_num_classes = m_labels->as<MulticlassSOLabels>()->get_num_classes();
+}
+
 void MulticlassModel::init()
 {
 	SG_ADD(&m_num_classes, "m_num_classes", "The number of classes");
@@ -106,6 +106,20 @@ class MulticlassModel : public StructuredModel
 		/** @return name of SGSerializable */
 		virtual const char* get_name() const { return "MulticlassModel"; }
 
+	protected:
+		/** argmax() only reads the model, see init_parallel_argmax() */
+		virtual bool supports_parallel_argmax() const
+		{
+			return true;
+		}
+
+		/** takes the number of classes from the labels before the
+		 * concurrent argmax() calls
+		 *
+		 * @param w weight vector
+		 */
+		virtual void init_parallel_argmax(SGVector< float64_t > w);
+
 	private:
 		void init();
 
@@ -12,6 +12,8 @@
 #include <shogun/structure/Plif.h>
 #include <shogun/lib/memory.h>
 
+#include <algorithm>
+
 //#define PLIF_DEBUG
 
 using namespace shogun;
@@ -90,6 +92,16 @@ void Plif::init_penalty_struct_cache()
 	this->cache=local_cache ;
 }
 
+int32_t Plif::find_interval(float64_t d_value) const
+{
+	// comparing with <= keeps NaN values in the first interval
+	const float64_t* end = std::partition_point(
+		limits.vector, limits.vector+len,
+		[d_value](float64_t limit) { return limit<=d_value; });
+
+	return end-limits.vector;
+}
+
 void Plif::set_plif_name(char *p_name)
 {
 	SG_FREE(name);
@@ -147,13 +159,8 @@ float64_t Plif::lookup_penalty_svm(
 		break ;
 	}
 
-	int32_t idx = 0 ;
+	int32_t idx = find_interval(d_value) ;
 	float64_t ret ;
-	for (int32_t i=0; i<len; i++)
-		if (limits[i]<=d_value)
-			idx++ ;
-		else
-			break ; // assume it is monotonically increasing
 
 #ifdef PLIF_DEBUG
 	io::print("  -> idx = {} ", idx);
@@ -243,13 +250,8 @@ float64_t Plif::lookup_penalty(float64_t p_value, float64_t* svm_values) const
 	io::print("  -> value = {:1.4f} ", d_value);
 #endif
 
-	int32_t idx = 0 ;
+	int32_t idx = find_interval(d_value) ;
 	float64_t ret ;
-	for (int32_t i=0; i<len; i++)
-		if (limits[i]<=d_value)
-			idx++ ;
-		else
-			break ; // assume it is monotonically increasing
 
 #ifdef PLIF_DEBUG
 	io::print("  -> idx = {} ", idx);
@@ -316,12 +318,7 @@ void Plif::penalty_add_derivative(float64_t p_value, float64_t* svm_values, floa
 		break ;
 	}
 
-	int32_t idx = 0 ;
-	for (int32_t i=0; i<len; i++)
-		if (limits[i]<=d_value)
-			idx++ ;
-		else
-			break ; // assume it is monotonically increasing
+	int32_t idx = find_interval(d_value) ;
 
 	if (idx==0)
 		cum_derivatives[0]+= factor ;
@@ -363,12 +360,7 @@ void Plif::penalty_add_derivative_svm(float64_t p_value, float64_t *d_values, fl
 		break ;
 	}
 
-	int32_t idx = 0 ;
-	for (int32_t i=0; i<len; i++)
-		if (limits[i]<=d_value)
-			idx++ ;
-		else
-			break ; // assume it is monotonically increasing
+	int32_t idx = find_interval(d_value) ;
 
 	if (idx==0)
 		cum_derivatives[0]+=factor ;
@@ -417,6 +417,13 @@ class Plif: public PlifBase
 		virtual const char* get_name() const { return "Plif"; }
 
 	protected:
+		/** @return number of limits less than or equal to d_value, found
+		 * by binary search since the limits increase monotonically
+		 *
+		 * @param d_value transformed value
+		 */
+		int32_t find_interval(float64_t d_value) const;
+
 		/** len */
 		int32_t len;
 		/** limits */
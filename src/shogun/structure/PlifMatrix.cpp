@@ -81,6 +81,19 @@ void PlifMatrix::set_plif_use_cache(SGVector<bool> use_cache)
 	}
 }
 
+void PlifMatrix::init_plif_caches(int32_t max_length)
+{
+	for (auto& plif : m_PEN)
+	{
+		// only PLiFs that were asked to cache, see set_plif_use_cache()
+		if (!plif || !plif->get_use_cache() || plif->uses_svm_values() ||
+		    plif->get_max_value()>max_length)
+			continue;
+
+		plif->init_penalty_struct_cache();
+	}
+}
+
 void PlifMatrix::set_plif_use_svm(SGVector<int32_t> use_svm)
 {
 	if (use_svm.vlen!=m_num_plifs)
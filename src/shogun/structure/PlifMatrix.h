@@ -108,6 +108,16 @@ class PlifMatrix: public SGObject
 		 */
 		void set_plif_use_cache(SGVector<bool> use_cache);
 
+		/** builds the lookup tables of the PLiFs that have caching
+		 * enabled and do not use SVM values, so that integer lookups
+		 * (e.g. of segment lengths) are table reads, see
+		 * Plif::init_penalty_struct_cache()
+		 *
+		 * @param max_length only PLiFs with a maximal value up to
+		 * max_length are tabulated
+		 */
+		void init_plif_caches(int32_t max_length);
+
 		/** set plif use svm
 		 *
 		 * @param use_svm use svm
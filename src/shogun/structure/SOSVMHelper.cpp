@@ -56,21 +56,20 @@ float64_t SOSVMHelper::primal_objective(SGVector<float64_t> w, const std::shared
 	auto labels = model->get_labels();
 	int32_t N = labels->get_num_labels();
 
+	// solve the loss-augmented inference for all points
+	SGVector<int32_t> examples(N);
+	examples.range_fill();
+	auto results = model->argmax_batch(w, examples);
 
 	for (int32_t i = 0; i < N; i++)
 	{
-		// solve the loss-augmented inference for point i
-		auto result = model->argmax(w, i);
-
 		// hinge loss for point i
-		float64_t hinge_loss_i = result->score;
+		float64_t hinge_loss_i = results[i]->score;
 
 		if (hinge_loss_i < 0)
 			hinge_loss_i = 0;
 
 		hinge_losses += hinge_loss_i;
-
-
 	}
 
 	return (lbda/2 * linalg::dot(w, w) + hinge_losses/N);
@@ -87,16 +86,13 @@ float64_t SOSVMHelper::average_loss(SGVector<float64_t> w, const std::shared_ptr
 	auto labels = model->get_labels();
 	int32_t N = labels->get_num_labels();
 
+	// solve the standard inference for all points
+	SGVector<int32_t> examples(N);
+	examples.range_fill();
+	auto results = model->argmax_batch(w, examples, is_ub);
 
 	for (int32_t i = 0; i < N; i++)
-	{
-		// solve the standard inference for point i
-		auto result = model->argmax(w, i, is_ub);
-
-		loss += result->delta;
-
-
-	}
+		loss += results[i]->delta;
 
 	return loss / N;
 }
@@ -7,6 +7,7 @@
 
 #include <shogun/structure/StructuredModel.h>
 
+#include <exception>
 #include <utility>
 
 using namespace shogun;
@@ -164,6 +165,54 @@ void StructuredModel::init()
 	m_labels   = NULL;
 }
 
+std::vector<std::shared_ptr<ResultSet>> StructuredModel::argmax_batch(
+		SGVector< float64_t > w, SGVector< int32_t > feat_idx,
+		bool const training)
+{
+	std::vector<std::shared_ptr<ResultSet>> results(feat_idx.vlen);
+	if (feat_idx.vlen < 2 || !supports_parallel_argmax())
+	{
+		for (index_t i = 0; i < feat_idx.vlen; ++i)
+			results[i] = argmax(w, feat_idx[i], training);
+
+		return results;
+	}
+
+	init_parallel_argmax(w);
+
+	// leaves the parallel state also if an argmax throws
+	struct ParallelArgmaxGuard
+	{
+		StructuredModel* model;
+		~ParallelArgmaxGuard() { model->finish_parallel_argmax(); }
+	} guard{this};
+
+	// exceptions must not leave the parallel region, the first one is
+	// rethrown after it
+	std::exception_ptr exception;
+
+	// inference time varies between examples, e.g. with the sequence length
+#pragma omp parallel for schedule(dynamic, 1)
+	for (index_t i = 0; i < feat_idx.vlen; ++i)
+	{
+		try
+		{
+			results[i] = argmax(w, feat_idx[i], training);
+		}
+		catch (...)
+		{
+#pragma omp critical (structured_model_argmax_batch)
+			if (!exception)
+				exception = std::current_exception();
+		}
+	}
+
+	if (exception)
+		std::rethrow_exception(exception);
+
+	return results;
+}
+
 void StructuredModel::init_training()
 {
 	// Nothing to do here
@@ -21,6 +21,8 @@
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/lib/StructuredData.h>
 
+#include <vector>
+
 namespace shogun
 {
 
@@ -236,6 +238,22 @@ class StructuredModel : public SGObject
 		 */
 		virtual std::shared_ptr<ResultSet> argmax(SGVector< float64_t > w, int32_t feat_idx, bool const training = true) = 0;
 
+		/**
+		 * obtains the argmax of several feature vectors, see argmax(). If
+		 * the model supports it, the examples are evaluated in parallel at
+		 * the same w. The indices in feat_idx must be distinct.
+		 *
+		 * @param w weight vector
+		 * @param feat_idx indices of the features to compute the argmax
+		 * @param training true if argmax is called during training
+		 *
+		 * @return structures with the predicted outputs, in the order of
+		 * feat_idx
+		 */
+		virtual std::vector<std::shared_ptr<ResultSet>> argmax_batch(
+				SGVector< float64_t > w, SGVector< int32_t > feat_idx,
+				bool const training = true);
+
 		/** computes \f$ \Delta(y_{\text{true}}, y_{\text{pred}}) \f$
 		 *
 		 * @param ytrue_idx index of the true label in labels
@@ -299,6 +317,30 @@ class StructuredModel : public SGObject
 		void init();
 
 	protected:
+		/** whether argmax() of different examples may run concurrently
+		 * between init_parallel_argmax() and finish_parallel_argmax().
+		 * False by default, re-implement in thread-safe models.
+		 */
+		virtual bool supports_parallel_argmax() const
+		{
+			return false;
+		}
+
+		/** prepares the shared state of the model for concurrent argmax()
+		 * calls at w, e.g. by updating parameters argmax() would otherwise
+		 * update on every call
+		 *
+		 * @param w weight vector of the following argmax() calls
+		 */
+		virtual void init_parallel_argmax(SGVector< float64_t > w)
+		{
+		}
+
+		/** releases the state of init_parallel_argmax() */
+		virtual void finish_parallel_argmax()
+		{
+		}
+
 		/** structured labels */
 		std::shared_ptr<StructuredLabels> m_labels;
 
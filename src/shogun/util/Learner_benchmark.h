@@ -0,0 +1,161 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef _LEARNER_BENCHMARK_H_
+#define _LEARNER_BENCHMARK_H_
+
+#include <benchmark/benchmark.h>
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/features/DataGenerator.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/labels/RegressionLabels.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace shogun
+{
+
+/** Seed of the synthetic data, fixed so that runs are comparable */
+static constexpr int32_t LEARNER_BENCHMARK_SEED = 42;
+
+/** Resets the peak resident set size of the process to its current resident
+ * set size, see proc(5) on /proc/self/clear_refs.
+ *
+ * @return whether the peak was reset, false on platforms other than Linux
+ */
+static bool learner_benchmark_reset_peak_memory()
+{
+#ifdef __linux__
+	std::ofstream clear_refs("/proc/self/clear_refs");
+	clear_refs << "5";
+	clear_refs.close();
+	return !clear_refs.fail();
+#else
+	return false;
+#endif
+}
+
+/** @return peak resident set size in megabytes since the last
+ * learner_benchmark_reset_peak_memory, or 0 if it is not available.
+ */
+static float64_t learner_benchmark_peak_memory_mb()
+{
+#ifdef __linux__
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line))
+	{
+		// VmHWM:	  123456 kB
+		if (line.compare(0, 6, "VmHWM:") == 0)
+			return std::strtod(line.c_str() + 6, nullptr) / 1024.0;
+	}
+#endif
+	return 0;
+}
+
+/** Registers the (vectors, dims, threads) grid of a learner benchmark.
+ * Number of vectors goes from 512 to MaxVectors in steps of 4.
+ */
+template <int64_t MaxVectors>
+void learner_benchmark_args(benchmark::internal::Benchmark* b)
+{
+	b->ArgNames({"vectors", "dims", "threads"});
+	for (int64_t num_vectors = 512; num_vectors <= MaxVectors; num_vectors *= 4)
+		for (int64_t num_dims : {16, 64})
+			for (int64_t num_threads : {1, 4})
+				b->Args({num_vectors, num_dims, num_threads});
+}
+
+/** @brief Fixture of the end-to-end learner benchmarks.
+ *
+ * Generates NUM_CLASSES Gaussian blobs with DataGenerator::generate_gaussians
+ * and derives binary (class parity), multiclass and regression labels from
+ * them. The benchmark arguments are (vectors, dims, threads), see
+ * learner_benchmark_args. The number of threads is set globally for the
+ * duration of the benchmark.
+ *
+ * The peak memory is reset in SetUp, so every run of a benchmark reports its
+ * own peak including its data rather than the peak of the whole process.
+ */
+class LearnerFixture : public benchmark::Fixture
+{
+public:
+	static constexpr index_t NUM_CLASSES = 4;
+
+	void SetUp(const ::benchmark::State& st)
+	{
+		m_old_num_threads = env()->get_num_threads();
+		env()->set_num_threads(st.range(2));
+		m_peak_memory_reset = learner_benchmark_reset_peak_memory();
+
+		std::mt19937_64 prng(LEARNER_BENCHMARK_SEED);
+		auto per_class = st.range(0) / NUM_CLASSES;
+		auto data = DataGenerator::generate_gaussians(
+		    per_class, NUM_CLASSES, st.range(1), prng);
+		num_vectors = data.num_cols;
+
+		SGVector<float64_t> binary(num_vectors);
+		SGVector<float64_t> multiclass(num_vectors);
+		SGVector<float64_t> regression(num_vectors);
+		std::normal_distribution<float64_t> noise(0, 0.1);
+		for (index_t i = 0; i < num_vectors; ++i)
+		{
+			auto label = i / per_class;
+			binary[i] = label % 2 ? 1 : -1;
+			multiclass[i] = label;
+			regression[i] = data(0, i) + noise(prng);
+		}
+
+		features = std::make_shared<DenseFeatures<float64_t>>(data);
+		binary_labels = std::make_shared<BinaryLabels>(binary);
+		multiclass_labels = std::make_shared<MulticlassLabels>(multiclass);
+		regression_labels = std::make_shared<RegressionLabels>(regression);
+	}
+
+	void TearDown(const ::benchmark::State&)
+	{
+		features.reset();
+		binary_labels.reset();
+		multiclass_labels.reset();
+		regression_labels.reset();
+		env()->set_num_threads(m_old_num_threads);
+	}
+
+	/** Reports throughput as processed vectors per second and the peak
+	 * memory of the benchmark, the latter only where it can be measured
+	 * per benchmark.
+	 */
+	void report(benchmark::State& state) const
+	{
+		state.SetItemsProcessed(state.iterations() * num_vectors);
+		if (m_peak_memory_reset)
+			state.counters["peak_rss_mb"] = learner_benchmark_peak_memory_mb();
+	}
+
+	index_t num_vectors;
+	std::shared_ptr<DenseFeatures<float64_t>> features;
+	std::shared_ptr<BinaryLabels> binary_labels;
+	std::shared_ptr<MulticlassLabels> multiclass_labels;
+	std::shared_ptr<RegressionLabels> regression_labels;
+
+private:
+	int32_t m_old_num_threads;
+	bool m_peak_memory_reset;
+};
+
+#define LEARNER_BENCHMARK(NAME, MAX_VECTORS)                                   \
+	BENCHMARK_REGISTER_F(LearnerFixture, NAME)                                 \
+	    ->Apply(learner_benchmark_args<MAX_VECTORS>)                           \
+	    ->Unit(benchmark::kMillisecond)                                        \
+	    ->UseRealTime()
+
+}
+
+#endif /* _LEARNER_BENCHMARK_H_ */
@@ -146,6 +146,23 @@ namespace shogun
 		}
 	}
 
+	BENCHMARK_DEFINE_F(DataFixture, perceptron_with_handle)(benchmark::State& st)
+	{
+		for (auto _ : st)
+		{
+			st.PauseTiming();
+			auto perceptron = std::make_shared<MockPerceptron>();
+			auto w = perceptron->get_parameter_handle(
+			    Tag<SGVector<float64_t>>("w"));
+			std::function<void()> callback = [&perceptron, &w]() {
+				w.put(perceptron->weights);
+			};
+			perceptron->m_callback = callback;
+			st.ResumeTiming();
+			perceptron->train(feats, labels);
+		}
+	}
+
 	BENCHMARK_REGISTER_F(DataFixture, perceptron_baseline)
 	    ->Ranges(
 	        {
@@ -163,5 +180,13 @@ namespace shogun
 	            {8 << 5, 8 << 8} // range for number of feature vectors
 	        })
 	    ->Unit(benchmark::kMillisecond);
-}
 
+	BENCHMARK_REGISTER_F(DataFixture, perceptron_with_handle)
+	    ->Ranges(
+	        {
+	            {8, 1 << 8} // range for dimensions of feature vector
+	            ,
+	            {8 << 5, 8 << 8} // range for number of feature vectors
+	        })
+	    ->Unit(benchmark::kMillisecond);
+}
@@ -565,6 +565,37 @@ TEST(SGObject, unsubscribe_observer_failure)
 	EXPECT_THROW(obj->unsubscribe(param_obs_not_in), ShogunException);
 }
 
+TEST(SGObject, parameter_handle)
+{
+	auto obj = std::make_shared<MockObject>();
+
+	auto watched = obj->get_parameter_handle(Tag<int32_t>("watched_int"));
+	EXPECT_TRUE(watched.is_direct());
+	watched.put(89);
+	EXPECT_EQ(obj->get_watched(), 89);
+	EXPECT_EQ(obj->get<int32_t>("watched_int"), 89);
+	obj->set_watched(12);
+	EXPECT_EQ(watched.get(), 12);
+
+	auto owned = obj->get_parameter_handle(Tag<int32_t>("int"));
+	EXPECT_FALSE(owned.is_direct());
+	owned.put(10);
+	EXPECT_EQ(owned.get(), 10);
+	EXPECT_EQ(obj->get<int32_t>("int"), 10);
+
+	auto constrained =
+	    obj->get_parameter_handle(Tag<int32_t>("constrained_parameter"));
+	EXPECT_FALSE(constrained.is_direct());
+	EXPECT_THROW(constrained.put(10), ShogunException);
+	EXPECT_EQ(constrained.get(), 1);
+
+	EXPECT_THROW(
+	    obj->get_parameter_handle(Tag<int32_t>("foo")), ShogunException);
+	EXPECT_THROW(
+	    obj->get_parameter_handle(Tag<float64_t>("watched_int")),
+	    ShogunException);
+}
+
 TEST(SGObject, constrained_parameter)
 {
     auto obj = std::make_shared<MockObject>();
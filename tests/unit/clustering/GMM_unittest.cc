@@ -0,0 +1,62 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/clustering/GMM.h>
+#include <shogun/features/DenseFeatures.h>
+
+#include <random>
+
+using namespace shogun;
+
+TEST(GMM, float32_features)
+{
+	// two clusters around (0,0) and (10,5), with values that are exact in
+	// float32
+	const index_t num_vectors=100;
+	std::mt19937_64 prng(5);
+	std::normal_distribution<float32_t> normal;
+	SGMatrix<float32_t> data32(2, num_vectors);
+	SGMatrix<float64_t> data64(2, num_vectors);
+	for (index_t i=0; i<num_vectors; ++i)
+	{
+		data32(0, i)=normal(prng)+(i%2 ? 10 : 0);
+		data32(1, i)=normal(prng)+(i%2 ? 5 : 0);
+		data64(0, i)=data32(0, i);
+		data64(1, i)=data32(1, i);
+	}
+
+	auto train=[](const std::shared_ptr<Features>& features)
+	{
+		auto gmm=std::make_shared<GMM>(2, FULL);
+		gmm->put("seed", 7);
+		gmm->train(features);
+		gmm->train_em(1e-9, 100, 1e-9);
+		return gmm;
+	};
+	auto gmm32=train(std::make_shared<DenseFeatures<float32_t>>(data32));
+	auto gmm64=train(std::make_shared<DenseFeatures<float64_t>>(data64));
+
+	for (int32_t k=0; k<2; ++k)
+	{
+		EXPECT_NEAR(gmm32->get_coef()[k], gmm64->get_coef()[k], 1e-8);
+		auto mean32=gmm32->get_nth_mean(k);
+		auto mean64=gmm64->get_nth_mean(k);
+		auto cov32=gmm32->get_nth_cov(k);
+		auto cov64=gmm64->get_nth_cov(k);
+		for (index_t j=0; j<2; ++j)
+		{
+			EXPECT_NEAR(mean32[j], mean64[j], 1e-8);
+			for (index_t l=0; l<2; ++l)
+				EXPECT_NEAR(cov32(j, l), cov64(j, l), 1e-8);
+		}
+	}
+
+	for (index_t i=0; i<num_vectors; ++i)
+	{
+		EXPECT_NEAR(
+		    gmm32->get_likelihood_example(i), gmm64->get_likelihood_example(i),
+		    1e-10);
+	}
+}
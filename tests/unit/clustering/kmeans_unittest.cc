@@ -293,3 +293,41 @@ TEST(KMeans, random_centers_assign)
 
 }
 
+
+TEST(KMeans, float32_features)
+{
+	/*create a rectangle with four points as (0,0) (0,10) (20,0) (20,10)*/
+	SGMatrix<float32_t> rect(2, 4);
+	rect(0,0)=0;
+	rect(1,0)=0;
+	rect(0,1)=0;
+	rect(1,1)=10;
+	rect(0,2)=20;
+	rect(1,2)=0;
+	rect(0,3)=20;
+	rect(1,3)=10;
+
+	SGMatrix<float64_t> initial_centers(2,2);
+	initial_centers(0,0)=0;
+	initial_centers(1,0)=4;
+	initial_centers(0,1)=20;
+	initial_centers(1,1)=4;
+
+	auto features=std::make_shared<DenseFeatures<float32_t>>(rect);
+	auto distance=std::make_shared<EuclideanDistance>(features, features);
+	auto clustering=std::make_shared<KMeans>(2, distance, initial_centers);
+
+	clustering->train(features);
+	auto c=clustering->get_cluster_centers();
+
+	EXPECT_NEAR(c(0,0), 0.0, 10E-12);
+	EXPECT_NEAR(c(1,0), 5.0, 10E-12);
+	EXPECT_NEAR(c(0,1), 20.0, 10E-12);
+	EXPECT_NEAR(c(1,1), 5.0, 10E-12);
+
+	auto result=clustering->apply(features)->as<MulticlassLabels>();
+	EXPECT_EQ(0.0, result->get_label(0));
+	EXPECT_EQ(0.0, result->get_label(1));
+	EXPECT_EQ(1.0, result->get_label(2));
+	EXPECT_EQ(1.0, result->get_label(3));
+}
@@ -68,6 +68,35 @@ TEST(IsomapTest,DISABLED_distance_preserving_max_k)
 }
 #endif // HAVE_LAPACK
 
+TEST(IsomapTest,neighbors_methods_same_embedding)
+{
+	std::mt19937_64 prng(7);
+	auto features = std::make_shared<DenseFeatures<float64_t>>(
+		DataGenerator::generate_gaussians(20, 3, 3, prng));
+	auto distance = std::make_shared<EuclideanDistance>(features, features);
+
+	auto embed = [&](EEmbeddingNeighborsMethod method) {
+		auto isomap = std::make_shared<Isomap>();
+		isomap->set_target_dim(2);
+		isomap->set_k(8);
+		isomap->set_eigen_method(EMBEDDING_EIGEN_DENSE);
+		isomap->set_neighbors_method(method);
+		return isomap->embed_distance(distance)->get_feature_matrix();
+	};
+
+	auto brute_force = embed(EMBEDDING_NEIGHBORS_BRUTE_FORCE);
+	auto vp_tree = embed(EMBEDDING_NEIGHBORS_VP_TREE);
+
+	// eigenvectors are unique up to their sign
+	ASSERT_EQ(brute_force.num_rows, vp_tree.num_rows);
+	ASSERT_EQ(brute_force.num_cols, vp_tree.num_cols);
+	for (index_t i=0; i<brute_force.num_rows; i++)
+	{
+		for (index_t j=0; j<brute_force.num_cols; j++)
+			EXPECT_NEAR(std::abs(brute_force(i,j)), std::abs(vp_tree(i,j)), 1e-6);
+	}
+}
+
 struct index_and_distance_struct
 {
 	float64_t distance;
@@ -0,0 +1,49 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/converter/LaplacianEigenmaps.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/features/DataGenerator.h>
+#include <shogun/features/DenseFeatures.h>
+
+#include <random>
+
+using namespace shogun;
+
+TEST(LaplacianEigenmapsTest, randomized_same_as_dense)
+{
+	std::mt19937_64 prng(5);
+	auto features = std::make_shared<DenseFeatures<float64_t>>(
+	    DataGenerator::generate_gaussians(60, 1, 3, prng));
+	auto distance = std::make_shared<EuclideanDistance>(features, features);
+
+	auto embed = [&](EEmbeddingEigenMethod method) {
+		auto converter = std::make_shared<LaplacianEigenmaps>();
+		converter->set_target_dim(2);
+		converter->set_k(10);
+		converter->set_tau(4.0);
+		converter->set_eigen_method(method);
+		return converter->embed_distance(distance)->get_feature_matrix();
+	};
+
+	auto dense = embed(EMBEDDING_EIGEN_DENSE);
+	auto randomized = embed(EMBEDDING_EIGEN_RANDOMIZED);
+
+	// generalized eigenvectors are unique up to scale and sign
+	ASSERT_EQ(randomized.num_rows, dense.num_rows);
+	ASSERT_EQ(randomized.num_cols, dense.num_cols);
+	for (index_t i = 0; i < dense.num_rows; ++i)
+	{
+		float64_t dot = 0, dense_norm = 0, randomized_norm = 0;
+		for (index_t j = 0; j < dense.num_cols; ++j)
+		{
+			dot += dense(i, j) * randomized(i, j);
+			dense_norm += dense(i, j) * dense(i, j);
+			randomized_norm += randomized(i, j) * randomized(i, j);
+		}
+		EXPECT_NEAR(
+		    std::abs(dot) / std::sqrt(dense_norm * randomized_norm), 1.0, 1e-4);
+	}
+}
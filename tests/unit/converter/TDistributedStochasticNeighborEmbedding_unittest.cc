@@ -4,10 +4,14 @@
  * Authors: Sergey Lisitsyn, Heiko Strathmann
  */
 #include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/converter/TDistributedStochasticNeighborEmbedding.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/features/DataGenerator.h>
 
+#include <cmath>
+#include <cstdlib>
+
 using namespace shogun;
 
 #ifdef HAVE_LAPACK
@@ -40,5 +44,61 @@ TEST(TDistributedStochasticNeighborEmbeddingTest,basic)
 	EXPECT_EQ(n_target_dimensions,low_dimensional_features->get_dim_feature_space());
 	EXPECT_EQ(high_dimensional_features->get_num_vectors(),low_dimensional_features->get_num_vectors());
 }
+
+/* Barnes-Hut t-SNE gives the same embedding with one and several threads */
+TEST(TDistributedStochasticNeighborEmbeddingTest,parallel_same_as_serial)
+{
+	std::mt19937_64 prng(25);
+	auto features = std::make_shared<DenseFeatures<float64_t>>(
+		DataGenerator::generate_gaussians(40, 3, 4, prng));
+
+	auto embed = [&](int32_t num_threads) {
+		auto embedder =
+			std::make_shared<TDistributedStochasticNeighborEmbedding>();
+		embedder->set_target_dim(2);
+		embedder->set_perplexity(5.0);
+		embedder->set_theta(0.5);
+
+		// tapkee draws the initial embedding with std::rand
+		std::srand(3);
+		int32_t previous_num_threads = env()->get_num_threads();
+		env()->set_num_threads(num_threads);
+		auto embedding = embedder->transform(features)
+			->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+		env()->set_num_threads(previous_num_threads);
+		return embedding;
+	};
+
+	auto serial = embed(1);
+	auto parallel = embed(4);
+
+	ASSERT_EQ(parallel.num_rows, serial.num_rows);
+	ASSERT_EQ(parallel.num_cols, serial.num_cols);
+	for (index_t i=0; i<serial.num_rows*serial.num_cols; i++)
+		EXPECT_NEAR(parallel[i], serial[i], 1e-10);
+}
+
+/* 3D embeddings use an octree */
+TEST(TDistributedStochasticNeighborEmbeddingTest,barnes_hut_3d)
+{
+	std::mt19937_64 prng(26);
+	const index_t n_samples = 60;
+	auto features = std::make_shared<DenseFeatures<float64_t>>(
+		DataGenerator::generate_gaussians(n_samples / 3, 3, 5, prng));
+
+	auto embedder =
+		std::make_shared<TDistributedStochasticNeighborEmbedding>();
+	embedder->set_target_dim(3);
+	embedder->set_perplexity(5.0);
+	embedder->set_theta(0.5);
+
+	auto embedding = embedder->transform(features)
+		->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+
+	ASSERT_EQ(embedding.num_rows, 3);
+	ASSERT_EQ(embedding.num_cols, n_samples);
+	for (index_t i=0; i<embedding.num_rows*embedding.num_cols; i++)
+		EXPECT_TRUE(std::isfinite(embedding[i]));
+}
 #endif // HAVE_LAPACK
 
@@ -144,4 +144,43 @@ TEST(EuclideanDistance, heterogenous_features)
 
 
 
+}
+
+std::shared_ptr<DenseFeatures<float32_t>> to_float32(
+	const std::shared_ptr<DenseFeatures<float64_t>>& features)
+{
+	SGMatrix<float64_t> mat=features->get_feature_matrix();
+	SGMatrix<float32_t> mat32(mat.num_rows, mat.num_cols);
+	std::copy_n(mat.matrix, mat.num_rows*mat.num_cols, mat32.matrix);
+	return std::make_shared<DenseFeatures<float32_t>>(mat32);
+}
+
+TEST(EuclideanDistance, float32_features)
+{
+	auto features_lhs=create_lhs();
+	auto features_rhs=create_rhs();
+	auto features_lhs32=to_float32(features_lhs);
+	auto features_rhs32=to_float32(features_rhs);
+
+	auto euclidean=std::make_shared<EuclideanDistance>(features_lhs32, features_rhs32);
+	euclidean->set_disable_sqrt(true);
+
+	EXPECT_EQ(euclidean->distance(0, 0), 2);
+	EXPECT_EQ(euclidean->distance(0, 1), 2);
+	EXPECT_EQ(euclidean->distance(1, 0), 5);
+	EXPECT_EQ(euclidean->distance(1, 1), 5);
+	EXPECT_EQ(euclidean->distance_upper_bounded(1, 1, 100), 5);
+
+	// float32 data against float64 features
+	euclidean->init(features_lhs32, features_rhs);
+
+	EXPECT_EQ(euclidean->distance(0, 0), 2);
+	EXPECT_EQ(euclidean->distance(0, 1), 2);
+	EXPECT_EQ(euclidean->distance(1, 0), 5);
+	EXPECT_EQ(euclidean->distance(1, 1), 5);
+
+	euclidean->init(features_lhs, features_rhs32);
+
+	EXPECT_EQ(euclidean->distance(0, 0), 2);
+	EXPECT_EQ(euclidean->distance(1, 1), 5);
 }
@@ -0,0 +1,76 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/distributions/HMM.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/mathematics/UniformIntDistribution.h>
+
+#include <random>
+
+using namespace shogun;
+
+class HMMTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		std::mt19937_64 prng(42);
+		UniformIntDistribution<int32_t> symbol(0, num_symbols - 1);
+		UniformIntDistribution<int32_t> length(10, 40);
+
+		std::vector<SGVector<uint16_t>> strings;
+		for (int32_t i = 0; i < 60; i++)
+		{
+			SGVector<uint16_t> str(length(prng));
+			for (auto& s : str)
+				s = symbol(prng);
+			strings.push_back(str);
+		}
+		feats = std::make_shared<StringFeatures<uint16_t>>(strings, RAWDNA);
+
+		serial = std::make_shared<HMM>(feats, num_states, num_symbols, 1e-10);
+		parallel = std::make_shared<HMM>(serial);
+
+		serial->set_iterations(3);
+		parallel->set_iterations(3);
+	}
+
+	void expect_same_model(float64_t eps)
+	{
+		for (int32_t i = 0; i < num_states; i++)
+		{
+			EXPECT_NEAR(serial->get_p(i), parallel->get_p(i), eps);
+			EXPECT_NEAR(serial->get_q(i), parallel->get_q(i), eps);
+			for (int32_t j = 0; j < num_states; j++)
+				EXPECT_NEAR(serial->get_a(i, j), parallel->get_a(i, j), eps);
+			for (int32_t j = 0; j < num_symbols; j++)
+				EXPECT_NEAR(serial->get_b(i, j), parallel->get_b(i, j), eps);
+		}
+	}
+
+	const int32_t num_states = 3;
+	const int32_t num_symbols = 4;
+	std::shared_ptr<StringFeatures<uint16_t>> feats;
+	std::shared_ptr<HMM> serial;
+	std::shared_ptr<HMM> parallel;
+};
+
+TEST_F(HMMTest, baum_welch_parallel)
+{
+	serial->baum_welch_viterbi_train(BW_NORMAL);
+	parallel->baum_welch_viterbi_train(BW_PARALLEL);
+
+	expect_same_model(1e-8);
+	EXPECT_NEAR(
+	    serial->model_probability(), parallel->model_probability(), 1e-8);
+}
+
+TEST_F(HMMTest, viterbi_parallel)
+{
+	serial->baum_welch_viterbi_train(VIT_NORMAL);
+	parallel->baum_welch_viterbi_train(VIT_PARALLEL);
+
+	expect_same_model(1e-8);
+}
@@ -192,3 +192,55 @@ TYPED_TEST(CrossValidationTests, single_multi_same_result)
 
 	EXPECT_NEAR(single, multi, 1e-7);
 }
+
+TYPED_TEST(CrossValidationTests, kernel_matrix_cache_same_result)
+{
+	if constexpr (std::is_base_of_v<KernelMachine, TypeParam>)
+	{
+		auto uncached = this->test_single_thread();
+
+		this->init();
+		this->cv->put("seed", 1);
+		this->cv->set_cache_kernel_matrix(true);
+		auto cached = this->cv->evaluate()->template get<float64_t>("mean");
+		// second evaluation reuses the kernel matrix
+		this->cv->put("seed", 1);
+		auto cached_again =
+		    this->cv->evaluate()->template get<float64_t>("mean");
+
+		// kernel matrix is cached in 32bit floats
+		EXPECT_NEAR(uncached, cached, 1e-4);
+		EXPECT_NEAR(cached, cached_again, 1e-4);
+	}
+}
+
+TYPED_TEST(CrossValidationTests, kernel_matrix_cache_follows_features)
+{
+	if constexpr (std::is_base_of_v<KernelMachine, TypeParam>)
+	{
+		auto num_threads = env()->get_num_threads();
+		env()->set_num_threads(4);
+
+		this->init();
+		this->cv->set_cache_kernel_matrix(true);
+		this->cv->put("seed", 1);
+		this->cv->evaluate();
+
+		// modifying the data has to invalidate the cached kernel matrix
+		auto X = this->features->template as<DenseFeatures<float64_t>>()
+		             ->get_feature_matrix();
+		linalg::scale(X, X, 3.0);
+
+		this->cv->put("seed", 1);
+		auto cached = this->cv->evaluate()->template get<float64_t>("mean");
+
+		this->cv->set_cache_kernel_matrix(false);
+		this->cv->put("seed", 1);
+		auto uncached =
+		    this->cv->evaluate()->template get<float64_t>("mean");
+
+		EXPECT_NEAR(uncached, cached, 1e-4);
+
+		env()->set_num_threads(num_threads);
+	}
+}
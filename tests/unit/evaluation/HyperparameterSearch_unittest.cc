@@ -0,0 +1,220 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/classifier/svm/LibLinear.h>
+#include <shogun/classifier/svm/LibSVM.h>
+#include <shogun/evaluation/ContingencyTableEvaluation.h>
+#include <shogun/evaluation/CrossValidationSplitting.h>
+#include <shogun/evaluation/HyperparameterSearch.h>
+#include <shogun/features/DataGenerator.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/labels/BinaryLabels.h>
+
+#include <random>
+
+using namespace shogun;
+
+class HyperparameterSearchTest : public ::testing::Test
+{
+protected:
+	void SetUp()
+	{
+		std::mt19937_64 prng(7);
+		auto data = DataGenerator::generate_gaussians(50, 2, 2, prng);
+		SGVector<float64_t> lab(data.num_cols);
+		for (index_t i = 0; i < lab.vlen; ++i)
+			lab[i] = i < 50 ? -1 : 1;
+
+		features = std::make_shared<DenseFeatures<float64_t>>(data);
+		labels = std::make_shared<BinaryLabels>(lab);
+	}
+
+	std::shared_ptr<HyperparameterSearch>
+	make_search(std::shared_ptr<Machine> machine)
+	{
+		auto splitting =
+		    std::make_shared<CrossValidationSplitting>(labels, 5);
+		splitting->put(random::kSeed, 1);
+		return std::make_shared<HyperparameterSearch>(
+		    machine, features, labels, splitting,
+		    std::make_shared<AccuracyMeasure>());
+	}
+
+	std::shared_ptr<DenseFeatures<float64_t>> features;
+	std::shared_ptr<BinaryLabels> labels;
+};
+
+TEST_F(HyperparameterSearchTest, grid)
+{
+	auto machine = std::make_shared<LibSVM>();
+	machine->set_kernel(std::make_shared<GaussianKernel>());
+	auto search = make_search(machine);
+	search->add_grid("kernel::width", SGVector<float64_t>({0.5, 2.0}));
+	search->add_grid("C1", SGVector<float64_t>({0.1, 1.0, 10.0}));
+
+	auto best = search->search();
+
+	auto configs = search->get_configs();
+	ASSERT_EQ(configs.num_rows, 2);
+	ASSERT_EQ(configs.num_cols, 6);
+	// last parameter varies fastest
+	EXPECT_EQ(configs(0, 0), 0.5);
+	EXPECT_EQ(configs(1, 0), 0.1);
+	EXPECT_EQ(configs(1, 1), 1.0);
+	EXPECT_EQ(configs(0, 3), 2.0);
+
+	auto results = search->get_results();
+	auto fold_results = search->get_fold_results();
+	for (index_t c = 0; c < configs.num_cols; ++c)
+	{
+		EXPECT_LE(results[c], results[search->get_best_index()]);
+		for (index_t f = 0; f < fold_results.num_rows; ++f)
+			EXPECT_FALSE(std::isnan(fold_results(f, c)));
+	}
+
+	auto best_config = search->get_best_config();
+	EXPECT_EQ(
+	    best->get<float64_t>("C1"), best_config[1]);
+	EXPECT_EQ(
+	    best->get("kernel")->as<GaussianKernel>()->get_width(),
+	    best_config[0]);
+	EXPECT_GT(results[search->get_best_index()], 0.8);
+}
+
+TEST_F(HyperparameterSearchTest, kernel_matrix_cache_same_result)
+{
+	auto machine = std::make_shared<LibSVM>();
+	machine->set_kernel(std::make_shared<GaussianKernel>());
+
+	auto search = make_search(machine);
+	search->add_grid("kernel::width", SGVector<float64_t>({0.5, 2.0}));
+	search->add_grid("C1", SGVector<float64_t>({0.1, 1.0, 10.0}));
+	search->search();
+	auto expected = search->get_fold_results();
+
+	auto cached_search = make_search(machine);
+	cached_search->add_grid(
+	    "kernel::width", SGVector<float64_t>({0.5, 2.0}));
+	cached_search->add_grid("C1", SGVector<float64_t>({0.1, 1.0, 10.0}));
+	cached_search->set_cache_kernel_matrix(true);
+	cached_search->search();
+	auto fold_results = cached_search->get_fold_results();
+
+	for (index_t i = 0; i < expected.size(); ++i)
+		EXPECT_NEAR(fold_results[i], expected[i], 0.02);
+}
+
+TEST_F(HyperparameterSearchTest, kernel_matrix_cache_successive_halving)
+{
+	auto machine = std::make_shared<LibSVM>();
+	machine->set_kernel(std::make_shared<GaussianKernel>());
+
+	auto make_halving_search = [&]() {
+		auto search = make_search(machine);
+		search->add_grid(
+		    "kernel::width", SGVector<float64_t>({0.5, 2.0, 8.0}));
+		search->add_grid("C1", SGVector<float64_t>({0.1, 1.0, 10.0}));
+		search->set_strategy(HS_SUCCESSIVE_HALVING);
+		search->set_halving_rate(3);
+		return search;
+	};
+
+	auto search = make_halving_search();
+	search->search();
+	auto expected = search->get_fold_results();
+
+	// kernel matrices prepared in the first round are reused by the
+	// surviving configurations
+	auto cached_search = make_halving_search();
+	cached_search->set_cache_kernel_matrix(true);
+	cached_search->search();
+	auto fold_results = cached_search->get_fold_results();
+
+	for (index_t i = 0; i < expected.size(); ++i)
+	{
+		if (std::isnan(expected[i]))
+			EXPECT_TRUE(std::isnan(fold_results[i]));
+		else
+			EXPECT_NEAR(fold_results[i], expected[i], 0.02);
+	}
+}
+
+TEST_F(HyperparameterSearchTest, successive_halving_prunes)
+{
+	auto machine = std::make_shared<LibLinear>(L2R_LR);
+	auto search = make_search(machine);
+	search->add_grid(
+	    "C1", SGVector<float64_t>({1e-4, 1e-3, 1e-2, 0.1, 1, 10, 100, 1000,
+	                               1e4}));
+	search->set_strategy(HS_SUCCESSIVE_HALVING);
+	search->set_halving_rate(3);
+	search->search();
+
+	// 9 configurations on fold 0, 3 on folds 1-2, 1 on folds 3-4
+	auto fold_results = search->get_fold_results();
+	index_t num_evaluated[5] = {0, 0, 0, 0, 0};
+	for (index_t c = 0; c < fold_results.num_cols; ++c)
+		for (index_t f = 0; f < fold_results.num_rows; ++f)
+			num_evaluated[f] += !std::isnan(fold_results(f, c));
+	EXPECT_EQ(num_evaluated[0], 9);
+	EXPECT_EQ(num_evaluated[1], 3);
+	EXPECT_EQ(num_evaluated[2], 3);
+	EXPECT_EQ(num_evaluated[3], 1);
+	EXPECT_EQ(num_evaluated[4], 1);
+
+	auto best = search->get_best_index();
+	for (index_t f = 0; f < fold_results.num_rows; ++f)
+		EXPECT_FALSE(std::isnan(fold_results(f, best)));
+}
+
+TEST_F(HyperparameterSearchTest, random)
+{
+	auto machine = std::make_shared<LibLinear>(L2R_LR);
+	auto search = make_search(machine);
+	search->add_range("C1", 1e-3, 1e3, true);
+	search->add_grid("epsilon", SGVector<float64_t>({1e-3, 1e-5}));
+	search->set_strategy(HS_RANDOM);
+	search->set_num_random_configs(8);
+	search->put(random::kSeed, 3);
+	search->search();
+
+	auto configs = search->get_configs();
+	ASSERT_EQ(configs.num_cols, 8);
+	for (index_t c = 0; c < configs.num_cols; ++c)
+	{
+		EXPECT_GE(configs(0, c), 1e-3);
+		EXPECT_LE(configs(0, c), 1e3);
+		EXPECT_TRUE(configs(1, c) == 1e-3 || configs(1, c) == 1e-5);
+	}
+}
+
+TEST_F(HyperparameterSearchTest, warm_start_same_result)
+{
+	auto machine = std::make_shared<LibLinear>(L2R_LR);
+	machine->set_epsilon(1e-8);
+
+	auto search = make_search(machine);
+	search->add_grid("C1", SGVector<float64_t>({0.01, 0.1, 1, 10}));
+	search->search();
+	auto expected = search->get_fold_results();
+
+	auto warm_search = make_search(machine);
+	warm_search->add_grid("C1", SGVector<float64_t>({0.01, 0.1, 1, 10}));
+	warm_search->set_warm_start(true);
+	warm_search->search();
+	auto fold_results = warm_search->get_fold_results();
+
+	for (index_t i = 0; i < expected.size(); ++i)
+		EXPECT_NEAR(fold_results[i], expected[i], 0.02);
+}
+
+TEST_F(HyperparameterSearchTest, unknown_parameter)
+{
+	auto search = make_search(std::make_shared<LibLinear>());
+	EXPECT_THROW(
+	    search->add_grid("no_such_parameter", SGVector<float64_t>({1.0})),
+	    ShogunException);
+}
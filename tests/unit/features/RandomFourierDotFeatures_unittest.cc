@@ -5,6 +5,10 @@
  */
 #include <gtest/gtest.h>
 #include <shogun/features/RandomFourierDotFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/mathematics/RandomNamespace.h>
+
+#include <random>
 
 
 using namespace shogun;
@@ -176,3 +180,99 @@ TEST(RandomFourierDotFeatures, add_to_dense_test)
 
 }
 
+static SGMatrix<float64_t> uniform_data(int32_t num_dims, int32_t vecs)
+{
+	std::mt19937_64 prng(1337);
+	SGMatrix<float64_t> data(num_dims, vecs);
+	random::fill_array(data, 0.0, 1.0, prng);
+	// some zeros for the sparse representation
+	for (index_t i=0; i<vecs; i++)
+		data(i % num_dims, i) = 0;
+	return data;
+}
+
+TEST(RandomFourierDotFeatures, sparse_input)
+{
+	int32_t num_dims = 20;
+	int32_t vecs = 6;
+	int32_t D = 50;
+	auto data = uniform_data(num_dims, vecs);
+	SGVector<float64_t> params(1);
+	params[0] = 4;
+
+	auto dense = std::make_shared<RandomFourierDotFeatures>(
+			std::make_shared<DenseFeatures<float64_t>>(data), D, GAUSSIAN, params);
+	auto sparse = std::make_shared<RandomFourierDotFeatures>(
+			std::make_shared<SparseFeatures<float64_t>>(data), D, GAUSSIAN, params,
+			dense->get_random_coefficients());
+
+	for (index_t i=0; i<vecs; i++)
+	{
+		for (index_t j=0; j<vecs; j++)
+			EXPECT_NEAR(dense->dot(i, dense, j), sparse->dot(i, sparse, j), 1e-12);
+	}
+}
+
+TEST(RandomFourierDotFeatures, fastfood_approximates_gaussian_kernel)
+{
+	int32_t num_dims = 20;
+	int32_t vecs = 8;
+	int32_t D = 16384;
+	float64_t width = 4;
+	auto data = uniform_data(num_dims, vecs);
+	SGVector<float64_t> params(1);
+	params[0] = width;
+
+	auto r_feats = std::make_shared<RandomFourierDotFeatures>(
+			std::make_shared<DenseFeatures<float64_t>>(data), D, GAUSSIAN, params,
+			FASTFOOD_PROJECTION);
+	EXPECT_EQ(r_feats->get_dim_feature_space(), D);
+
+	for (index_t i=0; i<vecs; i++)
+	{
+		for (index_t j=0; j<vecs; j++)
+		{
+			float64_t sqdist = 0;
+			for (index_t k=0; k<num_dims; k++)
+				sqdist += (data(k,i)-data(k,j))*(data(k,i)-data(k,j));
+			EXPECT_NEAR(r_feats->dot(i, r_feats, j), std::exp(-sqdist/width), 0.05);
+		}
+	}
+}
+
+TEST(RandomFourierDotFeatures, cache_and_dense_dot_range)
+{
+	int32_t num_dims = 20;
+	int32_t vecs = 300;
+	int32_t D = 64;
+	auto data = uniform_data(num_dims, vecs);
+	SGVector<float64_t> params(1);
+	params[0] = 4;
+
+	for (auto projection : {DENSE_PROJECTION, FASTFOOD_PROJECTION})
+	{
+		auto r_feats = std::make_shared<RandomFourierDotFeatures>(
+				std::make_shared<DenseFeatures<float64_t>>(data), D, GAUSSIAN,
+				params, projection);
+
+		SGVector<float64_t> w(D);
+		w.range_fill();
+		SGVector<float64_t> expected(vecs);
+		for (index_t i=0; i<vecs; i++)
+			expected[i] = r_feats->dot(i, w) + 1;
+
+		SGVector<float64_t> output(vecs);
+		r_feats->dense_dot_range(output.vector, 0, vecs, NULL, w.vector, D, 1);
+		for (index_t i=0; i<vecs; i++)
+			EXPECT_NEAR(output[i], expected[i], 1e-10);
+
+		r_feats->set_cache_features(true);
+		output.zero();
+		r_feats->dense_dot_range(output.vector, 0, vecs, NULL, w.vector, D, 1);
+		for (index_t i=0; i<vecs; i++)
+		{
+			EXPECT_NEAR(output[i], expected[i], 1e-10);
+			EXPECT_NEAR(r_feats->dot(i, w) + 1, expected[i], 1e-10);
+		}
+	}
+}
@@ -412,3 +412,56 @@ TEST(SparseFeaturesTest,subset_get_full_feature_vector_smaller)
 
 
 }
+
+TEST(SparseFeaturesTest,packed_dot_products)
+{
+	SGMatrix<float64_t> data(4, 5);
+	for (index_t i=0; i<data.num_rows*data.num_cols; ++i)
+		data.matrix[i]=i%3==0 ? 0 : (i%2==0 ? i : -i);
+
+	auto features=std::make_shared<SparseFeatures<float64_t>>(data);
+	EXPECT_TRUE(features->get_sparse_feature_matrix().is_packed());
+
+	SGVector<float64_t> w(data.num_rows);
+	for (index_t j=0; j<w.vlen; ++j)
+		w[j]=0.5*j-1;
+
+	auto check=[&](const SGMatrix<float64_t>& expected)
+	{
+		SGVector<index_t> subset_idx(3);
+		subset_idx[0]=4;
+		subset_idx[1]=1;
+		subset_idx[2]=3;
+		features->add_subset(subset_idx);
+
+		for (index_t i=0; i<subset_idx.vlen; ++i)
+		{
+			float64_t dot=0;
+			for (index_t j=0; j<w.vlen; ++j)
+				dot+=expected(j, subset_idx[i])*w[j];
+
+			EXPECT_NEAR(features->dot(i, w), dot, 1e-12);
+			EXPECT_NEAR(features->dense_dot(2, i, w.vector, w.vlen, 1),
+				2*dot+1, 1e-12);
+
+			SGVector<float64_t> sum(w.vlen);
+			sum.zero();
+			features->add_to_dense_vec(2, i, sum.vector, sum.vlen);
+			features->add_to_dense_vec(1, i, sum.vector, sum.vlen, true);
+			for (index_t j=0; j<w.vlen; ++j)
+			{
+				float64_t entry=expected(j, subset_idx[i]);
+				EXPECT_NEAR(sum[j], 2*entry+std::abs(entry), 1e-12);
+			}
+		}
+		features->remove_subset();
+	};
+	check(data);
+
+	// writing to the matrix falls back to the vectors
+	auto matrix=features->get_sparse_feature_matrix();
+	matrix(0, 4)=3;
+	data(0, 4)=3;
+	EXPECT_FALSE(features->get_sparse_feature_matrix().is_packed());
+	check(data);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cstdio>
 
 #include <shogun/io/ShogunErrc.h>
 #include <shogun/io/serialization/BitserySerializer.h>
@@ -11,6 +12,7 @@
 
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/kernel/GaussianKernel.h>
+#include "../../utils/Utils.h"
 
 using namespace shogun;
 using namespace shogun::io;
@@ -145,3 +147,31 @@ TYPED_TEST(SerializationTest, serialize)
 
 	ASSERT_TRUE(obj->equals(deser_obj));
 }
+
+TEST(BitserySerializationTest, page_aligned_arrays)
+{
+	SGMatrix<float64_t> data(16, 100);
+	for (index_t i = 0; i < data.num_rows * data.num_cols; ++i)
+		data[i] = i * 0.5;
+	auto df = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto obj = std::make_shared<GaussianKernel>(df, df, 2.0);
+
+	char fname[] = "BitserySerialization_page_aligned.XXXXXX";
+	generate_temp_filename(fname);
+
+	auto serializer = std::make_shared<BitserySerializer>();
+	serializer->set_page_aligned_arrays(true);
+	serialize(fname, obj, serializer);
+
+	auto deserializer = std::make_shared<BitseryDeserializer>();
+	auto deser_obj = deserializer->read_mapped(fname);
+	ASSERT_TRUE(obj->equals(deser_obj));
+
+	// the feature matrix is not copied but a view into the mapped file
+	auto lhs = deser_obj->as<GaussianKernel>()->get_lhs();
+	auto mapped = lhs->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(mapped.matrix) % 4096, 0u);
+	EXPECT_EQ(mapped(3, 7), data(3, 7));
+
+	std::remove(fname);
+}
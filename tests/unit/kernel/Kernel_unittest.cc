@@ -34,6 +34,7 @@
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/LinearKernel.h>
 #include <shogun/mathematics/NormalDistribution.h>
 
 using namespace shogun;
@@ -370,3 +371,40 @@ TEST(Kernel, gaussian_get_kernel_matrix)
 
 
 }
+
+TEST(Kernel, linear_float32_features)
+{
+	const index_t num_vectors=20;
+	const index_t dim=3;
+
+	std::mt19937_64 prng(100);
+	SGMatrix<float64_t> data = generate_std_norm_matrix(num_vectors, dim, prng);
+	SGMatrix<float32_t> data32(dim, num_vectors);
+	for (index_t i=0; i<dim*num_vectors; ++i)
+	{
+		data32.matrix[i]=data.matrix[i];
+		data.matrix[i]=data32.matrix[i];
+	}
+	auto feats=std::make_shared<DenseFeatures<float64_t>>(data);
+	auto feats32=std::make_shared<DenseFeatures<float32_t>>(data32);
+
+	auto kernel=std::make_shared<LinearKernel>(feats, feats);
+	SGMatrix<float64_t> expected=kernel->get_kernel_matrix();
+
+	// float32 on either side, accumulated in float64
+	kernel->init(feats32, feats32);
+	SGMatrix<float64_t> km=kernel->get_kernel_matrix();
+	kernel->init(feats32, feats);
+	SGMatrix<float64_t> km_mixed=kernel->get_kernel_matrix();
+	kernel->init(feats, feats32);
+	SGMatrix<float64_t> km_mixed2=kernel->get_kernel_matrix();
+	for (index_t i=0; i<num_vectors; i++)
+	{
+		for (index_t j=0; j<num_vectors; ++j)
+		{
+			EXPECT_NEAR(km(i, j), expected(i, j), 1E-12);
+			EXPECT_NEAR(km_mixed(i, j), expected(i, j), 1E-12);
+			EXPECT_NEAR(km_mixed2(i, j), expected(i, j), 1E-12);
+		}
+	}
+}
@@ -345,3 +345,131 @@ TEST(SGSparseMatrix, pointer_equal)
 	SGSparseMatrix<float64_t> m3(2, 2);
 	EXPECT_FALSE(m1 == m3);
 }
+
+TEST(SGSparseMatrix, pack)
+{
+	const index_t num_feat=20;
+	const index_t num_vec=10;
+	SGMatrix<float64_t> dense(num_feat, num_vec);
+	dense.zero();
+	GenerateMatrix(0.3, num_feat, num_vec, 12, &dense);
+
+	SGSparseMatrix<float64_t> sparse(num_feat, num_vec);
+	for (index_t i=0; i<num_vec; ++i)
+	{
+		index_t nnz=0;
+		for (index_t j=0; j<num_feat; ++j)
+			nnz+=dense(j, i)!=0;
+
+		sparse.sparse_matrix[i]=SGSparseVector<float64_t>(nnz);
+		for (index_t j=0, k=0; j<num_feat; ++j)
+		{
+			if (dense(j, i)!=0)
+			{
+				sparse[i].features[k].feat_index=j;
+				sparse[i].features[k++].entry=dense(j, i);
+			}
+		}
+	}
+
+	// a copy of a vector stays valid after packing
+	SGSparseVector<float64_t> unpacked=sparse[3];
+	EXPECT_FALSE(sparse.is_packed());
+	sparse.pack();
+	EXPECT_TRUE(sparse.is_packed());
+	EXPECT_TRUE(unpacked.equals(sparse[3]));
+
+	for (index_t i=1; i<num_vec; ++i)
+	{
+		EXPECT_EQ(sparse[i].features,
+			sparse[i-1].features+sparse[i-1].num_feat_entries);
+	}
+	const SGSparseMatrix<float64_t>& packed_view=sparse;
+	for (index_t i=0; i<num_vec; ++i)
+		for (index_t j=0; j<num_feat; ++j)
+			EXPECT_EQ(packed_view(j, i), dense(j, i));
+	EXPECT_TRUE(sparse.is_packed());
+
+	// the packed arrays hold the same entries as the vectors
+	SGVector<int64_t> indptr;
+	SGVector<index_t> indices;
+	SGVector<float64_t> values;
+	sparse.get_csr(indptr, indices, values);
+	for (index_t i=0; i<num_vec; ++i)
+	{
+		ASSERT_EQ(indptr[i+1]-indptr[i], sparse[i].num_feat_entries);
+		for (index_t k=0; k<sparse[i].num_feat_entries; ++k)
+		{
+			EXPECT_EQ(indices[indptr[i]+k], sparse[i].features[k].feat_index);
+			EXPECT_EQ(values[indptr[i]+k], sparse[i].features[k].entry);
+		}
+	}
+
+	// copies share the packed arrays
+	SGSparseMatrix<float64_t> copy=sparse;
+	SGVector<int64_t> copy_indptr;
+	SGVector<index_t> copy_indices;
+	SGVector<float64_t> copy_values;
+	copy.get_csr(copy_indptr, copy_indices, copy_values);
+	EXPECT_EQ(copy_indices.vector, indices.vector);
+	EXPECT_EQ(copy_values.vector, values.vector);
+
+	// writing through the reference unpacks the matrix and its copies
+	sparse(0, 0)=dense(0, 0);
+	EXPECT_FALSE(sparse.is_packed());
+	EXPECT_FALSE(copy.is_packed());
+
+	// vectors keep the packed entries alive
+	SGSparseVector<float64_t> packed=sparse[3];
+	sparse=SGSparseMatrix<float64_t>();
+	EXPECT_TRUE(packed.equals(unpacked));
+
+	// inserting into a packed vector
+	SGSparseMatrix<float64_t> from_dense(dense);
+	from_dense(num_feat-1, 0)=7.0;
+	EXPECT_EQ(from_dense(num_feat-1, 0), 7.0);
+	EXPECT_EQ(from_dense(0, 1), dense(0, 1));
+}
+
+TEST(SGSparseMatrix, csr)
+{
+	const index_t num_feat=15;
+	const index_t num_vec=8;
+	SGMatrix<float64_t> dense(num_feat, num_vec);
+	dense.zero();
+	GenerateMatrix(0.4, num_feat, num_vec, 3, &dense);
+	SGSparseMatrix<float64_t> sparse(dense);
+
+	SGVector<int64_t> indptr;
+	SGVector<index_t> indices;
+	SGVector<float64_t> values;
+	sparse.get_csr(indptr, indices, values);
+	ASSERT_EQ(indptr.vlen, num_vec+1);
+	EXPECT_EQ(indptr[num_vec], indices.vlen);
+
+	SGSparseMatrix<float64_t> csr(indptr, indices, values, num_feat);
+	EXPECT_TRUE(csr.is_packed());
+	EXPECT_TRUE(csr.equals(sparse));
+
+	// the transposed is the compressed sparse column matrix
+	auto transposed=sparse.get_transposed();
+	EXPECT_TRUE(transposed.is_packed());
+	EXPECT_EQ(transposed.num_vectors, num_feat);
+	EXPECT_EQ(transposed.num_features, num_vec);
+	for (index_t i=0; i<num_vec; ++i)
+		for (index_t j=0; j<num_feat; ++j)
+			EXPECT_EQ(transposed(i, j), dense(j, i));
+
+	// the product gathers from the packed arrays
+	SGVector<float64_t> v(num_feat);
+	v.range_fill();
+	ASSERT_TRUE(sparse.is_packed());
+	auto result=sparse*v;
+	for (index_t i=0; i<num_vec; ++i)
+	{
+		float64_t expected=0;
+		for (index_t j=0; j<num_feat; ++j)
+			expected+=dense(j, i)*v[j];
+		EXPECT_NEAR(result[i], expected, 1e-10);
+	}
+}
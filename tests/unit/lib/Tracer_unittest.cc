@@ -0,0 +1,71 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/lib/Tracer.h>
+
+using namespace shogun;
+
+TEST(Tracer, counter_only_counts_when_enabled)
+{
+	auto tracer = std::make_shared<Tracer>();
+	auto& counter = tracer->counter("evaluations");
+
+	counter.add(3);
+	EXPECT_EQ(counter.value(), 0);
+
+	tracer->set_enabled(true);
+	counter.add(3);
+	counter.add(2);
+	EXPECT_EQ(counter.value(), 5);
+	EXPECT_EQ(&tracer->counter("evaluations"), &counter);
+
+	tracer->clear();
+	EXPECT_EQ(counter.value(), 0);
+}
+
+TEST(Tracer, chrome_trace)
+{
+	auto tracer = std::make_shared<Tracer>();
+	tracer->set_enabled(true);
+	tracer->counter("evaluations").add(7);
+
+	auto start = Tracer::Clock::now();
+	tracer->record(
+	    "train_machine", "svm", start, start + std::chrono::milliseconds(2));
+
+	auto trace = tracer->to_chrome_trace();
+	EXPECT_NE(trace.find("\"traceEvents\""), std::string::npos);
+	EXPECT_NE(
+	    trace.find("\"name\":\"train_machine\",\"cat\":\"svm\",\"ph\":\"X\""),
+	    std::string::npos);
+	EXPECT_NE(trace.find("\"dur\":2000"), std::string::npos);
+	EXPECT_NE(
+	    trace.find("\"name\":\"evaluations\",\"ph\":\"C\""), std::string::npos);
+	EXPECT_NE(trace.find("\"args\":{\"value\":7}"), std::string::npos);
+
+	tracer->clear();
+	EXPECT_EQ(tracer->to_chrome_trace().find("train_machine"), std::string::npos);
+}
+
+TEST(Tracer, scope_records_only_when_enabled)
+{
+	auto tracer = Tracer::instance();
+	tracer->clear();
+
+	tracer->set_enabled(false);
+	{
+		TraceScope scope("disabled_scope", "test");
+	}
+	tracer->set_enabled(true);
+	{
+		TraceScope scope("enabled_scope", "test");
+	}
+	tracer->set_enabled(false);
+
+	auto trace = tracer->to_chrome_trace();
+	EXPECT_EQ(trace.find("disabled_scope"), std::string::npos);
+	EXPECT_NE(trace.find("enabled_scope"), std::string::npos);
+	tracer->clear();
+}
@@ -0,0 +1,106 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/lib/WorkspacePool.h>
+
+#include <cstdint>
+
+using namespace shogun;
+
+TEST(WorkspacePool, plain_vector_outside_of_scope)
+{
+	EXPECT_FALSE(workspace::in_scope());
+	workspace::reset_statistics();
+
+	auto v = workspace::vector<float64_t>(10);
+	ASSERT_EQ(v.vlen, 10);
+	for (index_t i = 0; i < v.vlen; ++i)
+		EXPECT_EQ(v[i], 0);
+	EXPECT_EQ(workspace::statistics().num_allocations, 0);
+}
+
+TEST(WorkspacePool, reuse_released_blocks)
+{
+	WorkspaceScope scope;
+	EXPECT_TRUE(workspace::in_scope());
+	workspace::reset_statistics();
+
+	float64_t* first;
+	{
+		auto v = workspace::vector<float64_t>(100);
+		first = v.vector;
+		// a live block is not handed out twice
+		auto w = workspace::vector<float64_t>(100);
+		EXPECT_NE(w.vector, first);
+	}
+	// same size class
+	auto v = workspace::vector<float64_t>(90);
+	EXPECT_EQ(v.vector, first);
+	EXPECT_EQ(v.vlen, 90);
+
+	auto statistics = workspace::statistics();
+	EXPECT_EQ(statistics.num_allocations, 2);
+	EXPECT_EQ(statistics.num_reuses, 1);
+}
+
+TEST(WorkspacePool, steady_state_allocates_nothing)
+{
+	WorkspaceScope scope;
+	auto iteration = [] {
+		auto a = workspace::vector<float64_t>(37);
+		auto b = workspace::matrix<float64_t>(5, 7);
+		auto c = workspace::vector<int32_t>(1000);
+		a.set_const(1);
+		b.set_const(2);
+		c.set_const(3);
+	};
+
+	iteration();
+	workspace::reset_statistics();
+	for (int32_t i = 0; i < 10; ++i)
+		iteration();
+
+	auto statistics = workspace::statistics();
+	EXPECT_EQ(statistics.num_allocations, 0);
+	EXPECT_EQ(statistics.num_bytes, 0);
+	EXPECT_EQ(statistics.num_reuses, 30);
+}
+
+TEST(WorkspacePool, aligned)
+{
+	WorkspaceScope scope;
+	for (index_t len : {1, 3, 17, 100, 1000})
+	{
+		auto v = workspace::vector<float32_t>(len);
+		EXPECT_EQ(
+		    reinterpret_cast<uintptr_t>(v.vector) % workspace::alignment, 0);
+		auto m = workspace::matrix<float64_t>(len, 3);
+		EXPECT_EQ(m.num_rows, len);
+		EXPECT_EQ(m.num_cols, 3);
+		EXPECT_EQ(
+		    reinterpret_cast<uintptr_t>(m.matrix) % workspace::alignment, 0);
+	}
+}
+
+TEST(WorkspacePool, escaping_vector_stays_valid)
+{
+	SGVector<float64_t> escaped;
+	{
+		WorkspaceScope scope;
+		{
+			WorkspaceScope nested;
+			escaped = workspace::vector<float64_t>(50);
+			escaped.range_fill();
+		}
+		// the pools are only released by the outermost scope
+		auto v = workspace::vector<float64_t>(50);
+		EXPECT_NE(v.vector, escaped.vector);
+	}
+	EXPECT_FALSE(workspace::in_scope());
+
+	ASSERT_EQ(escaped.vlen, 50);
+	for (index_t i = 0; i < escaped.vlen; ++i)
+		EXPECT_EQ(escaped[i], i);
+}
@@ -0,0 +1,143 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/lib/config.h>
+
+#define TAPKEE_EIGEN_INCLUDE_FILE <shogun/mathematics/eigen3.h>
+#ifdef HAVE_ARPACK
+	#define TAPKEE_WITH_ARPACK
+#endif
+#include <shogun/lib/tapkee/defines.hpp>
+#include <shogun/lib/tapkee/utils/naming.hpp>
+#include <shogun/lib/tapkee/utils/time.hpp>
+#include <shogun/lib/tapkee/utils/logging.hpp>
+#include <shogun/lib/tapkee/neighbors/neighbors.hpp>
+#include <shogun/lib/tapkee/routines/generalized_eigendecomposition.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace tapkee;
+using namespace tapkee::tapkee_internal;
+
+namespace
+{
+	/** absolute difference of points on a line, given by their indices */
+	struct line_distance_callback
+	{
+		line_distance_callback(const std::vector<ScalarType>& p) : points(p) {}
+		ScalarType distance(IndexType a, IndexType b) const
+		{
+			return std::abs(points[a] - points[b]);
+		}
+		const std::vector<ScalarType>& points;
+	};
+
+	void check_neighbors(NeighborsMethod method)
+	{
+		std::mt19937_64 prng(11);
+		std::uniform_real_distribution<ScalarType> uniform(0.0, 10.0);
+		const IndexType N = 50;
+		const IndexType k = 5;
+
+		// some points are duplicated, so the query point may tie with them
+		std::vector<ScalarType> points(N);
+		for (IndexType i = 0; i < N; ++i)
+			points[i] = i % 10 == 0 && i > 0 ? points[i - 1] : uniform(prng);
+		std::vector<IndexType> indices(N);
+		for (IndexType i = 0; i < N; ++i)
+			indices[i] = i;
+
+		typedef std::vector<IndexType>::iterator iterator;
+		line_distance_callback callback(points);
+		Neighbors neighbors = find_neighbors(
+		    method, indices.begin(), indices.end(),
+		    PlainDistance<iterator, line_distance_callback>(callback), k, false);
+
+		ASSERT_EQ(static_cast<IndexType>(neighbors.size()), N);
+		for (IndexType i = 0; i < N; ++i)
+		{
+			LocalNeighbors row = neighbors[i];
+			EXPECT_EQ(static_cast<IndexType>(row.size()), k);
+			EXPECT_EQ(std::count(row.begin(), row.end(), i), 0);
+
+			// the row holds the k nearest other points
+			std::vector<ScalarType> expected;
+			for (IndexType j = 0; j < N; ++j)
+			{
+				if (j != i)
+					expected.push_back(callback.distance(i, j));
+			}
+			std::sort(expected.begin(), expected.end());
+			std::vector<ScalarType> found;
+			for (IndexType j : row)
+				found.push_back(callback.distance(i, j));
+			std::sort(found.begin(), found.end());
+			for (IndexType j = 0; j < static_cast<IndexType>(found.size()); ++j)
+				EXPECT_EQ(found[j], expected[j]);
+
+			std::sort(row.begin(), row.end());
+			EXPECT_EQ(std::unique(row.begin(), row.end()), row.end());
+		}
+	}
+}
+
+TEST(TapkeeNeighbors, brute_force_k_nearest_without_self)
+{
+	check_neighbors(Brute);
+}
+
+TEST(TapkeeNeighbors, vptree_k_nearest_without_self)
+{
+	check_neighbors(VpTree);
+}
+
+TEST(TapkeeGeneralizedEigendecomposition, randomized_same_as_dense)
+{
+	// laplacian of a path graph with distinct weights, its eigenvalues are
+	// simple so the eigenvectors are unique up to their sign
+	std::mt19937_64 prng(3);
+	std::uniform_real_distribution<ScalarType> uniform(0.5, 1.5);
+	const IndexType n = 30;
+	const IndexType target_dimension = 2;
+
+	DenseVector degrees = DenseVector::Zero(n);
+	std::vector<Eigen::Triplet<ScalarType>> triplets;
+	for (IndexType i = 0; i + 1 < n; ++i)
+	{
+		ScalarType w = uniform(prng);
+		triplets.emplace_back(i, i + 1, -w);
+		triplets.emplace_back(i + 1, i, -w);
+		degrees(i) += w;
+		degrees(i + 1) += w;
+	}
+	for (IndexType i = 0; i < n; ++i)
+		triplets.emplace_back(i, i, degrees(i));
+	SparseWeightMatrix laplacian(n, n);
+	laplacian.setFromTriplets(triplets.begin(), triplets.end());
+	DenseDiagonalMatrix degree_matrix(n);
+	degree_matrix.diagonal() = degrees;
+
+	EigendecompositionResult dense = generalized_eigendecomposition(
+	    Dense, HomogeneousCPUStrategy, SmallestEigenvalues, laplacian,
+	    degree_matrix, target_dimension);
+	EigendecompositionResult randomized = generalized_eigendecomposition(
+	    Randomized, HomogeneousCPUStrategy, SmallestEigenvalues, laplacian,
+	    degree_matrix, target_dimension);
+
+	ASSERT_EQ(randomized.first.rows(), n);
+	ASSERT_EQ(randomized.first.cols(), target_dimension);
+	ASSERT_EQ(randomized.second.size(), target_dimension);
+	for (IndexType j = 0; j < target_dimension; ++j)
+	{
+		EXPECT_NEAR(randomized.second(j), dense.second(j), 1e-8);
+
+		DenseVector x = dense.first.col(j);
+		DenseVector y = randomized.first.col(j);
+		EXPECT_NEAR(std::abs(x.dot(y)) / (x.norm() * y.norm()), 1.0, 1e-6);
+	}
+}
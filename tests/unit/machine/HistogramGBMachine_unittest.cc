@@ -0,0 +1,119 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/evaluation/MeanSquaredError.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/loss/SquaredLoss.h>
+#include <shogun/machine/HistogramGBMachine.h>
+#include <shogun/mathematics/RandomNamespace.h>
+
+#include <random>
+
+using namespace shogun;
+
+class HistogramGBMachineTest : public ::testing::Test
+{
+protected:
+	void SetUp()
+	{
+		std::mt19937_64 prng(835);
+		train_feats = sinusoid(1000, prng, train_labels);
+		test_feats = sinusoid(100, prng, test_labels);
+	}
+
+	static std::shared_ptr<DenseFeatures<float64_t>> sinusoid(
+	    index_t num_vectors, std::mt19937_64& prng,
+	    std::shared_ptr<RegressionLabels>& labels)
+	{
+		SGMatrix<float64_t> mat(2, num_vectors);
+		random::fill_array(mat, 0.0, 10.0, prng);
+
+		SGVector<float64_t> lab(num_vectors);
+		for (index_t i = 0; i < num_vectors; ++i)
+			lab[i] = std::sin(mat(0, i)) + 0.1 * mat(1, i);
+
+		labels = std::make_shared<RegressionLabels>(lab);
+		return std::make_shared<DenseFeatures<float64_t>>(mat);
+	}
+
+	float64_t test_error(const std::shared_ptr<HistogramGBMachine>& machine)
+	{
+		auto predicted = machine->apply_regression(test_feats);
+		return MeanSquaredError().evaluate(predicted, test_labels);
+	}
+
+	std::shared_ptr<DenseFeatures<float64_t>> train_feats;
+	std::shared_ptr<DenseFeatures<float64_t>> test_feats;
+	std::shared_ptr<RegressionLabels> train_labels;
+	std::shared_ptr<RegressionLabels> test_labels;
+};
+
+TEST_F(HistogramGBMachineTest, sinusoid_curve_fitting)
+{
+	auto machine = std::make_shared<HistogramGBMachine>(
+	    std::make_shared<SquaredLoss>(), 200, 0.1, 15);
+	machine->set_labels(train_labels);
+	machine->train(train_feats);
+
+	EXPECT_EQ(machine->get_num_trees(), 200);
+	EXPECT_LT(test_error(machine), 0.01);
+}
+
+TEST_F(HistogramGBMachineTest, subset_fraction)
+{
+	auto machine = std::make_shared<HistogramGBMachine>(
+	    std::make_shared<SquaredLoss>(), 200, 0.1, 15);
+	machine->set_subset_fraction(0.5);
+	machine->put(random::kSeed, 3);
+	machine->set_labels(train_labels);
+	machine->train(train_feats);
+
+	EXPECT_LT(test_error(machine), 0.02);
+}
+
+TEST_F(HistogramGBMachineTest, stump_splits_at_threshold)
+{
+	SGMatrix<float64_t> mat(1, 6);
+	SGVector<float64_t> lab(6);
+	for (index_t i = 0; i < 6; ++i)
+	{
+		mat(0, i) = i;
+		lab[i] = i < 3 ? 1.0 : 4.0;
+	}
+
+	auto machine = std::make_shared<HistogramGBMachine>(
+	    std::make_shared<SquaredLoss>(), 1, 1.0, 2);
+	machine->set_min_samples_leaf(1);
+	machine->set_labels(std::make_shared<RegressionLabels>(lab));
+	machine->train(std::make_shared<DenseFeatures<float64_t>>(mat));
+
+	SGMatrix<float64_t> test_mat(1, 4);
+	test_mat(0, 0) = -10;
+	test_mat(0, 1) = 2.4;
+	test_mat(0, 2) = 2.6;
+	test_mat(0, 3) = 10;
+	auto predicted =
+	    machine
+	        ->apply_regression(
+	            std::make_shared<DenseFeatures<float64_t>>(test_mat))
+	        ->get_labels();
+
+	EXPECT_NEAR(predicted[0], 1.0, 1e-12);
+	EXPECT_NEAR(predicted[1], 1.0, 1e-12);
+	EXPECT_NEAR(predicted[2], 4.0, 1e-12);
+	EXPECT_NEAR(predicted[3], 4.0, 1e-12);
+}
+
+TEST_F(HistogramGBMachineTest, few_bins)
+{
+	auto machine = std::make_shared<HistogramGBMachine>(
+	    std::make_shared<SquaredLoss>(), 200, 0.1, 15);
+	machine->set_max_bins(16);
+	machine->set_labels(train_labels);
+	machine->train(train_feats);
+
+	EXPECT_LT(test_error(machine), 0.05);
+}
@@ -0,0 +1,250 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/classifier/svm/LibLinear.h>
+#include <shogun/classifier/svm/LibSVM.h>
+#include <shogun/features/DataGenerator.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/labels/MultilabelLabels.h>
+#include <shogun/lib/exception/ShogunException.h>
+#include <shogun/machine/KernelMulticlassMachine.h>
+#include <shogun/machine/LinearMulticlassMachine.h>
+#include <shogun/multiclass/MulticlassOneVsOneStrategy.h>
+#include <shogun/multiclass/MulticlassOneVsRestStrategy.h>
+
+#include <atomic>
+#include <random>
+
+using namespace shogun;
+
+/** kernel multiclass machine whose second submachine fails to train */
+class FailingKernelMulticlassMachine : public KernelMulticlassMachine
+{
+public:
+	using KernelMulticlassMachine::KernelMulticlassMachine;
+
+	mutable std::atomic<int32_t> num_trained{0};
+	bool finished = false;
+
+protected:
+	virtual void finish_machines_for_parallel_train()
+	{
+		finished = true;
+		KernelMulticlassMachine::finish_machines_for_parallel_train();
+	}
+
+	virtual std::shared_ptr<Machine> train_submachine(
+	    const SGVector<index_t>& subset,
+	    const std::shared_ptr<BinaryLabels>& labels) const
+	{
+		if (num_trained++ == 1)
+			error("Training of the submachine failed");
+		return KernelMulticlassMachine::train_submachine(subset, labels);
+	}
+};
+
+class MulticlassMachineTest : public ::testing::Test
+{
+protected:
+	void SetUp()
+	{
+		std::mt19937_64 prng(17);
+		auto data = DataGenerator::generate_gaussians(
+		    num_per_class, num_classes, 2, prng);
+		SGVector<float64_t> lab(data.num_cols);
+		for (index_t i = 0; i < lab.vlen; ++i)
+			lab[i] = i / num_per_class;
+
+		features = std::make_shared<DenseFeatures<float64_t>>(data);
+		labels = std::make_shared<MulticlassLabels>(lab);
+	}
+
+	const index_t num_per_class = 20;
+	const index_t num_classes = 4;
+	std::shared_ptr<DenseFeatures<float64_t>> features;
+	std::shared_ptr<MulticlassLabels> labels;
+};
+
+TEST_F(MulticlassMachineTest, linear_parallel_training_same_result)
+{
+	auto train = [&](bool parallel) {
+		auto machine = std::make_shared<LinearMulticlassMachine>(
+		    std::make_shared<MulticlassOneVsOneStrategy>(), features,
+		    std::make_shared<LibLinear>(L2R_L2LOSS_SVC), labels);
+		machine->set_parallel_training(parallel);
+		machine->train();
+		return machine;
+	};
+
+	auto serial = train(false);
+	auto parallel = train(true);
+
+	ASSERT_EQ(parallel->get_num_machines(), serial->get_num_machines());
+	for (index_t i = 0; i < serial->get_num_machines(); ++i)
+	{
+		auto w = serial->get_machine(i)->as<LinearMachine>()->get_w();
+		auto w_parallel =
+		    parallel->get_machine(i)->as<LinearMachine>()->get_w();
+		ASSERT_EQ(w_parallel.vlen, w.vlen);
+		for (index_t j = 0; j < w.vlen; ++j)
+			EXPECT_NEAR(w_parallel[j], w[j], 1e-10);
+	}
+
+	auto expected = serial->apply_multiclass(features);
+	auto result = parallel->apply_multiclass(features);
+	EXPECT_TRUE(result->get_labels().equals(expected->get_labels()));
+}
+
+TEST_F(MulticlassMachineTest, kernel_parallel_training_same_result)
+{
+	auto train = [&](bool parallel) {
+		auto machine = std::make_shared<KernelMulticlassMachine>(
+		    std::make_shared<MulticlassOneVsRestStrategy>(),
+		    std::make_shared<GaussianKernel>(2.0), std::make_shared<LibSVM>(),
+		    labels);
+		machine->set_parallel_training(parallel);
+		machine->train(features);
+		return machine;
+	};
+
+	auto serial = train(false);
+	auto parallel = train(true);
+
+	auto expected = serial->apply_multiclass(features);
+	auto result = parallel->apply_multiclass(features);
+	EXPECT_TRUE(result->get_labels().equals(expected->get_labels()));
+}
+
+TEST_F(MulticlassMachineTest, kernel_parallel_training_one_vs_one)
+{
+	auto machine = std::make_shared<KernelMulticlassMachine>(
+	    std::make_shared<MulticlassOneVsOneStrategy>(),
+	    std::make_shared<GaussianKernel>(2.0), std::make_shared<LibSVM>(),
+	    labels);
+	machine->set_parallel_training(true);
+	machine->train(features);
+	ASSERT_EQ(machine->get_num_machines(), num_classes * (num_classes - 1) / 2);
+
+	// the shared training kernel matrix is not kept by the submachines
+	for (index_t i = 0; i < machine->get_num_machines(); ++i)
+	{
+		EXPECT_EQ(
+		    machine->get_machine(i)->as<KernelMachine>()->get_kernel(),
+		    machine->get_kernel());
+	}
+
+	// support vectors of the (0, 1) machine are training vectors of
+	// class 0 or 1
+	auto svm = machine->get_machine(0)->as<KernelMachine>();
+	for (index_t j = 0; j < svm->get_num_support_vectors(); ++j)
+		EXPECT_LT(svm->get_support_vector(j), 2 * num_per_class);
+
+	auto result = machine->apply_multiclass(features);
+	index_t num_correct = 0;
+	for (index_t i = 0; i < result->get_num_labels(); ++i)
+		num_correct += result->get_label(i) == labels->get_label(i);
+	EXPECT_GT(num_correct, 0.9 * result->get_num_labels());
+}
+
+TEST_F(MulticlassMachineTest, kernel_parallel_training_throws)
+{
+	auto machine = std::make_shared<FailingKernelMulticlassMachine>(
+	    std::make_shared<MulticlassOneVsOneStrategy>(),
+	    std::make_shared<GaussianKernel>(2.0), std::make_shared<LibSVM>(),
+	    labels);
+	machine->set_parallel_training(true);
+
+	// the error reaches the caller as in serial training
+	EXPECT_THROW(machine->train(features), ShogunException);
+
+	// the other submachines are still trained and the shared state released
+	EXPECT_EQ(machine->num_trained, num_classes * (num_classes - 1) / 2);
+	EXPECT_TRUE(machine->finished);
+	EXPECT_EQ(machine->get_num_machines(), 0);
+}
+
+TEST_F(MulticlassMachineTest, kernel_batch_outputs)
+{
+	auto machine = std::make_shared<KernelMulticlassMachine>(
+	    std::make_shared<MulticlassOneVsOneStrategy>(),
+	    std::make_shared<GaussianKernel>(2.0), std::make_shared<LibSVM>(),
+	    labels);
+	machine->set_parallel_training(true);
+	machine->train(features);
+
+	// initializes the kernel with the test vectors
+	std::mt19937_64 prng(3);
+	auto test = std::make_shared<DenseFeatures<float64_t>>(
+	    DataGenerator::generate_gaussians(25, num_classes, 2, prng));
+	machine->apply_multiclass(test);
+
+	auto outputs = machine->get_all_submachine_outputs();
+	ASSERT_EQ(outputs.size(), machine->get_num_machines());
+	for (index_t i = 0; i < machine->get_num_machines(); ++i)
+	{
+		auto expected = machine->get_submachine_outputs(i)->get_values();
+		auto values = outputs[i]->get_values();
+		ASSERT_EQ(values.vlen, test->get_num_vectors());
+		for (index_t j = 0; j < values.vlen; ++j)
+			EXPECT_NEAR(values[j], expected[j], 1e-10);
+	}
+}
+
+TEST_F(MulticlassMachineTest, linear_batch_outputs)
+{
+	auto machine = std::make_shared<LinearMulticlassMachine>(
+	    std::make_shared<MulticlassOneVsRestStrategy>(), features,
+	    std::make_shared<LibLinear>(L2R_L2LOSS_SVC), labels);
+	machine->train();
+
+	auto sparse = std::make_shared<SparseFeatures<float64_t>>(features);
+	for (auto test : std::vector<std::shared_ptr<DotFeatures>>{features, sparse})
+	{
+		machine->set_features(test);
+		auto outputs = machine->get_all_submachine_outputs();
+		ASSERT_EQ(outputs.size(), machine->get_num_machines());
+		for (index_t i = 0; i < machine->get_num_machines(); ++i)
+		{
+			auto expected = machine->get_submachine_outputs(i)->get_values();
+			auto values = outputs[i]->get_values();
+			ASSERT_EQ(values.vlen, test->get_num_vectors());
+			for (index_t j = 0; j < values.vlen; ++j)
+				EXPECT_NEAR(values[j], expected[j], 1e-10);
+		}
+	}
+}
+
+TEST_F(MulticlassMachineTest, linear_top_k_outputs)
+{
+	auto machine = std::make_shared<LinearMulticlassMachine>(
+	    std::make_shared<MulticlassOneVsRestStrategy>(), features,
+	    std::make_shared<LibLinear>(L2R_L2LOSS_SVC), labels);
+	machine->train();
+
+	const int32_t k = 2;
+	auto result = machine->apply_multilabel_output(features, k);
+	ASSERT_EQ(result->get_num_labels(), features->get_num_vectors());
+
+	auto predicted = machine->apply_multiclass(features);
+	for (index_t i = 0; i < result->get_num_labels(); ++i)
+	{
+		auto classes = result->get_label(i);
+		ASSERT_EQ(classes.vlen, k);
+		EXPECT_EQ(classes[0], predicted->get_label(i));
+		EXPECT_GE(
+		    machine->get_submachine_output(classes[0], i),
+		    machine->get_submachine_output(classes[1], i));
+		for (index_t c = 0; c < num_classes; ++c)
+		{
+			if (c != classes[0] && c != classes[1])
+				EXPECT_GE(
+				    machine->get_submachine_output(classes[1], i),
+				    machine->get_submachine_output(c, i));
+		}
+	}
+}
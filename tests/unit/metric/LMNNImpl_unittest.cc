@@ -189,3 +189,42 @@ TEST(LMNNImpl,find_impostors_exact)
 
 
 }
+
+TEST(LMNNImpl,update_gradient)
+{
+	// create features, each column is a feature vector
+	SGMatrix<float64_t> feat_mat(2,4);
+	feat_mat(0,0)=0;
+	feat_mat(1,0)=0;
+	feat_mat(0,1)=0;
+	feat_mat(1,1)=-1;
+	feat_mat(0,2)=1;
+	feat_mat(1,2)=1;
+	feat_mat(0,3)=-1;
+	feat_mat(1,3)=2;
+	auto features=std::make_shared<DenseFeatures<float64_t>>(feat_mat);
+
+	// the previous and the current impostor sets share the first triplet
+	ImpostorsSetType Np = {CImpostorNode(0,1,2), CImpostorNode(2,3,0)};
+	ImpostorsSetType Nc = {CImpostorNode(0,1,2), CImpostorNode(3,2,1)};
+	float64_t mu=0.5;
+
+	SGMatrix<float64_t> G(2,2);
+	G.zero();
+	LMNNImpl::update_gradient(features, G, Nc, Np, mu);
+
+	// G = mu*(outer products of the new triplet - those of the removed one)
+	auto outer=[&](index_t a, index_t b, index_t r, index_t c)
+	{
+		return (feat_mat(r,a)-feat_mat(r,b))*(feat_mat(c,a)-feat_mat(c,b));
+	};
+	for (index_t r=0; r<2; ++r)
+	{
+		for (index_t c=0; c<2; ++c)
+		{
+			float64_t expected=mu*(outer(3,2,r,c)-outer(3,1,r,c)) -
+				mu*(outer(2,3,r,c)-outer(2,0,r,c));
+			EXPECT_NEAR(G(r,c), expected, 1e-12);
+		}
+	}
+}
@@ -128,3 +128,38 @@ TEST(MulticlassStrategy,rescale_ova_hamamura)
 	EXPECT_NEAR(scores[1],0.3333333333333333,1E-5);
 	EXPECT_NEAR(scores[2],0.3333333333333333,1E-5);
 }
+
+TEST(MulticlassStrategy, ovo_train_tasks)
+{
+	SGVector<float64_t> lab({0, 1, 2, 0, 1, 2});
+	auto labels = std::make_shared<MulticlassLabels>(lab);
+
+	MulticlassOneVsOneStrategy ovo;
+	ovo.set_num_classes(3);
+	auto tasks = ovo.get_train_tasks(labels);
+
+	// pairs (0,1), (0,2), (1,2)
+	ASSERT_EQ(tasks.size(), 3);
+	EXPECT_TRUE(tasks[0].subset.equals(SGVector<int32_t>({0, 1, 3, 4})));
+	EXPECT_TRUE(tasks[0].labels.equals(SGVector<float64_t>({1, -1, 1, -1})));
+	EXPECT_TRUE(tasks[1].subset.equals(SGVector<int32_t>({0, 2, 3, 5})));
+	EXPECT_TRUE(tasks[1].labels.equals(SGVector<float64_t>({1, -1, 1, -1})));
+	EXPECT_TRUE(tasks[2].subset.equals(SGVector<int32_t>({1, 2, 4, 5})));
+	EXPECT_TRUE(tasks[2].labels.equals(SGVector<float64_t>({1, -1, 1, -1})));
+}
+
+TEST(MulticlassStrategy, ova_train_tasks)
+{
+	SGVector<float64_t> lab({0, 1, 2, 0});
+	auto labels = std::make_shared<MulticlassLabels>(lab);
+
+	MulticlassOneVsRestStrategy ova;
+	ova.set_num_classes(3);
+	auto tasks = ova.get_train_tasks(labels);
+
+	ASSERT_EQ(tasks.size(), 3);
+	for (const auto& task : tasks)
+		EXPECT_EQ(task.subset.vlen, 0);
+	EXPECT_TRUE(tasks[0].labels.equals(SGVector<float64_t>({1, -1, -1, 1})));
+	EXPECT_TRUE(tasks[2].labels.equals(SGVector<float64_t>({-1, -1, 1, -1})));
+}
@@ -665,3 +665,45 @@ TEST(CARTree,cv_prune_simple)
 
 
 }
+
+TEST(CARTree, float32_features)
+{
+	const index_t num_vectors=40;
+	std::mt19937_64 prng(3);
+	std::uniform_real_distribution<float32_t> uniform(-1, 1);
+	SGMatrix<float32_t> data32(2, num_vectors);
+	SGMatrix<float64_t> data64(2, num_vectors);
+	SGVector<float64_t> lab(num_vectors);
+	for (index_t i=0; i<num_vectors; ++i)
+	{
+		for (index_t j=0; j<2; ++j)
+		{
+			data32(j, i)=uniform(prng);
+			data64(j, i)=data32(j, i);
+		}
+		lab[i]=(data64(0, i)>0.2)+(data64(1, i)>-0.3);
+	}
+	auto labels=std::make_shared<MulticlassLabels>(lab);
+	auto feats32=std::make_shared<DenseFeatures<float32_t>>(data32);
+	auto feats64=std::make_shared<DenseFeatures<float64_t>>(data64);
+
+	auto c32=std::make_shared<CARTree>();
+	c32->set_labels(labels);
+	c32->train(feats32);
+	auto c64=std::make_shared<CARTree>();
+	c64->set_labels(labels);
+	c64->train(feats64);
+
+	auto importance32=c32->get_feature_importance();
+	auto importance64=c64->get_feature_importance();
+	EXPECT_NEAR(importance32[0], importance64[0], 1e-12);
+	EXPECT_NEAR(importance32[1], importance64[1], 1e-12);
+
+	auto result32=c32->apply_multiclass(feats32);
+	auto result64=c64->apply_multiclass(feats64);
+	for (index_t i=0; i<num_vectors; ++i)
+	{
+		EXPECT_EQ(result32->get_label(i), result64->get_label(i));
+		EXPECT_EQ(result32->get_label(i), lab[i]);
+	}
+}
@@ -31,6 +31,7 @@
  * Written (W) 2014 Khaled Nasr
  */
 #include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/neuralnets/Autoencoder.h>
 #include <shogun/neuralnets/NeuralInputLayer.h>
 #include <shogun/neuralnets/NeuralRectifiedLinearLayer.h>
@@ -228,3 +229,47 @@ TEST(Autoencoder, convolutional_with_stride_and_pooling)
 
 	EXPECT_NEAR(ae.check_gradients(), 0.0, tolerance);
 }
+
+/** Tests that splitting the batches across threads trains the same
+ * contractive autoencoder as computing the error and gradients on the whole
+ * batch
+ */
+TEST(Autoencoder, contractive_parallel_training)
+{
+	int32_t seed = 100;
+	int32_t num_features = 10;
+	int32_t num_examples = 200;
+
+	std::mt19937_64 prng(seed);
+	UniformRealDistribution<float64_t> uniform_real_dist(-1.0, 1.0);
+	SGMatrix<float64_t> data(num_features, num_examples);
+	for (int32_t i=0; i<num_features*num_examples; i++)
+		data[i] = uniform_real_dist(prng);
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+
+	auto train = [&](bool parallel)
+	{
+		auto hidden_layer = std::make_shared<NeuralLogisticLayer>(8);
+		auto decoding_layer = std::make_shared<NeuralLinearLayer>(num_features);
+		hidden_layer->put("seed", seed);
+		decoding_layer->put("seed", seed);
+		auto ae = std::make_shared<Autoencoder>(
+			num_features, hidden_layer, decoding_layer);
+		ae->put("seed", seed);
+		ae->set_contraction_coefficient(1.0);
+		ae->set_max_num_epochs(30);
+		ae->set_parallel_training(parallel);
+		ae->train(features);
+		return ae->get<SGVector<float64_t>>("params");
+	};
+
+	auto num_threads = env()->get_num_threads();
+	env()->set_num_threads(4);
+	auto expected = train(false);
+	auto params = train(true);
+	env()->set_num_threads(num_threads);
+
+	ASSERT_EQ(params.vlen, expected.vlen);
+	for (int32_t i=0; i<params.vlen; i++)
+		EXPECT_NEAR(params[i], expected[i], 1e-5);
+}
@@ -32,6 +32,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/features/DenseFeatures.h>
@@ -447,3 +448,113 @@ TEST(NeuralNetwork, gradient_descent)
 	for (int32_t i=0; i<4; i++)
 		EXPECT_EQ(predictions->get_label(i), labels->get_label(i));
 }
+
+/** tests that splitting the batches across threads gives the same network as
+ * computing the gradients on the whole batch
+ */
+TEST(NeuralNetwork, parallel_training)
+{
+	int32_t N = 200;
+	SGMatrix<float64_t> inputs_matrix(2,N);
+	SGVector<float64_t> targets_vector(N);
+	for (int32_t i=0; i<N; i++)
+	{
+		inputs_matrix(0,i) = std::cos(0.9*i);
+		inputs_matrix(1,i) = std::sin(0.7*i);
+		targets_vector[i] = inputs_matrix(0,i)+inputs_matrix(1,i) > 0 ? 1 : 0;
+	}
+
+	auto features =
+		std::make_shared<DenseFeatures<float64_t>>(inputs_matrix);
+	auto labels = std::make_shared<MulticlassLabels>(targets_vector);
+
+	auto train = [&](bool parallel, bool single_precision)
+	{
+		std::vector<std::shared_ptr<NeuralLayer>> layers;
+		layers.push_back(std::make_shared<NeuralInputLayer>(2));
+		layers.push_back(std::make_shared<NeuralLogisticLayer>(8));
+		layers.push_back(std::make_shared<NeuralSoftmaxLayer>(2));
+
+		auto network = std::make_shared<NeuralNetwork>(layers);
+		network->put("seed", 100);
+		network->put("sigma", 0.1);
+		network->set_l2_coefficient(1e-3);
+		network->set_max_num_epochs(30);
+		network->set_parallel_training(parallel);
+		network->set_single_precision(single_precision);
+		network->set_labels(labels);
+		network->train(features);
+		return network;
+	};
+
+	auto num_threads = env()->get_num_threads();
+	env()->set_num_threads(4);
+	auto expected = train(false, false);
+	auto network = train(true, false);
+
+	auto expected_params = expected->get<SGVector<float64_t>>("params");
+	auto params = network->get<SGVector<float64_t>>("params");
+	ASSERT_EQ(params.vlen, expected_params.vlen);
+	for (int32_t i=0; i<params.vlen; i++)
+		EXPECT_NEAR(params[i], expected_params[i], 1e-5);
+
+	auto single_network = train(true, true);
+	auto predictions = single_network->apply_multiclass(features);
+	int32_t num_correct = 0;
+	for (int32_t i=0; i<N; i++)
+		num_correct += predictions->get_label(i)==labels->get_label(i);
+	EXPECT_GT(num_correct, 0.9*N);
+
+	env()->set_num_threads(num_threads);
+}
+
+/** tests that float32 features train the same network as their float64 copy
+ */
+TEST(NeuralNetwork, float32_features)
+{
+	int32_t N = 50;
+	SGMatrix<float32_t> inputs32(2,N);
+	SGMatrix<float64_t> inputs64(2,N);
+	SGVector<float64_t> targets_vector(N);
+	for (int32_t i=0; i<N; i++)
+	{
+		inputs32(0,i) = std::cos(0.9f*i);
+		inputs32(1,i) = std::sin(0.7f*i);
+		inputs64(0,i) = inputs32(0,i);
+		inputs64(1,i) = inputs32(1,i);
+		targets_vector[i] = inputs64(0,i)+inputs64(1,i) > 0 ? 1 : 0;
+	}
+	auto labels = std::make_shared<MulticlassLabels>(targets_vector);
+
+	auto train = [&](const std::shared_ptr<Features>& features)
+	{
+		std::vector<std::shared_ptr<NeuralLayer>> layers;
+		layers.push_back(std::make_shared<NeuralInputLayer>(2));
+		layers.push_back(std::make_shared<NeuralLogisticLayer>(4));
+		layers.push_back(std::make_shared<NeuralSoftmaxLayer>(2));
+
+		auto network = std::make_shared<NeuralNetwork>(layers);
+		network->put("seed", 100);
+		network->put("sigma", 0.1);
+		network->set_max_num_epochs(30);
+		network->set_labels(labels);
+		network->train(features);
+		return network;
+	};
+
+	auto features32 = std::make_shared<DenseFeatures<float32_t>>(inputs32);
+	auto features64 = std::make_shared<DenseFeatures<float64_t>>(inputs64);
+	auto network32 = train(features32);
+	auto network64 = train(features64);
+
+	auto params32 = network32->get<SGVector<float64_t>>("params");
+	auto params64 = network64->get<SGVector<float64_t>>("params");
+	ASSERT_EQ(params32.vlen, params64.vlen);
+	for (int32_t i=0; i<params32.vlen; i++)
+		EXPECT_NEAR(params32[i], params64[i], 1e-12);
+
+	auto predictions32 = network32->apply_multiclass(features32);
+	auto predictions64 = network64->apply_multiclass(features64);
+	for (int32_t i=0; i<N; i++)
+		EXPECT_EQ(predictions32->get_label(i), predictions64->get_label(i));
+}
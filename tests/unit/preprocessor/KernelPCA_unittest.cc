@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 #include <shogun/preprocessor/KernelPCA.h>
 #include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/LinearKernel.h>
 #include <shogun/lib/SGMatrix.h>
 
 
@@ -101,3 +102,82 @@ TEST(KernelPCA, apply_to_feature_vector)
 
 
 }
+
+TEST(KernelPCA, nystrom_all_landmarks_same_as_exact)
+{
+	index_t num_test_vectors = 2;
+
+	SGMatrix<float64_t> train_matrix(num_features, num_vectors);
+	SGMatrix<float64_t> test_matrix(num_features, num_test_vectors);
+	load_data(train_matrix, test_matrix);
+
+	auto train_feats =
+	    std::make_shared<DenseFeatures<float64_t>>(train_matrix);
+	auto test_feats = std::make_shared<DenseFeatures<float64_t>>(test_matrix);
+
+	auto kernel = std::make_shared<GaussianKernel>();
+	kernel->set_width(1);
+
+	auto kpca = std::make_shared<KernelPCA>(kernel);
+	kpca->set_method(KPCA_NYSTROM);
+	kpca->set_num_basis(num_vectors);
+	kpca->set_target_dim(target_dim);
+	kpca->put(random::kSeed, 7);
+	kpca->fit(train_feats);
+
+	SGMatrix<float64_t> embedding = kpca->transform(test_feats)
+	                                    ->as<DenseFeatures<float64_t>>()
+	                                    ->get_feature_matrix();
+	ASSERT_EQ(embedding.num_rows, target_dim);
+	ASSERT_EQ(embedding.num_cols, num_test_vectors);
+
+	// allow embedding with opposite sign
+	for (index_t i = 0; i < num_test_vectors * target_dim; ++i)
+		EXPECT_NEAR(Math::abs(embedding[i]), Math::abs(resdata[i]), 1E-6);
+}
+
+TEST(KernelPCA, random_fourier)
+{
+	SGMatrix<float64_t> train_matrix(num_features, num_vectors);
+	SGVector<float64_t> test_vector(num_features);
+	load_data(train_matrix, test_vector);
+
+	auto train_feats =
+	    std::make_shared<DenseFeatures<float64_t>>(train_matrix);
+
+	auto fit = [&](int32_t seed) {
+		auto kpca =
+		    std::make_shared<KernelPCA>(std::make_shared<GaussianKernel>(2.0));
+		kpca->set_method(KPCA_RANDOM_FOURIER);
+		kpca->set_num_basis(50);
+		kpca->set_target_dim(target_dim);
+		kpca->put(random::kSeed, seed);
+		kpca->fit(train_feats);
+		return kpca;
+	};
+
+	auto kpca = fit(3);
+	auto embedding = kpca->transform(train_feats)
+	                     ->as<DenseFeatures<float64_t>>()
+	                     ->get_feature_matrix();
+	ASSERT_EQ(embedding.num_rows, target_dim);
+	ASSERT_EQ(embedding.num_cols, num_vectors);
+
+	// training data is centered in the approximate feature space
+	for (index_t i = 0; i < target_dim; ++i)
+	{
+		float64_t sum = 0;
+		for (index_t j = 0; j < num_vectors; ++j)
+			sum += embedding(i, j);
+		EXPECT_NEAR(sum, 0.0, 1E-10);
+	}
+
+	auto expected = kpca->apply_to_feature_vector(test_vector);
+	auto result = fit(3)->apply_to_feature_vector(test_vector);
+	for (index_t i = 0; i < target_dim; ++i)
+		EXPECT_NEAR(result[i], expected[i], 1E-12);
+
+	auto linear = std::make_shared<KernelPCA>(std::make_shared<LinearKernel>());
+	linear->set_method(KPCA_RANDOM_FOURIER);
+	EXPECT_THROW(linear->fit(train_feats), ShogunException);
+}
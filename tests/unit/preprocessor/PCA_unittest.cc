@@ -7,6 +7,7 @@
 #include <gtest/gtest.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
@@ -603,3 +604,94 @@ TEST(PCA, PCA_WHITEN_EVD)
 	EXPECT_NEAR(0.0,covariance_mat(2,1),epsilon);
 	EXPECT_NEAR(1.0,covariance_mat(2,2),epsilon);
 }
+
+/** data of rank 3 around a non-zero mean */
+static SGMatrix<float64_t> low_rank_data(index_t num_features, index_t num_vectors)
+{
+	SGMatrix<float64_t> data(num_features, num_vectors);
+	for (index_t j = 0; j < num_vectors; ++j)
+	{
+		float64_t a = 3.0 * std::sin(0.7 * j);
+		float64_t b = 1.5 * std::cos(1.3 * j + 0.2);
+		float64_t c = 0.5 * std::sin(2.9 * j + 1.0);
+		for (index_t i = 0; i < num_features; ++i)
+		{
+			data(i, j) = 1.0 + i + a * std::cos(0.3 * i) +
+			             b * std::sin(0.5 * i + 1.0) + c * (i % 3 - 1.0);
+		}
+	}
+	return data;
+}
+
+static void expect_same_components(
+    std::shared_ptr<PCA> pca, std::shared_ptr<PCA> expected)
+{
+	auto eigenvalues = pca->get_eigenvalues();
+	auto expected_eigenvalues = expected->get_eigenvalues();
+	auto transmat = pca->get_transformation_matrix();
+	auto expected_transmat = expected->get_transformation_matrix();
+	ASSERT_EQ(transmat.num_cols, expected_transmat.num_cols);
+	ASSERT_EQ(eigenvalues.vlen, transmat.num_cols);
+	for (index_t i = 0; i < transmat.num_cols; ++i)
+	{
+		EXPECT_NEAR(eigenvalues[i], expected_eigenvalues[i], 1e-8);
+		check_eigenvector_eq(
+		    transmat.get_column(i), expected_transmat.get_column(i));
+	}
+
+	auto mean = pca->get_mean();
+	auto expected_mean = expected->get_mean();
+	for (index_t i = 0; i < mean.vlen; ++i)
+		EXPECT_NEAR(mean[i], expected_mean[i], 1e-10);
+}
+
+TEST(PCA, PCA_RANDOMIZED)
+{
+	auto features =
+	    std::make_shared<DenseFeatures<float64_t>>(low_rank_data(8, 60));
+
+	auto expected = std::make_shared<PCA>(SVD);
+	expected->set_target_dim(3);
+	expected->fit(features);
+
+	auto pca = std::make_shared<PCA>(RANDOMIZED);
+	pca->set_target_dim(3);
+	pca->set_oversampling(2);
+	pca->put(random::kSeed, 5);
+	pca->fit(features);
+	expect_same_components(pca, expected);
+
+	// feature matrix is restored after fitting
+	EXPECT_TRUE(features->get_feature_matrix().equals(low_rank_data(8, 60)));
+}
+
+TEST(PCA, PCA_INCREMENTAL)
+{
+	auto features =
+	    std::make_shared<DenseFeatures<float64_t>>(low_rank_data(8, 60));
+
+	auto expected = std::make_shared<PCA>(SVD);
+	expected->set_target_dim(3);
+	expected->fit(features);
+
+	auto pca = std::make_shared<PCA>(INCREMENTAL);
+	pca->set_target_dim(3);
+	pca->set_chunk_size(7);
+	pca->fit(features);
+	expect_same_components(pca, expected);
+
+	auto streaming_pca = std::make_shared<PCA>(INCREMENTAL);
+	streaming_pca->set_target_dim(3);
+	streaming_pca->set_chunk_size(16);
+	streaming_pca->fit(
+	    std::make_shared<StreamingDenseFeatures<float64_t>>(features));
+	expect_same_components(streaming_pca, expected);
+}
+
+TEST(PCA, PCA_INCREMENTAL_requires_fixed_number)
+{
+	auto features =
+	    std::make_shared<DenseFeatures<float64_t>>(low_rank_data(8, 60));
+	auto pca = std::make_shared<PCA>(false, VARIANCE_EXPLAINED, 0.9, INCREMENTAL);
+	EXPECT_THROW(pca->fit(features), ShogunException);
+}
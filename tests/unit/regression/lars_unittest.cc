@@ -483,3 +483,130 @@ TEST(LeastAngleRegression, early_stop_l1_norm)
 
 
 }
+
+static std::shared_ptr<DenseFeatures<float64_t>> generate_normalized_data(
+	int32_t n_feat, int32_t n_vec, int32_t seed, SGVector<float64_t>& lab)
+{
+	std::mt19937_64 prng(seed);
+	SGMatrix<float64_t> data(n_feat, n_vec);
+	random::fill_array(data, 0.0, 1.0, prng);
+
+	lab = SGVector<float64_t>(n_vec);
+	random::fill_array(lab, 0.0, 1.0, prng);
+	float64_t mean=linalg::mean(lab);
+	for (index_t i=0; i<lab.size(); i++)
+		lab[i]-=mean;
+
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto proc1 = std::make_shared<PruneVarSubMean>();
+	auto proc2 = std::make_shared<NormOne>();
+	proc1->fit(features);
+	features =
+	    proc1->transform(features)->as<DenseFeatures<float64_t>>();
+	proc2->fit(features);
+	return proc2->transform(features)->as<DenseFeatures<float64_t>>();
+}
+
+TEST(LeastAngleRegression, precompute_gram)
+{
+	SGVector<float64_t> lab;
+	auto features = generate_normalized_data(10, 200, 131, lab);
+	auto labels = std::make_shared<RegressionLabels>(lab);
+
+	auto lars = std::make_shared<LeastAngleRegression>(true);
+	lars->set_labels(labels);
+	lars->train(features);
+
+	auto lars_gram = std::make_shared<LeastAngleRegression>(true);
+	lars_gram->set_labels(labels);
+	lars_gram->put("precompute_gram", true);
+	lars_gram->train(features);
+
+	ASSERT_EQ(lars->get_path_size(), lars_gram->get_path_size());
+	for (int32_t i=0; i<lars->get_path_size(); i++)
+	{
+		SGVector<float64_t> w=lars->get_w_for_var(i);
+		SGVector<float64_t> w_gram=lars_gram->get_w_for_var(i);
+		for (index_t j=0; j<w.vlen; j++)
+			EXPECT_NEAR(w[j], w_gram[j], 1E-10);
+	}
+}
+
+TEST(LeastAngleRegression, coordinate_descent_path)
+{
+	SGVector<float64_t> lab;
+	auto features = generate_normalized_data(10, 200, 137, lab);
+	auto labels = std::make_shared<RegressionLabels>(lab);
+
+	auto lars = std::make_shared<LeastAngleRegression>(true);
+	lars->set_labels(labels);
+	lars->train(features);
+
+	auto cd = std::make_shared<LeastAngleRegression>(true);
+	cd->set_labels(labels);
+	cd->put("solver", LARS_SOLVER_COORDINATE_DESCENT);
+	cd->put("lambda_min_ratio", 1e-8);
+	cd->train(features);
+
+	// the path starts at zero
+	SGVector<float64_t> w0=cd->get_w_for_var(0);
+	for (index_t j=0; j<w0.vlen; j++)
+		EXPECT_EQ(w0[j], 0);
+
+	// and ends close to the least squares solution, as the lasso path does
+	SGVector<float64_t> w=lars->get_w();
+	SGVector<float64_t> w_cd=cd->get_w();
+	ASSERT_EQ(w.vlen, w_cd.vlen);
+	for (index_t j=0; j<w.vlen; j++)
+		EXPECT_NEAR(w[j], w_cd[j], 1E-5);
+}
+
+TEST(LeastAngleRegression, precompute_gram_lars)
+{
+	SGVector<float64_t> lab;
+	auto features = generate_normalized_data(10, 200, 139, lab);
+	auto labels = std::make_shared<RegressionLabels>(lab);
+
+	auto lars = std::make_shared<LeastAngleRegression>(false);
+	lars->set_labels(labels);
+	lars->train(features);
+
+	auto lars_gram = std::make_shared<LeastAngleRegression>(false);
+	lars_gram->set_labels(labels);
+	lars_gram->put("precompute_gram", true);
+	lars_gram->train(features);
+
+	ASSERT_EQ(lars->get_path_size(), lars_gram->get_path_size());
+	for (int32_t i=0; i<lars->get_path_size(); i++)
+	{
+		SGVector<float64_t> w=lars->get_w_for_var(i);
+		SGVector<float64_t> w_gram=lars_gram->get_w_for_var(i);
+		for (index_t j=0; j<w.vlen; j++)
+			EXPECT_NEAR(w[j], w_gram[j], 1E-10);
+	}
+}
+
+TEST(LeastAngleRegression, coordinate_descent_path_sparsity)
+{
+	SGVector<float64_t> lab;
+	auto features = generate_normalized_data(10, 200, 149, lab);
+	auto labels = std::make_shared<RegressionLabels>(lab);
+
+	// a coarse grid adds several coefficients between two estimators
+	auto cd = std::make_shared<LeastAngleRegression>(true);
+	cd->set_labels(labels);
+	cd->put("solver", LARS_SOLVER_COORDINATE_DESCENT);
+	cd->put("num_lambdas", 5);
+	cd->put("lambda_min_ratio", 1e-4);
+	cd->train(features);
+
+	ASSERT_GT(cd->get_path_size(), 1);
+	for (int32_t i=0; i<cd->get_path_size(); i++)
+	{
+		SGVector<float64_t> w=cd->get_w_for_var(i);
+		int32_t num_nonz = 0;
+		for (index_t j=0; j<w.vlen; j++)
+			num_nonz += w[j] != 0;
+		EXPECT_LE(num_nonz, i);
+	}
+}
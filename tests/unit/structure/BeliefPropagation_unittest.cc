@@ -9,6 +9,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <limits>
+
 using namespace shogun;
 
 inline int grid_to_index(int32_t x, int32_t y, int32_t w = 10)
@@ -168,3 +171,109 @@ TEST(BeliefPropagation, tree_max_product_multi_states)
 
 }
 
+
+TEST(BeliefPropagation, loopy_max_product_tree)
+{
+	SGVector<int32_t> assignment_expected; // expected assignment
+	float64_t min_energy_expected; // expected minimum energy
+
+	auto fg_test_data = std::make_shared<FactorGraphDataGenerator>();
+
+	auto fg = fg_test_data->random_chain_graph(assignment_expected, min_energy_expected);
+
+	// min-sum is exact on trees
+	MAPInference infer_met(fg, LOOPY_MAX_PROD);
+	infer_met.inference();
+
+	SGVector<int32_t> assignment = infer_met.get_structured_outputs()->get_data();
+	EXPECT_EQ(assignment.size(), assignment_expected.size());
+
+	for (int32_t i = 0; i < assignment.size(); i++)
+		EXPECT_EQ(assignment[i], assignment_expected[i]);
+
+	EXPECT_NEAR(min_energy_expected, infer_met.get_energy(), 1E-10);
+
+	auto fg_multi = fg_test_data->multi_state_tree_graph();
+	MAPInference infer_multi(fg_multi, LOOPY_MAX_PROD);
+	infer_multi.inference();
+	EXPECT_NEAR(-3.8, infer_multi.get_energy(), 1E-10);
+}
+
+TEST(BeliefPropagation, loopy_max_product_grid)
+{
+	const int32_t w = 3;
+	const int32_t h = 3;
+	const float64_t unary[] = {-1.0, 0.9, -0.8, 0.7, -0.2, 0.6, -0.9, 0.8, -0.5};
+
+	SGVector<int32_t> vc(w*h);
+	SGVector<int32_t>::fill_vector(vc.vector, vc.vlen, 2);
+	auto fg = std::make_shared<FactorGraph>(vc);
+
+	SGVector<float64_t> data;
+	for (int32_t i = 0; i < w*h; i++)
+	{
+		SGVector<int32_t> card(1);
+		card[0] = 2;
+		SGVector<float64_t> energies(2);
+		energies[0] = 0.0;
+		energies[1] = unary[i];
+		auto ftype = std::make_shared<TableFactorType>(i + 1, card, energies);
+
+		SGVector<int32_t> var_index(1);
+		var_index[0] = i;
+		fg->add_factor(std::make_shared<Factor>(ftype, var_index, data));
+	}
+
+	// Potts pairwise energies on the 4-connected grid
+	SGVector<int32_t> card(2);
+	card[0] = 2;
+	card[1] = 2;
+	SGVector<float64_t> potts(4);
+	potts[0] = 0.0; // 0,0
+	potts[1] = 0.3; // 1,0
+	potts[2] = 0.3; // 0,1
+	potts[3] = 0.0; // 1,1
+	auto pairtype = std::make_shared<TableFactorType>(0, card, potts);
+
+	for (int32_t y = 0; y < h; y++)
+	{
+		for (int32_t x = 0; x < w; x++)
+		{
+			SGVector<int32_t> var_index(2);
+			var_index[0] = grid_to_index(x, y, w);
+			if (x + 1 < w)
+			{
+				var_index[1] = grid_to_index(x + 1, y, w);
+				fg->add_factor(std::make_shared<Factor>(pairtype, var_index.clone(), data));
+			}
+			if (y + 1 < h)
+			{
+				var_index[1] = grid_to_index(x, y + 1, w);
+				fg->add_factor(std::make_shared<Factor>(pairtype, var_index.clone(), data));
+			}
+		}
+	}
+
+	fg->compute_energies();
+	EXPECT_FALSE(fg->is_acyclic_graph());
+
+	// brute force minimum
+	float64_t min_energy_expected = std::numeric_limits<float64_t>::infinity();
+	SGVector<int32_t> y_cand(w*h);
+	for (int32_t code = 0; code < (1 << (w*h)); code++)
+	{
+		for (int32_t i = 0; i < w*h; i++)
+			y_cand[i] = (code >> i) & 1;
+		min_energy_expected = std::min(min_energy_expected, fg->evaluate_energy(y_cand));
+	}
+
+	MAPInference infer_met(fg, LOOPY_MAX_PROD);
+	infer_met.inference();
+
+	SGVector<int32_t> assignment = infer_met.get_structured_outputs()->get_data();
+	EXPECT_NEAR(min_energy_expected, infer_met.get_energy(), 1E-10);
+	EXPECT_NEAR(min_energy_expected, fg->evaluate_energy(assignment), 1E-10);
+	EXPECT_EQ(assignment[0], 1);
+	EXPECT_EQ(assignment[1], 0);
+	EXPECT_EQ(assignment[6], 1);
+}
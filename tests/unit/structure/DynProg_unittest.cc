@@ -0,0 +1,315 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/structure/DynProg.h>
+#include <shogun/structure/Plif.h>
+#include <shogun/structure/PlifMatrix.h>
+
+#include <random>
+#include <vector>
+
+using namespace shogun;
+
+namespace
+{
+	const int32_t num_states = 3;
+	const int32_t num_limits = 4;
+
+	/** random penalties of the segment length PLiFs */
+	SGMatrix<float64_t> random_penalties(std::mt19937_64& prng)
+	{
+		std::normal_distribution<float64_t> normal;
+		SGMatrix<float64_t> penalties(num_states * num_states, num_limits);
+		for (index_t i = 0; i < penalties.num_rows * penalties.num_cols; ++i)
+			penalties.matrix[i] = normal(prng);
+		return penalties;
+	}
+
+	/** one segment length PLiF per transition, only the even ones cached */
+	std::shared_ptr<PlifMatrix>
+	create_plif_matrix(const SGMatrix<float64_t>& penalties)
+	{
+		const int32_t num_plifs = num_states * num_states;
+
+		auto pm = std::make_shared<PlifMatrix>();
+		pm->create_plifs(num_plifs, num_limits);
+
+		SGVector<int32_t> ids(num_plifs);
+		SGVector<float64_t> min_values(num_plifs);
+		SGVector<float64_t> max_values(num_plifs);
+		SGVector<bool> use_cache(num_plifs);
+		SGMatrix<float64_t> limits(num_plifs, num_limits);
+		const float64_t plif_limits[num_limits] = {1.0, 5.0, 10.0, 20.0};
+		for (int32_t i = 0; i < num_plifs; ++i)
+		{
+			ids[i] = i;
+			min_values[i] = 1;
+			max_values[i] = 20;
+			use_cache[i] = i % 2 == 0;
+			for (int32_t k = 0; k < num_limits; ++k)
+				limits.matrix[i * num_limits + k] = plif_limits[k];
+		}
+		pm->set_plif_ids(ids);
+		pm->set_plif_min_values(min_values);
+		pm->set_plif_max_values(max_values);
+		pm->set_plif_use_cache(use_cache);
+		pm->set_plif_limits(limits);
+		pm->set_plif_penalties(penalties);
+
+		index_t dims[3] = {num_states, num_states, 1};
+		SGNDArray<float64_t> transition_plifs(dims, 3);
+		for (int32_t i = 0; i < num_plifs; ++i)
+			transition_plifs.array[i] = i + 1;
+		pm->compute_plif_matrix(transition_plifs);
+
+		// the observations are used as they are
+		SGMatrix<int32_t> state_signals(num_states, 1);
+		state_signals.zero();
+		pm->compute_signal_plifs(state_signals);
+
+		return pm;
+	}
+
+	/** decoder of one sequence
+	 *
+	 * @param transitions score of the transition from row to column state
+	 * @param observations score of every state (rows) at every position
+	 * @param p start scores
+	 * @param q end scores
+	 */
+	std::shared_ptr<DynProg> create_dynprog(
+	    const std::shared_ptr<PlifMatrix>& pm,
+	    const SGMatrix<float64_t>& transitions,
+	    const SGMatrix<float64_t>& observations, SGVector<float64_t> p,
+	    SGVector<float64_t> q)
+	{
+		const int32_t seq_len = observations.num_cols;
+
+		auto dyn = std::make_shared<DynProg>();
+		dyn->set_num_states(num_states);
+		dyn->long_transition_settings(false, 1000, 0);
+
+		SGVector<int32_t> pos(seq_len);
+		SGVector<char> genestr(seq_len);
+		for (int32_t t = 0; t < seq_len; ++t)
+		{
+			pos[t] = t;
+			genestr[t] = 'a';
+		}
+		dyn->set_pos(pos);
+		dyn->set_gene_string(genestr);
+
+		SGMatrix<int32_t> orf_info(num_states, 2);
+		orf_info.set_const(-1);
+		dyn->set_orf_info(orf_info);
+
+		dyn->set_p_vector(p);
+		dyn->set_q_vector(q);
+
+		// all transitions, sorted by the state they lead to
+		const int32_t num_trans = num_states * num_states;
+		SGMatrix<float64_t> a_trans(num_trans, 3);
+		for (int32_t to = 0; to < num_states; ++to)
+		{
+			for (int32_t from = 0; from < num_states; ++from)
+			{
+				int32_t row = to * num_states + from;
+				a_trans(row, 0) = from;
+				a_trans(row, 1) = to;
+				a_trans(row, 2) = transitions(from, to);
+			}
+		}
+		dyn->set_a_trans_matrix(a_trans);
+
+		index_t dims[3] = {num_states, seq_len, 1};
+		SGNDArray<float64_t> observation_array(dims, 3);
+		for (int32_t i = 0; i < num_states * seq_len; ++i)
+			observation_array.array[i] = observations.matrix[i];
+		dyn->set_observation_matrix(observation_array);
+
+		dyn->set_plif_matrices(pm);
+		return dyn;
+	}
+
+	/** decoder with random scores, the observations of state 0 are
+	 * margin above and those of the other states margin below them
+	 */
+	std::shared_ptr<DynProg> create_random_dynprog(
+	    const std::shared_ptr<PlifMatrix>& pm, std::mt19937_64& prng,
+	    int32_t seq_len, float64_t margin = 0)
+	{
+		std::normal_distribution<float64_t> normal;
+
+		SGMatrix<float64_t> transitions(num_states, num_states);
+		for (index_t i = 0; i < num_states * num_states; ++i)
+			transitions.matrix[i] = normal(prng);
+
+		SGMatrix<float64_t> observations(num_states, seq_len);
+		for (int32_t t = 0; t < seq_len; ++t)
+			for (int32_t i = 0; i < num_states; ++i)
+				observations(i, t) = normal(prng) + (i == 0 ? margin : -margin);
+
+		SGVector<float64_t> p(num_states);
+		SGVector<float64_t> q(num_states);
+		for (int32_t i = 0; i < num_states; ++i)
+		{
+			p[i] = normal(prng);
+			q[i] = normal(prng);
+		}
+
+		return create_dynprog(pm, transitions, observations, p, q);
+	}
+
+	/** result of the last decoding of a DynProg */
+	struct DecodedPath
+	{
+		DecodedPath(const std::shared_ptr<DynProg>& dyn)
+		    : score(dyn->get_scores()[0]), states(dyn->get_states()),
+		      positions(dyn->get_positions())
+		{
+		}
+
+		void expect_equal(const DecodedPath& other) const
+		{
+			EXPECT_NEAR(score, other.score, 1e-10);
+			ASSERT_EQ(states.num_cols, other.states.num_cols);
+			for (index_t i = 0; i < states.num_cols; ++i)
+			{
+				EXPECT_EQ(states(0, i), other.states(0, i));
+				EXPECT_EQ(positions(0, i), other.positions(0, i));
+			}
+		}
+
+		bool visits(int32_t state) const
+		{
+			for (index_t i = 0; i < states.num_cols; ++i)
+			{
+				if (states(0, i) == state)
+					return true;
+			}
+			return false;
+		}
+
+		float64_t score;
+		SGMatrix<int32_t> states;
+		SGMatrix<int32_t> positions;
+	};
+}
+
+TEST(DynProg, parallel_beam_decoding_same_as_exact)
+{
+	std::mt19937_64 prng(17);
+	auto pm = create_plif_matrix(random_penalties(prng));
+	auto dyn = create_random_dynprog(pm, prng, 60);
+
+	int32_t num_threads = env()->get_num_threads();
+	env()->set_num_threads(1);
+	dyn->compute_nbest_paths(1, false, 1, false, false);
+	DecodedPath exact(dyn);
+
+	// the beam is much wider than the score differences of the problem
+	env()->set_num_threads(4);
+	dyn->set_beam_width(1e3);
+	dyn->compute_nbest_paths(1, false, 1, false, false);
+	env()->set_num_threads(num_threads);
+
+	EXPECT_EQ(dyn->get_num_pruned_segments(), 0);
+	EXPECT_EQ(dyn->get_scores().vlen, 1);
+	DecodedPath(dyn).expect_equal(exact);
+
+	// decoding does not switch on caching of the PLiFs
+	auto plifs = pm->get_PEN();
+	for (int32_t i = 0; i < pm->get_num_plifs(); ++i)
+		EXPECT_EQ(plifs[i]->get_use_cache() != 0, i % 2 == 0);
+}
+
+TEST(DynProg, narrow_beam_decoding_same_as_exact)
+{
+	// state 0 is 40 above the others at every position, far more than
+	// the transitions and PLiFs can make up for, so the best path only
+	// starts segments in state 0
+	std::mt19937_64 prng(23);
+	auto pm = create_plif_matrix(random_penalties(prng));
+	auto dyn = create_random_dynprog(pm, prng, 60, 20);
+
+	dyn->compute_nbest_paths(1, false, 1, false, false);
+	EXPECT_EQ(dyn->get_num_pruned_segments(), 0);
+	DecodedPath exact(dyn);
+
+	// segments starting in the other states are skipped
+	dyn->set_beam_width(10);
+	dyn->compute_nbest_paths(1, false, 1, false, false);
+	EXPECT_GT(dyn->get_num_pruned_segments(), 0);
+	DecodedPath(dyn).expect_equal(exact);
+}
+
+TEST(DynProg, too_narrow_beam_changes_path)
+{
+	// state 0 gains 1 per position, the transition 1 -> 2 gains 10 once
+	// and 0 -> 2 as well as leaving state 2 are penalized. The best path
+	// goes through state 1 at the end, whose partial paths are always 1
+	// below those of state 0.
+	SGMatrix<float64_t> penalties(num_states * num_states, num_limits);
+	penalties.zero();
+	auto pm = create_plif_matrix(penalties);
+
+	const int32_t seq_len = 60;
+	SGMatrix<float64_t> transitions(num_states, num_states);
+	transitions.set_const(-100);
+	transitions(0, 0) = 0;
+	transitions(0, 1) = 0;
+	transitions(1, 1) = 0;
+	transitions(1, 2) = 10;
+	transitions(2, 2) = 0;
+	SGMatrix<float64_t> observations(num_states, seq_len);
+	observations.zero();
+	for (int32_t t = 0; t < seq_len; ++t)
+		observations(0, t) = 1;
+	SGVector<float64_t> p(num_states);
+	SGVector<float64_t> q(num_states);
+	p.zero();
+	q.zero();
+	auto dyn = create_dynprog(pm, transitions, observations, p, q);
+
+	dyn->compute_nbest_paths(1, false, 1, false, false);
+	DecodedPath exact(dyn);
+	EXPECT_NEAR(exact.score, seq_len + 8, 1e-10);
+	EXPECT_TRUE(exact.visits(2));
+
+	// a beam narrower than 1 skips every segment starting in state 1
+	dyn->set_beam_width(0.5);
+	dyn->compute_nbest_paths(1, false, 1, false, false);
+	EXPECT_GT(dyn->get_num_pruned_segments(), 0);
+	DecodedPath pruned(dyn);
+	EXPECT_NEAR(pruned.score, seq_len, 1e-10);
+	EXPECT_FALSE(pruned.visits(2));
+}
+
+TEST(DynProg, batch_decoding_same_as_single)
+{
+	std::mt19937_64 prng(29);
+	auto pm = create_plif_matrix(random_penalties(prng));
+
+	// sequences of different lengths that share the PLiFs
+	std::vector<std::shared_ptr<DynProg>> decoders;
+	for (int32_t seq_len : {40, 60, 80, 100, 50, 70})
+		decoders.push_back(create_random_dynprog(pm, prng, seq_len));
+
+	int32_t num_threads = env()->get_num_threads();
+	env()->set_num_threads(4);
+	DynProg::compute_nbest_paths_batch(decoders, 1, false, 1, false);
+	env()->set_num_threads(num_threads);
+
+	std::vector<DecodedPath> batch;
+	for (const auto& dyn : decoders)
+		batch.emplace_back(dyn);
+
+	for (size_t i = 0; i < decoders.size(); ++i)
+	{
+		decoders[i]->compute_nbest_paths(1, false, 1, false, false);
+		DecodedPath(decoders[i]).expect_equal(batch[i]);
+	}
+}
@@ -0,0 +1,49 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/structure/Plif.h>
+
+#include <cmath>
+
+using namespace shogun;
+
+static std::shared_ptr<Plif> create_plif()
+{
+	auto plif = std::make_shared<Plif>(4);
+	plif->set_plif_limits(SGVector<float64_t>({2.0, 5.0, 10.0, 40.0}));
+	plif->set_plif_penalty(SGVector<float64_t>({1.0, -1.0, 0.5, 3.0}));
+	plif->set_min_value(1);
+	plif->set_max_value(50);
+	return plif;
+}
+
+TEST(Plif, lookup_interpolates)
+{
+	auto plif = create_plif();
+
+	// constant outside of the limits
+	EXPECT_EQ(plif->lookup_penalty(1.5, NULL), 1.0);
+	EXPECT_EQ(plif->lookup_penalty(45.0, NULL), 3.0);
+	// exact at the limits and linear in between
+	EXPECT_EQ(plif->lookup_penalty(5.0, NULL), -1.0);
+	EXPECT_NEAR(plif->lookup_penalty(3.5, NULL), 0.0, 1e-12);
+	EXPECT_NEAR(plif->lookup_penalty(25.0, NULL), 1.75, 1e-12);
+	// outside of [min_value, max_value]
+	EXPECT_EQ(plif->lookup_penalty(0.5, NULL), -Math::INFTY);
+	EXPECT_EQ(plif->lookup_penalty(51.0, NULL), -Math::INFTY);
+}
+
+TEST(Plif, cached_lookup_same_as_computed)
+{
+	auto plif = create_plif();
+	SGVector<float64_t> expected(52);
+	for (int32_t i = 0; i < expected.vlen; ++i)
+		expected[i] = plif->lookup_penalty(i, NULL);
+
+	plif->set_use_cache(true);
+	plif->init_penalty_struct_cache();
+	for (int32_t i = 0; i < expected.vlen; ++i)
+		EXPECT_EQ(plif->lookup_penalty(i, NULL), expected[i]);
+}
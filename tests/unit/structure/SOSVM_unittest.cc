@@ -9,8 +9,14 @@
 #include <shogun/structure/StochasticSOSVM.h>
 #include <shogun/structure/FWSOSVM.h>
 #include <shogun/structure/SOSVMHelper.h>
+#include <shogun/structure/MulticlassModel.h>
+#include <shogun/structure/MulticlassSOLabels.h>
+#include <shogun/features/DataGenerator.h>
+#include <shogun/features/DenseFeatures.h>
 #include <gtest/gtest.h>
 
+#include <random>
+
 using namespace shogun;
 
 TEST(SOSVM, sgd_check_w_helper)
@@ -176,4 +182,76 @@ TEST(SOSVM, fw_check_w_helper)
 
 
 
+}
+
+static std::shared_ptr<MulticlassModel> multiclass_gaussians_model()
+{
+	const index_t num_per_class = 20;
+	std::mt19937_64 prng(11);
+	auto data = DataGenerator::generate_gaussians(num_per_class, 4, 2, prng);
+	SGVector<float64_t> lab(data.num_cols);
+	for (index_t i = 0; i < lab.vlen; ++i)
+		lab[i] = i / num_per_class;
+
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto labels = std::make_shared<MulticlassSOLabels>(lab);
+	return std::make_shared<MulticlassModel>(features, labels);
+}
+
+TEST(SOSVM, argmax_batch_same_as_argmax)
+{
+	auto model = multiclass_gaussians_model();
+	int32_t N = model->get_labels()->get_num_labels();
+
+	std::mt19937_64 prng(5);
+	std::normal_distribution<float64_t> normal;
+	SGVector<float64_t> w(model->get_dim());
+	for (index_t i = 0; i < w.vlen; ++i)
+		w[i] = normal(prng);
+
+	SGVector<int32_t> examples(N);
+	examples.range_fill();
+	for (bool training : {true, false})
+	{
+		auto results = model->argmax_batch(w, examples, training);
+		ASSERT_EQ(results.size(), N);
+		for (int32_t i = 0; i < N; ++i)
+		{
+			auto expected = model->argmax(w, i, training);
+			EXPECT_EQ(
+			    results[i]->argmax->as<RealNumber>()->value,
+			    expected->argmax->as<RealNumber>()->value);
+			EXPECT_NEAR(results[i]->score, expected->score, 1e-12);
+			EXPECT_NEAR(results[i]->delta, expected->delta, 1e-12);
+		}
+	}
+}
+
+TEST(SOSVM, fw_block_coordinate)
+{
+	auto model = multiclass_gaussians_model();
+	auto labels = model->get_labels();
+
+	auto fw = std::make_shared<FWSOSVM>(model, labels, true, false);
+	fw->set_batch_size(8);
+	fw->set_num_iter(200);
+	fw->set_gap_threshold(1e-4);
+	fw->put(random::kSeed, 3);
+	fw->train();
+	auto w = fw->get_w();
+
+	// ell is kept consistent with w, so the primal-dual gap is small
+	float64_t lambda = fw->get_lambda();
+	float64_t primal = SOSVMHelper::primal_objective(w, model, lambda);
+	float64_t dual = SOSVMHelper::dual_objective(w, fw->get_ell(), lambda);
+	EXPECT_GE(primal - dual, -1e-10);
+	EXPECT_LT(primal - dual, 1e-2);
+
+	auto predicted = fw->apply_structured(model->get_features());
+	auto truth = labels->as<MulticlassSOLabels>();
+	int32_t num_correct = 0;
+	for (int32_t i = 0; i < truth->get_num_labels(); ++i)
+		num_correct += predicted->get_label(i)->as<RealNumber>()->value ==
+		               truth->get_label(i)->as<RealNumber>()->value;
+	EXPECT_GT(num_correct, 0.9 * truth->get_num_labels());
 }